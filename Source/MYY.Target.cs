@@ -10,6 +10,9 @@ public class MYYTarget : TargetRules
 		Type = TargetType.Game;
 		DefaultBuildSettings = BuildSettingsVersion.V5;
 
+		// Push-model replication (net.IsPushModelEnabled)
+		bWithPushModel = true;
+
 		ExtraModuleNames.AddRange( new string[] { "MYY" } );
 	}
 }
@@ -9,6 +9,7 @@
 
 
 class UBehaviorTree;
+class UStaticMesh;
 
 UCLASS()
 class MYY_API AAICharacter : public AMYYCharacterBase
@@ -34,6 +35,10 @@ public:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "AI|Combat", meta = (ClampMin = "0.0", ClampMax = "1.0"))
 	float AggressionLevel = 0.7f;
 
+	// Drawn for this minion while it's simulated by UMinionCrowdSubsystem (far from every player)
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "AI|Crowd")
+	UStaticMesh* CrowdProxyMesh;
+
 protected:
 	virtual void BeginPlay() override;
 	void PossessedBy(AController* NewController);
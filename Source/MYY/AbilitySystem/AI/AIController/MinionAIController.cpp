@@ -2,12 +2,18 @@
 #include "BehaviorTree/BehaviorTreeComponent.h"
 #include "BehaviorTree/BlackboardComponent.h"
 #include "BehaviorTree/BehaviorTree.h"
+#include "BehaviorTree/BlackboardData.h"
 #include "Perception/AIPerceptionComponent.h"
-#include "Perception/AISenseConfig_Sight.h"
 #include "Perception/AISenseConfig_Damage.h"
 #include "MYY/AbilitySystem/AI//AICharacter.h"
 #include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
 #include "Engine/World.h"
+#include "MYY/AbilitySystem/Subsystem/TargetGridSubsystem.h"
+#include "MYY/AbilitySystem/Subsystem/AttackSlotSubsystem.h"
+#include "MYY/AbilitySystem/Subsystem/TargetSelectionSubsystem.h"
+#include "MYY/AbilitySystem/Subsystem/MinionCombatStateSubsystem.h"
+#include "MYY/MYY.h"
 
 const FName AMinionAIController::BB_TargetActor     =       TEXT("TargetActor");
 const FName AMinionAIController::BB_PatrolLocation  =    TEXT("PatrolLocation");
@@ -25,22 +31,12 @@ AMinionAIController::AMinionAIController()
 	AIPerceptionComponent = CreateDefaultSubobject<UAIPerceptionComponent>(TEXT("AIPerceptionComponent"));
 	SetPerceptionComponent(*AIPerceptionComponent);
 
-	// Configure Sight
-	SightConfig = CreateDefaultSubobject<UAISenseConfig_Sight>(TEXT("SightConfig"));
-	SightConfig->SightRadius = 2000.f;
-	SightConfig->LoseSightRadius = 2500.f;
-	SightConfig->PeripheralVisionAngleDegrees = 90.f;
-    SightConfig->DetectionByAffiliation.bDetectEnemies = true;      // ✅ Detect hostile teams
-    SightConfig->DetectionByAffiliation.bDetectNeutrals = true;     // ✅ Detect neutral actors
-    SightConfig->DetectionByAffiliation.bDetectFriendlies = false;  // ✅ Ignore teammates
-	SightConfig->SetMaxAge(5.f);
-
-	AIPerceptionComponent->ConfigureSense(*SightConfig);
-	AIPerceptionComponent->SetDominantSense(SightConfig->GetSenseImplementation());
+	// Sight is handled for all minions at once by UTargetGridSubsystem (SightRadius, LoseSightRadius, ...)
 
 	// Configure Damage sense
 	DamageConfig = CreateDefaultSubobject<UAISenseConfig_Damage>(TEXT("DamageConfig"));
 	AIPerceptionComponent->ConfigureSense(*DamageConfig);
+	AIPerceptionComponent->SetDominantSense(DamageConfig->GetSenseImplementation());
 
 	// Bind perception events
 	AIPerceptionComponent->OnTargetPerceptionUpdated.AddDynamic(this, &AMinionAIController::OnTargetPerceptionUpdated);
@@ -77,6 +73,32 @@ void AMinionAIController::OnPossess(APawn* InPawn)
 
     AAICharacter* AIChar = Cast<AAICharacter>(InPawn);
 
+    // Pooled controllers possess a new pawn at a new spawn point
+    if (InPawn)
+    {
+        HomeLocation = InPawn->GetActorLocation();
+    }
+
+    if (UMinionSignificanceSubsystem* Significance = GetWorld()->GetSubsystem<UMinionSignificanceSubsystem>())
+    {
+        Significance->RegisterMinion(this);
+    }
+
+    if (UTargetGridSubsystem* TargetGrid = GetWorld()->GetSubsystem<UTargetGridSubsystem>())
+    {
+        TargetGrid->RegisterSeeker(this);
+    }
+
+    if (UTargetSelectionSubsystem* TargetSelection = GetWorld()->GetSubsystem<UTargetSelectionSubsystem>())
+    {
+        TargetSelection->RegisterSeeker(this);
+    }
+
+    if (UMinionCombatStateSubsystem* CombatState = GetWorld()->GetSubsystem<UMinionCombatStateSubsystem>())
+    {
+        CombatState->RegisterMinion(this);
+    }
+
     if (AAICharacter* PC = Cast<AAICharacter>(InPawn))
     {
         if (PC->EquipmentComponent)
@@ -118,12 +140,54 @@ void AMinionAIController::OnUnPossess()
         BehaviorTreeComponent->StopTree();
     }
 
+    // Parked by UMinionPoolSubsystem and reused: the next pawn starts with a clean blackboard
+    if (BlackboardComponent)
+    {
+        for (const UBlackboardData* Data = BlackboardComponent->GetBlackboardAsset(); Data; Data = Data->Parent)
+        {
+            for (const FBlackboardEntry& Entry : Data->Keys)
+            {
+                BlackboardComponent->ClearValue(Entry.EntryName);
+            }
+        }
+    }
+    bTargetInSight = false;
+    LastTargetSeenTime = 0.0;
+
+    // Hand the pawn back at full rate
+    SetSignificanceTier(EMinionSignificance::High);
+    if (UMinionSignificanceSubsystem* Significance = GetWorld()->GetSubsystem<UMinionSignificanceSubsystem>())
+    {
+        Significance->UnregisterMinion(this);
+    }
+
+    if (UTargetGridSubsystem* TargetGrid = GetWorld()->GetSubsystem<UTargetGridSubsystem>())
+    {
+        TargetGrid->UnregisterSeeker(this);
+    }
+
+    if (UTargetSelectionSubsystem* TargetSelection = GetWorld()->GetSubsystem<UTargetSelectionSubsystem>())
+    {
+        TargetSelection->UnregisterSeeker(this);
+    }
+
+    if (UMinionCombatStateSubsystem* CombatState = GetWorld()->GetSubsystem<UMinionCombatStateSubsystem>())
+    {
+        CombatState->UnregisterMinion(this);
+    }
+
+    if (UAttackSlotSubsystem* AttackSlots = GetWorld()->GetSubsystem<UAttackSlotSubsystem>())
+    {
+        AttackSlots->ReleaseSlot(GetPawn());
+    }
+
     Super::OnUnPossess();
     
 }
 
 void AMinionAIController::OnTargetPerceptionUpdated(AActor* Actor, FAIStimulus Stimulus)
 {
+    FScopeCycleCounter TierCounter(UMinionSignificanceSubsystem::GetTierStatId(SignificanceTier));
 
     // FIX: perception can fire before possession or after destroy
     if (!IsValid(Actor))
@@ -161,38 +225,56 @@ void AMinionAIController::OnTargetPerceptionUpdated(AActor* Actor, FAIStimulus S
         }
     }
 
-    // ✅ NOW: Process hostile targets
-    if (Stimulus.WasSuccessfullySensed())
+    // ✅ NOW: Process hostile targets (damage sense only; losing them is up to the sight checks).
+    // With a target already, switching is left to UTargetSelectionSubsystem's scores.
+    if (Stimulus.WasSuccessfullySensed() && !GetTargetActor())
+    {
+        HandleSightResult(Actor, true);
+    }
+}
+
+void AMinionAIController::HandleSightResult(AActor* Target, bool bVisible)
+{
+    if (!HasAuthority() || !IsValid(Target) || !BlackboardComponent || !GetPawn())
+    {
+        return;
+    }
+
+    AActor* CurrentTarget = GetTargetActor();
+
+    if (bVisible)
     {
-        UE_LOG(LogTemp, Log, TEXT("AI %s detected HOSTILE target: %s"), 
-            *GetPawn()->GetName(), *Actor->GetName());
+        if (CurrentTarget != Target)
+        {
+            UE_LOG(LogMYYCombat, Verbose, TEXT("AI %s detected HOSTILE target: %s"), 
+                *GetPawn()->GetName(), *Target->GetName());
+
+            SetTargetActor(Target);
+        }
 
-        SetTargetActor(Actor);
-        BlackboardComponent->SetValueAsVector(BB_LastKnownLocation, Actor->GetActorLocation() );
+        LastTargetSeenTime = GetWorld()->GetTimeSeconds();
+        bTargetInSight = true;
+        BlackboardComponent->SetValueAsVector(BB_LastKnownLocation, Target->GetActorLocation());
         BlackboardComponent->SetValueAsBool(BB_IsInCombat, true);
+        return;
     }
-    else
+
+    if (CurrentTarget != Target)
     {
-        UE_LOG(LogTemp, Log, TEXT("AI %s lost sight of: %s"), *GetPawn()->GetName(), *Actor->GetName());
+        return;
+    }
 
-        BlackboardComponent->SetValueAsVector(BB_LastKnownLocation, Actor->GetActorLocation());
-        
-        FTimerHandle ClearTargetTimer;
-        GetWorld()->GetTimerManager().SetTimer(ClearTargetTimer, [this]()
-        {
-            if (!IsValid(this) || !BlackboardComponent || !AIPerceptionComponent)
-            {
-                return;
-            }
-    
-            TArray<AActor*> PerceivedActors;
-            AIPerceptionComponent->GetCurrentlyPerceivedActors(UAISense_Sight::StaticClass(), PerceivedActors);
-    
-            if (PerceivedActors.Num() == 0)
-            {
-                ClearTarget();
-            }
-        }, 5.0f, false);
+    if (bTargetInSight)
+    {
+        UE_LOG(LogMYYCombat, Verbose, TEXT("AI %s lost sight of: %s"), *GetPawn()->GetName(), *Target->GetName());
+
+        bTargetInSight = false;
+        BlackboardComponent->SetValueAsVector(BB_LastKnownLocation, Target->GetActorLocation());
+    }
+
+    if (GetWorld()->GetTimeSeconds() - LastTargetSeenTime >= TargetMaxAge)
+    {
+        ClearTarget();
     }
 }
 
@@ -204,13 +286,13 @@ void AMinionAIController::OnDamageTaken(AActor* DamagedActor, float Damage,
         return;
     }
 
-    // React to damage by targeting the attacker
+    // React to damage by targeting the attacker (only when idle, see OnTargetPerceptionUpdated)
     if (!GetTargetActor())
     {
         SetTargetActor(InstigatedBy->GetPawn());
         BlackboardComponent->SetValueAsBool(BB_IsInCombat, true);
         
-        UE_LOG(LogTemp, Warning, TEXT("AI %s taking damage from %s - entering combat!"), 
+        UE_LOG(LogMYYCombat, Verbose, TEXT("AI %s taking damage from %s - entering combat!"), 
             *GetPawn()->GetName(), *InstigatedBy->GetPawn()->GetName());
     }
 }
@@ -223,6 +305,26 @@ void AMinionAIController::EndPlay(const EEndPlayReason::Type EndPlayReason)
         Perception->OnTargetPerceptionUpdated.RemoveAll(this);
     }
 
+    if (UMinionSignificanceSubsystem* Significance = GetWorld()->GetSubsystem<UMinionSignificanceSubsystem>())
+    {
+        Significance->UnregisterMinion(this);
+    }
+
+    if (UTargetGridSubsystem* TargetGrid = GetWorld()->GetSubsystem<UTargetGridSubsystem>())
+    {
+        TargetGrid->UnregisterSeeker(this);
+    }
+
+    if (UTargetSelectionSubsystem* TargetSelection = GetWorld()->GetSubsystem<UTargetSelectionSubsystem>())
+    {
+        TargetSelection->UnregisterSeeker(this);
+    }
+
+    if (UMinionCombatStateSubsystem* CombatState = GetWorld()->GetSubsystem<UMinionCombatStateSubsystem>())
+    {
+        CombatState->UnregisterMinion(this);
+    }
+
     Super::EndPlay(EndPlayReason);
 }
 
@@ -270,8 +372,32 @@ void AMinionAIController::ClearTarget()
         AIChar->SetCurrentTarget(nullptr);
     }
 
-    UE_LOG(LogTemp, Log, TEXT("AI %s cleared target"), *GetPawn()->GetName());
+    UE_LOG(LogMYYCombat, Verbose, TEXT("AI %s cleared target"), *GetPawn()->GetName());
 }
 
+void AMinionAIController::SetSignificanceTier(EMinionSignificance NewTier)
+{
+    if (NewTier == SignificanceTier)
+    {
+        return;
+    }
+
+    SignificanceTier = NewTier;
+    const FMinionSignificanceTierSettings& Settings = UMinionSignificanceSubsystem::GetTierSettings(NewTier);
+
+    ACharacter* Minion = Cast<ACharacter>(GetPawn());
+    if (!Minion)
+    {
+        return;
+    }
+
+    if (UCharacterMovementComponent* Movement = Minion->GetCharacterMovement())
+    {
+        Movement->SetComponentTickInterval(Settings.MovementTickInterval);
+    }
 
- 
\ No newline at end of file
+    if (USkeletalMeshComponent* Mesh = Minion->GetMesh())
+    {
+        Mesh->SetComponentTickInterval(Settings.AnimTickInterval);
+    }
+}
@@ -3,8 +3,8 @@
 #include "CoreMinimal.h"
 #include "AIController.h"
 #include "Perception/AIPerceptionComponent.h"
-#include "Perception/AISenseConfig_Sight.h"
 #include "Perception/AISenseConfig_Damage.h"
+#include "MYY/AbilitySystem/Subsystem/MinionSignificanceSubsystem.h"
 #include "MinionAIController.generated.h"
 
 class UBehaviorTreeComponent;
@@ -35,6 +35,28 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "AI")
 	void ClearTarget();
 
+	// Line-of-sight result for Target from UTargetGridSubsystem. Acquires visible hostiles and
+	// drops the current target once it has been out of sight for TargetMaxAge.
+	void HandleSightResult(AActor* Target, bool bVisible);
+
+	// Target acquisition (done for all minions by UTargetGridSubsystem)
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "AI|Targeting")
+	float SightRadius = 2000.f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "AI|Targeting")
+	float LoseSightRadius = 2500.f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "AI|Targeting")
+	float PeripheralVisionAngleDegrees = 90.f;
+
+	// Seconds the target may stay out of sight before it's cleared
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "AI|Targeting")
+	float TargetMaxAge = 5.f;
+
+	// Set by UMinionSignificanceSubsystem; applies the tier's movement and animation rates
+	void SetSignificanceTier(EMinionSignificance NewTier);
+	EMinionSignificance GetSignificanceTier() const { return SignificanceTier; }
+
 protected:
 	virtual void OnPossess(APawn* InPawn) override;
 	virtual void OnUnPossess() override;
@@ -44,9 +66,6 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "AI")
 	UAIPerceptionComponent* AIPerceptionComponent;
 
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "AI")
-	UAISenseConfig_Sight* SightConfig;
-
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "AI")
 	UAISenseConfig_Damage* DamageConfig;
 
@@ -66,6 +85,12 @@ protected:
 
 	// Home location for patrol/reset
 	FVector HomeLocation;
+
+	EMinionSignificance SignificanceTier = EMinionSignificance::High;
+
+	// When the current target was last confirmed visible
+	double LastTargetSeenTime = 0.0;
+	bool bTargetInSight = false;
 	
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
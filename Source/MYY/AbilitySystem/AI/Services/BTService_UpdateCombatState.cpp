@@ -1,10 +1,8 @@
 ﻿#include "BTService_UpdateCombatState.h"
 #include "AIController.h"
-#include "BehaviorTree/BlackboardComponent.h"
-#include "MYY/AbilitySystem/MYYCharacterBase.h"
-#include "MYY/AbilitySystem/AI/AICharacter.h"
-#include "AbilitySystemComponent.h"
-#include "MYY/AbilitySystem/AttributeSet/AttributeSetBase.h"
+#include "BehaviorTree/BehaviorTreeComponent.h"
+#include "MYY/AbilitySystem/AI/AIController/MinionAIController.h"
+#include "MYY/AbilitySystem/Subsystem/MinionCombatStateSubsystem.h"
 
 UBTService_UpdateCombatState::UBTService_UpdateCombatState()
 {
@@ -15,73 +13,47 @@ UBTService_UpdateCombatState::UBTService_UpdateCombatState()
     TargetActorKey.AddObjectFilter(this, GET_MEMBER_NAME_CHECKED(UBTService_UpdateCombatState, TargetActorKey), AActor::StaticClass());
     CanAttackKey.AddBoolFilter(this, GET_MEMBER_NAME_CHECKED(UBTService_UpdateCombatState, CanAttackKey));
     ShouldBlockKey.AddBoolFilter(this, GET_MEMBER_NAME_CHECKED(UBTService_UpdateCombatState, ShouldBlockKey));
+    TargetDistanceKey.AddFloatFilter(this, GET_MEMBER_NAME_CHECKED(UBTService_UpdateCombatState, TargetDistanceKey));
+    TargetDistanceKey.AllowNoneAsValue(true);
+
+    // Evaluation happens in UMinionCombatStateSubsystem
+    bNotifyTick = false;
+    bNotifyBecomeRelevant = true;
+    bNotifyCeaseRelevant = true;
 }
 
-void UBTService_UpdateCombatState::TickNode(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds)
+void UBTService_UpdateCombatState::OnBecomeRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
 {
-    Super::TickNode(OwnerComp, NodeMemory, DeltaSeconds);
-
-    AAIController* AIController = OwnerComp.GetAIOwner();
-    if (!AIController)
-    {
-        return;
-    }
-
-    AMYYCharacterBase* AICharacter = Cast<AMYYCharacterBase>(AIController->GetPawn());
-    AAICharacter* AIChar = Cast<AAICharacter>(AIController->GetPawn());
-    
-    if (!AICharacter || !AIChar || !AICharacter->AbilitySystemComponent)
-    {
-        return;
-    }
-
-    UBlackboardComponent* BlackboardComp = OwnerComp.GetBlackboardComponent();
-    if (!BlackboardComp)
-    {
-        return;
-    }
+    Super::OnBecomeRelevant(OwnerComp, NodeMemory);
 
-    // Check if we have a target
-    AActor* TargetActor = Cast<AActor>(BlackboardComp->GetValueAsObject(TargetActorKey.SelectedKeyName));
-    if (!TargetActor)
+    AMinionAIController* MinionController = Cast<AMinionAIController>(OwnerComp.GetAIOwner());
+    UMinionCombatStateSubsystem* CombatState = GetWorld() ? GetWorld()->GetSubsystem<UMinionCombatStateSubsystem>() : nullptr;
+    if (!MinionController || !CombatState)
     {
-        BlackboardComp->SetValueAsBool(CanAttackKey.SelectedKeyName, false);
-        BlackboardComp->SetValueAsBool(ShouldBlockKey.SelectedKeyName, false);
         return;
     }
-    
-    UAttributeSetBase* AttributeSet = const_cast<UAttributeSetBase*>( Cast<UAttributeSetBase>( AICharacter->AbilitySystemComponent->GetAttributeSet( UAttributeSetBase::StaticClass() ) ) );
-    float CurrentStamina = AttributeSet ? AttributeSet->GetStamina() : 0.f;
-
-    float CurrentTime = AIController->GetWorld()->GetTimeSeconds();
-    bool bCanAttack = (CurrentTime - LastAttackTime >= AttackCooldown) && (CurrentStamina >= MinStaminaForAttack);
 
-    BlackboardComp->SetValueAsBool(CanAttackKey.SelectedKeyName, bCanAttack);
-
-    if (bCanAttack)
-    {
-        LastAttackTime = CurrentTime;
-    }
-
-    // Determine if should block based on:
-    // 1. Enemy is attacking (has State.Combat.Attacking tag)
-    // 2. Random chance based on BlockChance
-    // 3. Has enough stamina
-    bool bShouldBlock = false;
+    FMinionCombatConfig Config;
+    Config.TargetActorKey = TargetActorKey.SelectedKeyName;
+    Config.CanAttackKey = CanAttackKey.SelectedKeyName;
+    Config.ShouldBlockKey = ShouldBlockKey.SelectedKeyName;
+    Config.TargetDistanceKey = TargetDistanceKey.IsSet() ? TargetDistanceKey.SelectedKeyName : NAME_None;
+    Config.AttackCooldown = AttackCooldown;
+    Config.MinStaminaForAttack = MinStaminaForAttack;
+    Config.MinStaminaForBlock = MinStaminaForBlock;
+    Config.Interval = Interval;
+    Config.RandomDeviation = RandomDeviation;
+
+    CombatState->ActivateMinion(MinionController, OwnerComp.GetBlackboardComponent(), Config);
+}
 
-    AMYYCharacterBase* TargetChar = Cast<AMYYCharacterBase>(TargetActor);
-    if (TargetChar && TargetChar->AbilitySystemComponent)
+void UBTService_UpdateCombatState::OnCeaseRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+    if (UMinionCombatStateSubsystem* CombatState = GetWorld() ? GetWorld()->GetSubsystem<UMinionCombatStateSubsystem>() : nullptr)
     {
-        bool bTargetAttacking = TargetChar->AbilitySystemComponent->HasMatchingGameplayTag(
-            FGameplayTag::RequestGameplayTag("State.Combat.Attacking")
-        );
-
-        if (bTargetAttacking && CurrentStamina >= 10.f)
-        {
-            float RandomValue = FMath::FRand();
-            bShouldBlock = (RandomValue <= AIChar->BlockChance);
-        }
+        // Registration follows possession; only stop evaluating so the attack cooldown carries over
+        CombatState->PauseMinion(Cast<AMinionAIController>(OwnerComp.GetAIOwner()));
     }
 
-    BlackboardComp->SetValueAsBool(ShouldBlockKey.SelectedKeyName, bShouldBlock);
-}
\ No newline at end of file
+    Super::OnCeaseRelevant(OwnerComp, NodeMemory);
+}
@@ -5,6 +5,10 @@
 #include "BTService_UpdateCombatState.generated.h"
 
 
+/**
+ * Activates the minion in UMinionCombatStateSubsystem while the branch is relevant (registration follows possession).
+ * CanAttack / ShouldBlock are evaluated there for all minions in one batch.
+ */
 UCLASS()
 class MYY_API UBTService_UpdateCombatState : public UBTService
 {
@@ -14,7 +18,8 @@ public:
 	UBTService_UpdateCombatState();
 
 protected:
-	virtual void TickNode(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds) override;
+	virtual void OnBecomeRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual void OnCeaseRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
 
 	UPROPERTY(EditAnywhere, Category = "Combat")
 	FBlackboardKeySelector TargetActorKey;
@@ -25,13 +30,17 @@ protected:
 	UPROPERTY(EditAnywhere, Category = "Combat")
 	FBlackboardKeySelector ShouldBlockKey;
 
+	// Optional: distance to the target, written on each evaluation
+	UPROPERTY(EditAnywhere, Category = "Combat")
+	FBlackboardKeySelector TargetDistanceKey;
+
 	UPROPERTY(EditAnywhere, Category = "Combat")
 	float AttackCooldown = 2.0f;
 
 	UPROPERTY(EditAnywhere, Category = "Combat")
 	float MinStaminaForAttack = 15.0f;
 
-private:
-	float LastAttackTime = 0.f;
+	UPROPERTY(EditAnywhere, Category = "Combat")
+	float MinStaminaForBlock = 10.0f;
 };
 
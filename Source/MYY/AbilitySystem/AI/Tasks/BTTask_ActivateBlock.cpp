@@ -5,6 +5,7 @@
 #include "AbilitySystemComponent.h"
 #include "GameplayTagContainer.h"
 #include "TimerManager.h"
+#include "MYY/AbilitySystem/GameplayTags/MYYGameplayTags.h"
 
 UBTTask_ActivateBlock::UBTTask_ActivateBlock()
 {
@@ -30,7 +31,7 @@ EBTNodeResult::Type UBTTask_ActivateBlock::ExecuteTask(UBehaviorTreeComponent& O
 
     // Activate block ability
     FGameplayTagContainer BlockTags;
-    BlockTags.AddTag(FGameplayTag::RequestGameplayTag("Ability.Combat.Block"));
+    BlockTags.AddTag(MYYTags::Ability_Combat_Block);
 
     bool bActivated = AICharacter->AbilitySystemComponent->TryActivateAbilitiesByTag(BlockTags);
 
@@ -46,7 +47,7 @@ EBTNodeResult::Type UBTTask_ActivateBlock::ExecuteTask(UBehaviorTreeComponent& O
             {
                 // Cancel block ability
                 FGameplayTagContainer CancelTags;
-                CancelTags.AddTag(FGameplayTag::RequestGameplayTag("State.Combat.Blocking"));
+                CancelTags.AddTag(MYYTags::State_Combat_Blocking);
                 AICharacter->AbilitySystemComponent->CancelAbilities(&CancelTags);
             }
         }, BlockDuration, false);
@@ -2,6 +2,7 @@
 #include "AIController.h"
 #include "BehaviorTree/BlackboardComponent.h"
 #include "NavigationSystem.h"
+#include "MYY/AbilitySystem/Subsystem/PatrolPointSubsystem.h"
 
 UBTTask_FindPatrolLocation::UBTTask_FindPatrolLocation()
 {
@@ -11,6 +12,21 @@ UBTTask_FindPatrolLocation::UBTTask_FindPatrolLocation()
 	HomeLocationKey.AddVectorFilter(this, GET_MEMBER_NAME_CHECKED(UBTTask_FindPatrolLocation, HomeLocationKey));
 }
 
+uint16 UBTTask_FindPatrolLocation::GetInstanceMemorySize() const
+{
+	return sizeof(FBTFindPatrolLocationMemory);
+}
+
+void UBTTask_FindPatrolLocation::InitializeMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryInit::Type InitType) const
+{
+	InitializeNodeMemory<FBTFindPatrolLocationMemory>(NodeMemory, InitType);
+}
+
+void UBTTask_FindPatrolLocation::CleanupMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryClear::Type CleanupType) const
+{
+	CleanupNodeMemory<FBTFindPatrolLocationMemory>(NodeMemory, CleanupType);
+}
+
 
 
 
@@ -35,22 +51,56 @@ EBTNodeResult::Type UBTTask_FindPatrolLocation::ExecuteTask(UBehaviorTreeCompone
         HomeLocation = AIController->GetPawn()->GetActorLocation();
     }
 
-    // Find random navigable point around home
-    UNavigationSystemV1* NavSys = UNavigationSystemV1::GetCurrent(GetWorld());
-    if (!NavSys)
+    UPatrolPointSubsystem* PatrolPoints = GetWorld()->GetSubsystem<UPatrolPointSubsystem>();
+
+    // Cached point for this home; a miss queues the region and queries the navmesh once here
+    FVector PatrolLocation;
+    bool bSuccess = bUsePatrolPointCache && PatrolPoints && PatrolPoints->TakePatrolPoint(HomeLocation, PatrolRadius, PatrolLocation);
+
+    if (!bSuccess)
     {
-        UE_LOG(LogTemp, Error, TEXT("BTTask_FindPatrolLocation: No Navigation System!"));
-        return EBTNodeResult::Failed;
+        // Find random navigable point around home
+        UNavigationSystemV1* NavSys = UNavigationSystemV1::GetCurrent(GetWorld());
+        if (!NavSys)
+        {
+            UE_LOG(LogTemp, Error, TEXT("BTTask_FindPatrolLocation: No Navigation System!"));
+            return EBTNodeResult::Failed;
+        }
+
+        FNavLocation ResultLocation;
+        bSuccess = NavSys->GetRandomPointInNavigableRadius(HomeLocation, PatrolRadius, ResultLocation);
+        PatrolLocation = ResultLocation.Location;
     }
 
-    FNavLocation ResultLocation;
-    bool bSuccess = NavSys->GetRandomPointInNavigableRadius(HomeLocation, PatrolRadius, ResultLocation);
+    if (bSuccess && bRequireReachablePoint && PatrolPoints)
+    {
+        // Finished when the batched path request comes back
+        FBTFindPatrolLocationMemory* Memory = CastInstanceNodeMemory<FBTFindPatrolLocationMemory>(NodeMemory);
+        TWeakObjectPtr<UBehaviorTreeComponent> WeakOwnerComp(&OwnerComp);
+        Memory->PathRequestId = PatrolPoints->RequestPath(AIController, PatrolLocation, [this, WeakOwnerComp, Memory, PatrolLocation](FNavPathSharedPtr Path)
+        {
+            UBehaviorTreeComponent* OwnerCompPtr = WeakOwnerComp.Get();
+            if (!OwnerCompPtr)
+            {
+                return;
+            }
+
+            Memory->PathRequestId = 0;
+            if (Path.IsValid())
+            {
+                OwnerCompPtr->GetBlackboardComponent()->SetValueAsVector(PatrolLocationKey.SelectedKeyName, PatrolLocation);
+            }
+            FinishLatentTask(*OwnerCompPtr, Path.IsValid() ? EBTNodeResult::Succeeded : EBTNodeResult::Failed);
+        });
+
+        return EBTNodeResult::InProgress;
+    }
 
     if (bSuccess)
     {
-        BlackboardComp->SetValueAsVector(PatrolLocationKey.SelectedKeyName, ResultLocation.Location);
+        BlackboardComp->SetValueAsVector(PatrolLocationKey.SelectedKeyName, PatrolLocation);
         UE_LOG(LogTemp, Log, TEXT("BTTask_FindPatrolLocation: Found patrol point at %s"), 
-            *ResultLocation.Location.ToString());
+            *PatrolLocation.ToString());
         return EBTNodeResult::Succeeded;
     }
 
@@ -67,4 +117,19 @@ EBTNodeResult::Type UBTTask_FindPatrolLocation::ExecuteTask(UBehaviorTreeCompone
     BlackboardComp->SetValueAsVector(PatrolLocationKey.SelectedKeyName, FallbackLocation);
     
     return EBTNodeResult::Succeeded;
-}
\ No newline at end of file
+}
+
+EBTNodeResult::Type UBTTask_FindPatrolLocation::AbortTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+    FBTFindPatrolLocationMemory* Memory = CastInstanceNodeMemory<FBTFindPatrolLocationMemory>(NodeMemory);
+    if (Memory->PathRequestId != 0)
+    {
+        if (UPatrolPointSubsystem* PatrolPoints = GetWorld()->GetSubsystem<UPatrolPointSubsystem>())
+        {
+            PatrolPoints->CancelPath(Memory->PathRequestId);
+        }
+        Memory->PathRequestId = 0;
+    }
+
+    return EBTNodeResult::Aborted;
+}
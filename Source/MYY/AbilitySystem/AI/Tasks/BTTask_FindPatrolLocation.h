@@ -6,6 +6,11 @@
 #include "BehaviorTree/BTTaskNode.h"
 #include "BTTask_FindPatrolLocation.generated.h"
 
+struct FBTFindPatrolLocationMemory
+{
+	// UPatrolPointSubsystem path request while waiting on a reachability check
+	uint32 PathRequestId = 0;
+};
 
 UCLASS()
 class MYY_API UBTTask_FindPatrolLocation : public UBTTaskNode
@@ -16,6 +21,10 @@ public:
 	UBTTask_FindPatrolLocation();
 
 	virtual EBTNodeResult::Type ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual EBTNodeResult::Type AbortTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual uint16 GetInstanceMemorySize() const override;
+	virtual void InitializeMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryInit::Type InitType) const override;
+	virtual void CleanupMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryClear::Type CleanupType) const override;
 
 protected:
 	UPROPERTY(EditAnywhere, Category = "Patrol")
@@ -26,4 +35,12 @@ protected:
 
 	UPROPERTY(EditAnywhere, Category = "Patrol")
 	float PatrolRadius = 1000.f;
+
+	// Take the point from UPatrolPointSubsystem's cached set (refilled over frames) instead of querying the navmesh here
+	UPROPERTY(EditAnywhere, Category = "Patrol")
+	bool bUsePatrolPointCache = true;
+
+	// Wait for an async path to the point (batched by UPatrolPointSubsystem) and fail if it isn't reachable
+	UPROPERTY(EditAnywhere, Category = "Patrol")
+	bool bRequireReachablePoint = false;
 };
\ No newline at end of file
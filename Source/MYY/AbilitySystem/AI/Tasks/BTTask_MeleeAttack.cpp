@@ -7,6 +7,9 @@
 #include "MYY/AbilitySystem/MYYCharacterBase.h"
 #include "AbilitySystemComponent.h"
 #include "GameplayTagContainer.h"
+#include "MYY/AbilitySystem/GameplayTags/MYYGameplayTags.h"
+#include "MYY/AbilitySystem/Subsystem/AttackSlotSubsystem.h"
+#include "MYY/MYY.h"
 
 
 UBTTask_MeleeAttack::UBTTask_MeleeAttack()
@@ -16,6 +19,8 @@ UBTTask_MeleeAttack::UBTTask_MeleeAttack()
 	bNotifyTaskFinished = true;
 
 	TargetActorKey.AddObjectFilter(this, GET_MEMBER_NAME_CHECKED(UBTTask_MeleeAttack, TargetActorKey), AActor::StaticClass());
+	WaitingForAttackSlotKey.AddBoolFilter(this, GET_MEMBER_NAME_CHECKED(UBTTask_MeleeAttack, WaitingForAttackSlotKey));
+	WaitingForAttackSlotKey.AllowNoneAsValue(true);
 }
  
 EBTNodeResult::Type UBTTask_MeleeAttack::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
@@ -45,17 +50,43 @@ EBTNodeResult::Type UBTTask_MeleeAttack::ExecuteTask(UBehaviorTreeComponent& Own
     float Distance = FVector::Dist(AICharacter->GetActorLocation(), TargetActor->GetActorLocation());
     if (Distance > AttackRange)
     {
-        UE_LOG(LogTemp, Warning, TEXT("BTTask_MeleeAttack: Target out of range (%.2f > %.2f)"), Distance, AttackRange);
+        UE_LOG(LogMYYCombat, Verbose, TEXT("BTTask_MeleeAttack: Target out of range (%.2f > %.2f)"), Distance, AttackRange);
         return EBTNodeResult::Failed;
     }
 
+    // Only a few minions swing at the same target; the rest wait in a cheaper branch
+    UAttackSlotSubsystem* AttackSlots = bUseAttackSlots ? GetWorld()->GetSubsystem<UAttackSlotSubsystem>() : nullptr;
+    bool bSlotNewlyGranted = false;
+    if (AttackSlots)
+    {
+        const bool bHasSlot = AttackSlots->RequestSlot(AICharacter, TargetActor, &bSlotNewlyGranted);
+        if (WaitingForAttackSlotKey.IsSet())
+        {
+            BlackboardComp->SetValueAsBool(WaitingForAttackSlotKey.SelectedKeyName, !bHasSlot);
+        }
+
+        if (!bHasSlot)
+        {
+            UE_LOG(LogMYYCombat, Verbose, TEXT("BTTask_MeleeAttack: %s deferred, no attack slot on %s"),
+                *AICharacter->GetName(), *TargetActor->GetName());
+            return EBTNodeResult::Failed;
+        }
+    }
+
     // Try to activate melee attack ability
     FGameplayTagContainer AttackTags;
-    AttackTags.AddTag(FGameplayTag::RequestGameplayTag("Ability.Attack.Melee"));
+    AttackTags.AddTag(MYYTags::Ability_Attack_Melee);
 
     bool bActivated = AICharacter->AbilitySystemComponent->TryActivateAbilitiesByTag(AttackTags);
 
-    UE_LOG(LogTemp, Log, TEXT("BTTask_MeleeAttack: Attack %s for %s"), 
+    // The slot is held until the ability ends; nothing to hold it for otherwise. A slot held from
+    // before this call belongs to the attack already running, so leave that one alone.
+    if (!bActivated && bSlotNewlyGranted)
+    {
+        AttackSlots->ReleaseSlot(AICharacter);
+    }
+
+    UE_LOG(LogMYYCombat, Verbose, TEXT("BTTask_MeleeAttack: Attack %s for %s"), 
         bActivated ? TEXT("SUCCESS") : TEXT("FAILED"), 
         *AICharacter->GetName());
 
@@ -21,4 +21,12 @@ protected:
 
 	UPROPERTY(EditAnywhere, Category = "Combat")
 	float AttackRange = 250.f;
+
+	// Ask UAttackSlotSubsystem for an attack slot on the target before swinging
+	UPROPERTY(EditAnywhere, Category = "Combat")
+	bool bUseAttackSlots = true;
+
+	// Optional: set while the attack is deferred for lack of a slot, so the tree can idle/strafe instead
+	UPROPERTY(EditAnywhere, Category = "Combat", meta = (EditCondition = "bUseAttackSlots"))
+	FBlackboardKeySelector WaitingForAttackSlotKey;
 };
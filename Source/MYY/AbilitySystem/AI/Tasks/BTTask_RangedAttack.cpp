@@ -4,6 +4,7 @@
 #include "MYY/AbilitySystem/MYYCharacterBase.h"
 #include "AbilitySystemComponent.h"
 #include "GameplayTagContainer.h"
+#include "MYY/AbilitySystem/GameplayTags/MYYGameplayTags.h"
 
 UBTTask_RangedAttack::UBTTask_RangedAttack()
 {
@@ -46,7 +47,7 @@ EBTNodeResult::Type UBTTask_RangedAttack::ExecuteTask(UBehaviorTreeComponent& Ow
 
     // Try to activate ranged attack ability
     FGameplayTagContainer AttackTags;
-    AttackTags.AddTag(FGameplayTag::RequestGameplayTag("Ability.Attack.Ranged"));
+    AttackTags.AddTag(MYYTags::Ability_Attack_Ranged);
 
     bool bActivated = AICharacter->AbilitySystemComponent->TryActivateAbilitiesByTag(AttackTags);
 
@@ -4,6 +4,7 @@
 #include "Camera/CameraComponent.h"
 #include "GameFramework/SpringArmComponent.h"
 #include "DrawDebugHelpers.h"
+#include "MYY/AbilitySystem/GameplayTags/MYYGameplayTags.h"
 
 UGA_Interact::UGA_Interact()
 {
@@ -12,7 +13,7 @@ UGA_Interact::UGA_Interact()
     
     // Set asset tags
     FGameplayTagContainer AssetTags;
-    AssetTags.AddTag(FGameplayTag::RequestGameplayTag(FName("Ability.Interact")));
+    AssetTags.AddTag(MYYTags::Ability_Interact);
     SetAssetTags(AssetTags);
 }
 
@@ -5,6 +5,7 @@
 #include "MYY/AbilitySystem/BaseWeapon.h"
 #include "AbilitySystemComponent.h"
 #include "MYY/AbilitySystem/DataAsset/WeaponDataAsset.h"
+#include "MYY/AbilitySystem/GameplayTags/MYYGameplayTags.h"
 
 UGA_WeaponBase::UGA_WeaponBase()
 {
@@ -48,7 +49,7 @@ bool UGA_WeaponBase::CanActivateAbility(
 	{
 		if (OptionalRelevantTags)
 		{
-			OptionalRelevantTags->AddTag(FGameplayTag::RequestGameplayTag("Ability.Failed.NoStamina"));
+			OptionalRelevantTags->AddTag(MYYTags::Ability_Failed_NoStamina);
 		}
         
 		UE_LOG(LogTemp, Warning, TEXT("Cannot activate ability %s: Not enough stamina"), 
@@ -7,8 +7,10 @@
 #include "Abilities/Tasks/AbilityTask_PlayMontageAndWait.h"
 #include "GameplayEffect.h"
 #include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/GameStateBase.h"
 #include "Kismet/GameplayStatics.h"
 #include "MYY/AbilitySystem/DataAsset/WeaponDataAsset.h"
+#include "MYY/AbilitySystem/GameplayTags/MYYGameplayTags.h"
 
 
 UGA_Block::UGA_Block()
@@ -19,15 +21,15 @@ UGA_Block::UGA_Block()
     
     // Use SetAssetTags instead of AbilityTags
     FGameplayTagContainer AssetTags;
-    AssetTags.AddTag(FGameplayTag::RequestGameplayTag("Ability.Combat.Block"));
+    AssetTags.AddTag(MYYTags::Ability_Combat_Block);
     SetAssetTags(AssetTags);
 
-    ActivationOwnedTags.AddTag(FGameplayTag::RequestGameplayTag("State.Combat.Blocking"));
-    BlockAbilitiesWithTag.AddTag(FGameplayTag::RequestGameplayTag("State.Combat"));                                                 
+    ActivationOwnedTags.AddTag(MYYTags::State_Combat_Blocking);
+    BlockAbilitiesWithTag.AddTag(MYYTags::State_Combat);                                                 
 
     // CRITICAL: Set activation policy for event-triggered ability
     AbilityTriggers.AddDefaulted();
-    AbilityTriggers[0].TriggerTag = FGameplayTag::RequestGameplayTag("Ability.Combat.Block");
+    AbilityTriggers[0].TriggerTag = MYYTags::Ability_Combat_Block;
     AbilityTriggers[0].TriggerSource = EGameplayAbilityTriggerSource::GameplayEvent;
 
     
@@ -132,7 +134,7 @@ void UGA_Block::ActivateAbility(const FGameplayAbilitySpecHandle Handle,
 
     // Check if player wants to parry (press block at right time vs hold block)
     // For this implementation, we'll use the parry montage if available
-    if (WeaponData->Animations.ParryMontage && Character && Character->bIsInBlockWindow)
+    if (WeaponData->Animations.ParryMontage && Character && Character->IsInBlockWindow())
     {
         MontageToPlay = WeaponData->Animations.ParryMontage;
     }
@@ -164,6 +166,21 @@ void UGA_Block::ActivateAbility(const FGameplayAbilitySpecHandle Handle,
         BlockMontageTask->OnInterrupted.AddDynamic(this, &UGA_Block::OnBlockMontageCompleted);
         BlockMontageTask->OnBlendOut.AddDynamic(this, &UGA_Block::OnBlockMontageBlendOut);
         BlockMontageTask->ReadyForActivation();
+
+        // Parry window: the server derives it from this montage's start, the owner only sends when
+        // its montage started so the window lines up with what the player saw
+        if (Character && HasAuthority(&ActivationInfo))
+        {
+            Character->StartBlockWindow(MontageToPlay, ActivationInfo.GetActivationPredictionKey().Current);
+        }
+        else if (Character && IsLocallyControlled())
+        {
+            if (const AGameStateBase* GameState = GetWorld()->GetGameState())
+            {
+                Character->Server_SetBlockStartTime(GameState->GetServerWorldTimeSeconds(),
+                    ActivationInfo.GetActivationPredictionKey().Current);
+            }
+        }
     }
     else
     {
@@ -229,6 +246,21 @@ void UGA_Block::CancelAbility(const FGameplayAbilitySpecHandle Handle,
     
 }
 
+void UGA_Block::EndAbility(const FGameplayAbilitySpecHandle Handle,
+    const FGameplayAbilityActorInfo* ActorInfo,
+    const FGameplayAbilityActivationInfo ActivationInfo,
+    bool bReplicateEndAbility,
+    bool bWasCancelled)
+{
+    AMYYCharacterBase* Character = Cast<AMYYCharacterBase>(GetAvatarActorFromActorInfo());
+    if (Character && HasAuthority(&ActivationInfo))
+    {
+        Character->EndBlockWindow();
+    }
+
+    Super::EndAbility(Handle, ActorInfo, ActivationInfo, bReplicateEndAbility, bWasCancelled);
+}
+
 void UGA_Block::InputReleased(const FGameplayAbilitySpecHandle Handle,
     const FGameplayAbilityActorInfo* ActorInfo,
     const FGameplayAbilityActivationInfo ActivationInfo)
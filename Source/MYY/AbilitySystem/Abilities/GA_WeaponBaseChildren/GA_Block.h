@@ -36,6 +36,12 @@ public:
 		const FGameplayAbilityActivationInfo ActivationInfo, 
 		bool bReplicateCancelAbility) override; 
 
+	virtual void EndAbility(const FGameplayAbilitySpecHandle Handle,
+		const FGameplayAbilityActorInfo* ActorInfo,
+		const FGameplayAbilityActivationInfo ActivationInfo,
+		bool bReplicateEndAbility,
+		bool bWasCancelled) override;
+
 protected:
 	UPROPERTY()
 	UAbilityTask_PlayMontageAndWait* BlockMontageTask;
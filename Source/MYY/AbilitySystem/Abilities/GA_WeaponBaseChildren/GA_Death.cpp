@@ -7,19 +7,19 @@
 #include "AbilitySystemComponent.h"
 #include "Components/CapsuleComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
+#include "MYY/AbilitySystem/GameplayTags/MYYGameplayTags.h"
 
 UGA_Death::UGA_Death()
 {
     // Triggered by GameplayEvent.Death
     FAbilityTriggerData TriggerData;
-    TriggerData.TriggerTag = FGameplayTag::RequestGameplayTag("GameplayEvent.Death");
+    TriggerData.TriggerTag = MYYTags::GameplayEvent_Death;
     TriggerData.TriggerSource = EGameplayAbilityTriggerSource::GameplayEvent;
     AbilityTriggers.Add(TriggerData);
 
     // Death ability tag
     {
-        const FGameplayTag DeathTag =
-            FGameplayTag::RequestGameplayTag(TEXT("Ability.Combat.Death"), /*ErrorIfNotFound*/ false);
+        const FGameplayTag DeathTag = MYYTags::Ability_Combat_Death;
         if (DeathTag.IsValid())
         {
             FGameplayTagContainer AssetTags;
@@ -30,8 +30,7 @@ UGA_Death::UGA_Death()
 
     // Mark character as dead
     {
-        const FGameplayTag DeadStateTag =
-            FGameplayTag::RequestGameplayTag(TEXT("State.Dead"), /*ErrorIfNotFound*/ false);
+        const FGameplayTag DeadStateTag = MYYTags::State_Dead;
         if (DeadStateTag.IsValid())
         {
             ActivationOwnedTags.AddTag(DeadStateTag);
@@ -39,12 +38,12 @@ UGA_Death::UGA_Death()
     }
 
     // Cancel other gameplay abilities
-    CancelAbilitiesWithTag.AddTag(FGameplayTag::RequestGameplayTag("State.Combat.Attacking"));
-    CancelAbilitiesWithTag.AddTag(FGameplayTag::RequestGameplayTag("State.Combat.Blocking"));
-    CancelAbilitiesWithTag.AddTag(FGameplayTag::RequestGameplayTag("State.Action"));
+    CancelAbilitiesWithTag.AddTag(MYYTags::State_Combat_Attacking);
+    CancelAbilitiesWithTag.AddTag(MYYTags::State_Combat_Blocking);
+    CancelAbilitiesWithTag.AddTag(MYYTags::State_Action);
 
     // Prevent new abilities from activating
-    BlockAbilitiesWithTag.AddTag(FGameplayTag::RequestGameplayTag("Ability"));
+    BlockAbilitiesWithTag.AddTag(MYYTags::Ability);
 
     // Death should never check stamina
     bCheckStaminaBeforeActivate = false;
@@ -144,7 +143,7 @@ void UGA_Death::ActivateAbility(
         if (Character->HasAuthority())
         {
             Character->SetActorHiddenInGame(true);
-            Character->SetLifeSpan(2.0f);
+            Character->RemoveCorpse(2.0f);
         }
 
         EndAbility(CurrentSpecHandle, CurrentActorInfo, CurrentActivationInfo, true, false);
@@ -162,7 +161,7 @@ void UGA_Death::ActivateAbility(
         if (Character->HasAuthority())
         {
             Character->SetActorHiddenInGame(true);
-            Character->SetLifeSpan(2.0f);
+            Character->RemoveCorpse(2.0f);
         }
 
         EndAbility(CurrentSpecHandle, CurrentActorInfo, CurrentActivationInfo, true, false);
@@ -189,7 +188,7 @@ void UGA_Death::OnDeathMontageCompleted()
     {
         Character->SetActorEnableCollision(false);
         Character->SetActorHiddenInGame(true);
-        Character->SetLifeSpan(2.0f);   // or Destroy() if you really want immediate destroy
+        Character->RemoveCorpse(2.0f);   // pooled minions are parked instead of destroyed
         
     }
 
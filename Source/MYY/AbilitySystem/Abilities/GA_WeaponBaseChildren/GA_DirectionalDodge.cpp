@@ -8,6 +8,7 @@
 #include "MYY/AbilitySystem/Components/EquipmentComponent.h"
 #include "MYY/AbilitySystem/DataAsset/WeaponDataAsset.h"
 #include "Abilities/Tasks/AbilityTask_PlayMontageAndWait.h"
+#include "MYY/AbilitySystem/GameplayTags/MYYGameplayTags.h"
 
 UGA_DirectionalDodge::UGA_DirectionalDodge()
 {
@@ -18,7 +19,7 @@ UGA_DirectionalDodge::UGA_DirectionalDodge()
     RequiredStaminaCost = 10.0f;
     
     FGameplayTagContainer AssetTags;
-    AssetTags.AddTag(FGameplayTag::RequestGameplayTag(FName("Ability.Movement.Dodge")));
+    AssetTags.AddTag(MYYTags::Ability_Movement_Dodge);
     SetAssetTags(AssetTags);
 }
 
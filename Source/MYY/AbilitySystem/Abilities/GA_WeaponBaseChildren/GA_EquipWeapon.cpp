@@ -4,6 +4,7 @@
 #include "MYY/AbilitySystem/MYYCharacterBase.h"
 #include "MYY/AbilitySystem/Components/EquipmentComponent.h"
 #include "MYY/AbilitySystem/DataAsset/WeaponDataAsset.h"
+#include "MYY/AbilitySystem/GameplayTags/MYYGameplayTags.h"
 
 UGA_EquipWeapon::UGA_EquipWeapon()
 {
@@ -13,7 +14,7 @@ UGA_EquipWeapon::UGA_EquipWeapon()
 	
 	// Use SetAssetTags instead of AbilityTags
 	FGameplayTagContainer AssetTags;
-	AssetTags.AddTag(FGameplayTag::RequestGameplayTag(FName("Ability.Weapon.Equip")));
+	AssetTags.AddTag(MYYTags::Ability_Weapon_Equip);
 	SetAssetTags(AssetTags);
 }
 
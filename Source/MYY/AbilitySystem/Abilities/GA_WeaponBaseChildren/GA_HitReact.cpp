@@ -7,31 +7,31 @@
 #include "MYY/AbilitySystem/Components/EquipmentComponent.h"
 #include "AbilitySystemComponent.h"
 #include "Abilities/Tasks/AbilityTask_PlayMontageAndWait.h"
+#include "MYY/AbilitySystem/GameplayTags/MYYGameplayTags.h"
 
 UGA_HitReact::UGA_HitReact()
 {
     // Use SetAssetTags instead of AbilityTags
     // FGameplayTagContainer AssetTags;
-    // AssetTags.AddTag(FGameplayTag::RequestGameplayTag("Ability.Combat.HitReact"));
+    // AssetTags.AddTag(MYYTags::Ability_Combat_HitReact);
     // SetAssetTags(AssetTags);
     
     // ---- Event that activates this ability ----
     // // This tells GAS: “When GameplayEvent.HitReact happens, this ability should activate.”
-    // AbilityTags.AddTag(FGameplayTag::RequestGameplayTag("GameplayEvent.HitReact"));
+    // AbilityTags.AddTag(MYYTags::GameplayEvent_HitReact);
     //
     // // Extra protection: ensure the ability can also activate ONLY when this tag event happens
-    // ActivationRequiredTags.AddTag(FGameplayTag::RequestGameplayTag("GameplayEvent.HitReact"));
+    // ActivationRequiredTags.AddTag(MYYTags::GameplayEvent_HitReact);
 
     // ✅ CORRECT: Trigger setup (BUT it's fighting with above mistakes)
     FAbilityTriggerData TriggerData;
-    TriggerData.TriggerTag = FGameplayTag::RequestGameplayTag("GameplayEvent.HitReact");
+    TriggerData.TriggerTag = MYYTags::GameplayEvent_HitReact;
     TriggerData.TriggerSource = EGameplayAbilityTriggerSource::GameplayEvent;
     AbilityTriggers.Add(TriggerData);
     
     // ✅ CORRECT: Use SetAssetTags for ability identification
     {
-        const FGameplayTag HitReactTag = 
-            FGameplayTag::RequestGameplayTag(TEXT("Ability.Combat.HitReact"), /*ErrorIfNotFound*/ false);
+        const FGameplayTag HitReactTag = MYYTags::Ability_Combat_HitReact;
         if (HitReactTag.IsValid())
         {
             FGameplayTagContainer AssetTags;
@@ -44,11 +44,11 @@ UGA_HitReact::UGA_HitReact()
     bCheckStaminaBeforeActivate = false;
 
     // ---- Tags granted while running ----
-    ActivationOwnedTags.AddTag(FGameplayTag::RequestGameplayTag("State.Combat.HitStunned"));
-    ActivationOwnedTags.AddTag(FGameplayTag::RequestGameplayTag("State.Combat.HitReact"));
+    ActivationOwnedTags.AddTag(MYYTags::State_Combat_HitStunned);
+    ActivationOwnedTags.AddTag(MYYTags::State_Combat_HitReact);
 
     // ---- Tags that cancel this ability ----
-    CancelAbilitiesWithTag.AddTag(FGameplayTag::RequestGameplayTag("State.Combat.Attacking"));
+    CancelAbilitiesWithTag.AddTag(MYYTags::State_Combat_Attacking);
 
     // ✅ CRITICAL FIX: Use ServerInitiated instead of ServerOnly
     // This allows:
@@ -66,7 +66,7 @@ UGA_HitReact::UGA_HitReact()
     UE_LOG(LogTemp, Warning, TEXT("✅ GA_HitReact constructor: ServerInitiated execution policy"))
  
     
-    ActivationOwnedTags.AddTag(FGameplayTag::RequestGameplayTag("State.Combat.HitReact"));
+    ActivationOwnedTags.AddTag(MYYTags::State_Combat_HitReact);
     
     UE_LOG(LogTemp, Warning, TEXT("GA_HitReact registered for tag: GameplayEvent.HitReact"))
     
@@ -88,7 +88,7 @@ bool UGA_HitReact::CanActivateAbility(const FGameplayAbilitySpecHandle Handle,
     // if (Character && Character->AbilitySystemComponent)
     // {
     //     if (Character->AbilitySystemComponent->HasMatchingGameplayTag(
-    //         FGameplayTag::RequestGameplayTag("State.Combat.Blocking")) ||
+    //         MYYTags::State_Combat_Blocking) ||
     //         Character->bIsInBlockWindow)
     //     {
     //         return false;
@@ -101,8 +101,8 @@ bool UGA_HitReact::CanActivateAbility(const FGameplayAbilitySpecHandle Handle,
     if (Character && Character->AbilitySystemComponent)
     {
         if (Character->AbilitySystemComponent->HasMatchingGameplayTag(
-            FGameplayTag::RequestGameplayTag("State.Combat.Blocking")) ||
-            Character->bIsInBlockWindow)
+            MYYTags::State_Combat_Blocking) ||
+            Character->IsInBlockWindow())
         {
             UE_LOG(LogTemp, Warning, TEXT("GA_HitReact: Blocked - character is blocking/parrying"));
             return false;
@@ -110,7 +110,7 @@ bool UGA_HitReact::CanActivateAbility(const FGameplayAbilitySpecHandle Handle,
 
         // ✅ Also check if already in hit react (prevent spam)
         if (Character->AbilitySystemComponent->HasMatchingGameplayTag(
-            FGameplayTag::RequestGameplayTag("State.Combat.HitReact")))
+            MYYTags::State_Combat_HitReact))
         {
             UE_LOG(LogTemp, Warning, TEXT("GA_HitReact: Already in hit react animation"));
             return false;
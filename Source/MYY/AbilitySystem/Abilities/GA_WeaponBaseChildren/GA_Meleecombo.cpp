@@ -2,64 +2,154 @@
 #include "MYY/AbilitySystem/MYYCharacterBase.h"
 #include "MYY/AbilitySystem/BaseWeapon.h"
 #include "MYY/AbilitySystem/DataAsset/WeaponDataAsset.h"
+#include "MYY/AbilitySystem/Anim_Notifiers/ComboNotifiers/AnimNotify_OpenComboWindow.h"
+#include "MYY/AbilitySystem/Anim_Notifiers/ComboNotifiers/AnimNotify_CloseComboWindow.h"
 #include "AbilitySystemComponent.h"
-#include "Net/UnrealNetwork.h"
+#include "Animation/AnimInstance.h"
+#include "Animation/AnimMontage.h"
+#include "HAL/IConsoleManager.h"
+#include "MYY/AbilitySystem/GameplayTags/MYYGameplayTags.h"
+#include "MYY/MYY.h"
+
+static TAutoConsoleVariable<float> CVarComboInputBufferTime(
+	TEXT("MYY.Combo.InputBufferTime"),
+	0.2f,
+	TEXT("Seconds (montage time) before the combo window opens during which a press is kept and chains when it opens."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarComboMaxPressLead(
+	TEXT("MYY.Combo.MaxPressLead"),
+	0.25f,
+	TEXT("How far (montage time) a client's reported press may be ahead of the server's montage before it is rejected."),
+	ECVF_Default);
+
+namespace MeleeComboPrivate
+{
+	struct FComboWindow
+	{
+		float Open = -1.f;
+		float Close = -1.f;
+
+		bool IsValid() const { return Open >= 0.f; }
+	};
+
+	// Trigger times of the montage's OpenComboWindow/CloseComboWindow notifies.
+	// Without a close notify the window stays open until the montage ends.
+	FComboWindow FindComboWindow(const UAnimMontage* Montage)
+	{
+		FComboWindow Window;
+		if (!Montage)
+		{
+			return Window;
+		}
+
+		for (const FAnimNotifyEvent& Event : Montage->Notifies)
+		{
+			if (Cast<UAnimNotify_OpenComboWindow>(Event.Notify))
+			{
+				Window.Open = Event.GetTriggerTime();
+			}
+			else if (Cast<UAnimNotify_CloseComboWindow>(Event.Notify))
+			{
+				Window.Close = Event.GetTriggerTime();
+			}
+		}
+
+		if (Window.Close < Window.Open)
+		{
+			Window.Close = Montage->GetPlayLength();
+		}
+		return Window;
+	}
+}
 
 UGA_Meleecombo::UGA_Meleecombo()
 {
 	CurrentComboIndex = 0;
 	bComboWindowOpen = false;
-	bHasBufferedInput = false;
 	bUseRandomCombo = false;
+	CurrentMontage = nullptr;
 
 	// Set stamina cost for melee combo
 	bCheckStaminaBeforeActivate = true;
 	RequiredStaminaCost = 10.0f; // Default cost, can be overridden per weapon
  
-	AbilityTags.AddTag(FGameplayTag::RequestGameplayTag(FName("Ability.Attack.Melee")));
-	ActivationOwnedTags.AddTag(FGameplayTag::RequestGameplayTag(FName("State.Attack")));
-	BlockAbilitiesWithTag.AddTag(FGameplayTag::RequestGameplayTag(FName("State.Defense.Blocking")));
-	BlockAbilitiesWithTag.AddTag(FGameplayTag::RequestGameplayTag(FName("State.Action.Swap")));
-	CancelAbilitiesWithTag.AddTag(FGameplayTag::RequestGameplayTag(FName("State.Attack")));
-	ActivationBlockedTags.AddTag(FGameplayTag::RequestGameplayTag(FName("State.Action.Dodge")));
+	AbilityTags.AddTag(MYYTags::Ability_Attack_Melee);
+	ActivationOwnedTags.AddTag(MYYTags::State_Attack);
+	BlockAbilitiesWithTag.AddTag(MYYTags::State_Defense_Blocking);
+	BlockAbilitiesWithTag.AddTag(MYYTags::State_Action_Swap);
+	CancelAbilitiesWithTag.AddTag(MYYTags::State_Attack);
+	ActivationBlockedTags.AddTag(MYYTags::State_Action_Dodge);
 
 	InstancingPolicy = EGameplayAbilityInstancingPolicy::InstancedPerActor;
 	NetExecutionPolicy = EGameplayAbilityNetExecutionPolicy::LocalPredicted;
 	ReplicationPolicy = EGameplayAbilityReplicationPolicy::ReplicateYes;
 }
 
-void UGA_Meleecombo::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+void UGA_Meleecombo::ServerComboInput_Implementation(int32 PredictedComboIndex, float PressPosition)
 {
-	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
-	
-	DOREPLIFETIME(UGA_Meleecombo, CurrentComboIndex);
-	DOREPLIFETIME(UGA_Meleecombo, bComboWindowOpen);
-}
+	// The server's step already ran out and ended the ability, which also ends the client's
+	if (!IsActive())
+	{
+		return;
+	}
 
-void UGA_Meleecombo::ServerHandleComboInput_Implementation()
-{
-	UE_LOG(LogTemp, Warning, TEXT("[SERVER RPC] Handling combo input"));
-    
-	if (bComboWindowOpen)
+	const bool bExpectedStep = bUseRandomCombo
+		? CachedWeaponData && CachedWeaponData->Animations.ComboMontages.IsValidIndex(PredictedComboIndex)
+		: PredictedComboIndex == ChooseNextComboIndex();
+
+	if (!bExpectedStep || !IsValidComboPress(PressPosition) || !CheckStaminaCost())
 	{
-		TriggerNextCombo();
+		UE_LOG(LogMYYCombat, Verbose, TEXT("Combo press rejected: step %d at %.2fs, server at step %d, %.2fs"),
+			PredictedComboIndex, PressPosition, CurrentComboIndex, GetMontagePosition());
+		ClientRejectComboInput(PredictedComboIndex);
+		return;
 	}
-	else
+
+	// Buffered press that reached the server before its own window opened: chain when it does
+	if (!bComboWindowOpen && GetMontagePosition() < MeleeComboPrivate::FindComboWindow(CurrentMontage).Open)
 	{
-		bHasBufferedInput = true;
+		ServerBufferedComboIndex = PredictedComboIndex;
+		return;
 	}
+
+	AdvanceCombo(PredictedComboIndex);
 }
 
- 
+void UGA_Meleecombo::ClientRejectComboInput_Implementation(int32 RejectedComboIndex)
+{
+	// Stale answer for a combo that already ended
+	if (!IsActive() || CurrentComboIndex != RejectedComboIndex)
+	{
+		return;
+	}
 
- 
+	// Drop the combo on both sides rather than rewinding to the server's step
+	CancelAbility(CurrentSpecHandle, CurrentActorInfo, CurrentActivationInfo, true);
+}
 
-void UGA_Meleecombo::OnRep_CurrentComboIndex()
+bool UGA_Meleecombo::IsValidComboPress(float PressPosition) const
 {
+	const MeleeComboPrivate::FComboWindow Window = MeleeComboPrivate::FindComboWindow(CurrentMontage);
+	if (!Window.IsValid())
+	{
+		return false;
+	}
+
+	if (PressPosition < Window.Open - CVarComboInputBufferTime.GetValueOnGameThread() || PressPosition > Window.Close)
+	{
+		return false;
+	}
+
+	// The client's montage starts about half a round trip before the server's, so the press can
+	// only be a little ahead of it. Anything earlier is fine: that's the RPC's latency.
+	return PressPosition <= GetMontagePosition() + CVarComboMaxPressLead.GetValueOnGameThread();
 }
 
-void UGA_Meleecombo::OnRep_bComboWindowOpen()
+float UGA_Meleecombo::GetMontagePosition() const
 {
+	const UAnimInstance* AnimInstance = CurrentActorInfo ? CurrentActorInfo->GetAnimInstance() : nullptr;
+	return AnimInstance && CurrentMontage ? AnimInstance->Montage_GetPosition(CurrentMontage) : 0.f;
 }
 
 
@@ -127,6 +217,10 @@ void UGA_Meleecombo::ActivateAbility(const FGameplayAbilitySpecHandle Handle,
 	CachedHandle = Handle;
 	CachedActivationInfo = ActivationInfo;
 
+	bComboWindowOpen = false;
+	BufferedPressPosition = -1.f;
+	ServerBufferedComboIndex = INDEX_NONE;
+
 	// NOW weapon type check is safe
 	if (CachedWeaponData->WeaponType == EWeaponType::Ranged)
 	{
@@ -159,15 +253,39 @@ void UGA_Meleecombo::ActivateAbility(const FGameplayAbilitySpecHandle Handle,
 	
 	MontageIndex = FMath::Clamp(MontageIndex, 0, ComboArray.Num() - 1);
 
-	UAnimMontage* AttackMontage = ComboArray[MontageIndex];
-	if (!AttackMontage)
+	CurrentComboIndex = MontageIndex;
+	if (!PlayComboMontage(MontageIndex))
 	{
 		EndAbility(Handle, ActorInfo, ActivationInfo, true, false);
 		return;
 	}
+}
+
+bool UGA_Meleecombo::PlayComboMontage(int32 ComboIndex)
+{
+	if (!CachedWeaponData)
+	{
+		return false;
+	}
+
+	const auto& ComboArray = CachedWeaponData->Animations.ComboMontages;
+	UAnimMontage* AttackMontage = ComboArray.IsValidIndex(ComboIndex) ? ComboArray[ComboIndex] : nullptr;
+	if (!AttackMontage)
+	{
+		return false;
+	}
+
+	// The previous step's task would end the ability when the next montage interrupts it
+	if (MontageTask)
+	{
+		MontageTask->OnCompleted.RemoveAll(this);
+		MontageTask->OnCancelled.RemoveAll(this);
+		MontageTask->OnInterrupted.RemoveAll(this);
+		MontageTask->EndTask();
+	}
+
+	CurrentMontage = AttackMontage;
 
- 
-	
 	// Use GAS montage task for automatic replication
 	MontageTask = UAbilityTask_PlayMontageAndWait::CreatePlayMontageAndWaitProxy(
 		this, NAME_None, AttackMontage, 1.0f, NAME_None, false);
@@ -176,6 +294,7 @@ void UGA_Meleecombo::ActivateAbility(const FGameplayAbilitySpecHandle Handle,
 	MontageTask->OnCancelled.AddDynamic(this, &UGA_Meleecombo::OnMontageCancelled);
 	MontageTask->OnInterrupted.AddDynamic(this, &UGA_Meleecombo::OnMontageInterrupted);
 	MontageTask->ReadyForActivation();
+	return true;
 }
 
 
@@ -199,25 +318,28 @@ void UGA_Meleecombo::OnMontageInterrupted()
 
 void UGA_Meleecombo::OpenComboWindow()
 {
-	if (GetOwningActorFromActorInfo()->HasAuthority())
-	{
-		bComboWindowOpen = true;
+	bComboWindowOpen = true;
 
-		if (bHasBufferedInput)
+	if (IsLocallyControlled())
+	{
+		// Input buffer: a press shortly before the window chains now
+		if (BufferedPressPosition >= 0.f
+			&& GetMontagePosition() - BufferedPressPosition <= CVarComboInputBufferTime.GetValueOnGameThread())
 		{
-			bHasBufferedInput = false;
-			TriggerNextCombo();
+			PredictComboAdvance(BufferedPressPosition);
 		}
+		BufferedPressPosition = -1.f;
+	}
+	else if (ServerBufferedComboIndex != INDEX_NONE)
+	{
+		AdvanceCombo(ServerBufferedComboIndex);
 	}
 }
 
 void UGA_Meleecombo::CloseComboWindow()
 {
-	if (GetOwningActorFromActorInfo()->HasAuthority())
-	{
-		bComboWindowOpen = false;
-		bHasBufferedInput = false;
-	}
+	bComboWindowOpen = false;
+	BufferedPressPosition = -1.f;
 }
 
 void UGA_Meleecombo::InputPressed(
@@ -225,71 +347,82 @@ void UGA_Meleecombo::InputPressed(
 	const FGameplayAbilityActorInfo* ActorInfo,
 	const FGameplayAbilityActivationInfo ActivationInfo)
 {
-	UE_LOG(LogTemp, Warning, TEXT("[%s] InputPressed - ComboWindowOpen: %s, HasBufferedInput: %s, CurrentCombo: %d"), 
-		GetOwningActorFromActorInfo()->HasAuthority() ? TEXT("SERVER") : TEXT("CLIENT"),
-		bComboWindowOpen ? TEXT("true") : TEXT("false"),
-		bHasBufferedInput ? TEXT("true") : TEXT("false"),
-		CurrentComboIndex);
-
-	// Call server RPC to handle the input on server
-	if (!GetOwningActorFromActorInfo()->HasAuthority())
+	// Presses only exist on the owning machine, the server hears about them through ServerComboInput
+	if (!IsLocallyControlled())
 	{
-		ServerHandleComboInput();
+		return;
 	}
 
-	// Also handle locally for client prediction
+	const float PressPosition = GetMontagePosition();
+
+	UE_LOG(LogMYYCombat, Verbose, TEXT("Combo press at %.2fs - window open: %s, step %d"),
+		PressPosition, bComboWindowOpen ? TEXT("true") : TEXT("false"), CurrentComboIndex);
+
 	if (bComboWindowOpen)
 	{
-		TriggerNextCombo();
+		PredictComboAdvance(PressPosition);
+	}
+	else if (PressPosition < MeleeComboPrivate::FindComboWindow(CurrentMontage).Open)
+	{
+		// Kept until the window opens, dropped if it's more than the buffer time early by then
+		BufferedPressPosition = PressPosition;
 	}
-	else
+}
+
+int32 UGA_Meleecombo::ChooseNextComboIndex() const
+{
+	const int32 NumMontages = CachedWeaponData ? CachedWeaponData->Animations.ComboMontages.Num() : 0;
+	if (NumMontages == 0)
 	{
-		bHasBufferedInput = true;
+		return INDEX_NONE;
 	}
+
+	if (bUseRandomCombo)
+	{
+		return FMath::RandRange(0, NumMontages - 1);
+	}
+
+	const int32 NextComboIndex = CurrentComboIndex + 1;
+	return NextComboIndex >= NumMontages || NextComboIndex >= MaxComboChain ? 0 : NextComboIndex;
 }
 
-void UGA_Meleecombo::TriggerNextCombo()
+void UGA_Meleecombo::PredictComboAdvance(float PressPosition)
 {
-	if (!GetOwningActorFromActorInfo())
+	const int32 NextComboIndex = ChooseNextComboIndex();
+	if (NextComboIndex == INDEX_NONE || !CheckStaminaCost())
+	{
 		return;
+	}
+
+	if (!HasAuthority(&CurrentActivationInfo))
+	{
+		ServerComboInput(NextComboIndex, PressPosition);
+	}
+
+	AdvanceCombo(NextComboIndex);
+}
 
-	UE_LOG(LogTemp, Warning, TEXT("[%s] TriggerNextCombo - CurrentCombo: %d"), 
-		GetOwningActorFromActorInfo()->HasAuthority() ? TEXT("SERVER") : TEXT("CLIENT"),
-		CurrentComboIndex);
+void UGA_Meleecombo::AdvanceCombo(int32 ComboIndex)
+{
+	UE_LOG(LogMYYCombat, Verbose, TEXT("[%s] Combo step %d -> %d"),
+		HasAuthority(&CurrentActivationInfo) ? TEXT("SERVER") : TEXT("CLIENT"), CurrentComboIndex, ComboIndex);
+
+	// The next montage's notifies open its own window
+	bComboWindowOpen = false;
+	BufferedPressPosition = -1.f;
+	ServerBufferedComboIndex = INDEX_NONE;
 
-	// Predict combo index on both client and server
-	if (!bUseRandomCombo)
+	// Every step costs stamina. The client's prediction window closed with activation, so only
+	// the server applies it and the attribute replicates back.
+	if (HasAuthority(&CurrentActivationInfo))
 	{
-		int32 PredictedComboIndex = CurrentComboIndex + 1;
-        
-		if (CachedWeaponData && PredictedComboIndex >= CachedWeaponData->Animations.ComboMontages.Num())
-		{
-			PredictedComboIndex = 0;
-		}
-        
-		if (PredictedComboIndex >= MaxComboChain)
-		{
-			PredictedComboIndex = 0;
-		}
-        
-		// Server updates the replicated variable
-		if (GetOwningActorFromActorInfo()->HasAuthority())
-		{
-			CurrentComboIndex = PredictedComboIndex;
-			UE_LOG(LogTemp, Warning, TEXT("[SERVER] New CurrentComboIndex: %d"), CurrentComboIndex);
-		}
-		// Client predicts locally (will be corrected by replication if wrong)
-		else
-		{
-			CurrentComboIndex = PredictedComboIndex;
-			UE_LOG(LogTemp, Warning, TEXT("[CLIENT PREDICT] New CurrentComboIndex: %d"), CurrentComboIndex);
-		}
+		CommitAbilityCost(CurrentSpecHandle, CurrentActorInfo, CurrentActivationInfo);
 	}
-    
-	// Try to activate ability
-	if (GetAbilitySystemComponentFromActorInfo())
+
+	CurrentComboIndex = ComboIndex;
+	if (!PlayComboMontage(ComboIndex))
 	{
-		GetAbilitySystemComponentFromActorInfo()->TryActivateAbility(CachedHandle, true);
+		EndAbility(CurrentSpecHandle, CurrentActorInfo, CurrentActivationInfo, true, true);
 	}
 }
 
@@ -303,12 +436,12 @@ void UGA_Meleecombo::EndAbility(
 	// Clear cached pointer
 	CachedActorInfo = nullptr;
 	
-	if (bWasCancelled && GetOwningActorFromActorInfo()->HasAuthority())
-	{
-		CurrentComboIndex = 0;
-		bComboWindowOpen = false;
-		bHasBufferedInput = false;
-	}
+	// The instance is reused by the next activation, which starts a new combo
+	CurrentComboIndex = 0;
+	bComboWindowOpen = false;
+	BufferedPressPosition = -1.f;
+	ServerBufferedComboIndex = INDEX_NONE;
+	CurrentMontage = nullptr;
 
 	if (MontageTask)
 	{
@@ -30,7 +30,7 @@ public:
 		const FGameplayAbilityActorInfo* ActorInfo,
 		const FGameplayAbilityActivationInfo ActivationInfo) override;
 
-	// Called by AnimNotifies
+	// Called by AnimNotifies, on the server and the owning client
 	UFUNCTION()
 	void OpenComboWindow();
 	
@@ -54,22 +54,27 @@ protected:
 
 
 protected:
-	// Replicated variables
-	UPROPERTY(ReplicatedUsing = OnRep_CurrentComboIndex)
+	// Combo advancement is predicted by the owning client and checked by the server:
+	// - a press inside the window, or up to MYY.Combo.InputBufferTime before it opens (input buffer),
+	//   plays the next step locally right away and sends its montage position once, unreliably
+	// - the server checks that position against the montage's OpenComboWindow/CloseComboWindow
+	//   times, not against when the press arrived, so latency doesn't push presses out of the window
+	// - only a rejected press is answered (ClientRejectComboInput), and it drops the combo on both sides
+	// A lost press ends the same way: the server's step runs out and ends the ability.
+
+	// ComboMontages index of the step being played
 	int32 CurrentComboIndex;
 
-	UPROPERTY(ReplicatedUsing = OnRep_bComboWindowOpen)
 	bool bComboWindowOpen;
-    
-	// Replication notification functions
-	UFUNCTION()
-	void OnRep_CurrentComboIndex();
-    
-	UFUNCTION()
-	void OnRep_bComboWindowOpen();
+
+	// Owning client: montage position of a press before the window opened, -1 for none
+	float BufferedPressPosition = -1.f;
+
+	// Server: validated step whose press arrived before the server's window opened
+	int32 ServerBufferedComboIndex = INDEX_NONE;
 
 	UPROPERTY()
-	bool bHasBufferedInput;
+	UAnimMontage* CurrentMontage;
 
 	UPROPERTY(EditDefaultsOnly, Category = "Combo")
 	bool bUseRandomCombo;
@@ -86,13 +91,29 @@ protected:
 	UFUNCTION()
 	void OnMontageInterrupted();
 
-	void TriggerNextCombo();
-	
-	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+	// Plays a ComboMontages entry, replacing the previous step's montage task
+	bool PlayComboMontage(int32 ComboIndex);
+
+	// Sequential (wrapping at MaxComboChain) or random, INDEX_NONE without montages
+	int32 ChooseNextComboIndex() const;
+
+	// Owning client: plays the next step now, and tells the server when it isn't the server
+	void PredictComboAdvance(float PressPosition);
+
+	// Both sides: moves to ComboIndex (the server also pays its stamina)
+	void AdvanceCombo(int32 ComboIndex);
+
+	// Server: the press happened inside CurrentMontage's window (with input buffer and lead tolerance)
+	bool IsValidComboPress(float PressPosition) const;
+
+	float GetMontagePosition() const;
 
  
 	const FGameplayAbilityActorInfo* CachedActorInfo;
 protected:
-	UFUNCTION(Server, Reliable)
-	void ServerHandleComboInput();
+	UFUNCTION(Server, Unreliable)
+	void ServerComboInput(int32 PredictedComboIndex, float PressPosition);
+
+	UFUNCTION(Client, Reliable)
+	void ClientRejectComboInput(int32 RejectedComboIndex);
 };
\ No newline at end of file
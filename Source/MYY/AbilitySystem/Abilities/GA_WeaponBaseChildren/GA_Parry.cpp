@@ -9,6 +9,7 @@
 #include "AbilitySystemComponent.h"
 #include "Abilities/Tasks/AbilityTask_PlayMontageAndWait.h"
 #include "Kismet/GameplayStatics.h"
+#include "MYY/AbilitySystem/GameplayTags/MYYGameplayTags.h"
 
 UGA_Parry::UGA_Parry()
 {
@@ -18,12 +19,12 @@ UGA_Parry::UGA_Parry()
     //
     
         FGameplayTagContainer Tags;
-        Tags.AddTag(FGameplayTag::RequestGameplayTag("Ability.Combat.Parry"));
+        Tags.AddTag(MYYTags::Ability_Combat_Parry);
         SetAssetTags(Tags); 
     //
     // 2. Activation Owned Tags (USE MUTABLE ACCESSOR)
     // 
-        ActivationOwnedTags.AddTag(FGameplayTag::RequestGameplayTag("State.Combat.ParrySuccess"));
+        ActivationOwnedTags.AddTag(MYYTags::State_Combat_ParrySuccess);
      
     
     InstancingPolicy = EGameplayAbilityInstancingPolicy::InstancedPerActor;
@@ -32,7 +33,7 @@ UGA_Parry::UGA_Parry()
 
     // Trigger on parry event
     FAbilityTriggerData TriggerData;
-    TriggerData.TriggerTag = FGameplayTag::RequestGameplayTag("GameplayEvent.Parry");
+    TriggerData.TriggerTag = MYYTags::GameplayEvent_Parry;
     TriggerData.TriggerSource = EGameplayAbilityTriggerSource::GameplayEvent;
     AbilityTriggers.Add(TriggerData);
 }
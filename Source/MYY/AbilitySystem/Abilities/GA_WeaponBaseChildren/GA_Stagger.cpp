@@ -12,6 +12,7 @@
 #include "Kismet/GameplayStatics.h"
 
 #include "MYY/AbilitySystem/DataAsset/WeaponDataAsset.h"
+#include "MYY/AbilitySystem/GameplayTags/MYYGameplayTags.h"
 
 
 UGA_Stagger::UGA_Stagger()
@@ -21,24 +22,24 @@ UGA_Stagger::UGA_Stagger()
     //
     {
         FGameplayTagContainer Tags;
-        Tags.AddTag(FGameplayTag::RequestGameplayTag("Ability.Combat.Stagger"));   // <-- moved here
+        Tags.AddTag(MYYTags::Ability_Combat_Stagger);   // <-- moved here
         SetAssetTags(Tags);
     }
 
     //
     // 2. Activation Owned Tags (STILL VALID TO MODIFY DIRECTLY)
     //
-    ActivationOwnedTags.AddTag(FGameplayTag::RequestGameplayTag("State.Combat.Stunned"));
+    ActivationOwnedTags.AddTag(MYYTags::State_Combat_Stunned);
 
     //
     // 3. Cancel Abilities (STILL VALID)
     //
-    CancelAbilitiesWithTag.AddTag(FGameplayTag::RequestGameplayTag("State.Combat.Attacking"));
+    CancelAbilitiesWithTag.AddTag(MYYTags::State_Combat_Attacking);
 
     //
     // 4. Block Abilities (STILL VALID)
     //
-    BlockAbilitiesWithTag.AddTag(FGameplayTag::RequestGameplayTag("Ability.Combat"));
+    BlockAbilitiesWithTag.AddTag(MYYTags::Ability_Combat);
     
     InstancingPolicy = EGameplayAbilityInstancingPolicy::InstancedPerActor;
     NetExecutionPolicy = EGameplayAbilityNetExecutionPolicy::LocalPredicted;
@@ -46,7 +47,7 @@ UGA_Stagger::UGA_Stagger()
 
     // Trigger on stagger event
     FAbilityTriggerData TriggerData;
-    TriggerData.TriggerTag = FGameplayTag::RequestGameplayTag("GameplayEvent.Stagger");
+    TriggerData.TriggerTag = MYYTags::GameplayEvent_Stagger;
     TriggerData.TriggerSource = EGameplayAbilityTriggerSource::GameplayEvent;
     AbilityTriggers.Add(TriggerData);
 }
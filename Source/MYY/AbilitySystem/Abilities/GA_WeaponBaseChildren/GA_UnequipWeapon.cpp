@@ -3,6 +3,7 @@
 #include "MYY/AbilitySystem/Components/EquipmentComponent.h"
 #include "MYY/AbilitySystem/BaseWeapon.h"
 #include "MYY/AbilitySystem/DataAsset/WeaponDataAsset.h"
+#include "MYY/AbilitySystem/GameplayTags/MYYGameplayTags.h"
 
 UGA_UnequipWeapon::UGA_UnequipWeapon()
 {
@@ -12,7 +13,7 @@ UGA_UnequipWeapon::UGA_UnequipWeapon()
 	
 	// Use SetAssetTags instead of AbilityTags (deprecated)
 	FGameplayTagContainer AssetTags;
-	AssetTags.AddTag(FGameplayTag::RequestGameplayTag(FName("Ability.Weapon.Unequip")));
+	AssetTags.AddTag(MYYTags::Ability_Weapon_Unequip);
 	SetAssetTags(AssetTags);
 }
 
@@ -8,6 +8,7 @@
 #include "MYY/AbilitySystem/Components/EquipmentComponent.h"
 #include "MYY/AbilitySystem/DataAsset/WeaponDataAsset.h"
 #include "MYY/AbilitySystem/MYYCharacterBase.h"
+#include "MYY/AbilitySystem/GameplayTags/MYYGameplayTags.h"
 
 UGA_Vault::UGA_Vault()
 {
@@ -20,7 +21,7 @@ UGA_Vault::UGA_Vault()
 	RequiredStaminaCost = 15.0f;
 	
 	FGameplayTagContainer AssetTags;
-	AssetTags.AddTag(FGameplayTag::RequestGameplayTag(FName("Ability.Movement.Vault")));
+	AssetTags.AddTag(MYYTags::Ability_Movement_Vault);
 	SetAssetTags(AssetTags);
 }
 
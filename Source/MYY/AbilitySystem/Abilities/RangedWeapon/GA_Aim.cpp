@@ -8,6 +8,7 @@
 #include "AbilitySystemComponent.h"
 
 #include "Blueprint/UserWidget.h"
+#include "MYY/AbilitySystem/GameplayTags/MYYGameplayTags.h"
 
 UGA_Aim::UGA_Aim()
 {
@@ -16,14 +17,14 @@ UGA_Aim::UGA_Aim()
     ReplicationPolicy = EGameplayAbilityReplicationPolicy::ReplicateYes;
 
     // Ability tags
-    AbilityTags.AddTag(FGameplayTag::RequestGameplayTag("Ability.Ranged.Aim"));
+    AbilityTags.AddTag(MYYTags::Ability_Ranged_Aim);
     
     // While aiming, we're in "aiming state"
-    ActivationOwnedTags.AddTag(FGameplayTag::RequestGameplayTag("State.Aiming"));
+    ActivationOwnedTags.AddTag(MYYTags::State_Aiming);
     
     
     // Block other combat abilities while aiming (except Fire)
-    BlockAbilitiesWithTag.AddTag(FGameplayTag::RequestGameplayTag("Ability.Attack.Melee"));
+    BlockAbilitiesWithTag.AddTag(MYYTags::Ability_Attack_Melee);
     
     bCheckStaminaBeforeActivate = false;
 }
@@ -1,4 +1,5 @@
 ﻿#include "GA_Fire.h"
+#include "MYY/MYY.h"
 #include "MYY/AbilitySystem/MYYCharacterBase.h"
 #include "MYY/AbilitySystem/BaseWeapon.h"
 #include "MYY/AbilitySystem/Components/EquipmentComponent.h"
@@ -7,11 +8,12 @@
 #include "AbilitySystemComponent.h"
 #include "Camera/CameraComponent.h"
 #include "GameFramework/ProjectileMovementComponent.h"
+#include "MYY/AbilitySystem/GameplayTags/MYYGameplayTags.h"
 
 
 /**
      *               -------Doesn't Recquired Aim ability to fire Arrows
-    // ActivationRequiredTags.AddTag(FGameplayTag::RequestGameplayTag("State.Aiming"));
+    // ActivationRequiredTags.AddTag(MYYTags::State_Aiming);
 
  **/
 
@@ -22,12 +24,12 @@ UGA_Fire::UGA_Fire()
     NetExecutionPolicy = EGameplayAbilityNetExecutionPolicy::LocalPredicted;
     ReplicationPolicy = EGameplayAbilityReplicationPolicy::ReplicateYes;
     
-    AbilityTags.AddTag(FGameplayTag::RequestGameplayTag("Ability.Ranged.Fire"));
+    AbilityTags.AddTag(MYYTags::Ability_Ranged_Fire);
 
     
 
     // ✅ ADD THIS: Block activation while montage is playing
-    ActivationBlockedTags.AddTag(FGameplayTag::RequestGameplayTag("State.Firing"));
+    ActivationBlockedTags.AddTag(MYYTags::State_Firing);
     
     bCheckStaminaBeforeActivate = false;
 }
@@ -40,60 +42,60 @@ bool UGA_Fire::CanActivateAbility(const FGameplayAbilitySpecHandle Handle,
 {
     if (!Super::CanActivateAbility(Handle, ActorInfo, SourceTags, TargetTags, OptionalRelevantTags))
     {
-        UE_LOG(LogTemp, Warning, TEXT("[GA_Fire] Super::CanActivateAbility failed"));
+        UE_LOG(LogMYYCombat, Verbose, TEXT("[GA_Fire] Super::CanActivateAbility failed"));
         return false;
     }
 
     // ✅ ADD THIS: Check if cooldown timer is still active
     if (IsOnCooldown())
     {
-        UE_LOG(LogTemp, Warning, TEXT("[GA_Fire] ❌ Cannot fire - still on cooldown!"));
+        UE_LOG(LogMYYCombat, Verbose, TEXT("[GA_Fire] ❌ Cannot fire - still on cooldown!"));
         return false;
     }
         
     AMYYCharacterBase* Character = Cast<AMYYCharacterBase>(ActorInfo->AvatarActor.Get());
     if (!Character)
     {
-        UE_LOG(LogTemp, Warning, TEXT("[GA_Fire] No character"));
+        UE_LOG(LogMYYCombat, Verbose, TEXT("[GA_Fire] No character"));
         return false;
     }
 
     // ✅ CRITICAL: Check if character is aiming
     if (!Character->bIsAiming)
     {
-        UE_LOG(LogTemp, Warning, TEXT("[GA_Fire] ❌ Cannot fire - not aiming!"));
+        UE_LOG(LogMYYCombat, Verbose, TEXT("[GA_Fire] ❌ Cannot fire - not aiming!"));
         return false;
     }
 
     if (!Character->EquipmentComponent)
     {
-        UE_LOG(LogTemp, Warning, TEXT("[GA_Fire] No EquipmentComponent"));
+        UE_LOG(LogMYYCombat, Verbose, TEXT("[GA_Fire] No EquipmentComponent"));
         return false;
     }
 
     ABaseWeapon* Weapon = Character->EquipmentComponent->GetCurrentWeapon();
     if (!Weapon)
     {
-        UE_LOG(LogTemp, Warning, TEXT("[GA_Fire] No weapon equipped"));
+        UE_LOG(LogMYYCombat, Verbose, TEXT("[GA_Fire] No weapon equipped"));
         return false;
     }
 
     URangedWeaponDataAsset* RangedData = Cast<URangedWeaponDataAsset>(Weapon->WeaponData);
     if (!RangedData)
     {
-        UE_LOG(LogTemp, Error, TEXT("[GA_Fire] Weapon is not ranged"));
+        UE_LOG(LogMYYCombat, Error, TEXT("[GA_Fire] Weapon is not ranged"));
         return false;
     }
 
 
     if (!RangedData->AmmoConfig.bInfiniteAmmo && !Weapon->HasAmmo())
     {
-        UE_LOG(LogTemp, Warning, TEXT("[GA_Fire] Out of ammo!"));
+        UE_LOG(LogMYYCombat, Verbose, TEXT("[GA_Fire] Out of ammo!"));
  
         return false;
     }
 
-    UE_LOG(LogTemp, Warning, TEXT("[GA_Fire] ✅ CanActivateAbility = TRUE (Ammo: %d)"), Weapon->CurrentAmmo);
+    UE_LOG(LogMYYCombat, Verbose, TEXT("[GA_Fire] ✅ CanActivateAbility = TRUE (Ammo: %d)"), Weapon->CurrentAmmo);
  
     
     return true;
@@ -105,11 +107,11 @@ void UGA_Fire::ActivateAbility(const FGameplayAbilitySpecHandle Handle,
                                const FGameplayAbilityActivationInfo ActivationInfo,
                                const FGameplayEventData* TriggerEventData)
 {
-    UE_LOG(LogTemp, Warning, TEXT("[GA_Fire] 🔥 FIRING ARROW"));
+    UE_LOG(LogMYYCombat, Verbose, TEXT("[GA_Fire] 🔥 FIRING ARROW"));
 
     if (!CommitAbility(Handle, ActorInfo, ActivationInfo))
     {
-        UE_LOG(LogTemp, Error, TEXT("[GA_Fire] ❌ Failed to commit ability"));
+        UE_LOG(LogMYYCombat, Error, TEXT("[GA_Fire] ❌ Failed to commit ability"));
         EndAbility(Handle, ActorInfo, ActivationInfo, true, true);
         return;
     }
@@ -124,7 +126,7 @@ void UGA_Fire::ActivateAbility(const FGameplayAbilitySpecHandle Handle,
     ABaseWeapon* Weapon = Character->EquipmentComponent->GetCurrentWeapon();
     if (!Weapon)
     {
-        UE_LOG(LogTemp, Error, TEXT("[GA_Fire] ❌ No weapon"));
+        UE_LOG(LogMYYCombat, Error, TEXT("[GA_Fire] ❌ No weapon"));
         EndAbility(Handle, ActorInfo, ActivationInfo, true, false);
         return;
     }
@@ -132,7 +134,7 @@ void UGA_Fire::ActivateAbility(const FGameplayAbilitySpecHandle Handle,
     RangedWeaponData = Cast<URangedWeaponDataAsset>(Weapon->WeaponData);
     if (!RangedWeaponData)
     {
-        UE_LOG(LogTemp, Error, TEXT("[GA_Fire] ❌ Not ranged"));
+        UE_LOG(LogMYYCombat, Error, TEXT("[GA_Fire] ❌ Not ranged"));
         EndAbility(Handle, ActorInfo, ActivationInfo, true, false);
         return;
     }
@@ -146,7 +148,7 @@ void UGA_Fire::ActivateAbility(const FGameplayAbilitySpecHandle Handle,
 
     // ✅ Store data for InputReleased() but DON'T consume ammo yet
     // ✅ DON'T end ability here - wait for InputReleased()
-    UE_LOG(LogTemp, Warning, TEXT("[GA_Fire] ✅ Ready to fire (Ammo: %d)"), Weapon->CurrentAmmo);
+    UE_LOG(LogMYYCombat, Verbose, TEXT("[GA_Fire] ✅ Ready to fire (Ammo: %d)"), Weapon->CurrentAmmo);
  
 }
 
@@ -170,7 +172,7 @@ void UGA_Fire::ActivateAbility(const FGameplayAbilitySpecHandle Handle,
 //
 //     // ✅ Apply State.Firing tag to block rapid fire
 //     FGameplayTagContainer FireTags;
-//     FireTags.AddTag(FGameplayTag::RequestGameplayTag("State.Firing"));
+//     FireTags.AddTag(MYYTags::State_Firing);
 //     UAbilitySystemComponent* ASC = GetAbilitySystemComponentFromActorInfo();
 //     ASC->AddLooseGameplayTags(FireTags);
 //     UE_LOG(LogTemp, Warning, TEXT("[GA_Fire] ✅ State.Firing tag ADDED"));
@@ -213,21 +215,21 @@ void UGA_Fire::InputReleased(const FGameplayAbilitySpecHandle Handle,
                              const FGameplayAbilityActorInfo* ActorInfo,
                              const FGameplayAbilityActivationInfo ActivationInfo)
 {
-    UE_LOG(LogTemp, Warning, TEXT("[GA_Fire] 🏹 INPUT RELEASED - FIRING NOW!"));
+    UE_LOG(LogMYYCombat, Verbose, TEXT("[GA_Fire] 🏹 INPUT RELEASED - FIRING NOW!"));
 
     if (!RangedWeaponData)
     {
-        UE_LOG(LogTemp, Error, TEXT("[GA_Fire] ❌ RangedWeaponData is NULL!"));
+        UE_LOG(LogMYYCombat, Error, TEXT("[GA_Fire] ❌ RangedWeaponData is NULL!"));
         EndAbility(Handle, ActorInfo, ActivationInfo, true, false);
         return;
     }
 
     // ✅ Apply State.Firing tag to block rapid fire
     FGameplayTagContainer FireTags;
-    FireTags.AddTag(FGameplayTag::RequestGameplayTag("State.Firing"));
+    FireTags.AddTag(MYYTags::State_Firing);
     UAbilitySystemComponent* ASC = GetAbilitySystemComponentFromActorInfo();
     ASC->AddLooseGameplayTags(FireTags);
-    UE_LOG(LogTemp, Warning, TEXT("[GA_Fire] ✅ State.Firing tag ADDED"));
+    UE_LOG(LogMYYCombat, Verbose, TEXT("[GA_Fire] ✅ State.Firing tag ADDED"));
 
     // ✅ Consume ammo
     if (!RangedWeaponData->AmmoConfig.bInfiniteAmmo)
@@ -236,7 +238,7 @@ void UGA_Fire::InputReleased(const FGameplayAbilitySpecHandle Handle,
         if (Weapon)
         {
             Weapon->ConsumeAmmo(1);
-            UE_LOG(LogTemp, Log, TEXT("[GA_Fire] Ammo consumed: %d remaining"), Weapon->CurrentAmmo);
+            UE_LOG(LogMYYCombat, Verbose, TEXT("[GA_Fire] Ammo consumed: %d remaining"), Weapon->CurrentAmmo);
         }
     }
 
@@ -255,7 +257,7 @@ void UGA_Fire::InputReleased(const FGameplayAbilitySpecHandle Handle,
         // ✅ Play montage on character (MONTAGE PLAYS HERE)
         Character->PlayAnimMontage(RangedWeaponData->FireMontage, 1.0f);
         
-        UE_LOG(LogTemp, Warning, TEXT("[GA_Fire] ✅ Playing fire montage (Duration: %.2f seconds)"), MontageDuration);
+        UE_LOG(LogMYYCombat, Verbose, TEXT("[GA_Fire] ✅ Playing fire montage (Duration: %.2f seconds)"), MontageDuration);
         
         // ✅ Setup timer to remove blocking tag after montage completes
         GetWorld()->GetTimerManager().SetTimer(MontageTimerHandle, [ASC, FireTags]()
@@ -263,52 +265,52 @@ void UGA_Fire::InputReleased(const FGameplayAbilitySpecHandle Handle,
             if (ASC)
             {
                 ASC->RemoveLooseGameplayTags(FireTags);
-                UE_LOG(LogTemp, Warning, TEXT("[GA_Fire] ⏱️ Timer REMOVED State.Firing tag"));
+                UE_LOG(LogMYYCombat, Verbose, TEXT("[GA_Fire] ⏱️ Timer REMOVED State.Firing tag"));
             }
         }, MontageDuration, false);
     }
     else
     {
         // No montage, remove tag immediately
-        UE_LOG(LogTemp, Warning, TEXT("[GA_Fire] ⚠️ No fire montage - ending immediately"));
+        UE_LOG(LogMYYCombat, Verbose, TEXT("[GA_Fire] ⚠️ No fire montage - ending immediately"));
         ASC->RemoveLooseGameplayTags(FireTags);
     }
 
     // ✅ END ABILITY IMMEDIATELY (ability ends but montage keeps playing)
-    UE_LOG(LogTemp, Warning, TEXT("[GA_Fire] ✅ Ability ending immediately"));
+    UE_LOG(LogMYYCombat, Verbose, TEXT("[GA_Fire] ✅ Ability ending immediately"));
     EndAbility(Handle, ActorInfo, ActivationInfo, true, false);
 }
 
 void UGA_Fire::SpawnProjectile()
 {
-    UE_LOG(LogTemp, Warning, TEXT("[GA_Fire] 🏹 SpawnProjectile called"));
+    UE_LOG(LogMYYCombat, Verbose, TEXT("[GA_Fire] 🏹 SpawnProjectile called"));
 
     if (!RangedWeaponData || !RangedWeaponData->ProjectileClass)
     {
-        UE_LOG(LogTemp, Error, TEXT("[GA_Fire] ❌ No ProjectileClass!"));
+        UE_LOG(LogMYYCombat, Error, TEXT("[GA_Fire] ❌ No ProjectileClass!"));
         return;
     }
 
     AMYYCharacterBase* Character = Cast<AMYYCharacterBase>(GetAvatarActorFromActorInfo());
     if (!Character)
     {
-        UE_LOG(LogTemp, Error, TEXT("[GA_Fire] ❌ No character"));
+        UE_LOG(LogMYYCombat, Error, TEXT("[GA_Fire] ❌ No character"));
         return;
     }
 
     // ✅ Only server spawns projectiles
     if (!Character->HasAuthority())
     {
-        UE_LOG(LogTemp, Warning, TEXT("[GA_Fire] ⚠️ CLIENT - skipping spawn"));
+        UE_LOG(LogMYYCombat, Verbose, TEXT("[GA_Fire] ⚠️ CLIENT - skipping spawn"));
         return;
     }
 
-    UE_LOG(LogTemp, Warning, TEXT("[GA_Fire] ✅ SERVER - Spawning projectile"));
+    UE_LOG(LogMYYCombat, Verbose, TEXT("[GA_Fire] ✅ SERVER - Spawning projectile"));
 
     ABaseWeapon* Weapon = GetCurrentWeapon();
     if (!Weapon || !Weapon->WeaponMesh)
     {
-        UE_LOG(LogTemp, Error, TEXT("[GA_Fire] ❌ No weapon or mesh"));
+        UE_LOG(LogMYYCombat, Error, TEXT("[GA_Fire] ❌ No weapon or mesh"));
         return;
     }
 
@@ -325,7 +327,7 @@ void UGA_Fire::SpawnProjectile()
         SpawnLocation = Character->GetActorLocation() + 
                        (Character->GetActorForwardVector() * 100.f) + 
                        (Character->GetActorUpVector() * 50.f);
-        UE_LOG(LogTemp, Warning, TEXT("[GA_Fire] ⚠️ Socket not found, using fallback"));
+        UE_LOG(LogMYYCombat, Verbose, TEXT("[GA_Fire] ⚠️ Socket not found, using fallback"));
     }
 
     // Calculate aim direction
@@ -333,7 +335,7 @@ void UGA_Fire::SpawnProjectile()
     FVector Direction = (AimTarget - SpawnLocation).GetSafeNormal();
     FRotator SpawnRotation = Direction.Rotation();
 
-    UE_LOG(LogTemp, Warning, TEXT("[GA_Fire] 🎯 Direction: %s"), *Direction.ToCompactString());
+    UE_LOG(LogMYYCombat, Verbose, TEXT("[GA_Fire] 🎯 Direction: %s"), *Direction.ToCompactString());
 
     // Spawn projectile
     FActorSpawnParameters SpawnParams;
@@ -359,15 +361,15 @@ void UGA_Fire::SpawnProjectile()
             ProjectileMovement->MaxSpeed = FinalSpeed;
             ProjectileMovement->Velocity = Direction * FinalSpeed;
             
-            UE_LOG(LogTemp, Log, TEXT("[GA_Fire] Velocity: %s (Speed: %.0f)"),
+            UE_LOG(LogMYYCombat, Verbose, TEXT("[GA_Fire] Velocity: %s (Speed: %.0f)"),
                 *ProjectileMovement->Velocity.ToCompactString(), FinalSpeed);
         }
 
-        UE_LOG(LogTemp, Warning, TEXT("[GA_Fire] ✅ Spawned: %s"), *Projectile->GetName());
+        UE_LOG(LogMYYCombat, Verbose, TEXT("[GA_Fire] ✅ Spawned: %s"), *Projectile->GetName());
     }
     else
     {
-        UE_LOG(LogTemp, Error, TEXT("[GA_Fire] ❌ FAILED TO SPAWN PROJECTILE!"));
+        UE_LOG(LogMYYCombat, Error, TEXT("[GA_Fire] ❌ FAILED TO SPAWN PROJECTILE!"));
     }
 }
 
@@ -437,27 +439,27 @@ void UGA_Fire::EndAbility(const FGameplayAbilitySpecHandle Handle,
                           bool bReplicateEndAbility,
                           bool bWasCancelled)
 {
-    UE_LOG(LogTemp, Warning, TEXT("[GA_Fire] 🛑 EndAbility called (Cancelled: %s)"), 
+    UE_LOG(LogMYYCombat, Verbose, TEXT("[GA_Fire] 🛑 EndAbility called (Cancelled: %s)"), 
         bWasCancelled ? TEXT("YES") : TEXT("NO"));
     
     // ✅ ONLY clear timer if ability was CANCELLED (not normal completion)
     if (bWasCancelled && GetWorld() && MontageTimerHandle.IsValid())
     {
-        UE_LOG(LogTemp, Warning, TEXT("[GA_Fire] ⏱️ Clearing timer - ability was cancelled"));
+        UE_LOG(LogMYYCombat, Verbose, TEXT("[GA_Fire] ⏱️ Clearing timer - ability was cancelled"));
         GetWorld()->GetTimerManager().ClearTimer(MontageTimerHandle);
         
         // Remove tag if cancelled
         FGameplayTagContainer FireTags;
-        FireTags.AddTag(FGameplayTag::RequestGameplayTag("State.Firing"));
+        FireTags.AddTag(MYYTags::State_Firing);
         if (GetAbilitySystemComponentFromActorInfo())
         {
             GetAbilitySystemComponentFromActorInfo()->RemoveLooseGameplayTags(FireTags);
-            UE_LOG(LogTemp, Warning, TEXT("[GA_Fire] 🧹 Cleaned up State.Firing tag"));
+            UE_LOG(LogMYYCombat, Verbose, TEXT("[GA_Fire] 🧹 Cleaned up State.Firing tag"));
         }
     }
     else
     {
-        UE_LOG(LogTemp, Log, TEXT("[GA_Fire] ⏱️ Timer left running - will expire naturally"));
+        UE_LOG(LogMYYCombat, Verbose, TEXT("[GA_Fire] ⏱️ Timer left running - will expire naturally"));
     }
     
     Super::EndAbility(Handle, ActorInfo, ActivationInfo, bReplicateEndAbility, bWasCancelled);
@@ -465,11 +467,11 @@ void UGA_Fire::EndAbility(const FGameplayAbilitySpecHandle Handle,
 
 void UGA_Fire::OnFireMontageCompleted()
 {
-    UE_LOG(LogTemp, Log, TEXT("[GA_Fire] 🎬 Fire montage completed - cleaning up"));
+    UE_LOG(LogMYYCombat, Verbose, TEXT("[GA_Fire] 🎬 Fire montage completed - cleaning up"));
 
     // ✅ Remove blocking tag so we can fire again
     FGameplayTagContainer FireTags;
-    FireTags.AddTag(FGameplayTag::RequestGameplayTag("State.Firing"));
+    FireTags.AddTag(MYYTags::State_Firing);
     GetAbilitySystemComponentFromActorInfo()->RemoveLooseGameplayTags(FireTags);
 
     // // ✅ CHANGE THIS: Use cached handles instead of CurrentSpecHandle
@@ -9,6 +9,7 @@
 #include "GameFramework/Character.h"
 #include "Camera/CameraComponent.h"
 #include "GameFramework/ProjectileMovementComponent.h"
+#include "MYY/AbilitySystem/GameplayTags/MYYGameplayTags.h"
 
 UGA_RangedAttack::UGA_RangedAttack()
 {
@@ -18,18 +19,18 @@ UGA_RangedAttack::UGA_RangedAttack()
     
 
     FGameplayTagContainer AssetTags;
-    AssetTags.AddTag(FGameplayTag::RequestGameplayTag("Ability.Attack.Ranged"));
+    AssetTags.AddTag(MYYTags::Ability_Attack_Ranged);
     SetAssetTags(AssetTags);
 
-    ActivationOwnedTags.AddTag(FGameplayTag::RequestGameplayTag("State.Combat.Attacking"));
-    BlockAbilitiesWithTag.AddTag(FGameplayTag::RequestGameplayTag("State.Combat"));
+    ActivationOwnedTags.AddTag(MYYTags::State_Combat_Attacking);
+    BlockAbilitiesWithTag.AddTag(MYYTags::State_Combat);
 
     // CurrentState = ERangedAttackState::Idle;
     bCheckStaminaBeforeActivate = false;
     RequiredStaminaCost = 15.f;
  
     FAbilityTriggerData TriggerData;
-    TriggerData.TriggerTag = FGameplayTag::RequestGameplayTag("GameplayEvent.Fire");
+    TriggerData.TriggerTag = MYYTags::GameplayEvent_Fire;
     TriggerData.TriggerSource = EGameplayAbilityTriggerSource::GameplayEvent;
     AbilityTriggers.Add(TriggerData);
 
@@ -77,7 +78,7 @@ bool UGA_RangedAttack::CanActivateAbility(const FGameplayAbilitySpecHandle Handl
         UE_LOG(LogTemp, Warning, TEXT("[GA_RangedAttack] Out of ammo!"));
         if (OptionalRelevantTags)
         {
-            OptionalRelevantTags->AddTag(FGameplayTag::RequestGameplayTag("Ability.Failed.NoAmmo"));
+            OptionalRelevantTags->AddTag(MYYTags::Ability_Failed_NoAmmo);
         }
         return false;
     }
@@ -95,7 +96,7 @@ void UGA_RangedAttack::ActivateAbility(const FGameplayAbilitySpecHandle Handle,
 {
     // ✅ FIX: Check if this is a FIRE event
     if (TriggerEventData && TriggerEventData->EventTag.MatchesTag(
-        FGameplayTag::RequestGameplayTag("GameplayEvent.Fire")))
+        MYYTags::GameplayEvent_Fire))
     {
         UE_LOG(LogTemp, Warning, TEXT("[GA_RangedAttack] 🔥 FIRE EVENT"));
         
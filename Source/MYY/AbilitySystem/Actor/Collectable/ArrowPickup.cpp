@@ -98,7 +98,7 @@ void AArrowPickup::OnInteract_Implementation(AActor* Interactor)
     if (CurrentWeapon->CurrentAmmo < RangedData->AmmoConfig.MaxAmmo)
     {
         int32 AmmoToAdd = FMath::Min(ArrowCount, RangedData->AmmoConfig.MaxAmmo - CurrentWeapon->CurrentAmmo);
-        CurrentWeapon->CurrentAmmo += AmmoToAdd;
+        CurrentWeapon->SetCurrentAmmo(CurrentWeapon->CurrentAmmo + AmmoToAdd);
 
         UE_LOG(LogTemp, Warning, TEXT("[ArrowPickup] ✅ Added %d arrows. Total: %d/%d"),
             AmmoToAdd, CurrentWeapon->CurrentAmmo, RangedData->AmmoConfig.MaxAmmo);
@@ -0,0 +1,216 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MinionCrowdActor.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "HAL/IConsoleManager.h"
+#include "Net/UnrealNetwork.h"
+#include "MYY/MYY.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Crowd Instances Dirtied"), STAT_MYY_CrowdInstancesDirtied, STATGROUP_MYYCombat);
+
+static TAutoConsoleVariable<float> CVarCrowdNetPositionThreshold(
+    TEXT("MYY.AI.Crowd.NetPositionThreshold"),
+    20.f,
+    TEXT("Distance (cm) a crowd minion moves from its last replicated position before it's sent again."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarCrowdNetYawThreshold(
+    TEXT("MYY.AI.Crowd.NetYawThreshold"),
+    4,
+    TEXT("Turn (in 1/256ths of a circle) a crowd minion makes from its last replicated facing before it's sent again."),
+    ECVF_Default);
+
+void FMinionCrowdInstanceArray::PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters)
+{
+    if (Owner)
+    {
+        Owner->RefreshInstances();
+    }
+}
+
+AMinionCrowdActor::AMinionCrowdActor()
+{
+    PrimaryActorTick.bCanEverTick = false;
+
+    // Crowd minions are far from everyone by definition, so relevancy by distance would drop them all
+    bReplicates = true;
+    bAlwaysRelevant = true;
+    SetNetUpdateFrequency(5.f);
+    SetMinNetUpdateFrequency(1.f);
+
+    RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+    RootComponent->SetMobility(EComponentMobility::Static);
+}
+
+void AMinionCrowdActor::PostInitializeComponents()
+{
+    Super::PostInitializeComponents();
+
+    Instances.Owner = this;
+}
+
+void AMinionCrowdActor::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+    Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+    DOREPLIFETIME(AMinionCrowdActor, Instances);
+    DOREPLIFETIME(AMinionCrowdActor, ProxyMeshes);
+}
+
+uint8 AMinionCrowdActor::FindOrAddProxyMesh(UStaticMesh* Mesh)
+{
+    const int32 Existing = ProxyMeshes.Find(Mesh);
+    if (Existing != INDEX_NONE)
+    {
+        return static_cast<uint8>(Existing);
+    }
+
+    if (ProxyMeshes.Num() > MAX_uint8)
+    {
+        return 0;
+    }
+
+    return static_cast<uint8>(ProxyMeshes.Add(Mesh));
+}
+
+void AMinionCrowdActor::BeginInstanceSync()
+{
+    ++SyncSerial;
+    bInstancesChanged = false;
+}
+
+void AMinionCrowdActor::SyncInstance(uint32 AgentId, const FVector& Location, float Yaw, uint8 MeshIndex)
+{
+    const FVector_NetQuantize QuantizedLocation(Location);
+    const uint8 QuantizedYaw = static_cast<uint8>(FMath::RoundToInt32(FRotator::ClampAxis(Yaw) * (256.f / 360.f)) & 0xFF);
+
+    const int32* ExistingIndex = InstanceIndexByAgent.Find(AgentId);
+    if (!ExistingIndex)
+    {
+        FMinionCrowdInstance& Instance = Instances.Items.AddDefaulted_GetRef();
+        Instance.AgentId = AgentId;
+        Instance.LastSync = SyncSerial;
+        Instance.Location = QuantizedLocation;
+        Instance.Yaw = QuantizedYaw;
+        Instance.MeshIndex = MeshIndex;
+        InstanceIndexByAgent.Add(AgentId, Instances.Items.Num() - 1);
+
+        Instances.MarkItemDirty(Instance);
+        INC_DWORD_STAT(STAT_MYY_CrowdInstancesDirtied);
+        bInstancesChanged = true;
+        return;
+    }
+
+    FMinionCrowdInstance& Instance = Instances.Items[*ExistingIndex];
+    Instance.LastSync = SyncSerial;
+
+    // Shortest way round, in 1/256ths
+    const int32 YawDelta = FMath::Abs(static_cast<int32>(static_cast<int8>(QuantizedYaw - Instance.Yaw)));
+    const bool bMoved = FVector::DistSquared(Instance.Location, QuantizedLocation) >= FMath::Square(CVarCrowdNetPositionThreshold.GetValueOnGameThread());
+    const bool bTurned = YawDelta >= CVarCrowdNetYawThreshold.GetValueOnGameThread();
+    if (!bMoved && !bTurned && Instance.MeshIndex == MeshIndex)
+    {
+        return;
+    }
+
+    Instance.Location = QuantizedLocation;
+    Instance.Yaw = QuantizedYaw;
+    Instance.MeshIndex = MeshIndex;
+
+    Instances.MarkItemDirty(Instance);
+    INC_DWORD_STAT(STAT_MYY_CrowdInstancesDirtied);
+    bInstancesChanged = true;
+}
+
+void AMinionCrowdActor::EndInstanceSync()
+{
+    // Agents that left the crowd (promoted, removed) since the last sync
+    bool bRemoved = false;
+    for (int32 Index = Instances.Items.Num() - 1; Index >= 0; --Index)
+    {
+        if (Instances.Items[Index].LastSync == SyncSerial)
+        {
+            continue;
+        }
+
+        InstanceIndexByAgent.Remove(Instances.Items[Index].AgentId);
+        Instances.Items.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+        if (Instances.Items.IsValidIndex(Index))
+        {
+            InstanceIndexByAgent.Add(Instances.Items[Index].AgentId, Index);
+        }
+        bRemoved = true;
+    }
+
+    if (bRemoved)
+    {
+        Instances.MarkArrayDirty();
+        bInstancesChanged = true;
+    }
+
+    if (bInstancesChanged)
+    {
+        RefreshInstances();
+    }
+}
+
+void AMinionCrowdActor::RefreshInstances()
+{
+    if (GetNetMode() == NM_DedicatedServer)
+    {
+        return;
+    }
+
+    TransformScratch.SetNum(ProxyMeshes.Num());
+    for (TArray<FTransform>& Transforms : TransformScratch)
+    {
+        Transforms.Reset();
+    }
+
+    for (const FMinionCrowdInstance& Instance : Instances.Items)
+    {
+        if (TransformScratch.IsValidIndex(Instance.MeshIndex))
+        {
+            const FRotator Rotation(0.f, Instance.Yaw * (360.f / 256.f), 0.f);
+            TransformScratch[Instance.MeshIndex].Emplace(Rotation, Instance.Location);
+        }
+    }
+
+    for (int32 MeshIndex = 0; MeshIndex < ProxyMeshes.Num(); ++MeshIndex)
+    {
+        UStaticMesh* Mesh = ProxyMeshes[MeshIndex];
+        if (!Mesh)
+        {
+            continue;
+        }
+
+        if (!MeshComponents.IsValidIndex(MeshIndex))
+        {
+            MeshComponents.SetNumZeroed(MeshIndex + 1);
+        }
+
+        UInstancedStaticMeshComponent*& MeshComponent = MeshComponents[MeshIndex];
+        if (!MeshComponent)
+        {
+            MeshComponent = NewObject<UInstancedStaticMeshComponent>(this);
+            MeshComponent->SetStaticMesh(Mesh);
+            MeshComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+            MeshComponent->SetCanEverAffectNavigation(false);
+            MeshComponent->SetupAttachment(RootComponent);
+            MeshComponent->RegisterComponent();
+        }
+
+        // Same count: update in place, otherwise rebuild
+        const TArray<FTransform>& Transforms = TransformScratch[MeshIndex];
+        if (MeshComponent->GetInstanceCount() == Transforms.Num())
+        {
+            MeshComponent->BatchUpdateInstancesTransforms(0, Transforms, true, true, true);
+        }
+        else
+        {
+            MeshComponent->ClearInstances();
+            MeshComponent->AddInstances(Transforms, false, true);
+        }
+    }
+}
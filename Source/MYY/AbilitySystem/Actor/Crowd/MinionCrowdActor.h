@@ -0,0 +1,114 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "Net/Serialization/FastArraySerializer.h"
+#include "MinionCrowdActor.generated.h"
+
+class AMinionCrowdActor;
+class UInstancedStaticMeshComponent;
+class UStaticMesh;
+
+// One crowd minion as clients see it
+USTRUCT()
+struct FMinionCrowdInstance : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FVector_NetQuantize Location = FVector::ZeroVector;
+
+	// Yaw / 360 * 256
+	UPROPERTY()
+	uint8 Yaw = 0;
+
+	// Into AMinionCrowdActor::ProxyMeshes
+	UPROPERTY()
+	uint8 MeshIndex = 0;
+
+	// Server: the crowd agent this entry draws, and the last sync that touched it
+	UPROPERTY(NotReplicated)
+	uint32 AgentId = 0;
+
+	UPROPERTY(NotReplicated)
+	uint32 LastSync = 0;
+};
+
+// Crowd instances as a fast array: only the entries that moved past the threshold are sent
+USTRUCT()
+struct FMinionCrowdInstanceArray : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FMinionCrowdInstance> Items;
+
+	UPROPERTY(NotReplicated)
+	TObjectPtr<AMinionCrowdActor> Owner = nullptr;
+
+	// Client: redraws once per received update, not once per entry
+	void PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters);
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FMinionCrowdInstance, FMinionCrowdInstanceArray>(Items, DeltaParms, *this);
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FMinionCrowdInstanceArray> : public TStructOpsTypeTraitsBase2<FMinionCrowdInstanceArray>
+{
+	enum { WithNetDeltaSerializer = true };
+};
+
+/**
+ * Draws the minions simulated by UMinionCrowdSubsystem, one instanced static mesh per proxy mesh.
+ *
+ * Spawned and fed by the subsystem on the server; the instance list replicates at a low rate so
+ * clients draw the same crowd. Entries are keyed by agent id and only re-sent when their quantized
+ * position or facing moved past a threshold. Nothing here collides or ticks.
+ */
+UCLASS(NotPlaceable)
+class MYY_API AMinionCrowdActor : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	AMinionCrowdActor();
+
+	// Server: index into ProxyMeshes for Mesh, adding it when new (nullptr draws nothing)
+	uint8 FindOrAddProxyMesh(UStaticMesh* Mesh);
+
+	// Server: one sync per crowd update. Every agent still in the crowd is passed to SyncInstance
+	// between these; entries not synced by EndInstanceSync are removed.
+	void BeginInstanceSync();
+	void SyncInstance(uint32 AgentId, const FVector& Location, float Yaw, uint8 MeshIndex);
+	void EndInstanceSync();
+
+	// Pushes Instances into the instanced mesh components (not on a dedicated server)
+	void RefreshInstances();
+
+protected:
+	virtual void PostInitializeComponents() override;
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	UPROPERTY(Replicated)
+	FMinionCrowdInstanceArray Instances;
+
+	// Server: agent id -> index into Instances.Items
+	TMap<uint32, int32> InstanceIndexByAgent;
+	uint32 SyncSerial = 0;
+	bool bInstancesChanged = false;
+
+	UPROPERTY(Replicated)
+	TArray<UStaticMesh*> ProxyMeshes;
+
+	// Parallel to ProxyMeshes, created as meshes show up
+	UPROPERTY(Transient)
+	TArray<UInstancedStaticMeshComponent*> MeshComponents;
+
+	// Per-mesh transforms, rebuilt on every refresh
+	TArray<TArray<FTransform>> TransformScratch;
+};
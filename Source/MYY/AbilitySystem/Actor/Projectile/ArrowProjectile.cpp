@@ -9,10 +9,20 @@
 #include "Kismet/GameplayStatics.h"
 #include "MYY/AbilitySystem/AttributeSet/AttributeSetBase.h"
 #include "MYY/AbilitySystem/Actor/Havankund/Havankund.h"
+#include "MYY/AbilitySystem/MYYCharacterBase.h"
+#include "MYY/AbilitySystem/GameplayTags/MYYGameplayTags.h"
+#include "MYY/AbilitySystem/Subsystem/LagCompensationSubsystem.h"
+#include "MYY/MYY.h"
+
+#if WITH_EDITOR
+#include "Misc/DataValidation.h"
+#endif
 
 AArrowProjectile::AArrowProjectile()
 {
-    PrimaryActorTick.bCanEverTick = false;
+    // Only ticks on the server for lag-compensated arrows (see BeginPlay)
+    PrimaryActorTick.bCanEverTick = true;
+    PrimaryActorTick.bStartWithTickEnabled = false;
     bReplicates = true;
     SetReplicatingMovement(true);
         
@@ -38,6 +48,22 @@ AArrowProjectile::AArrowProjectile()
     ProjectileMovement->ProjectileGravityScale = 0.5f;
 }
 
+#if WITH_EDITOR
+EDataValidationResult AArrowProjectile::IsDataValid(FDataValidationContext& Context) const
+{
+    EDataValidationResult Result = Super::IsDataValid(Context);
+
+    if (!FDamageSpecCache::IsValidDamageEffect(DamageEffect))
+    {
+        Context.AddError(FText::Format(INVTEXT("DamageEffect {0} is not UGE_Damage or a child of it"),
+            FText::FromString(GetNameSafe(DamageEffect))));
+        Result = EDataValidationResult::Invalid;
+    }
+
+    return Result;
+}
+#endif
+
 void AArrowProjectile::BeginPlay()
 {
     Super::BeginPlay();
@@ -48,7 +74,70 @@ void AArrowProjectile::BeginPlay()
         
         // Auto-destroy after 10 seconds
         SetLifeSpan(15.0f);
+
+        // Owner stands in when the spawner didn't set an instigator
+        AActor* InstigatorActor = GetInstigator() ? static_cast<AActor*>(GetInstigator()) : GetOwner();
+        DamageSpecCache.Arm(UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(InstigatorActor),
+            DamageEffect, this, InstigatorActor, MYYTags::Ability_Attack_Ranged);
+
+        // Remote shooters aimed at characters as they saw them: keep testing the flight path
+        // against the rewound hitboxes, at a fixed offset behind the server
+        const ULagCompensationSubsystem* LagCompensation = GetWorld()->GetSubsystem<ULagCompensationSubsystem>();
+        if (LagCompensation && LagCompensation->ShouldRewindFor(GetInstigator()))
+        {
+            RewindOffset = GetWorld()->GetTimeSeconds() - LagCompensation->GetAttackerViewTime(GetInstigator());
+            LastTraceLocation = GetActorLocation();
+            SetActorTickEnabled(RewindOffset > 0.0);
+
+            // The rewound test owns character hits: blocking on present-time capsules as well
+            // would compensate twice and hit where the target is now, not where the shooter saw it
+            if (RewindOffset > 0.0)
+            {
+                CollisionSphere->SetCollisionResponseToChannel(ECC_Pawn, ECR_Ignore);
+            }
+        }
+    }
+}
+
+void AArrowProjectile::Tick(float DeltaSeconds)
+{
+    Super::Tick(DeltaSeconds);
+
+    const FVector CurrentLocation = GetActorLocation();
+
+    FHitResult RewoundHit;
+    if (FindRewoundCharacterHit(LastTraceLocation, CurrentLocation, RewoundHit))
+    {
+        HandleImpact(RewoundHit.GetActor(), RewoundHit);
+        return;
     }
+
+    LastTraceLocation = CurrentLocation;
+}
+
+bool AArrowProjectile::FindRewoundCharacterHit(const FVector& From, const FVector& To, FHitResult& OutHit)
+{
+    if (RewindOffset <= 0.0 || bHasImpacted) return false;
+
+    const ULagCompensationSubsystem* LagCompensation = GetWorld()->GetSubsystem<ULagCompensationSubsystem>();
+    if (!LagCompensation) return false;
+
+    RewindHitScratch.Reset();
+    const int32 NumHits = LagCompensation->SweepSphereAtTime(
+        GetWorld()->GetTimeSeconds() - RewindOffset, From, To,
+        CollisionSphere->GetScaledSphereRadius(), GetInstigator(), RewindHitScratch);
+
+    // Sorted by time along the segment
+    for (int32 Index = 0; Index < NumHits; ++Index)
+    {
+        if (RewindHitScratch[Index].GetActor() != GetOwner())
+        {
+            OutHit = RewindHitScratch[Index];
+            return true;
+        }
+    }
+
+    return false;
 }
 
 
@@ -59,6 +148,20 @@ void AArrowProjectile::OnProjectileHit(
     FVector NormalImpulse,
     const FHitResult& Hit)
 {
+    // A character the arrow passed in the shooter's past comes before whatever it hit now
+    FHitResult RewoundHit;
+    if (FindRewoundCharacterHit(LastTraceLocation, Hit.Location, RewoundHit))
+    {
+        HandleImpact(RewoundHit.GetActor(), RewoundHit);
+        return;
+    }
+
+    HandleImpact(OtherActor, Hit);
+}
+
+void AArrowProjectile::HandleImpact(AActor* OtherActor, const FHitResult& Hit)
+{
+    if (bHasImpacted) return;
 
     /* =========================================================
        GHOST ACTORS (NO GAS DAMAGE)
@@ -96,6 +199,8 @@ void AArrowProjectile::OnProjectileHit(
     if (!HasAuthority()) return;
     if (!OtherActor || OtherActor == GetOwner()) return;
 
+    bHasImpacted = true;
+
     
 
     /* =========================================================
@@ -165,82 +270,27 @@ void AArrowProjectile::ApplyDamageToTarget(AActor* Target, const FHitResult& Hit
 
     if (!TargetASC)
     {
-        UE_LOG(LogTemp, Warning, TEXT("[ArrowProjectile] ⚠️ Target has no ASC"));
+        UE_LOG(LogMYYCombat, Verbose, TEXT("[ArrowProjectile] ⚠️ Target has no ASC"));
         return;
     }
 
-    // ✅ FIX: Get instigator properly
-    AActor* InstigatorActor = GetInstigator();
-    if (!InstigatorActor)
-    {
-        InstigatorActor = GetOwner();
-        UE_LOG(LogTemp, Warning, TEXT("[ArrowProjectile] Using Owner as Instigator: %s"), 
-            *GetNameSafe(InstigatorActor));
-    }
-    
-    if (!InstigatorActor)
+    // Spec was built from the instigator when the arrow spawned; UGE_Damage is used if DamageEffect is unset
+    if (!DamageSpecCache.IsArmed())
     {
-        UE_LOG(LogTemp, Error, TEXT("[ArrowProjectile] ❌ No Instigator or Owner set!"));
+        UE_LOG(LogMYYCombat, Warning, TEXT("[ArrowProjectile] ❌ No instigator ASC, damage spec not armed!"));
         return;
     }
 
-    UE_LOG(LogTemp, Log, TEXT("[ArrowProjectile] Instigator: %s"), *InstigatorActor->GetName());
+    FActiveGameplayEffectHandle GEHandle = DamageSpecCache.ApplyDamage(TargetASC, BaseDamage, HitResult);
 
-    UAbilitySystemComponent* InstigatorASC = 
-       UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(InstigatorActor);
-    if (!InstigatorASC) return;
-
-    // Create damage effect context
-    FGameplayEffectContextHandle EffectContext = InstigatorASC->MakeEffectContext();
-    EffectContext.AddSourceObject(this);
-    EffectContext.AddHitResult(HitResult);
-    
-    AController* InstigatorController = InstigatorActor->GetInstigatorController();
-    EffectContext.AddInstigator(InstigatorActor, InstigatorController);
-    if (!InstigatorController && Cast<APawn>(InstigatorActor))
+    if (GEHandle.WasSuccessfullyApplied())
     {
-        InstigatorController = Cast<APawn>(InstigatorActor)->GetController();
-    }
-    
-    EffectContext.AddInstigator(InstigatorActor, InstigatorController);
-    
-    if (DamageEffect)
-    {
-        FGameplayEffectSpecHandle SpecHandle = 
-            InstigatorASC->MakeOutgoingSpec(DamageEffect, 1.f, EffectContext);
-
-        if (SpecHandle.IsValid())
-        {
-            FGameplayTag DamageTag = FGameplayTag::RequestGameplayTag("Data.Damage");
-            SpecHandle.Data->SetSetByCallerMagnitude(DamageTag, BaseDamage);
-
-            // Add ranged attack tag
-            SpecHandle.Data->CapturedSourceTags.GetSpecTags().AddTag(
-                FGameplayTag::RequestGameplayTag("Ability.Attack.Ranged"));
-
-            FActiveGameplayEffectHandle GEHandle = 
-                InstigatorASC->ApplyGameplayEffectSpecToTarget(*SpecHandle.Data.Get(), TargetASC);
-
-            if (GEHandle.IsValid())
-            {
-                UE_LOG(LogTemp, Warning, TEXT("✅[ArrowProjectile]  Arrow applied %.1f damage to %s"),
-                    BaseDamage, *Target->GetName());
-            }
-            else
-            {
-                UE_LOG(LogTemp, Error, TEXT("❌[ArrowProjectile]  Failed to apply arrow damage effect"));
-            }
-        }
+        UE_LOG(LogMYYCombat, Verbose, TEXT("✅[ArrowProjectile]  Arrow hit %s for %.1f base damage"),
+            *Target->GetName(), BaseDamage);
     }
     else
     {
-        // Fallback damage application
-        UE_LOG(LogTemp, Warning, TEXT("⚠️ [ArrowProjectile]  No DamageEffect set, using fallback"));
-        TargetASC->ApplyModToAttribute(
-            UAttributeSetBase::GetDamageAttribute(),
-            EGameplayModOp::Additive,
-            BaseDamage
-        );
+        UE_LOG(LogMYYCombat, Warning, TEXT("❌[ArrowProjectile]  Failed to apply arrow damage effect"));
     }
 }
  
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "GameplayEffect.h"
+#include "MYY/AbilitySystem/Combat/DamageSpecCache.h"
 #include "ArrowProjectile.generated.h"
 
 class UNiagaraSystem;
@@ -19,6 +20,10 @@ class MYY_API AArrowProjectile : public AActor
 public:    
 	AArrowProjectile();
 
+#if WITH_EDITOR
+	virtual EDataValidationResult IsDataValid(FDataValidationContext& Context) const override;
+#endif
+
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Projectile")
 	UStaticMeshComponent* ArrowMesh;
 
@@ -28,6 +33,7 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Projectile")
 	UProjectileMovementComponent* ProjectileMovement;
 
+	// UGE_Damage or a child of it, unset means UGE_Damage (anything else fails validation)
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Damage")
 	TSubclassOf<UGameplayEffect> DamageEffect;
 
@@ -42,10 +48,29 @@ public:
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void Tick(float DeltaSeconds) override;
 
 	UFUNCTION()
 	void OnProjectileHit(UPrimitiveComponent* HitComponent, AActor* OtherActor,
 		UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit);
 
+	// Damage, VFX and destroy for the first thing the arrow hits (server)
+	void HandleImpact(AActor* OtherActor, const FHitResult& Hit);
+	bool bHasImpacted = false;
+
+	// ========== LAG COMPENSATION ==========
+
+	// Earliest rewound character hit on From -> To, when the shooter is a remote player
+	bool FindRewoundCharacterHit(const FVector& From, const FVector& To, FHitResult& OutHit);
+
+	// How far behind the server the shooter saw characters, 0 when not rewinding
+	double RewindOffset = 0.0;
+
+	FVector LastTraceLocation = FVector::ZeroVector;
+	TArray<FHitResult> RewindHitScratch;
+
 	void ApplyDamageToTarget(AActor* Target, const FHitResult& HitResult);
+
+	// Built in BeginPlay from the instigator's ASC, so the impact only patches the hit
+	FDamageSpecCache DamageSpecCache;
 };
\ No newline at end of file
@@ -2,13 +2,15 @@
 #include "AnimNotifyState_BlockWindow.h"
 #include "MYY/AbilitySystem/MYYCharacterBase.h"
 #include "AbilitySystemComponent.h"
+#include "Animation/AnimMontage.h"
 #include "GameplayTagContainer.h"
+#include "MYY/AbilitySystem/GameplayTags/MYYGameplayTags.h"
 
 UAnimNotifyState_BlockWindow::UAnimNotifyState_BlockWindow()
 {
     bIsParryWindow = true;
     WindowDuration = 0.3f;
-    BlockWindowTag = FGameplayTag::RequestGameplayTag("State.Combat.BlockWindow");
+    BlockWindowTag = MYYTags::State_Combat_BlockWindow;
 }
 
 void UAnimNotifyState_BlockWindow::NotifyBegin(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, float TotalDuration, const FAnimNotifyEventReference& EventReference)
@@ -20,17 +22,6 @@ void UAnimNotifyState_BlockWindow::NotifyBegin(USkeletalMeshComponent* MeshComp,
     AMYYCharacterBase* Character = Cast<AMYYCharacterBase>(MeshComp->GetOwner());
     if (!Character) return;
 
-    // Set block window flag (replicated)
-    if (Character->HasAuthority())
-    {
-        Character->bIsInBlockWindow = true;
-    }
-    else
-    {
-        // Call server RPC to set flag
-        Character->Server_SetBlockWindow(true);
-    }
-
     // Add gameplay tag for block window
     if (Character->AbilitySystemComponent)
     {
@@ -39,7 +30,7 @@ void UAnimNotifyState_BlockWindow::NotifyBegin(USkeletalMeshComponent* MeshComp,
         
         if (bIsParryWindow)
         {
-            TagContainer.AddTag(FGameplayTag::RequestGameplayTag("State.Combat.ParryWindow"));
+            TagContainer.AddTag(MYYTags::State_Combat_ParryWindow);
         }
 
         Character->AbilitySystemComponent->AddLooseGameplayTags(TagContainer);
@@ -62,16 +53,6 @@ void UAnimNotifyState_BlockWindow::NotifyEnd(USkeletalMeshComponent* MeshComp, U
     AMYYCharacterBase* Character = Cast<AMYYCharacterBase>(MeshComp->GetOwner());
     if (!Character) return;
 
-    // Clear block window flag (replicated)
-    if (Character->HasAuthority())
-    {
-        Character->bIsInBlockWindow = false;
-    }
-    else
-    {
-        Character->Server_SetBlockWindow(false);
-    }
-
     // Remove gameplay tags
     if (Character->AbilitySystemComponent)
     {
@@ -80,7 +61,7 @@ void UAnimNotifyState_BlockWindow::NotifyEnd(USkeletalMeshComponent* MeshComp, U
         
         if (bIsParryWindow)
         {
-            TagContainer.AddTag(FGameplayTag::RequestGameplayTag("State.Combat.ParryWindow"));
+            TagContainer.AddTag(MYYTags::State_Combat_ParryWindow);
         }
 
         Character->AbilitySystemComponent->RemoveLooseGameplayTags(TagContainer);
@@ -92,4 +73,24 @@ void UAnimNotifyState_BlockWindow::NotifyEnd(USkeletalMeshComponent* MeshComp, U
 FString UAnimNotifyState_BlockWindow::GetNotifyName_Implementation() const
 {
     return bIsParryWindow ? TEXT("Parry Window") : TEXT("Block Window");
-}
\ No newline at end of file
+}
+
+bool UAnimNotifyState_BlockWindow::FindWindowRange(const UAnimMontage* Montage, float& OutBegin, float& OutEnd)
+{
+    if (!Montage) return false;
+
+    // Callers compare against wall time since the montage started (GA_Block plays at 1.0),
+    // so the asset's own rate scale stretches the window
+    const float RateScale = Montage->RateScale > UE_KINDA_SMALL_NUMBER ? Montage->RateScale : 1.f;
+
+    for (const FAnimNotifyEvent& Event : Montage->Notifies)
+    {
+        if (Cast<UAnimNotifyState_BlockWindow>(Event.NotifyStateClass))
+        {
+            OutBegin = Event.GetTriggerTime() / RateScale;
+            OutEnd = Event.GetEndTriggerTime() / RateScale;
+            return true;
+        }
+    }
+    return false;
+}
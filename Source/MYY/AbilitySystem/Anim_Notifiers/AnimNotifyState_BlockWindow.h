@@ -8,7 +8,9 @@
 #include "AnimNotifyState_BlockWindow.generated.h"
 /**
  * Manages block/parry timing windows in animations
- * Networked and works for both AI and Players
+ * Networked and works for both AI and Players: the server reads the window's range from the block
+ * montage (FindWindowRange, AMYYCharacterBase::StartBlockWindow) instead of waiting for the notify,
+ * the notify itself only adds the local BlockWindow/ParryWindow tags
  */
 UCLASS()
 class MYY_API UAnimNotifyState_BlockWindow : public UAnimNotifyState
@@ -23,6 +25,10 @@ public:
 
 	virtual FString GetNotifyName_Implementation() const override;
 
+	// Begin/end of the first block window in Montage, in seconds of playback at the montage's
+	// RateScale (play rate 1), false if it has none
+	static bool FindWindowRange(const UAnimMontage* Montage, float& OutBegin, float& OutEnd);
+
 protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Block Window")
 	bool bIsParryWindow = true; // If true, this is a parry window; if false, regular block
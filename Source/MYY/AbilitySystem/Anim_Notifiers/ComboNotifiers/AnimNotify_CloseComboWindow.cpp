@@ -10,8 +10,8 @@ void UAnimNotify_CloseComboWindow::Notify(USkeletalMeshComponent* MeshComp, UAni
 	AMYYCharacterBase* Character = Cast<AMYYCharacterBase>(MeshComp->GetOwner());
 	if (!Character || !Character->GetAbilitySystemComponent()) return;
 
-	// Only execute on server
-	if (!Character->HasAuthority()) return;
+	// Server validates the combo, the owning client predicts it
+	if (!Character->HasAuthority() && !Character->IsLocallyControlled()) return;
 
 	FGameplayAbilitySpec* Spec = Character->GetAbilitySystemComponent()->FindAbilitySpecFromClass(UGA_Meleecombo::StaticClass());
 	if (Spec && Spec->IsActive())
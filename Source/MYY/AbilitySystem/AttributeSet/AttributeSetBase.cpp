@@ -6,6 +6,70 @@
 #include "GameplayEffect.h"
 #include "GameplayEffectExtension.h"
 #include "MYY/AbilitySystem/MYYCharacterBase.h"
+#include "MYY/AbilitySystem/GameplayTags/MYYGameplayTags.h"
+#include "MYY/AbilitySystem/Effects/MYYGameplayEffectContext.h"
+#include "MYY/AbilitySystem/Combat/CombatTelemetry.h"
+#include "MYY/AbilitySystem/Subsystem/TargetSelectionSubsystem.h"
+#include "MYY/Networking/MYYNetStats.h"
+#include "MYY/MYY.h"
+#include "GameFramework/Pawn.h"
+#include "HAL/IConsoleManager.h"
+#include "Net/Core/PushModel/PushModel.h"
+
+static TAutoConsoleVariable<float> CVarAttributesHealthDelta(
+    TEXT("MYY.Net.Attributes.HealthDelta"),
+    0.002f,
+    TEXT("Smallest health change (fraction of max) sent to clients. Reaching 0 or max is always sent."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarAttributesStaminaDelta(
+    TEXT("MYY.Net.Attributes.StaminaDelta"),
+    0.01f,
+    TEXT("Smallest stamina change (fraction of max) sent to the owner. Reaching 0 or max is always sent."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarAttributesCoarseStaminaDelta(
+    TEXT("MYY.Net.Attributes.CoarseStaminaDelta"),
+    0.05f,
+    TEXT("Smallest stamina change (fraction of max) sent to everyone but the owner."),
+    ECVF_Default);
+
+namespace CompactVitalsPrivate
+{
+    // Payload estimates for MYY.Net.Attributes.Dump: a changed property costs its handle plus its value
+    constexpr int32 HandleBits = 8;
+    constexpr int32 FullAttributeBits = HandleBits + 64; // FGameplayAttributeData: Base + Current
+
+    template<typename T>
+    T Quantize(float Value, float Max)
+    {
+        const float Fraction = Max > 0.f ? FMath::Clamp(Value / Max, 0.f, 1.f) : 0.f;
+        return static_cast<T>(FMath::RoundToInt(Fraction * TNumericLimits<T>::Max()));
+    }
+
+    template<typename T>
+    float Dequantize(T Quantized, float Max)
+    {
+        return Max * Quantized / static_cast<float>(TNumericLimits<T>::Max());
+    }
+
+    // Reaching or leaving 0 and max is always sent (deaths, full bars), anything else once it
+    // moved MinDelta of max away from what clients last got
+    template<typename T>
+    bool IsWorthSending(T Old, T New, float MinDelta)
+    {
+        constexpr T Full = TNumericLimits<T>::Max();
+        if (Old == New)
+        {
+            return false;
+        }
+        if (New == 0 || New == Full || Old == 0 || Old == Full)
+        {
+            return true;
+        }
+        return FMath::Abs(static_cast<int32>(New) - static_cast<int32>(Old)) >= MinDelta * Full;
+    }
+}
 
 UAttributeSetBase::UAttributeSetBase()
 {
@@ -24,10 +88,16 @@ void UAttributeSetBase::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& Ou
 {
     Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-    DOREPLIFETIME_CONDITION_NOTIFY(UAttributeSetBase, Health, COND_None, REPNOTIFY_Always);
-    DOREPLIFETIME_CONDITION_NOTIFY(UAttributeSetBase, MaxHealth, COND_None, REPNOTIFY_Always);
-    DOREPLIFETIME_CONDITION_NOTIFY(UAttributeSetBase, Stamina, COND_None, REPNOTIFY_Always);
-    DOREPLIFETIME_CONDITION_NOTIFY(UAttributeSetBase, MaxStamina, COND_None, REPNOTIFY_Always);
+    // Push model: marked dirty in PostAttributeChange / UpdateCompactVitals
+    FDoRepLifetimeParams Params;
+    Params.bIsPushBased = true;
+    Params.RepNotifyCondition = REPNOTIFY_OnChanged;
+    DOREPLIFETIME_WITH_PARAMS_FAST(UAttributeSetBase, MaxHealth, Params);
+    DOREPLIFETIME_WITH_PARAMS_FAST(UAttributeSetBase, MaxStamina, Params);
+    DOREPLIFETIME_WITH_PARAMS_FAST(UAttributeSetBase, Vitals, Params);
+
+    Params.Condition = COND_OwnerOnly;
+    DOREPLIFETIME_WITH_PARAMS_FAST(UAttributeSetBase, OwnerStamina, Params);
 }
 // attribute set manually clamp values before they are set
 void UAttributeSetBase::PreAttributeChange(const FGameplayAttribute& Attribute, float& NewValue)
@@ -44,6 +114,86 @@ void UAttributeSetBase::PreAttributeChange(const FGameplayAttribute& Attribute,
         NewValue = FMath::Clamp(NewValue, 0.f, GetMaxStamina());
     }
 }
+
+void UAttributeSetBase::PostAttributeChange(const FGameplayAttribute& Attribute, float OldValue, float NewValue)
+{
+    Super::PostAttributeChange(Attribute, OldValue, NewValue);
+
+    const AActor* OwningActor = GetOwningActor();
+    if (OldValue == NewValue || !OwningActor || !OwningActor->HasAuthority())
+    {
+        return;
+    }
+
+    int32 MaxBits = 0;
+    if (Attribute == GetMaxHealthAttribute())
+    {
+        MARK_PROPERTY_DIRTY_FROM_NAME(UAttributeSetBase, MaxHealth, this);
+        MYYNetStats::RecordDirtyMark();
+        MaxBits = CompactVitalsPrivate::FullAttributeBits;
+    }
+    else if (Attribute == GetMaxStaminaAttribute())
+    {
+        MARK_PROPERTY_DIRTY_FROM_NAME(UAttributeSetBase, MaxStamina, this);
+        MYYNetStats::RecordDirtyMark();
+        MaxBits = CompactVitalsPrivate::FullAttributeBits;
+    }
+    else if (Attribute != GetHealthAttribute() && Attribute != GetStaminaAttribute())
+    {
+        return;
+    }
+
+    // Vitals are fractions of max, so a max change can move them too
+    UpdateCompactVitals(MaxBits);
+}
+
+void UAttributeSetBase::UpdateCompactVitals(int32 MaxBits)
+{
+    using namespace CompactVitalsPrivate;
+
+    int32 CompactBits = MaxBits;
+    int32 OwnerOnlyBits = 0;
+
+    const uint16 NewHealth = Quantize<uint16>(GetHealth(), GetMaxHealth());
+    const uint8 NewCoarseStamina = Quantize<uint8>(GetStamina(), GetMaxStamina());
+    const uint16 NewOwnerStamina = Quantize<uint16>(GetStamina(), GetMaxStamina());
+
+    bool bVitalsDirty = false;
+    if (IsWorthSending(Vitals.Health, NewHealth, CVarAttributesHealthDelta.GetValueOnGameThread()))
+    {
+        Vitals.Health = NewHealth;
+        bVitalsDirty = true;
+        CompactBits += HandleBits + 16;
+    }
+    if (IsWorthSending(Vitals.CoarseStamina, NewCoarseStamina, CVarAttributesCoarseStaminaDelta.GetValueOnGameThread()))
+    {
+        Vitals.CoarseStamina = NewCoarseStamina;
+        bVitalsDirty = true;
+        CompactBits += HandleBits + 8;
+    }
+    if (bVitalsDirty)
+    {
+        MARK_PROPERTY_DIRTY_FROM_NAME(UAttributeSetBase, Vitals, this);
+        MYYNetStats::RecordDirtyMark();
+    }
+
+    if (IsWorthSending(OwnerStamina, NewOwnerStamina, CVarAttributesStaminaDelta.GetValueOnGameThread()))
+    {
+        OwnerStamina = NewOwnerStamina;
+        MARK_PROPERTY_DIRTY_FROM_NAME(UAttributeSetBase, OwnerStamina, this);
+        MYYNetStats::RecordDirtyMark();
+
+        // Owner-only goes nowhere for AI
+        const APawn* Pawn = Cast<APawn>(GetOwningActor());
+        if (Pawn && Pawn->IsPlayerControlled())
+        {
+            OwnerOnlyBits += HandleBits + 16;
+        }
+    }
+
+    // The full-float path sent one whole attribute to everyone for every change
+    MYYNetStats::RecordAttributeUpdate(FullAttributeBits, CompactBits, OwnerOnlyBits);
+}
   
 
 void UAttributeSetBase::PostGameplayEffectExecute(const FGameplayEffectModCallbackData& Data)
@@ -56,7 +206,35 @@ void UAttributeSetBase::PostGameplayEffectExecute(const FGameplayEffectModCallba
         const float DamageDone = GetDamage();
         SetDamage(0.f);
 
-        UE_LOG(LogTemp, Error, TEXT("🩸 DAMAGE DETECTED: %.1f"), DamageDone);
+        UE_LOG(LogMYYCombat, Verbose, TEXT("🩸 DAMAGE DETECTED: %.1f"), DamageDone);
+
+        // Parried in UMYYDamageExecution: defender parries, attacker staggers, no hit react
+        const FMYYGameplayEffectContext* HitOutcome = FMYYGameplayEffectContext::Get(Data.EffectSpec.GetContext());
+        if (HitOutcome && HitOutcome->IsParried())
+        {
+            AActor* DefenderActor = Data.Target.GetAvatarActor();
+            UAbilitySystemComponent* AttackerASC = Data.EffectSpec.GetContext().GetInstigatorAbilitySystemComponent();
+            AActor* AttackerActor = AttackerASC ? AttackerASC->GetAvatarActor() : nullptr;
+
+            CombatTelemetry::Record(ECombatTelemetryEvent::Parry, AttackerActor, DefenderActor,
+                0.f, 0.f, ECombatTelemetryFlags::Parried);
+
+            FGameplayEventData ParryEventData;
+            ParryEventData.Instigator = AttackerActor;
+            ParryEventData.Target = DefenderActor;
+            Data.Target.HandleGameplayEvent(MYYTags::GameplayEvent_Parry, &ParryEventData);
+
+            if (AttackerASC)
+            {
+                FGameplayEventData StaggerEventData;
+                StaggerEventData.Instigator = DefenderActor;
+                StaggerEventData.Target = AttackerActor;
+                AttackerASC->HandleGameplayEvent(MYYTags::GameplayEvent_Stagger, &StaggerEventData);
+
+                CombatTelemetry::Record(ECombatTelemetryEvent::Stagger, DefenderActor, AttackerActor);
+            }
+            return;
+        }
 
         if (DamageDone > 0.f)
         {
@@ -64,7 +242,7 @@ void UAttributeSetBase::PostGameplayEffectExecute(const FGameplayEffectModCallba
             const float NewHealth = FMath::Max(OldHealth - DamageDone, 0.f);
             SetHealth(NewHealth);
 
-            UE_LOG(LogTemp, Warning, TEXT("Damage Applied: %.1f | Old Health: %.1f | New Health: %.1f"),
+            UE_LOG(LogMYYCombat, Verbose, TEXT("Damage Applied: %.1f | Old Health: %.1f | New Health: %.1f"),
                 DamageDone, OldHealth, NewHealth);
 
             AActor* TargetActor = nullptr;
@@ -84,14 +262,35 @@ void UAttributeSetBase::PostGameplayEffectExecute(const FGameplayEffectModCallba
                     Data.EffectSpec.GetContext().GetInstigatorAbilitySystemComponent()->GetAvatarActor();
             }
 
+            uint8 TelemetryFlags = ECombatTelemetryFlags::None;
+            if (HitOutcome && HitOutcome->IsCriticalHit())
+            {
+                TelemetryFlags |= ECombatTelemetryFlags::Critical;
+            }
+            if (HitOutcome && HitOutcome->IsBlockedHit())
+            {
+                TelemetryFlags |= ECombatTelemetryFlags::Blocked;
+            }
+            CombatTelemetry::Record(
+                (TelemetryFlags & ECombatTelemetryFlags::Blocked) ? ECombatTelemetryEvent::Block : ECombatTelemetryEvent::Hit,
+                SourceActor, TargetActor, DamageDone, NewHealth, TelemetryFlags);
+
+            // Minions weigh who hurt them when picking targets
+            UTargetSelectionSubsystem* TargetSelection = TargetActor && TargetActor->GetWorld()
+                ? TargetActor->GetWorld()->GetSubsystem<UTargetSelectionSubsystem>() : nullptr;
+            if (TargetSelection)
+            {
+                TargetSelection->RecordDamage(TargetActor, SourceActor, DamageDone);
+            }
+
             //---------------------------------------------------------
             //                      HIT REACT
             //---------------------------------------------------------
             if (NewHealth > 0.f) // Still alive
             {
-                UE_LOG(LogTemp, Error, TEXT("🎯 Attempting to trigger HitReact..."));
-                UE_LOG(LogTemp, Error, TEXT("   Target: %s"), *GetNameSafe(TargetActor));
-                UE_LOG(LogTemp, Error, TEXT("   Source: %s"), *GetNameSafe(SourceActor));
+                UE_LOG(LogMYYCombat, Verbose, TEXT("🎯 Attempting to trigger HitReact..."));
+                UE_LOG(LogMYYCombat, Verbose, TEXT("   Target: %s"), *GetNameSafe(TargetActor));
+                UE_LOG(LogMYYCombat, Verbose, TEXT("   Source: %s"), *GetNameSafe(SourceActor));
 
                 UAbilitySystemComponent* TargetASC = nullptr;
                 if (TargetActor)
@@ -118,19 +317,19 @@ void UAttributeSetBase::PostGameplayEffectExecute(const FGameplayEffectModCallba
                     HitReactEventData.EventMagnitude = DamageDone;
 
                     int32 TriggerCount = TargetASC->HandleGameplayEvent(
-                                        FGameplayTag::RequestGameplayTag("GameplayEvent.HitReact"),
+                                        MYYTags::GameplayEvent_HitReact,
                                         &HitReactEventData);
 
                     bool bTriggered = (TriggerCount > 0);
 
-                    UE_LOG(LogTemp, Error,
+                    UE_LOG(LogMYYCombat, Verbose,
                         TEXT("   HitReact Event Triggered: %s"),
                         bTriggered ? TEXT("YES") : TEXT("NO"));
 
                     // ✅ IMPORTANT: Add ability check debugging from old logic
                     if (!bTriggered)
                     {
-                        UE_LOG(LogTemp, Error, TEXT("❌ HitReact event failed. Checking ability..."));
+                        UE_LOG(LogMYYCombat, Warning, TEXT("❌ HitReact event failed. Checking ability..."));
                         
                         // Check if ability exists
                         for (const FGameplayAbilitySpec& Spec : TargetASC->GetActivatableAbilities())
@@ -138,19 +337,19 @@ void UAttributeSetBase::PostGameplayEffectExecute(const FGameplayEffectModCallba
                             FString AbilityName = GetNameSafe(Spec.Ability);
                             if (AbilityName.Contains("HitReact"))
                             {
-                                UE_LOG(LogTemp, Error, TEXT("   Found HitReact ability: %s"), *AbilityName);
+                                UE_LOG(LogMYYCombat, Warning, TEXT("   Found HitReact ability: %s"), *AbilityName);
                             }
                         }
                     }
                     else
                     {
-                        UE_LOG(LogTemp, Warning, TEXT("✅ Triggered HitReact event on %s"),
+                        UE_LOG(LogMYYCombat, Verbose, TEXT("✅ Triggered HitReact event on %s"),
                             *GetNameSafe(TargetActor));
                     }
                 }
                 else
                 {
-                    UE_LOG(LogTemp, Error, TEXT("❌ Failed to get TargetASC for HitReact! TargetActor: %s"),
+                    UE_LOG(LogMYYCombat, Warning, TEXT("❌ Failed to get TargetASC for HitReact! TargetActor: %s"),
                         *GetNameSafe(TargetActor));
                 }
             }
@@ -159,7 +358,7 @@ void UAttributeSetBase::PostGameplayEffectExecute(const FGameplayEffectModCallba
             //---------------------------------------------------------
             else if (NewHealth <= 0.f && OldHealth > 0.f)
             {
-                UE_LOG(LogTemp, Error, TEXT("💀 Character DIED: %s | Killer: %s"),
+                UE_LOG(LogMYYCombat, Log, TEXT("💀 Character DIED: %s | Killer: %s"),
                     *GetNameSafe(TargetActor), *GetNameSafe(SourceActor));
 
                 UAbilitySystemComponent* TargetASC = nullptr;
@@ -188,7 +387,7 @@ void UAttributeSetBase::PostGameplayEffectExecute(const FGameplayEffectModCallba
 
  
                     int32 DeathTriggerCount  = TargetASC->HandleGameplayEvent(
-                            FGameplayTag::RequestGameplayTag("GameplayEvent.Death"),
+                            MYYTags::GameplayEvent_Death,
                             &DeathEventData);
 
                     bool bDeathTriggered  = (DeathTriggerCount  > 0);
@@ -203,25 +402,27 @@ void UAttributeSetBase::PostGameplayEffectExecute(const FGameplayEffectModCallba
 
                     bIsDead = true;
 
+                    CombatTelemetry::Record(ECombatTelemetryEvent::Death, SourceActor, TargetActor, DamageDone);
+
                     if (AMYYCharacterBase* TargetCharacter = Cast<AMYYCharacterBase>(TargetActor))
                     {
                         TargetCharacter->HandleDeath(SourceActor);
                     }
                     
 
-                    UE_LOG(LogTemp, Error,
+                    UE_LOG(LogMYYCombat, Verbose,
                         TEXT("   Death Event Triggered: %s"),
                         bDeathTriggered  ? TEXT("YES") : TEXT("NO"));
 
                     if (bDeathTriggered )
                     {
-                        UE_LOG(LogTemp, Warning, TEXT("✅ Triggered Death event on %s"),
+                        UE_LOG(LogMYYCombat, Verbose, TEXT("✅ Triggered Death event on %s"),
                             *GetNameSafe(TargetActor));
                     }
                 }
                 else
                 {
-                    UE_LOG(LogTemp, Error, TEXT("❌ Failed to get TargetASC for Death event! TargetActor: %s"),
+                    UE_LOG(LogMYYCombat, Warning, TEXT("❌ Failed to get TargetASC for Death event! TargetActor: %s"),
                         *GetNameSafe(TargetActor));
                 }
 
@@ -241,7 +442,7 @@ void UAttributeSetBase::PostGameplayEffectExecute(const FGameplayEffectModCallba
         if (CurrentHealth != ClampedHealth)
         {
             SetHealth(ClampedHealth);
-            UE_LOG(LogTemp, Warning, TEXT("Health clamped: %.1f -> %.1f"), CurrentHealth, ClampedHealth);
+            UE_LOG(LogMYYCombat, Verbose, TEXT("Health clamped: %.1f -> %.1f"), CurrentHealth, ClampedHealth);
         }
     }
     else if (Data.EvaluatedData.Attribute == GetStaminaAttribute())
@@ -256,22 +457,67 @@ void UAttributeSetBase::PostGameplayEffectExecute(const FGameplayEffectModCallba
     }
 }
 
-void UAttributeSetBase::OnRep_Health(const FGameplayAttributeData& OldHealth)
+void UAttributeSetBase::OnRep_Vitals()
+{
+    ApplyCompactHealth();
+
+    // The owner has the finer OwnerStamina
+    if (!IsLocallyOwned())
+    {
+        ApplyCompactStamina();
+    }
+}
+
+void UAttributeSetBase::OnRep_OwnerStamina()
 {
-    GAMEPLAYATTRIBUTE_REPNOTIFY(UAttributeSetBase, Health, OldHealth);
+    ApplyReplicatedValue(Stamina, GetStaminaAttribute(), CompactVitalsPrivate::Dequantize(OwnerStamina, GetMaxStamina()));
 }
 
 void UAttributeSetBase::OnRep_MaxHealth(const FGameplayAttributeData& OldMaxHealth)
 {
     GAMEPLAYATTRIBUTE_REPNOTIFY(UAttributeSetBase, MaxHealth, OldMaxHealth);
-}
 
-void UAttributeSetBase::OnRep_Stamina(const FGameplayAttributeData& OldStamina)
-{
-    GAMEPLAYATTRIBUTE_REPNOTIFY(UAttributeSetBase, Stamina, OldStamina);
+    // Vitals is relative to max and may not have changed with it
+    ApplyCompactHealth();
 }
 
 void UAttributeSetBase::OnRep_MaxStamina(const FGameplayAttributeData& OldMaxStamina)
 {
     GAMEPLAYATTRIBUTE_REPNOTIFY(UAttributeSetBase, MaxStamina, OldMaxStamina);
+    ApplyCompactStamina();
+}
+
+void UAttributeSetBase::ApplyCompactHealth()
+{
+    ApplyReplicatedValue(Health, GetHealthAttribute(), CompactVitalsPrivate::Dequantize(Vitals.Health, GetMaxHealth()));
+}
+
+void UAttributeSetBase::ApplyCompactStamina()
+{
+    const float NewStamina = IsLocallyOwned()
+        ? CompactVitalsPrivate::Dequantize(OwnerStamina, GetMaxStamina())
+        : CompactVitalsPrivate::Dequantize(Vitals.CoarseStamina, GetMaxStamina());
+    ApplyReplicatedValue(Stamina, GetStaminaAttribute(), NewStamina);
+}
+
+void UAttributeSetBase::ApplyReplicatedValue(FGameplayAttributeData& Data, const FGameplayAttribute& Attribute, float NewValue)
+{
+    // Rescaling against an unchanged max lands on the same value: no notify
+    if (FMath::IsNearlyEqual(Data.GetCurrentValue(), NewValue))
+    {
+        return;
+    }
+
+    // A replicated FGameplayAttributeData carries both values, so the full-float path set the base too.
+    // SetBaseAttributeValueFromReplication reads the new base for the aggregator and the change delegates.
+    const FGameplayAttributeData OldData = Data;
+    Data.SetBaseValue(NewValue);
+    Data.SetCurrentValue(NewValue);
+    GetOwningAbilitySystemComponentChecked()->SetBaseAttributeValueFromReplication(Attribute, Data, OldData);
+}
+
+bool UAttributeSetBase::IsLocallyOwned() const
+{
+    const APawn* Pawn = Cast<APawn>(GetOwningActor());
+    return Pawn && Pawn->IsLocallyControlled();
 }
@@ -15,7 +15,30 @@ GAMEPLAYATTRIBUTE_VALUE_SETTER(PropertyName) \
 GAMEPLAYATTRIBUTE_VALUE_INITTER(PropertyName)
 
 /**
- * 
+ * Health and stamina as fractions of their max, sent to every connection in place of the full
+ * attributes. 3 bytes instead of 16 (Base + Current floats for both).
+ */
+USTRUCT()
+struct FMYYCompactVitals
+{
+	GENERATED_BODY()
+
+	// Health / MaxHealth in 1/65535ths
+	UPROPERTY()
+	uint16 Health = MAX_uint16;
+
+	// Stamina / MaxStamina in 1/255ths. Only a bar for others, the owner reads OwnerStamina.
+	UPROPERTY()
+	uint8 CoarseStamina = MAX_uint8;
+};
+
+/**
+ * Health and Stamina are not replicated as attributes. The server quantizes them into Vitals
+ * (everyone) and OwnerStamina (owner only, 16-bit), and only marks them dirty when the change is
+ * worth sending (MYY.Net.Attributes.*Delta, always when reaching 0 or max). Clients write the
+ * decoded values back into the attributes, so the attribute change delegates fire as before.
+ * MaxHealth/MaxStamina still replicate in full, but push model and only when they change.
+ * Modelled bandwidth against the full-float path (an estimate, not a capture): MYY.Net.Attributes.Dump.
  */
 UCLASS()
 class MYY_API UAttributeSetBase : public UAttributeSet
@@ -25,8 +48,8 @@ class MYY_API UAttributeSetBase : public UAttributeSet
 	UAttributeSetBase();
 	
 public:
-	// Health
-	UPROPERTY(BlueprintReadOnly, Category = "Attributes", ReplicatedUsing = OnRep_Health)
+	// Health (replicated through Vitals)
+	UPROPERTY(BlueprintReadOnly, Category = "Attributes")
 	FGameplayAttributeData Health;
 	ATTRIBUTE_ACCESSORS(UAttributeSetBase, Health)
 
@@ -39,8 +62,8 @@ public:
 	FGameplayAttributeData Damage;
 	ATTRIBUTE_ACCESSORS(UAttributeSetBase, Damage)
 
-	// Stamina
-	UPROPERTY(BlueprintReadOnly, Category = "Attributes", ReplicatedUsing = OnRep_Stamina)
+	// Stamina (replicated through OwnerStamina, and Vitals for others)
+	UPROPERTY(BlueprintReadOnly, Category = "Attributes")
 	FGameplayAttributeData Stamina;
 	ATTRIBUTE_ACCESSORS(UAttributeSetBase, Stamina)
 
@@ -52,14 +75,21 @@ public:
 	bool bIsDead = false;
 
 protected:
+	UPROPERTY(ReplicatedUsing = OnRep_Vitals)
+	FMYYCompactVitals Vitals;
+
+	// Stamina / MaxStamina in 1/65535ths, owner only
+	UPROPERTY(ReplicatedUsing = OnRep_OwnerStamina)
+	uint16 OwnerStamina = MAX_uint16;
+
 	UFUNCTION()
-	virtual void OnRep_Health(const FGameplayAttributeData& OldHealth);
+	virtual void OnRep_Vitals();
 
 	UFUNCTION()
-	virtual void OnRep_MaxHealth(const FGameplayAttributeData& OldMaxHealth);
+	virtual void OnRep_OwnerStamina();
 
 	UFUNCTION()
-	virtual void OnRep_Stamina(const FGameplayAttributeData& OldStamina);
+	virtual void OnRep_MaxHealth(const FGameplayAttributeData& OldMaxHealth);
 
 	UFUNCTION()
 	virtual void OnRep_MaxStamina(const FGameplayAttributeData& OldMaxStamina);
@@ -67,7 +97,24 @@ protected:
 
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 	virtual void PreAttributeChange(const FGameplayAttribute& Attribute, float& NewValue) override;
+	virtual void PostAttributeChange(const FGameplayAttribute& Attribute, float OldValue, float NewValue) override;
 	virtual void PostGameplayEffectExecute(const FGameplayEffectModCallbackData& Data) override;
 
+private:
+	// Server. Requantizes Health/Stamina and marks what moved enough to be sent.
+	// MaxBits: a max attribute changed too, for the bandwidth stats.
+	void UpdateCompactVitals(int32 MaxBits);
+
+	// Client. Decodes Vitals/OwnerStamina against the current max values.
+	void ApplyCompactHealth();
+	void ApplyCompactStamina();
+
+	// Client. Writes a replicated value into the attribute's base and current value, as the full-float
+	// FGameplayAttributeData replication did, then notifies like GAMEPLAYATTRIBUTE_REPNOTIFY.
+	void ApplyReplicatedValue(FGameplayAttributeData& Data, const FGameplayAttribute& Attribute, float NewValue);
+
+	// The owning character is controlled on this machine (it reads OwnerStamina, not Vitals)
+	bool IsLocallyOwned() const;
+
 
 };
@@ -10,10 +10,35 @@
 #include "Components/EquipmentComponent.h"
 #include "DataAsset/WeaponTypeDA/RangedWeaponDataAsset.h"
 #include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
 #include "Kismet/GameplayStatics.h"
 #include "MYY/AbilitySystem/MYYCharacterBase.h"
 #include "MYY/AbilitySystem/AttributeSet/AttributeSetBase.h"
 #include "Subsystem/WeaponDataSubsystem.h"
+#include "Subsystem/WeaponTraceSubsystem.h"
+#include "Subsystem/LagCompensationSubsystem.h"
+#include "Combat/WeaponPoseSampler.h"
+#include "Combat/CombatTelemetry.h"
+#include "MYY/MYY.h"
+#include "MYY/Networking/MYYNetStats.h"
+#include "GameplayTags/MYYGameplayTags.h"
+#include "Effects/MYYGameplayEffectContext.h"
+#include "GameFramework/Character.h"
+#include "Animation/AnimInstance.h"
+#include "Animation/AnimMontage.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<float> CVarWeaponTraceSampleRate(
+    TEXT("MYY.WeaponTrace.SampleRate"),
+    60.f,
+    TEXT("Rate (Hz, in montage time) at which the blade pose is sampled during a swing, independent of the server frame rate."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarWeaponTraceMaxSamples(
+    TEXT("MYY.WeaponTrace.MaxSamplesPerStep"),
+    8,
+    TEXT("Upper bound of blade samples per trace step. Longer hitches are covered with wider samples."),
+    ECVF_Default);
 
 ABaseWeapon::ABaseWeapon()
 {
@@ -67,12 +92,15 @@ void ABaseWeapon::DebugWeapon()
     // UE_LOG(LogTemp, Warning, TEXT("bIsProcessingHit: %s"), bIsProcessingHit ? TEXT("True") : TEXT("False"));
     UE_LOG(LogTemp, Warning, TEXT("HitActors Count: %d"), HitActorsThisSwing.Num());
     
-    bool bHasTimer = false;
-    if (GetWorld())
+    bool bIsRegistered = false;
+    if (UWorld* World = GetWorld())
     {
-        bHasTimer = GetWorld()->GetTimerManager().IsTimerActive(TraceTimerHandle);
+        if (UWeaponTraceSubsystem* TraceSubsystem = World->GetSubsystem<UWeaponTraceSubsystem>())
+        {
+            bIsRegistered = TraceSubsystem->IsWeaponRegistered(this);
+        }
     }
-    UE_LOG(LogTemp, Warning, TEXT("Has Timer: %s"), bHasTimer ? TEXT("True") : TEXT("False"));
+    UE_LOG(LogTemp, Warning, TEXT("Trace Registered: %s"), bIsRegistered ? TEXT("True") : TEXT("False"));
     UE_LOG(LogTemp, Warning, TEXT("WeaponData: %s"), WeaponData ? *WeaponData->GetName() : TEXT("None"));
     UE_LOG(LogTemp, Warning, TEXT("==================="));
 }
@@ -93,7 +121,7 @@ void ABaseWeapon::BeginPlay()
             UE_LOG(LogTemp, Error, TEXT("RangeData Not Found"));
             if (CurrentAmmo == 0) // Only initialize if not already set
             {
-                CurrentAmmo = RangedData->AmmoConfig.StartingAmmo;
+                SetCurrentAmmo(RangedData->AmmoConfig.StartingAmmo);
                 UE_LOG(LogTemp, Log, TEXT("Initialized ranged weapon with %d ammo"), CurrentAmmo);
             }
         }
@@ -133,21 +161,114 @@ void ABaseWeapon::BeginPlay()
     
     if (HasAuthority() && WeaponData)
     {
-        WeaponDataID = WeaponData->WeaponID_ReplicateWeapon_DA;   // Send lightweight ID
+        SetWeaponData(WeaponData);   // Send lightweight ID
     }
 
-    
+    // Placed in the level (or spawned loose) and lying on the ground
+    if (HasAuthority() && !GetOwner() && bCanBePickedUp)
+    {
+        SetWeaponDormant(true);
+    }
+}
+
+void ABaseWeapon::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (HasAuthority() && NetDormancy > DORM_Awake)
+    {
+        MYYNetStats::RecordWeaponDormancy(false);
+    }
+
+    Super::EndPlay(EndPlayReason);
 }
 
 void ABaseWeapon::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
     Super::GetLifetimeReplicatedProps(OutLifetimeProps);
-    DOREPLIFETIME(ABaseWeapon, bIsTracing);
-    DOREPLIFETIME(ABaseWeapon, bCanBePickedUp);
-    DOREPLIFETIME(ABaseWeapon, WeaponData);   // PDA is should not replication support
-    DOREPLIFETIME(ABaseWeapon, WeaponDataID);    // Replicate the WeaponDataID instead which is in pda
-    DOREPLIFETIME(ABaseWeapon, CurrentAmmo);  // ✅ NEW LINE
-    
+
+    // All push model: only compared after a setter marked them dirty
+    FDoRepLifetimeParams Params;
+    Params.bIsPushBased = true;
+
+    DOREPLIFETIME_WITH_PARAMS_FAST(ABaseWeapon, bIsTracing, Params);
+    DOREPLIFETIME_WITH_PARAMS_FAST(ABaseWeapon, bCanBePickedUp, Params);
+    DOREPLIFETIME_WITH_PARAMS_FAST(ABaseWeapon, WeaponData, Params);   // PDA is should not replication support
+    DOREPLIFETIME_WITH_PARAMS_FAST(ABaseWeapon, WeaponDataID, Params);    // Replicate the WeaponDataID instead which is in pda
+    DOREPLIFETIME_WITH_PARAMS_FAST(ABaseWeapon, CurrentAmmo, Params);  // ✅ NEW LINE
+}
+
+void ABaseWeapon::PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker)
+{
+    Super::PreReplication(ChangedPropertyTracker);
+
+    // bIsTracing, bCanBePickedUp, WeaponData, WeaponDataID, CurrentAmmo
+    MYYNetStats::RecordPushModelPass(5);
+}
+
+void ABaseWeapon::SetWeaponData(UWeaponDataAsset* NewWeaponData)
+{
+    WeaponData = NewWeaponData;
+    MARK_PROPERTY_DIRTY_FROM_NAME(ABaseWeapon, WeaponData, this);
+
+    const int32 NewWeaponDataID = WeaponData ? WeaponData->WeaponID_ReplicateWeapon_DA : 0;
+    if (WeaponDataID != NewWeaponDataID)
+    {
+        WeaponDataID = NewWeaponDataID;
+        MARK_PROPERTY_DIRTY_FROM_NAME(ABaseWeapon, WeaponDataID, this);
+    }
+
+    OnReplicatedPropertyDirty();
+}
+
+void ABaseWeapon::SetCurrentAmmo(int32 NewAmmo)
+{
+    if (CurrentAmmo == NewAmmo) return;
+
+    CurrentAmmo = NewAmmo;
+    MARK_PROPERTY_DIRTY_FROM_NAME(ABaseWeapon, CurrentAmmo, this);
+    OnReplicatedPropertyDirty();
+}
+
+void ABaseWeapon::SetIsTracing(bool bTracing)
+{
+    if (bIsTracing == bTracing) return;
+
+    bIsTracing = bTracing;
+    MARK_PROPERTY_DIRTY_FROM_NAME(ABaseWeapon, bIsTracing, this);
+    OnReplicatedPropertyDirty();
+}
+
+void ABaseWeapon::SetCanBePickedUp(bool bCanPickUp)
+{
+    if (bCanBePickedUp == bCanPickUp) return;
+
+    bCanBePickedUp = bCanPickUp;
+    MARK_PROPERTY_DIRTY_FROM_NAME(ABaseWeapon, bCanBePickedUp, this);
+    OnReplicatedPropertyDirty();
+}
+
+void ABaseWeapon::OnReplicatedPropertyDirty()
+{
+    if (!HasAuthority()) return;
+
+    MYYNetStats::RecordDirtyMark();
+
+    // Replicates the change once and goes back to sleep
+    if (NetDormancy > DORM_Awake)
+    {
+        FlushNetDormancy();
+    }
+}
+
+void ABaseWeapon::SetWeaponDormant(bool bDormant)
+{
+    if (!HasAuthority() || !GetIsReplicated()) return;
+
+    const bool bWasDormant = NetDormancy > DORM_Awake;
+    if (bWasDormant == bDormant) return;
+
+    // Pending changes still go out before the channel goes dormant
+    SetNetDormancy(bDormant ? DORM_DormantAll : DORM_Awake);
+    MYYNetStats::RecordWeaponDormancy(bDormant);
 }
 
 void ABaseWeapon::OnRep_WeaponDataID()
@@ -166,7 +287,7 @@ void ABaseWeapon::OnRep_WeaponDataID()
 void ABaseWeapon::OnRep_CurrentAmmo()
 {
     // Broadcast to UI that ammo changed
-    UE_LOG(LogTemp, Log, TEXT("Ammo changed: %d"), CurrentAmmo);
+    UE_LOG(LogMYYCombat, Verbose, TEXT("Ammo changed: %d"), CurrentAmmo);
     
     // You can add a delegate broadcast here if needed:
     // OnAmmoChanged.Broadcast(CurrentAmmo, GetMaxAmmo());
@@ -178,8 +299,10 @@ void ABaseWeapon::ConsumeAmmo(int32 Amount)
 {
     if (!HasAuthority()) return;
 
-    CurrentAmmo = FMath::Max(0, CurrentAmmo - Amount);
-    UE_LOG(LogTemp, Log, TEXT("Consumed %d ammo. Remaining: %d"), Amount, CurrentAmmo);
+    SetCurrentAmmo(FMath::Max(0, CurrentAmmo - Amount));
+    UE_LOG(LogMYYCombat, Verbose, TEXT("Consumed %d ammo. Remaining: %d"), Amount, CurrentAmmo);
+
+    CombatTelemetry::Record(ECombatTelemetryEvent::Ammo, GetOwner(), nullptr, CurrentAmmo, Amount);
 }
 
 // 5. NEW: GetMaxAmmo - Get max ammo from weapon data
@@ -198,22 +321,275 @@ void ABaseWeapon::StartTrace()
 {
     if (!HasAuthority()) return;
  
-    bIsTracing = true;
+    SetIsTracing(true);
     ClearHitActors();
     bHasLastPositions = false;
     
-    // Perform trace every 0.01 seconds during active swing
-    GetWorld()->GetTimerManager().SetTimer(TraceTimerHandle, this, 
-        &ABaseWeapon::PerformTrace, 0.01f, true);
+    // Traced by the weapon trace subsystem every tick while the swing is active
+    SetTraceRegistered(true);
 }
 
 void ABaseWeapon::EndTrace()
 {
     if (!HasAuthority()) return;
 
-    bIsTracing = false;
+    SetIsTracing(false);
     bHasLastPositions = false;
-    GetWorld()->GetTimerManager().ClearTimer(TraceTimerHandle);
+    SetTraceRegistered(false);
+}
+
+void ABaseWeapon::SetTraceRegistered(bool bRegistered)
+{
+    UWorld* World = GetWorld();
+    UWeaponTraceSubsystem* TraceSubsystem = World ? World->GetSubsystem<UWeaponTraceSubsystem>() : nullptr;
+    if (!TraceSubsystem) return;
+
+    if (!bRegistered)
+    {
+        TraceSubsystem->UnregisterWeapon(this);
+        CachedInstigatorASC.Reset();
+        DamageSpecCache.Reset();
+        SampledMontage.Reset();
+        SampledTrajectoryTrack = nullptr;
+        bIsSamplingPose = false;
+        return;
+    }
+
+    // Per-swing setup, so the per-step trace only does the sweeps
+    AActor* OwnerActor = GetOwner();
+
+    TraceQueryParams = FCollisionQueryParams(SCENE_QUERY_STAT(MeleeWeaponTrace), false, this);
+    TraceQueryParams.AddIgnoredActor(OwnerActor);
+    TraceQueryParams.bReturnPhysicalMaterial = false;
+
+    CachedInstigatorASC = UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(OwnerActor);
+
+    if (WeaponData && DamageSpecCache.Arm(CachedInstigatorASC.Get(), WeaponData->DamageEffect,
+        this, OwnerActor, MYYTags::Ability_Attack_Melee))
+    {
+        DamageSpecCache.SetSetByCallerMagnitude(MYYTags::Data_CritChance, WeaponData->Stats.CriticalHitChance);
+        DamageSpecCache.SetSetByCallerMagnitude(MYYTags::Data_CritMultiplier, WeaponData->Stats.CriticalHitMultiplier);
+        DamageSpecCache.SetSetByCallerMagnitude(MYYTags::Data_BlockReduction, WeaponData->Stats.BlockDamageReduction);
+    }
+
+    BeginBladeSampling();
+
+    TraceSubsystem->RegisterWeapon(this);
+}
+
+void ABaseWeapon::BeginBladeSampling()
+{
+    bIsSamplingPose = false;
+    SampledMontage.Reset();
+    SampledTrajectoryTrack = nullptr;
+
+    const ACharacter* OwnerCharacter = Cast<ACharacter>(GetOwner());
+    USkeletalMeshComponent* OwnerMesh = OwnerCharacter ? OwnerCharacter->GetMesh() : nullptr;
+    UAnimInstance* AnimInstance = OwnerMesh ? OwnerMesh->GetAnimInstance() : nullptr;
+    UAnimMontage* Montage = AnimInstance ? AnimInstance->GetCurrentActiveMontage() : nullptr;
+
+    if (!Montage || !WeaponData || GetAttachParentActor() != OwnerCharacter)
+    {
+        return;
+    }
+
+    // The trace sockets are rigid relative to the hand socket, whatever the pose
+    const FTransform SocketTransform = OwnerMesh->GetSocketTransform(GetAttachParentSocketName());
+    BladeStartInSocketSpace = SocketTransform.InverseTransformPosition(TraceStartSocket->GetComponentLocation());
+    BladeEndInSocketSpace = SocketTransform.InverseTransformPosition(TraceEndSocket->GetComponentLocation());
+
+    bIsSamplingPose = SwitchSampledMontage(AnimInstance, OwnerMesh, Montage);
+    bHasLastPositions = bIsSamplingPose;
+}
+
+bool ABaseWeapon::SwitchSampledMontage(const UAnimInstance* AnimInstance, const USkeletalMeshComponent* OwnerMesh, UAnimMontage* Montage)
+{
+    SampledMontage = Montage;
+
+    // The slot the anim graph is actually blending in, the first one if none is yet
+    SampledSlotName = NAME_None;
+    for (const FSlotAnimationTrack& Slot : Montage->SlotAnimTracks)
+    {
+        if (AnimInstance->GetSlotNodeGlobalWeight(Slot.SlotName) > 0.f)
+        {
+            SampledSlotName = Slot.SlotName;
+            break;
+        }
+    }
+
+    // Baked tracks are relative to the hand socket they were baked for, and to the first slot
+    const bool bFirstSlot = SampledSlotName.IsNone() || Montage->SlotAnimTracks[0].SlotName == SampledSlotName;
+    SampledTrajectoryTrack = bFirstSlot && GetAttachParentSocketName() == WeaponData->HandSocketName
+        ? WeaponData->FindTrajectoryTrack(Montage)
+        : nullptr;
+
+    LastFrameMontageTime = AnimInstance->Montage_GetPosition(Montage);
+    LastFrameMeshTransform = OwnerMesh->GetComponentTransform();
+
+    // Samples sit on a fixed grid in montage time, so the same swing is always
+    // sampled at the same poses no matter how often the server ticks
+    const float PlayRate = FMath::Max(FMath::Abs(AnimInstance->Montage_GetPlayRate(Montage) * Montage->RateScale), KINDA_SMALL_NUMBER);
+    const float SampleStep = PlayRate / FMath::Max(CVarWeaponTraceSampleRate.GetValueOnGameThread(), 1.f);
+    LastSampleMontageTime = FMath::FloorToFloat(LastFrameMontageTime / SampleStep) * SampleStep;
+
+    return SampleBladeAtMontageTime(LastSampleMontageTime, LastFrameMeshTransform, LastStartPos, LastEndPos);
+}
+
+bool ABaseWeapon::SampleBladeAtMontageTime(float MontageTime, const FTransform& MeshTransform,
+    FVector& OutStart, FVector& OutEnd) const
+{
+    // Baked offline: no bone evaluation at all
+    if (SampledTrajectoryTrack)
+    {
+        FVector TrackStart, TrackEnd;
+        if (SampledTrajectoryTrack->Evaluate(MontageTime, TrackStart, TrackEnd))
+        {
+            OutStart = MeshTransform.TransformPosition(TrackStart);
+            OutEnd = MeshTransform.TransformPosition(TrackEnd);
+            return true;
+        }
+    }
+
+    const ACharacter* OwnerCharacter = Cast<ACharacter>(GetOwner());
+    const USkeletalMeshComponent* OwnerMesh = OwnerCharacter ? OwnerCharacter->GetMesh() : nullptr;
+    if (!OwnerMesh)
+    {
+        return false;
+    }
+
+    FTransform SocketComponentTransform;
+    if (!FWeaponPoseSampler::GetSocketTransformAtMontageTime(OwnerMesh->GetSkeletalMeshAsset(),
+        SampledMontage.Get(), MontageTime, GetAttachParentSocketName(), SocketComponentTransform, SampledSlotName))
+    {
+        return false;
+    }
+
+    const FTransform SocketWorldTransform = SocketComponentTransform * MeshTransform;
+    OutStart = SocketWorldTransform.TransformPosition(BladeStartInSocketSpace);
+    OutEnd = SocketWorldTransform.TransformPosition(BladeEndInSocketSpace);
+    return true;
+}
+
+bool ABaseWeapon::TraceSampledBlade(TArray<FHitResult>& OutHits, int32& OutSweepCount, float StepAlpha)
+{
+    OutSweepCount = 0;
+
+    if (!bIsSamplingPose)
+    {
+        return false;
+    }
+
+    const ACharacter* OwnerCharacter = Cast<ACharacter>(GetOwner());
+    USkeletalMeshComponent* OwnerMesh = OwnerCharacter ? OwnerCharacter->GetMesh() : nullptr;
+    UAnimInstance* AnimInstance = OwnerMesh ? OwnerMesh->GetAnimInstance() : nullptr;
+    UAnimMontage* Montage = SampledMontage.Get();
+
+    UAnimMontage* ActiveMontage = AnimInstance ? AnimInstance->GetCurrentActiveMontage() : nullptr;
+
+    // Montage stopped - the live sockets take over
+    if (!ActiveMontage || !Montage)
+    {
+        bIsSamplingPose = false;
+        return false;
+    }
+
+    // Replaced (next combo step): keep sampling the new montage, bridging from the last blade sample.
+    // The live sockets may be stale here (montage-only server ticking).
+    if (ActiveMontage != Montage)
+    {
+        const FVector FromStart = LastStartPos;
+        const FVector FromEnd = LastEndPos;
+        const bool bHadLastPositions = bHasLastPositions;
+
+        if (!SwitchSampledMontage(AnimInstance, OwnerMesh, ActiveMontage))
+        {
+            bIsSamplingPose = false;
+            return false;
+        }
+
+        if (bHadLastPositions)
+        {
+            OutSweepCount += SweepBladeSegment(FromStart, FromEnd, LastStartPos, LastEndPos, OutHits);
+        }
+        bHasLastPositions = true;
+        return true;
+    }
+
+    const float LiveMontageTime = AnimInstance->Montage_GetPosition(Montage);
+    const FTransform LiveMeshTransform = OwnerMesh->GetComponentTransform();
+
+    const float PlayRate = FMath::Max(FMath::Abs(AnimInstance->Montage_GetPlayRate(Montage) * Montage->RateScale), KINDA_SMALL_NUMBER);
+    const float SampleStep = PlayRate / FMath::Max(CVarWeaponTraceSampleRate.GetValueOnGameThread(), 1.f);
+
+    // Section jump or loop: don't sweep across the discontinuity
+    if (LiveMontageTime < LastFrameMontageTime)
+    {
+        LastFrameMontageTime = LiveMontageTime;
+        LastFrameMeshTransform = LiveMeshTransform;
+        LastSampleMontageTime = FMath::FloorToFloat(LiveMontageTime / SampleStep) * SampleStep;
+        bHasLastPositions = SampleBladeAtMontageTime(LastSampleMontageTime, LiveMeshTransform, LastStartPos, LastEndPos);
+        bIsSamplingPose = bHasLastPositions;
+        return bIsSamplingPose;
+    }
+
+    // Substep: this step ends part of the way to the live pose
+    const float CurrentMontageTime = FMath::Lerp(LastFrameMontageTime, LiveMontageTime, StepAlpha);
+    FTransform CurrentMeshTransform;
+    CurrentMeshTransform.Blend(LastFrameMeshTransform, LiveMeshTransform, StepAlpha);
+
+    int32 NumSamples = FMath::FloorToInt((CurrentMontageTime - LastSampleMontageTime) / SampleStep);
+    float StepThisFrame = SampleStep;
+
+    // Hitch: cover the whole span with wider samples rather than falling behind
+    const int32 MaxSamples = FMath::Max(CVarWeaponTraceMaxSamples.GetValueOnGameThread(), 1);
+    if (NumSamples > MaxSamples)
+    {
+        StepThisFrame = (CurrentMontageTime - LastSampleMontageTime) / MaxSamples;
+        NumSamples = MaxSamples;
+    }
+
+    const float FrameSpan = CurrentMontageTime - LastFrameMontageTime;
+
+    for (int32 SampleIndex = 0; SampleIndex < NumSamples; ++SampleIndex)
+    {
+        const float SampleTime = LastSampleMontageTime + StepThisFrame;
+
+        // The mesh only has transforms for whole frames; place the sample in between.
+        // Root motion montages move the mesh by their own root motion, otherwise interpolate.
+        FTransform SampleMeshTransform;
+        if (Montage->HasRootMotion())
+        {
+            SampleMeshTransform = FWeaponPoseSampler::ExtractRootMotion(Montage, LastFrameMontageTime, SampleTime) * LastFrameMeshTransform;
+        }
+        else
+        {
+            const float Alpha = FrameSpan > KINDA_SMALL_NUMBER
+                ? FMath::Clamp((SampleTime - LastFrameMontageTime) / FrameSpan, 0.f, 1.f)
+                : 1.f;
+            SampleMeshTransform.Blend(LastFrameMeshTransform, CurrentMeshTransform, Alpha);
+        }
+
+        FVector SampleStart, SampleEnd;
+        if (!SampleBladeAtMontageTime(SampleTime, SampleMeshTransform, SampleStart, SampleEnd))
+        {
+            bIsSamplingPose = false;
+            return false;
+        }
+
+        OutSweepCount += SweepBladeSegment(
+            bHasLastPositions ? LastStartPos : SampleStart,
+            bHasLastPositions ? LastEndPos : SampleEnd,
+            SampleStart, SampleEnd, OutHits);
+
+        LastStartPos = SampleStart;
+        LastEndPos = SampleEnd;
+        bHasLastPositions = true;
+        LastSampleMontageTime = SampleTime;
+    }
+
+    LastFrameMontageTime = CurrentMontageTime;
+    LastFrameMeshTransform = CurrentMeshTransform;
+    return true;
 }
 
 void ABaseWeapon::ClearHitActors()
@@ -253,90 +629,72 @@ float ABaseWeapon::CalculateDamage(bool& bOutIsCritical)
 
  
 
-void ABaseWeapon::PerformTrace()
+int32 ABaseWeapon::PerformTrace(TArray<FHitResult>& HitResults, float StepAlpha)
 {
-    if (!bIsTracing || !WeaponData || !HasAuthority()) return;
+    if (!bIsTracing || !WeaponData || !HasAuthority()) return 0;
 
     AActor* OwnerActor = GetOwner();
     if (!OwnerActor) 
     {
-        UE_LOG(LogTemp, Error, TEXT("❌ Weapon has no owner!"));
-        return;
+        UE_LOG(LogMYYCombat, Error, TEXT("❌ Weapon has no owner!"));
+        return 0;
     }
 
-    UAbilitySystemComponent* InstigatorASC = 
-        UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(OwnerActor);
+    UAbilitySystemComponent* InstigatorASC = CachedInstigatorASC.Get();
     
     if (!InstigatorASC)
     {
-        UE_LOG(LogTemp, Warning, TEXT("⚠️ InstigatorASC is null for owner %s. Damage won't be applied, but parry/block may still trigger."), *OwnerActor->GetName());
-        // Don't return - continue for parry/block events
+        UE_LOG(LogMYYCombat, Verbose, TEXT("⚠️ InstigatorASC is null for owner %s. Hits are traced but no damage or parry will be applied."), *OwnerActor->GetName());
+        // Don't return - hit actors and VFX are still tracked
     }
 
     FVector Start = TraceStartSocket->GetComponentLocation();
     FVector End = TraceEndSocket->GetComponentLocation();
 
-    FCollisionQueryParams QueryParams;
-    QueryParams.AddIgnoredActor(this);
-    QueryParams.AddIgnoredActor(OwnerActor);
-    QueryParams.bTraceComplex = false;
-    QueryParams.bReturnPhysicalMaterial = false;
+    // Substep: only part of the way from the last step to the live sockets
+    if (bHasLastPositions && StepAlpha < 1.f)
+    {
+        Start = FMath::Lerp(LastStartPos, Start, StepAlpha);
+        End = FMath::Lerp(LastEndPos, End, StepAlpha);
+    }
 
-    TArray<FHitResult> HitResults;
+    // Each sweep appends, so start from an empty (but already allocated) buffer
+    HitResults.Reset();
 
-    
-    // Line base Trace.
-    // if (bHasLastPositions)
-    // {
-    //     GetWorld()->SweepMultiByChannel(
-    //         HitResults, LastStartPos, Start, FQuat::Identity,
-    //         ECC_Pawn, FCollisionShape::MakeSphere(10.f), QueryParams);
-    //
-    //     GetWorld()->SweepMultiByChannel(
-    //         HitResults, LastEndPos, End, FQuat::Identity,
-    //         ECC_Pawn, FCollisionShape::MakeSphere(10.f), QueryParams);
-    // }
-    //
-    // GetWorld()->LineTraceMultiByChannel(HitResults, Start, End, ECC_Pawn, QueryParams);
-
-    // ✅ Get collision shape from weapon data
-    float TraceRadius = WeaponData->Stats.TraceRadius;
-    float TraceHalfHeight = WeaponData->Stats.TraceHalfHeight;
-    bool bUseCapsule = WeaponData->Stats.bUseCapsuleTrace;
-
-    FCollisionShape CollisionShape = bUseCapsule 
-        ? FCollisionShape::MakeCapsule(TraceRadius, TraceHalfHeight)
-        : FCollisionShape::MakeSphere(TraceRadius);
-
-    if (bHasLastPositions)
-    {
-        // Sweep from last positions to current positions
-        GetWorld()->SweepMultiByChannel( 
-            HitResults, LastStartPos, Start, FQuat::Identity,
-            ECC_Pawn, CollisionShape, QueryParams);
-
-        GetWorld()->SweepMultiByChannel( 
-            HitResults, LastEndPos, End, FQuat::Identity,
-            ECC_Pawn, CollisionShape, QueryParams);
-    }
-
-    // Current frame trace between start and end
-    GetWorld()->SweepMultiByChannel( 
-        HitResults, Start, End, FQuat::Identity,
-        ECC_Pawn, CollisionShape, QueryParams);
+    // Remote players swung at what they saw: test characters where they were back then
+    TraceRewindTime = -1.0;
+    if (const ULagCompensationSubsystem* LagCompensation = GetWorld()->GetSubsystem<ULagCompensationSubsystem>())
+    {
+        if (LagCompensation->ShouldRewindFor(OwnerActor))
+        {
+            TraceRewindTime = LagCompensation->GetAttackerViewTime(OwnerActor);
+        }
+    }
+
+    // Fixed-rate samples of the montage pose since the last step
+    int32 SweepCount = 0;
+    if (!TraceSampledBlade(HitResults, SweepCount, StepAlpha))
+    {
+        // No montage to sample: one step from the last live sockets.
+        // First step of a swing has no previous segment: sweep the blade in place
+        SweepCount += SweepBladeSegment(
+            bHasLastPositions ? LastStartPos : Start,
+            bHasLastPositions ? LastEndPos : End,
+            Start, End, HitResults);
+
+        LastStartPos = Start;
+        LastEndPos = End;
+        bHasLastPositions = true;
+    }
 
     //-------------------------------------------------------
 
-    LastStartPos = Start;
-    LastEndPos = End;
-    bHasLastPositions = true;
+    // One hit per actor before any GAS work
+    FilterUniqueHitActors(HitResults);
 
     for (const FHitResult& Hit : HitResults)
     {
         AActor* HitActor = Hit.GetActor();
-        
-        if (!HitActor || HitActorsThisSwing.Contains(HitActor) || HitActor == OwnerActor) 
-            continue;
 
         UAbilitySystemComponent* TargetASC = 
             UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(HitActor);
@@ -349,112 +707,34 @@ void ABaseWeapon::PerformTrace()
 
         HitActorsThisSwing.Add(HitActor);
 
-        bool bIsCritical = false;
-        float Damage = CalculateDamage(bIsCritical);
-
-        // Check if target is blocking/parrying
-        AMYYCharacterBase* TargetCharacter = Cast<AMYYCharacterBase>(HitActor);
+        // ✅ APPLY DAMAGE USING GAMEPLAY EFFECT
+        // Crit, block, parry and the health clamp all resolve in UMYYDamageExecution
         bool bWasParried = false;
-        
-        if (TargetCharacter && TargetCharacter->bIsInBlockWindow)
+
+        if (InstigatorASC && DamageSpecCache.IsArmed())
         {
-            // Perfect parry - no damage, trigger parry event
-            bWasParried = true;
-            Damage = 0.f;
+            FGameplayEffectContextHandle HitContext;
+            const FActiveGameplayEffectHandle GEHandle =
+                DamageSpecCache.ApplyDamage(TargetASC, WeaponData->Stats.BaseDamage, Hit, &HitContext);
 
-            FGameplayEventData ParryEventData;
-            ParryEventData.Instigator = OwnerActor;
-            ParryEventData.Target = HitActor;
-            TargetASC->HandleGameplayEvent(
-                FGameplayTag::RequestGameplayTag("GameplayEvent.Parry"), &ParryEventData);
+            if (const FMYYGameplayEffectContext* HitOutcome = FMYYGameplayEffectContext::Get(HitContext))
+            {
+                bWasParried = HitOutcome->IsParried();
+            }
 
-            // Stagger attacker
-            if (InstigatorASC)
+            if (!GEHandle.WasSuccessfullyApplied())
             {
-                FGameplayEventData StaggerEventData;
-                StaggerEventData.Instigator = HitActor;
-                StaggerEventData.Target = OwnerActor;
-                InstigatorASC->HandleGameplayEvent(
-                    FGameplayTag::RequestGameplayTag("GameplayEvent.Stagger"), &StaggerEventData);
+                UE_LOG(LogMYYCombat, Warning, TEXT("❌ Failed to apply GameplayEffect to %s (Effect: %s)"),
+                    *HitActor->GetName(), *GetNameSafe(DamageSpecCache.GetEffectDef()));
             }
         }
-        else if (TargetASC->HasMatchingGameplayTag(
-            FGameplayTag::RequestGameplayTag("State.Combat.Blocking")))
+        else if (!InstigatorASC)
         {
-            // Regular block - reduced damage
-            Damage *= (1.0f - WeaponData->Stats.BlockDamageReduction);
+            UE_LOG(LogMYYCombat, Warning, TEXT("❌ Cannot apply damage: InstigatorASC is null"));
         }
-
-        // ✅ APPLY DAMAGE USING GAMEPLAY EFFECT
-        if (!bWasParried && Damage > 0.f)
+        else
         {
-            // ✅ IMPORTANT: Check if InstigatorASC exists before applying damage
-            if (InstigatorASC && WeaponData && WeaponData->DamageEffect)
-            {
-                // Build effect context
-                FGameplayEffectContextHandle EffectContext = InstigatorASC->MakeEffectContext();
-                EffectContext.AddSourceObject(this);
-                EffectContext.AddHitResult(Hit);
-
-                // ✅ IMPORTANT: Controller fallback logic from old version
-                AController* InstigatorController = OwnerActor->GetInstigatorController();
-                if (!InstigatorController)
-                {
-                    if (APawn* OwnerPawn = Cast<APawn>(OwnerActor))
-                    {
-                        InstigatorController = OwnerPawn->GetController();
-                    }
-                }
-
-                EffectContext.AddInstigator(OwnerActor, InstigatorController);
-
-                // Create spec
-                FGameplayEffectSpecHandle SpecHandle =
-                    InstigatorASC->MakeOutgoingSpec(WeaponData->DamageEffect, 1.f, EffectContext);
-
-                if (SpecHandle.IsValid())
-                {
-                    // Damage tag
-                    FGameplayTag DamageTag = FGameplayTag::RequestGameplayTag("Data.Damage");
-                    SpecHandle.Data->SetSetByCallerMagnitude(DamageTag, Damage);
-
-                    // ✅ Add gameplay tags to the effect spec
-                    SpecHandle.Data->CapturedSourceTags.GetSpecTags().AddTag(
-                        FGameplayTag::RequestGameplayTag("Ability.Attack.Melee"));
-                    
-                    // Apply
-                    FActiveGameplayEffectHandle GEHandle =
-                        InstigatorASC->ApplyGameplayEffectSpecToTarget(*SpecHandle.Data.Get(), TargetASC);
-
-                    if (GEHandle.IsValid())
-                    {
-                        UE_LOG(LogTemp, Warning, TEXT("✅ Applied %.1f damage to %s"),
-                            Damage, *HitActor->GetName());
-                    }
-                    else
-                    {
-                        // ✅ IMPORTANT: Better error logging from old logic
-                        UE_LOG(LogTemp, Error, TEXT("❌ Failed to apply GameplayEffect to %s. Checking effect..."),
-                            *HitActor->GetName());
-                        
-                        UE_LOG(LogTemp, Error, TEXT("   Effect Class: %s"), *GetNameSafe(WeaponData->DamageEffect));
-                        UE_LOG(LogTemp, Error, TEXT("   Target ASC: %s"), *TargetASC->GetName());
-                        UE_LOG(LogTemp, Error, TEXT("   Instigator ASC: %s"), *InstigatorASC->GetName());
-                    }
-                }
-                else
-                {
-                    UE_LOG(LogTemp, Error, TEXT("❌ Invalid effect spec for damage effect"));
-                }
-            }
-            else if (!InstigatorASC)
-            {
-                UE_LOG(LogTemp, Error, TEXT("❌ Cannot apply damage: InstigatorASC is null"));
-            }
-            else
-            {
-                UE_LOG(LogTemp, Error, TEXT("❌ WeaponData or DamageEffect is null!"));
-            }
+            UE_LOG(LogMYYCombat, Warning, TEXT("❌ Damage spec was not armed for this swing!"));
         }
 
         // Spawn VFX/SFX
@@ -477,6 +757,11 @@ void ABaseWeapon::PerformTrace()
     #if !UE_BUILD_SHIPPING
         if (WeaponData->bDebugWeaponTrace)
         {
+            // ✅ Get collision shape from weapon data
+            float TraceRadius = WeaponData->Stats.TraceRadius;
+            float TraceHalfHeight = WeaponData->Stats.TraceHalfHeight;
+            bool bUseCapsule = WeaponData->Stats.bUseCapsuleTrace;
+
             // Draw the trace line between sockets
             DrawDebugLine(GetWorld(), Start, End, FColor::Red, false, 0.1f, 0, 2.f);
         
@@ -513,7 +798,189 @@ void ABaseWeapon::PerformTrace()
             }
         }
     #endif
-    
+
+    return SweepCount;
+}
+
+namespace WeaponTraceGeometry
+{
+    struct FSweptCapsule
+    {
+        FVector From;
+        FVector To;
+        FQuat Rotation;
+        float Radius;
+        float HalfHeight;
+    };
+
+    // Smallest capsule aligned to the averaged blade axis that, translated from blade A to
+    // blade B, contains every linearly interpolated blade in between (inflated by BladeRadius)
+    static FSweptCapsule MakeSweptCapsule(const FVector& AStart, const FVector& AEnd,
+        const FVector& BStart, const FVector& BEnd, float BladeRadius, float& OutInflation)
+    {
+        FVector Axis = (AEnd - AStart) + (BEnd - BStart);
+        if (!Axis.Normalize())
+        {
+            Axis = FVector::UpVector;
+        }
+
+        const FVector CenterA = (AStart + AEnd) * 0.5f;
+        const FVector CenterB = (BStart + BEnd) * 0.5f;
+
+        float HalfLength = 0.f;
+        OutInflation = 0.f;
+
+        const FVector Offsets[] = { AStart - CenterA, AEnd - CenterA, BStart - CenterB, BEnd - CenterB };
+        for (const FVector& Offset : Offsets)
+        {
+            const float Along = FVector::DotProduct(Offset, Axis);
+            HalfLength = FMath::Max(HalfLength, FMath::Abs(Along));
+            OutInflation = FMath::Max(OutInflation, (Offset - Along * Axis).Size());
+        }
+
+        FSweptCapsule Capsule;
+        Capsule.From = CenterA;
+        Capsule.To = CenterB;
+        Capsule.Rotation = FRotationMatrix::MakeFromZ(Axis).ToQuat();
+        Capsule.Radius = BladeRadius + OutInflation;
+        Capsule.HalfHeight = HalfLength + Capsule.Radius;
+        return Capsule;
+    }
+}
+
+int32 ABaseWeapon::SweepBladeSegment(const FVector& FromStart, const FVector& FromEnd,
+    const FVector& ToStart, const FVector& ToEnd, TArray<FHitResult>& OutHits)
+{
+    UWorld* World = GetWorld();
+    if (!World || !WeaponData) return 0;
+
+    const FWeaponStats& Stats = WeaponData->Stats;
+    const int32 FirstNewHit = OutHits.Num();
+    int32 SweepCount = 0;
+
+    // SweepMultiByChannel resets its output, so every query goes through the scratch buffer
+    auto SweepAppend = [&](const FVector& From, const FVector& To, const FQuat& Rotation, const FCollisionShape& Shape)
+    {
+        World->SweepMultiByChannel(
+            SweepScratch, From, To, Rotation,
+            ECC_Pawn, Shape, TraceQueryParams);
+        OutHits.Append(SweepScratch);
+        ++SweepCount;
+    };
+
+    if (Stats.TraceMode == EWeaponTraceMode::LegacyTripleSweep)
+    {
+        const FCollisionShape CollisionShape = Stats.bUseCapsuleTrace
+            ? FCollisionShape::MakeCapsule(Stats.TraceRadius, Stats.TraceHalfHeight)
+            : FCollisionShape::MakeSphere(Stats.TraceRadius);
+
+        if (!FromStart.Equals(ToStart) || !FromEnd.Equals(ToEnd))
+        {
+            // Sweep from last positions to current positions
+            SweepAppend(FromStart, ToStart, FQuat::Identity, CollisionShape);
+            SweepAppend(FromEnd, ToEnd, FQuat::Identity, CollisionShape);
+        }
+
+        // Current trace between start and end
+        SweepAppend(ToStart, ToEnd, FQuat::Identity, CollisionShape);
+
+        ResolveRewoundCharacterHits(FirstNewHit, FromStart, FromEnd, ToStart, ToEnd, OutHits);
+        return SweepCount;
+    }
+
+    // Swept blade: one capsule for the whole step, split only when the blade rotated
+    // so much that a single capsule would need more than MaxSweptCapsuleInflation
+    float Inflation = 0.f;
+    WeaponTraceGeometry::MakeSweptCapsule(FromStart, FromEnd, ToStart, ToEnd, Stats.TraceRadius, Inflation);
+
+    const int32 NumCapsules = FMath::Clamp(
+        FMath::CeilToInt(Inflation / FMath::Max(Stats.MaxSweptCapsuleInflation, 1.f)),
+        1, FMath::Max(Stats.MaxSweptCapsules, 1));
+
+    for (int32 Index = 0; Index < NumCapsules; ++Index)
+    {
+        const float AlphaA = static_cast<float>(Index) / NumCapsules;
+        const float AlphaB = static_cast<float>(Index + 1) / NumCapsules;
+
+        const WeaponTraceGeometry::FSweptCapsule Capsule = WeaponTraceGeometry::MakeSweptCapsule(
+            FMath::Lerp(FromStart, ToStart, AlphaA), FMath::Lerp(FromEnd, ToEnd, AlphaA),
+            FMath::Lerp(FromStart, ToStart, AlphaB), FMath::Lerp(FromEnd, ToEnd, AlphaB),
+            Stats.TraceRadius, Inflation);
+
+        SweepAppend(Capsule.From, Capsule.To, Capsule.Rotation,
+            FCollisionShape::MakeCapsule(Capsule.Radius, Capsule.HalfHeight));
+
+#if !UE_BUILD_SHIPPING
+        if (WeaponData->bDebugWeaponTrace)
+        {
+            DrawDebugCapsule(World, Capsule.To, Capsule.HalfHeight, Capsule.Radius,
+                Capsule.Rotation, FColor::Cyan, false, 0.1f, 0, 1.f);
+        }
+#endif
+    }
+
+    ResolveRewoundCharacterHits(FirstNewHit, FromStart, FromEnd, ToStart, ToEnd, OutHits);
+    return SweepCount;
+}
+
+void ABaseWeapon::ResolveRewoundCharacterHits(int32 FirstNewHit, const FVector& FromStart, const FVector& FromEnd,
+    const FVector& ToStart, const FVector& ToEnd, TArray<FHitResult>& OutHits) const
+{
+    if (TraceRewindTime < 0.0) return;
+
+    const ULagCompensationSubsystem* LagCompensation = GetWorld()->GetSubsystem<ULagCompensationSubsystem>();
+    if (!LagCompensation) return;
+
+    // Present-time character hits are replaced; everything else (props, destructibles) stays
+    for (int32 Index = OutHits.Num() - 1; Index >= FirstNewHit; --Index)
+    {
+        if (Cast<AMYYCharacterBase>(OutHits[Index].GetActor()))
+        {
+            OutHits.RemoveAt(Index, 1, EAllowShrinking::No);
+        }
+    }
+
+    LagCompensation->SweepBladeAtTime(TraceRewindTime, FromStart, FromEnd, ToStart, ToEnd,
+        WeaponData->Stats.TraceRadius, GetOwner(), OutHits);
+}
+
+void ABaseWeapon::FilterUniqueHitActors(TArray<FHitResult>& HitResults) const
+{
+    const AActor* OwnerActor = GetOwner();
+    int32 NumUnique = 0;
+
+    for (int32 Index = 0; Index < HitResults.Num(); ++Index)
+    {
+        const AActor* HitActor = HitResults[Index].GetActor();
+        if (!HitActor || HitActor == OwnerActor || HitActorsThisSwing.Contains(HitActor))
+        {
+            continue;
+        }
+
+        // Hits arrive in sweep order, so the first one per actor is the earliest contact
+        bool bAlreadyKept = false;
+        for (int32 KeptIndex = 0; KeptIndex < NumUnique; ++KeptIndex)
+        {
+            if (HitResults[KeptIndex].GetActor() == HitActor)
+            {
+                bAlreadyKept = true;
+                break;
+            }
+        }
+
+        if (bAlreadyKept)
+        {
+            continue;
+        }
+
+        if (Index != NumUnique)
+        {
+            HitResults[NumUnique] = MoveTemp(HitResults[Index]);
+        }
+        ++NumUnique;
+    }
+
+    HitResults.SetNum(NumUnique, EAllowShrinking::No);
 }
 
 void ABaseWeapon::OnInteractionSphereEndOverlap(UPrimitiveComponent* OverlappedComponent,
@@ -611,10 +1078,9 @@ FText ABaseWeapon::GetInteractionPrompt_Implementation() const
 
 void ABaseWeapon::SetPickupEnabled(bool bEnabled)
 {
-    bCanBePickedUp = bEnabled;
+    SetCanBePickedUp(bEnabled);
     InteractionSphere->SetCollisionEnabled(bEnabled ? 
         ECollisionEnabled::QueryOnly : ECollisionEnabled::NoCollision);
-    bCanBePickedUp = bEnabled;
 
     // CRITICAL: Use multicast function to ensure all clients see the change
     if (HasAuthority())
@@ -656,22 +1122,21 @@ void ABaseWeapon::EnableWeaponCollision(bool bForAttack)
     if (bForAttack)
     {
         // For attack tracing - use trace system, NOT overlap events
-        bIsTracing = true;
+        SetIsTracing(true);
         ClearHitActors();
         bHasLastPositions = false;
         
         // CRASH FIX: Don't enable overlap events for attacks
-        // Use timer-based tracing instead
+        // Use the batched trace subsystem instead
         if (HasAuthority())
         {
-            GetWorld()->GetTimerManager().SetTimer(TraceTimerHandle, this, 
-                &ABaseWeapon::PerformTrace, 0.01f, true);
+            SetTraceRegistered(true);
         }
     }
     else
     {
         // For pickup - enable overlap but only for interaction
-        bCanBePickedUp = true;
+        SetCanBePickedUp(true);
         if (InteractionSphere)
         {
             InteractionSphere->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
@@ -683,8 +1148,8 @@ void ABaseWeapon::EnableWeaponCollision(bool bForAttack)
 void ABaseWeapon::DisableWeaponCollision()
 {
     // CRASH FIX: Completely disable all collision and overlap events
-    bIsTracing = false;
-    bCanBePickedUp = false;
+    SetIsTracing(false);
+    SetCanBePickedUp(false);
     
     if (InteractionSphere)
     {
@@ -692,10 +1157,10 @@ void ABaseWeapon::DisableWeaponCollision()
         InteractionSphere->SetGenerateOverlapEvents(false);
     }
     
-    // Clear any active timers
+    // Stop any active trace
     if (HasAuthority())
     {
-        GetWorld()->GetTimerManager().ClearTimer(TraceTimerHandle);
+        SetTraceRegistered(false);
     }
     
     ClearHitActors();
@@ -6,9 +6,15 @@
 #include "GameFramework/Actor.h"
 #include "MYY/AbilitySystem/DataAsset/WeaponDataAsset.h"
 #include "Interface/Interactable.h"
+#include "MYY/AbilitySystem/Combat/DamageSpecCache.h"
 #include "BaseWeapon.generated.h"
 
 class USphereComponent;
+class UAbilitySystemComponent;
+class UWeaponTraceSubsystem;
+class UAnimMontage;
+class UAnimInstance;
+class USkeletalMeshComponent;
 
 UCLASS()
 class MYY_API ABaseWeapon : public AActor, public IInteractable
@@ -62,6 +68,9 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Weapon")
 	UWeaponDataAsset* GetWeaponData() const { return WeaponData; }
 
+	// Server. Sets WeaponData and the WeaponDataID clients resolve it from.
+	void SetWeaponData(UWeaponDataAsset* NewWeaponData);
+
 	// ========== AMMO SYSTEM FOR RANGED WEAPONS ==========
 	
 	UPROPERTY(ReplicatedUsing=OnRep_CurrentAmmo, BlueprintReadOnly, Category = "Ammo")
@@ -79,12 +88,16 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Ammo")
 	int32 GetCurrentAmmo() const { return CurrentAmmo; }
 
+	UFUNCTION(BlueprintCallable, Category = "Ammo")
+	void SetCurrentAmmo(int32 NewAmmo);
+
 	UFUNCTION(BlueprintPure, Category = "Ammo")
 	int32 GetMaxAmmo() const;
 	// ====================================================		
 
-	// Damage calculation with critical hit logic
-	UFUNCTION(BlueprintCallable, Category = "Combat")
+	// Deprecated: crits are rolled in UMYYDamageExecution, this one's roll never reaches the target.
+	// Kept so existing Blueprint calls still load.
+	UFUNCTION(BlueprintCallable, Category = "Combat", meta = (DeprecatedFunction, DeprecationMessage = "Critical hits resolve in UMYYDamageExecution; read the applied damage from the attribute change instead."))
 	float CalculateDamage(bool& bOutIsCritical);
 	
 	// IInteractable interface
@@ -112,29 +125,108 @@ public:
 	void Multicast_SetPickupEnabled(bool bEnabled);
 
 	// Temp for EquipComp & move to protected later------------------
-	UPROPERTY()
-	FTimerHandle TraceTimerHandle;
-
+	// Push model: write through SetIsTracing
 	UPROPERTY(Replicated)
 	bool bIsTracing = false;
 
 	// Temp for EquipComp & move to protected later---------------------
 
-	
+	// Server. Weapons lying loose on the ground are dormant; carried ones (in hand or holstered) and
+	// falling ones are awake. Changing a replicated property on a dormant weapon flushes it once.
+	void SetWeaponDormant(bool bDormant);
+
+	// AActor
+	virtual void PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker) override;
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
-	
+	// Replicated properties are push model (dirty marked); these are the only writers
+	void SetIsTracing(bool bTracing);
+	void SetCanBePickedUp(bool bCanPickUp);
+
+	// Counts the dirty mark and flushes a dormant weapon so the change goes out
+	void OnReplicatedPropertyDirty();
 
 	UPROPERTY(Replicated)
 	bool bCanBePickedUp = true;
 
-	
- 
-	// Main trace function - called repeatedly during attack
-	void PerformTrace();
+	// Traces are driven in one batch by UWeaponTraceSubsystem
+	friend class UWeaponTraceSubsystem;
+
+	// Main trace function - called by the trace subsystem while the weapon is registered.
+	// HitResults is a scratch buffer owned by the caller. Returns the number of sweeps issued.
+	// StepAlpha: share of the motion left since the last step to sweep now (substeps after a hitch).
+	int32 PerformTrace(TArray<FHitResult>& HitResults, float StepAlpha = 1.f);
+
+	// Add/remove this weapon from the batched trace scheduler
+	void SetTraceRegistered(bool bRegistered);
+
+	// Sweeps the area the blade covered moving From -> To and appends the hits. Returns the query count.
+	int32 SweepBladeSegment(const FVector& FromStart, const FVector& FromEnd,
+		const FVector& ToStart, const FVector& ToEnd, TArray<FHitResult>& OutHits);
+
+	// Lag compensation: swaps the character hits appended since FirstNewHit for hits against
+	// the capsules at TraceRewindTime. No-op when the attacker isn't rewound.
+	void ResolveRewoundCharacterHits(int32 FirstNewHit, const FVector& FromStart, const FVector& FromEnd,
+		const FVector& ToStart, const FVector& ToEnd, TArray<FHitResult>& OutHits) const;
+
+	// Server time character hitboxes are tested at for the current step, < 0 for the present
+	double TraceRewindTime = -1.0;
+
+	// Keeps the first hit per actor, dropping the owner and actors already hit this swing
+	void FilterUniqueHitActors(TArray<FHitResult>& HitResults) const;
+
+	// Per-query buffer, appended into the caller's hit array
+	TArray<FHitResult> SweepScratch;
+
+	// ========== FIXED-RATE BLADE SAMPLING ==========
+
+	// Starts sampling the owner's active montage pose for this swing (server)
+	void BeginBladeSampling();
+
+	// Sweeps the blade at every fixed-rate montage sample reached since the last step, up to
+	// StepAlpha of the way to the current montage time.
+	// Returns false when the pose can't be sampled and the live sockets must be used.
+	bool TraceSampledBlade(TArray<FHitResult>& OutHits, int32& OutSweepCount, float StepAlpha);
+
+	// Blade segment in world space for MontageTime, placed with the given mesh transform
+	bool SampleBladeAtMontageTime(float MontageTime, const FTransform& MeshTransform,
+		FVector& OutStart, FVector& OutEnd) const;
+
+	// Samples Montage from its current position on (swing start, next combo step).
+	// The blade sample there goes to LastStartPos/LastEndPos. False if it can't be sampled.
+	bool SwitchSampledMontage(const UAnimInstance* AnimInstance, const USkeletalMeshComponent* OwnerMesh, UAnimMontage* Montage);
+
+	TWeakObjectPtr<UAnimMontage> SampledMontage;
+
+	// Slot track of SampledMontage the owner's anim graph plays
+	FName SampledSlotName;
+	bool bIsSamplingPose = false;
+
+	// Baked blade track for SampledMontage (points into WeaponData), null when the pose is sampled live
+	const FWeaponTrajectoryTrack* SampledTrajectoryTrack = nullptr;
+
+	// Montage time of the last blade sample (always on the fixed-rate grid)
+	float LastSampleMontageTime = 0.f;
+
+	// Montage time and mesh transform when the previous step ran, used to place samples in between
+	float LastFrameMontageTime = 0.f;
+	FTransform LastFrameMeshTransform;
+
+	// Trace sockets relative to the owner mesh socket the weapon is attached to
+	FVector BladeStartInSocketSpace = FVector::ZeroVector;
+	FVector BladeEndInSocketSpace = FVector::ZeroVector;
+
+	// Built once per swing instead of every trace
+	FCollisionQueryParams TraceQueryParams;
+
+	TWeakObjectPtr<UAbilitySystemComponent> CachedInstigatorASC;
+
+	// Damage spec prebuilt for the swing; hits copy it and patch the damage
+	FDamageSpecCache DamageSpecCache;
 
 	UFUNCTION()
 	void OnInteractionSphereEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
@@ -9,13 +9,16 @@
 #include "Components/CapsuleComponent.h"
 #include "MYY/AbilitySystem/BaseWeapon.h"  
 #include "MYY/AbilitySystem/DataAsset/WeaponTypeDA/RangedWeaponDataAsset.h"
+#include "MYY/AbilitySystem/GameplayTags/MYYGameplayTags.h"
 
 
 // Sets default values
 APlayerCharacter::APlayerCharacter()
 {
 	
+	// Camera zoom smoothing ticks every frame (the base class only ticks during unarmed traces)
 	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = true;
 
 	// Camera setup
 	CameraBoom = CreateDefaultSubobject<USpringArmComponent>(TEXT("CameraBoom"));
@@ -280,7 +283,7 @@ void APlayerCharacter::JumpOrVault()
 
 	// Find vault ability
 	FGameplayAbilitySpec* VaultSpec = nullptr;
-	FGameplayTag VaultTag = FGameplayTag::RequestGameplayTag(FName("Ability.Movement.Vault"));
+	FGameplayTag VaultTag = MYYTags::Ability_Movement_Vault;
     
 	for (FGameplayAbilitySpec& Spec : AbilitySystemComponent->GetActivatableAbilities())
 	{
@@ -612,7 +615,7 @@ void APlayerCharacter::Server_FireRangedWeapon_Implementation()
 	EventData.Instigator = this;
     
 	AbilitySystemComponent->HandleGameplayEvent(
-		FGameplayTag::RequestGameplayTag("GameplayEvent.Fire"),
+		MYYTags::GameplayEvent_Fire,
 		&EventData
 	);
 }
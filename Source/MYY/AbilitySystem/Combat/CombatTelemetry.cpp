@@ -0,0 +1,327 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CombatTelemetry.h"
+#include "MYY/MYY.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "HAL/Event.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include <atomic>
+
+DECLARE_CYCLE_STAT(TEXT("Telemetry Flush"), STAT_MYY_TelemetryFlush, STATGROUP_MYYCombat);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Telemetry Records"), STAT_MYY_TelemetryRecords, STATGROUP_MYYCombat);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Telemetry Dropped"), STAT_MYY_TelemetryDropped, STATGROUP_MYYCombat);
+DECLARE_MEMORY_STAT(TEXT("Telemetry Rings"), STAT_MYY_TelemetryMemory, STATGROUP_MYYCombat);
+
+namespace CombatTelemetryPrivate
+{
+	void OnFlushModeChanged(IConsoleVariable* Var);
+}
+
+static TAutoConsoleVariable<int32> CVarTelemetryEnable(
+	TEXT("MYY.Telemetry.Enable"),
+	0,
+	TEXT("1 = record combat events (hit, block, parry, stagger, death, ammo) into the telemetry rings."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarTelemetryFlush(
+	TEXT("MYY.Telemetry.Flush"),
+	0,
+	TEXT("1 = write the telemetry rings to Saved/Telemetry on a background thread.\n")
+	TEXT("0 = keep them in memory until MYY.Telemetry.Dump (full rings drop new records)."),
+	FConsoleVariableDelegate::CreateStatic(&CombatTelemetryPrivate::OnFlushModeChanged),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarTelemetryFlushInterval(
+	TEXT("MYY.Telemetry.FlushInterval"),
+	0.5f,
+	TEXT("Seconds between background telemetry writes."),
+	ECVF_Default);
+
+namespace CombatTelemetryPrivate
+{
+	using namespace CombatTelemetry;
+
+	// Single producer (the owning thread), single consumer (whoever holds RingsLock)
+	struct FRing
+	{
+		FCombatTelemetryRecord Records[RingCapacity];
+		std::atomic<uint32> Head{0};
+		std::atomic<uint32> Tail{0};
+		uint16 Slot = 0;
+
+		bool Push(const FCombatTelemetryRecord& Record)
+		{
+			const uint32 CurrentHead = Head.load(std::memory_order_relaxed);
+			if (CurrentHead - Tail.load(std::memory_order_acquire) >= RingCapacity)
+			{
+				return false;
+			}
+
+			Records[CurrentHead & (RingCapacity - 1)] = Record;
+			Head.store(CurrentHead + 1, std::memory_order_release);
+			return true;
+		}
+
+		void Drain(TArray<FCombatTelemetryRecord>& Out)
+		{
+			const uint32 CurrentTail = Tail.load(std::memory_order_relaxed);
+			const uint32 CurrentHead = Head.load(std::memory_order_acquire);
+			for (uint32 Index = CurrentTail; Index != CurrentHead; ++Index)
+			{
+				Out.Add(Records[Index & (RingCapacity - 1)]);
+			}
+			Tail.store(CurrentHead, std::memory_order_release);
+		}
+	};
+
+	class FWriter : public FRunnable
+	{
+	public:
+		FWriter() : WakeEvent(FPlatformProcess::GetSynchEventFromPool()) {}
+		virtual ~FWriter() override { FPlatformProcess::ReturnSynchEventToPool(WakeEvent); }
+
+		virtual uint32 Run() override
+		{
+			while (!bStopping.load())
+			{
+				WakeEvent->Wait(FTimespan::FromSeconds(FMath::Max(CVarTelemetryFlushInterval.GetValueOnAnyThread(), 0.05f)));
+				Flush();
+			}
+			return 0;
+		}
+
+		virtual void Stop() override
+		{
+			bStopping = true;
+			WakeEvent->Trigger();
+		}
+
+	private:
+		std::atomic<bool> bStopping{false};
+		FEvent* WakeEvent;
+	};
+
+	std::atomic<bool> bRunning{false};
+
+	// Guards ring registration, drains and the file.
+	// Rings live until the process exits: producer threads keep a raw pointer to theirs.
+	FCriticalSection RingsLock;
+	TArray<TUniquePtr<FRing>> Rings;
+	TArray<FCombatTelemetryRecord> DrainScratch;
+
+	TUniquePtr<FArchive> FileWriter;
+	FString FilePath;
+
+	TUniquePtr<FWriter> Writer;
+	FRunnableThread* WriterThread = nullptr;
+
+	thread_local FRing* ThreadRing = nullptr;
+
+	FRing* GetThreadRing()
+	{
+		if (ThreadRing)
+		{
+			return ThreadRing;
+		}
+
+		// First record on this thread
+		FScopeLock Lock(&RingsLock);
+		if (Rings.Num() > MAX_uint16)
+		{
+			return nullptr;
+		}
+
+		FRing* Ring = Rings.Add_GetRef(MakeUnique<FRing>()).Get();
+		Ring->Slot = static_cast<uint16>(Rings.Num() - 1);
+		INC_MEMORY_STAT_BY(STAT_MYY_TelemetryMemory, sizeof(FRing));
+
+		ThreadRing = Ring;
+		return Ring;
+	}
+
+	// Caller holds RingsLock
+	bool OpenFile()
+	{
+		FilePath = FPaths::ProjectSavedDir() / TEXT("Telemetry") /
+			FString::Printf(TEXT("Combat_%s.mct"), *FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S")));
+
+		FileWriter.Reset(IFileManager::Get().CreateFileWriter(*FilePath, FILEWRITE_AllowRead));
+		if (!FileWriter)
+		{
+			UE_LOG(LogMYYCombat, Error, TEXT("❌ Combat telemetry: can't open %s"), *FilePath);
+			return false;
+		}
+
+		FFileHeader Header;
+		Header.StartTicks = FDateTime::UtcNow().GetTicks();
+		FileWriter->Serialize(&Header, sizeof(Header));
+		return true;
+	}
+
+	void StartWriter()
+	{
+		if (WriterThread || !bRunning)
+		{
+			return;
+		}
+
+		Writer = MakeUnique<FWriter>();
+		WriterThread = FRunnableThread::Create(Writer.Get(), TEXT("MYYCombatTelemetry"), 0, TPri_BelowNormal);
+		if (!WriterThread)
+		{
+			Writer.Reset();
+		}
+	}
+
+	void StopWriter()
+	{
+		if (!WriterThread)
+		{
+			return;
+		}
+
+		Writer->Stop();
+		WriterThread->WaitForCompletion();
+		delete WriterThread;
+		WriterThread = nullptr;
+		Writer.Reset();
+	}
+
+	void OnFlushModeChanged(IConsoleVariable* Var)
+	{
+		if (Var->GetInt() != 0)
+		{
+			StartWriter();
+		}
+		else
+		{
+			StopWriter();
+		}
+	}
+}
+
+void CombatTelemetry::Startup()
+{
+	using namespace CombatTelemetryPrivate;
+
+	bRunning = true;
+	if (CVarTelemetryFlush.GetValueOnGameThread() != 0)
+	{
+		StartWriter();
+	}
+}
+
+void CombatTelemetry::Shutdown()
+{
+	using namespace CombatTelemetryPrivate;
+
+	StopWriter();
+	Flush();
+
+	bRunning = false;
+
+	// The rings stay allocated: a thread that passed IsRecording() before this may still be pushing
+	FScopeLock Lock(&RingsLock);
+	DrainScratch.Empty();
+	FileWriter.Reset();
+}
+
+bool CombatTelemetry::IsRecording()
+{
+	return CombatTelemetryPrivate::bRunning.load(std::memory_order_relaxed) && CVarTelemetryEnable.GetValueOnAnyThread() != 0;
+}
+
+void CombatTelemetry::Record(ECombatTelemetryEvent Event, const AActor* Source, const AActor* Target,
+	float Value, float Aux, uint8 Flags)
+{
+	if (!IsRecording())
+	{
+		return;
+	}
+
+	CombatTelemetryPrivate::FRing* Ring = CombatTelemetryPrivate::GetThreadRing();
+	if (!Ring)
+	{
+		return;
+	}
+
+	const AActor* ContextActor = Source ? Source : Target;
+	const UWorld* World = ContextActor ? ContextActor->GetWorld() : nullptr;
+
+	FCombatTelemetryRecord NewRecord;
+	NewRecord.Time = World ? World->GetTimeSeconds() : 0.0;
+	NewRecord.Frame = static_cast<uint32>(GFrameCounter);
+	NewRecord.SourceId = Source ? Source->GetUniqueID() : 0;
+	NewRecord.TargetId = Target ? Target->GetUniqueID() : 0;
+	NewRecord.Value = Value;
+	NewRecord.Aux = Aux;
+	NewRecord.Event = Event;
+	NewRecord.Flags = Flags;
+	NewRecord.ThreadSlot = Ring->Slot;
+
+	if (Ring->Push(NewRecord))
+	{
+		INC_DWORD_STAT(STAT_MYY_TelemetryRecords);
+	}
+	else
+	{
+		INC_DWORD_STAT(STAT_MYY_TelemetryDropped);
+	}
+}
+
+int32 CombatTelemetry::Flush()
+{
+	using namespace CombatTelemetryPrivate;
+
+	SCOPE_CYCLE_COUNTER(STAT_MYY_TelemetryFlush);
+
+	FScopeLock Lock(&RingsLock);
+
+	DrainScratch.Reset();
+	for (const TUniquePtr<FRing>& Ring : Rings)
+	{
+		Ring->Drain(DrainScratch);
+	}
+
+	if (DrainScratch.IsEmpty() || (!FileWriter && !OpenFile()))
+	{
+		return 0;
+	}
+
+	FileWriter->Serialize(DrainScratch.GetData(), DrainScratch.Num() * sizeof(FCombatTelemetryRecord));
+	FileWriter->Flush();
+	return DrainScratch.Num();
+}
+
+const TCHAR* CombatTelemetry::LexToString(ECombatTelemetryEvent Event)
+{
+	switch (Event)
+	{
+	case ECombatTelemetryEvent::Hit:		return TEXT("Hit");
+	case ECombatTelemetryEvent::Block:		return TEXT("Block");
+	case ECombatTelemetryEvent::Parry:		return TEXT("Parry");
+	case ECombatTelemetryEvent::Stagger:	return TEXT("Stagger");
+	case ECombatTelemetryEvent::Death:		return TEXT("Death");
+	case ECombatTelemetryEvent::Ammo:		return TEXT("Ammo");
+	default:								return TEXT("Unknown");
+	}
+}
+
+// MYY.Telemetry.Dump
+// Writes whatever the rings hold right now, for sessions running without the background writer.
+static FAutoConsoleCommand GTelemetryDumpCommand(
+	TEXT("MYY.Telemetry.Dump"),
+	TEXT("Writes the buffered combat telemetry to Saved/Telemetry now."),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		const int32 Written = CombatTelemetry::Flush();
+		UE_LOG(LogTemp, Warning, TEXT("📊 Combat telemetry: wrote %d records to %s"),
+			Written, *CombatTelemetryPrivate::FilePath);
+	}));
@@ -0,0 +1,107 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AActor;
+
+enum class ECombatTelemetryEvent : uint8
+{
+	Hit,
+	Block,
+	Parry,
+	Stagger,
+	Death,
+	Ammo,
+
+	Count
+};
+
+namespace ECombatTelemetryFlags
+{
+	enum : uint8
+	{
+		None		= 0,
+		Critical	= 1 << 0,
+		Blocked		= 1 << 1,
+		Parried		= 1 << 2,
+	};
+}
+
+/**
+ * One combat event. Fixed size and written to the .mct file as-is, so the layout is the file format:
+ * bump CombatTelemetry::FileVersion when it changes.
+ */
+struct FCombatTelemetryRecord
+{
+	// World time (seconds) on the machine that recorded it
+	double Time = 0.0;
+
+	// Low 32 bits of GFrameCounter
+	uint32 Frame = 0;
+
+	// UObject unique ids of the instigator and the target avatar, 0 when there is none
+	uint32 SourceId = 0;
+	uint32 TargetId = 0;
+
+	// Hit/Block: damage dealt, Aux = target health after
+	// Death: killing blow, Stagger/Parry: unused
+	// Ammo: ammo left, Aux = amount consumed
+	float Value = 0.f;
+	float Aux = 0.f;
+
+	ECombatTelemetryEvent Event = ECombatTelemetryEvent::Hit;
+	uint8 Flags = ECombatTelemetryFlags::None;
+
+	// Which per-thread ring the record came from
+	uint16 ThreadSlot = 0;
+};
+
+static_assert(sizeof(FCombatTelemetryRecord) == 32, "FCombatTelemetryRecord is part of the .mct file format");
+
+/**
+ * Binary combat event stream, replacing per-hit log lines on the server.
+ *
+ * Every thread that records gets its own single-producer ring, so Record() never takes a lock.
+ * Rings are drained either by the background writer (MYY.Telemetry.Flush 1) or on demand
+ * (MYY.Telemetry.Dump) into Saved/Telemetry/Combat_<date>.mct: a CombatTelemetry::FFileHeader
+ * followed by raw records. Decode it with -run=CombatTelemetryDecode.
+ */
+namespace CombatTelemetry
+{
+	// 'MYCT'
+	constexpr uint32 FileMagic = 0x5443594D;
+	constexpr uint16 FileVersion = 1;
+
+	// Records per thread ring (power of two). A full ring drops new records and counts them.
+	constexpr uint32 RingCapacity = 4096;
+
+	struct FFileHeader
+	{
+		uint32 Magic = FileMagic;
+		uint16 Version = FileVersion;
+		uint16 RecordSize = sizeof(FCombatTelemetryRecord);
+
+		// FDateTime ticks (UTC) when the file was opened
+		int64 StartTicks = 0;
+	};
+
+	static_assert(sizeof(FFileHeader) == 16, "FFileHeader is part of the .mct file format");
+
+	// Called from the module
+	MYY_API void Startup();
+	MYY_API void Shutdown();
+
+	// MYY.Telemetry.Enable
+	MYY_API bool IsRecording();
+
+	// Safe from any thread. No-op while recording is off.
+	MYY_API void Record(ECombatTelemetryEvent Event, const AActor* Source, const AActor* Target,
+		float Value = 0.f, float Aux = 0.f, uint8 Flags = ECombatTelemetryFlags::None);
+
+	// Drains every ring into the current file now. Returns the number of records written.
+	MYY_API int32 Flush();
+
+	MYY_API const TCHAR* LexToString(ECombatTelemetryEvent Event);
+}
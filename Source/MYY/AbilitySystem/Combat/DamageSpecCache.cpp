@@ -0,0 +1,205 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "DamageSpecCache.h"
+#include "MYY/MYY.h"
+#include "AbilitySystemComponent.h"
+#include "AbilitySystemBlueprintLibrary.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "MYY/AbilitySystem/GameplayTags/MYYGameplayTags.h"
+#include "MYY/AbilitySystem/Effects/GE_Damage.h"
+
+DECLARE_CYCLE_STAT(TEXT("Damage Spec Arm"), STAT_MYY_DamageSpecArm, STATGROUP_MYYCombat);
+DECLARE_CYCLE_STAT(TEXT("Damage Spec Per Hit"), STAT_MYY_DamageSpecHit, STATGROUP_MYYCombat);
+
+namespace DamageSpecCacheUtils
+{
+	AController* ResolveInstigatorController(AActor* InstigatorActor)
+	{
+		if (!InstigatorActor)
+		{
+			return nullptr;
+		}
+
+		AController* InstigatorController = InstigatorActor->GetInstigatorController();
+		if (!InstigatorController)
+		{
+			if (APawn* InstigatorPawn = Cast<APawn>(InstigatorActor))
+			{
+				InstigatorController = InstigatorPawn->GetController();
+			}
+		}
+
+		return InstigatorController;
+	}
+}
+
+bool FDamageSpecCache::Arm(UAbilitySystemComponent* InInstigatorASC, TSubclassOf<UGameplayEffect> DamageEffect,
+	UObject* SourceObject, AActor* InstigatorActor, FGameplayTag AttackTag)
+{
+	SCOPE_CYCLE_COUNTER(STAT_MYY_DamageSpecArm);
+
+	Reset();
+
+	if (!InInstigatorASC)
+	{
+		return false;
+	}
+
+	// One damage path for every attack: the execution does crit, block, parry and clamping.
+	// Data validation rejects anything else, so this only guards assets that skipped it.
+	if (!IsValidDamageEffect(DamageEffect))
+	{
+		static TSet<FName> ReportedEffects;
+		bool bAlreadyReported = false;
+		ReportedEffects.Add(DamageEffect->GetFName(), &bAlreadyReported);
+		UE_CLOG(!bAlreadyReported, LogMYYCombat, Warning, TEXT("%s is not a UGE_Damage effect, using UGE_Damage (first seen on %s)"),
+			*GetNameSafe(DamageEffect), *GetNameSafe(SourceObject));
+		DamageEffect = nullptr;
+	}
+	if (!DamageEffect)
+	{
+		DamageEffect = UGE_Damage::StaticClass();
+	}
+
+	FGameplayEffectContextHandle EffectContext = InInstigatorASC->MakeEffectContext();
+	EffectContext.AddSourceObject(SourceObject);
+	EffectContext.AddInstigator(InstigatorActor, DamageSpecCacheUtils::ResolveInstigatorController(InstigatorActor));
+
+	FGameplayEffectSpecHandle SpecHandle = InInstigatorASC->MakeOutgoingSpec(DamageEffect, 1.f, EffectContext);
+	if (!SpecHandle.IsValid())
+	{
+		return false;
+	}
+
+	// Magnitude slot exists up front; hits only overwrite the value
+	SpecHandle.Data->SetSetByCallerMagnitude(MYYTags::Data_Damage, 0.f);
+
+	if (AttackTag.IsValid())
+	{
+		SpecHandle.Data->CapturedSourceTags.GetSpecTags().AddTag(AttackTag);
+	}
+
+	InstigatorASC = InInstigatorASC;
+	PrototypeSpec = SpecHandle;
+	return true;
+}
+
+bool FDamageSpecCache::IsValidDamageEffect(TSubclassOf<UGameplayEffect> DamageEffect)
+{
+	return !DamageEffect || DamageEffect->IsChildOf(UGE_Damage::StaticClass());
+}
+
+void FDamageSpecCache::Reset()
+{
+	InstigatorASC.Reset();
+	PrototypeSpec.Clear();
+}
+
+void FDamageSpecCache::SetSetByCallerMagnitude(FGameplayTag DataTag, float Magnitude)
+{
+	if (PrototypeSpec.IsValid())
+	{
+		PrototypeSpec.Data->SetSetByCallerMagnitude(DataTag, Magnitude);
+	}
+}
+
+FGameplayEffectSpec FDamageSpecCache::MakeHitSpec(float Damage, const FHitResult& Hit) const
+{
+	check(PrototypeSpec.IsValid());
+
+	FGameplayEffectSpec HitSpec(*PrototypeSpec.Data);
+
+	// The context is shared by pointer, so each hit needs its own before adding the hit result
+	FGameplayEffectContextHandle HitContext = PrototypeSpec.Data->GetEffectContext().Duplicate();
+	HitContext.AddHitResult(Hit, true);
+	HitSpec.SetContext(HitContext, true);
+
+	HitSpec.SetSetByCallerMagnitude(MYYTags::Data_Damage, Damage);
+	return HitSpec;
+}
+
+FActiveGameplayEffectHandle FDamageSpecCache::ApplyDamage(UAbilitySystemComponent* TargetASC, float Damage, const FHitResult& Hit,
+	FGameplayEffectContextHandle* OutHitContext) const
+{
+	UAbilitySystemComponent* SourceASC = InstigatorASC.Get();
+	if (!SourceASC || !TargetASC || !PrototypeSpec.IsValid())
+	{
+		return FActiveGameplayEffectHandle();
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_MYY_DamageSpecHit);
+
+	const FGameplayEffectSpec HitSpec = MakeHitSpec(Damage, Hit);
+	if (OutHitContext)
+	{
+		*OutHitContext = HitSpec.GetEffectContext();
+	}
+
+	return SourceASC->ApplyGameplayEffectSpecToTarget(HitSpec, TargetASC);
+}
+
+// ========== BENCHMARK ==========
+
+#if !UE_BUILD_SHIPPING
+// MYY.Combat.BenchDamageSpec [Iterations]
+// Builds per-hit damage specs for the local player's pawn both ways and logs the cost per hit.
+// Nothing is applied, so it's safe to run in a live session.
+static FAutoConsoleCommandWithWorldAndArgs GBenchDamageSpecCommand(
+	TEXT("MYY.Combat.BenchDamageSpec"),
+	TEXT("Compares building a damage spec per hit against copying a cached one. Usage: MYY.Combat.BenchDamageSpec [Iterations]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		APlayerController* PlayerController = World ? World->GetFirstPlayerController() : nullptr;
+		APawn* Pawn = PlayerController ? PlayerController->GetPawn() : nullptr;
+		UAbilitySystemComponent* ASC = UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(Pawn);
+		if (!ASC)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("⚠️ BenchDamageSpec: local pawn has no ASC"));
+			return;
+		}
+
+		const int32 Iterations = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 10000;
+		const TSubclassOf<UGameplayEffect> EffectClass = UGE_Damage::StaticClass();
+
+		FHitResult Hit(Pawn, nullptr, Pawn->GetActorLocation(), FVector::UpVector);
+		float Checksum = 0.f;
+
+		// Before: what every hit used to do
+		const double UncachedStart = FPlatformTime::Seconds();
+		for (int32 Index = 0; Index < Iterations; ++Index)
+		{
+			FGameplayEffectContextHandle Context = ASC->MakeEffectContext();
+			Context.AddSourceObject(Pawn);
+			Context.AddHitResult(Hit);
+			Context.AddInstigator(Pawn, DamageSpecCacheUtils::ResolveInstigatorController(Pawn));
+
+			FGameplayEffectSpecHandle Spec = ASC->MakeOutgoingSpec(EffectClass, 1.f, Context);
+			Spec.Data->SetSetByCallerMagnitude(FGameplayTag::RequestGameplayTag("Data.Damage"), Index);
+			Spec.Data->CapturedSourceTags.GetSpecTags().AddTag(
+				FGameplayTag::RequestGameplayTag("Ability.Attack.Melee"));
+
+			Checksum += Spec.Data->GetSetByCallerMagnitude(MYYTags::Data_Damage, false);
+		}
+		const double UncachedSeconds = FPlatformTime::Seconds() - UncachedStart;
+
+		// After: arm once, copy and patch per hit
+		const double CachedStart = FPlatformTime::Seconds();
+		FDamageSpecCache Cache;
+		Cache.Arm(ASC, EffectClass, Pawn, Pawn, MYYTags::Ability_Attack_Melee);
+		for (int32 Index = 0; Index < Iterations; ++Index)
+		{
+			const FGameplayEffectSpec Spec = Cache.MakeHitSpec(Index, Hit);
+			Checksum -= Spec.GetSetByCallerMagnitude(MYYTags::Data_Damage, false);
+		}
+		const double CachedSeconds = FPlatformTime::Seconds() - CachedStart;
+
+		UE_LOG(LogTemp, Warning, TEXT("📊 BenchDamageSpec x%d: per-hit build %.3f us | cached copy %.3f us | speedup %.2fx (checksum %.1f)"),
+			Iterations,
+			UncachedSeconds * 1.0e6 / Iterations,
+			CachedSeconds * 1.0e6 / Iterations,
+			CachedSeconds > 0.0 ? UncachedSeconds / CachedSeconds : 0.0,
+			Checksum);
+	}));
+#endif
@@ -0,0 +1,49 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayEffect.h"
+#include "GameplayTagContainer.h"
+
+class UAbilitySystemComponent;
+
+/**
+ * One outgoing damage spec built when a swing (or projectile) is armed.
+ * The effect is always UGE_Damage (or a Blueprint child), so every hit resolves in UMYYDamageExecution.
+ *
+ * The context, instigator, level and source tags are resolved once in Arm(). Every hit then
+ * copies the prototype, gives the copy its own context with the hit result and patches the
+ * Data.Damage SetByCaller magnitude, instead of going through MakeEffectContext/MakeOutgoingSpec.
+ */
+struct MYY_API FDamageSpecCache
+{
+	// Builds the prototype spec. Returns false (and stays unarmed) if the ASC is missing.
+	// DamageEffect falls back to UGE_Damage when it's unset or not a UGE_Damage class (see IsValidDamageEffect).
+	bool Arm(UAbilitySystemComponent* InInstigatorASC, TSubclassOf<UGameplayEffect> DamageEffect,
+		UObject* SourceObject, AActor* InstigatorActor, FGameplayTag AttackTag);
+
+	void Reset();
+
+	// Unset or UGE_Damage (or a Blueprint child). Assets holding anything else fail data validation.
+	static bool IsValidDamageEffect(TSubclassOf<UGameplayEffect> DamageEffect);
+
+	// Per-swing SetByCaller values (crit, block reduction) written into the prototype once
+	void SetSetByCallerMagnitude(FGameplayTag DataTag, float Magnitude);
+
+	bool IsArmed() const { return PrototypeSpec.IsValid() && InstigatorASC.IsValid(); }
+
+	// Per-hit copy of the prototype with its own context. Requires IsArmed().
+	FGameplayEffectSpec MakeHitSpec(float Damage, const FHitResult& Hit) const;
+
+	// Applies MakeHitSpec(Damage, Hit) from the instigator to TargetASC.
+	// OutHitContext receives the hit's context, which holds the outcome (see FMYYGameplayEffectContext).
+	FActiveGameplayEffectHandle ApplyDamage(UAbilitySystemComponent* TargetASC, float Damage, const FHitResult& Hit,
+		FGameplayEffectContextHandle* OutHitContext = nullptr) const;
+
+	const UGameplayEffect* GetEffectDef() const { return PrototypeSpec.IsValid() ? PrototypeSpec.Data->Def.Get() : nullptr; }
+
+private:
+	TWeakObjectPtr<UAbilitySystemComponent> InstigatorASC;
+	FGameplayEffectSpecHandle PrototypeSpec;
+};
@@ -0,0 +1,102 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "WeaponPoseSampler.h"
+#include "Animation/AnimMontage.h"
+#include "Animation/AnimSequence.h"
+#include "Animation/Skeleton.h"
+#include "Engine/SkeletalMesh.h"
+#include "Engine/SkeletalMeshSocket.h"
+
+bool FWeaponPoseSampler::GetSocketTransformAtMontageTime(const USkeletalMesh* Mesh, const UAnimMontage* Montage,
+	float MontageTime, FName SocketOrBoneName, FTransform& OutComponentTransform, FName SlotName)
+{
+	if (!Mesh || !Montage || Montage->SlotAnimTracks.Num() == 0)
+	{
+		return false;
+	}
+
+	const USkeleton* Skeleton = Mesh->GetSkeleton();
+	if (!Skeleton)
+	{
+		return false;
+	}
+
+	// Sockets are a fixed offset from their bone
+	FName BoneName = SocketOrBoneName;
+	FTransform ComponentTransform = FTransform::Identity;
+	if (const USkeletalMeshSocket* Socket = Mesh->FindSocket(SocketOrBoneName))
+	{
+		BoneName = Socket->BoneName;
+		ComponentTransform = Socket->GetSocketLocalTransform();
+	}
+
+	const FReferenceSkeleton& RefSkeleton = Mesh->GetRefSkeleton();
+	int32 MeshBoneIndex = RefSkeleton.FindBoneIndex(BoneName);
+	if (MeshBoneIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	const FSlotAnimationTrack* SlotTrack = Montage->SlotAnimTracks.FindByPredicate([SlotName](const FSlotAnimationTrack& Slot)
+	{
+		return Slot.SlotName == SlotName;
+	});
+	const FAnimTrack& Track = (SlotTrack ? *SlotTrack : Montage->SlotAnimTracks[0]).AnimTrack;
+	const FAnimSegment* Segment = Track.GetSegmentAtTime(MontageTime);
+	if (!Segment)
+	{
+		return false;
+	}
+
+	float AnimTime = 0.f;
+	const UAnimSequence* Sequence = Cast<UAnimSequence>(Segment->GetAnimationData(MontageTime, AnimTime));
+	if (!Sequence || Sequence->IsValidAdditive())
+	{
+		return false;
+	}
+
+	// Root motion is taken out of the pose and moves the capsule instead; lock the root like the live pose
+	const bool bLockRoot = Sequence->HasRootMotion();
+
+	// Walk up to the root composing local bone transforms; bones the sequence
+	// doesn't know about keep their reference pose
+	const TArray<FTransform>& RefBonePose = RefSkeleton.GetRefBonePose();
+	while (MeshBoneIndex != INDEX_NONE)
+	{
+		FTransform BoneLocal = RefBonePose[MeshBoneIndex];
+
+		const int32 SkeletonBoneIndex = Skeleton->GetSkeletonBoneIndexFromMeshBoneIndex(Mesh, MeshBoneIndex);
+		const bool bIsRoot = RefSkeleton.GetParentIndex(MeshBoneIndex) == INDEX_NONE;
+		if (bIsRoot && bLockRoot)
+		{
+			if (Sequence->RootMotionRootLock == ERootMotionRootLock::AnimFirstFrame && SkeletonBoneIndex != INDEX_NONE)
+			{
+				Sequence->GetBoneTransform(BoneLocal, FSkeletonPoseBoneIndex(SkeletonBoneIndex), 0.0, false);
+			}
+			else if (Sequence->RootMotionRootLock == ERootMotionRootLock::Zero)
+			{
+				BoneLocal = FTransform::Identity;
+			}
+		}
+		else if (SkeletonBoneIndex != INDEX_NONE)
+		{
+			Sequence->GetBoneTransform(BoneLocal, FSkeletonPoseBoneIndex(SkeletonBoneIndex), AnimTime, false);
+		}
+
+		ComponentTransform = ComponentTransform * BoneLocal;
+		MeshBoneIndex = RefSkeleton.GetParentIndex(MeshBoneIndex);
+	}
+
+	OutComponentTransform = ComponentTransform;
+	return true;
+}
+
+FTransform FWeaponPoseSampler::ExtractRootMotion(const UAnimMontage* Montage, float FromTime, float ToTime)
+{
+	if (!Montage || !Montage->HasRootMotion() || ToTime <= FromTime)
+	{
+		return FTransform::Identity;
+	}
+
+	return Montage->ExtractRootMotionFromTrackRange(FromTime, ToTime, FAnimExtractContext());
+}
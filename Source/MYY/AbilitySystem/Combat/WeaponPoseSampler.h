@@ -0,0 +1,29 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class USkeletalMesh;
+class UAnimMontage;
+
+/**
+ * Evaluates a socket (or bone) of a skeletal mesh at an arbitrary montage time,
+ * straight from the animation data and without ticking the mesh.
+ *
+ * One slot track of the montage is sampled (the one the anim graph plays, or the first).
+ * A root motion sequence has its root locked the way the live pose does; the motion itself
+ * moves the mesh, see ExtractRootMotion. Montage blend in/out against the base pose is
+ * ignored and additive segments can't be sampled, which is what the attack montages need
+ * for blade hit detection.
+ */
+struct MYY_API FWeaponPoseSampler
+{
+	// Component-space transform of SocketOrBoneName at MontageTime. False if the montage can't be sampled.
+	// SlotName: slot track to sample, NAME_None (or not in the montage) for the first one.
+	static bool GetSocketTransformAtMontageTime(const USkeletalMesh* Mesh, const UAnimMontage* Montage,
+		float MontageTime, FName SocketOrBoneName, FTransform& OutComponentTransform, FName SlotName = NAME_None);
+
+	// Mesh-space root motion of Montage between two montage times, identity without root motion
+	static FTransform ExtractRootMotion(const UAnimMontage* Montage, float FromTime, float ToTime);
+};
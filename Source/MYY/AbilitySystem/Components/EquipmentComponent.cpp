@@ -2,6 +2,7 @@
 #include "MYY/AbilitySystem/MYYCharacterBase.h"
 #include "MYY/AbilitySystem/BaseWeapon.h"
 #include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
 #include "AbilitySystemComponent.h"
 #include "Animation/AnimInstance.h"
 #include "Animation/AnimLayerInterface.h"
@@ -9,6 +10,8 @@
 #include "Kismet/GameplayStatics.h"
 #include "MYY/AbilitySystem/DataAsset/WeaponTypeDA/RangedWeaponDataAsset.h"
 #include "MYY/AbilitySystem/Interface/AnimLayerInterface/AnimationLayerInterface.h"
+#include "MYY/Networking/MYYNetStats.h"
+#include "MYY/Networking/MYYReplicationGraph.h"
 
 UEquipmentComponent::UEquipmentComponent()
 {
@@ -49,8 +52,21 @@ void UEquipmentComponent::BeginPlay()
 void UEquipmentComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
     Super::GetLifetimeReplicatedProps(OutLifetimeProps);
-    DOREPLIFETIME(UEquipmentComponent, PrimarySlot);
-    DOREPLIFETIME(UEquipmentComponent, SecondarySlot);
+
+    // Push model, marked dirty by UpdateWeaponReplication
+    FDoRepLifetimeParams Params;
+    Params.bIsPushBased = true;
+
+    DOREPLIFETIME_WITH_PARAMS_FAST(UEquipmentComponent, PrimarySlot, Params);
+    DOREPLIFETIME_WITH_PARAMS_FAST(UEquipmentComponent, SecondarySlot, Params);
+}
+
+void UEquipmentComponent::PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker)
+{
+    Super::PreReplication(ChangedPropertyTracker);
+
+    // PrimarySlot, SecondarySlot
+    MYYNetStats::RecordPushModelPass(2);
 }
 
 // ========== NEW: GET ACTIVE WEAPON DATA ==========
@@ -94,6 +110,36 @@ void UEquipmentComponent::SwitchToUnarmedCombat()
     ApplyWeaponAnimLayers(DefaultUnarmedData); 
 }
 
+void UEquipmentComponent::ResetLoadout()
+{
+    if (!OwnerCharacter || !GetOwner()->HasAuthority()) return;
+
+    StopAllWeaponTraces();
+
+    for (FWeaponSlotData* SlotData : { &PrimarySlot, &SecondarySlot })
+    {
+        if (SlotData->Weapon)
+        {
+            RemoveWeaponAbilities(SlotData->WeaponDataAsset);
+            SlotData->Weapon->Destroy();
+        }
+
+        *SlotData = FWeaponSlotData();
+    }
+
+    UpdateWeaponReplication();
+
+    // Same as BeginPlay
+    if (DefaultWeaponData)
+    {
+        EquipDefaultWeapon();
+    }
+    else if (DefaultUnarmedData)
+    {
+        SwitchToUnarmedCombat();
+    }
+}
+
 void UEquipmentComponent::DropAllWeapons()
 {
     if (!OwnerCharacter) return;
@@ -174,6 +220,7 @@ void UEquipmentComponent::Server_DropAllWeapons_Implementation()
         
         Weapon->SetActorLocation(DropLocation);
         Weapon->SetActorRotation(DropRotation);
+        ReleaseWeaponReplication(Weapon);
 
         UE_LOG(LogTemp, Log, TEXT("    ✅ Dropped at: %s"), *DropLocation.ToString());
     }
@@ -195,6 +242,8 @@ void UEquipmentComponent::Server_DropAllWeapons_Implementation()
         SecondarySlot.bIsOccupied = false;
     }
 
+    UpdateWeaponReplication();
+
     if (!GetCurrentWeapon())
     {
         SwitchToUnarmedCombat();
@@ -267,7 +316,7 @@ void UEquipmentComponent::EquipDefaultWeapon()
 
         if (DefaultWeapon)
         {
-            DefaultWeapon->WeaponData = DefaultWeaponData;
+            DefaultWeapon->SetWeaponData(DefaultWeaponData);
             
             // ✅ Double-check owner is set
             if (!DefaultWeapon->GetOwner())
@@ -279,7 +328,7 @@ void UEquipmentComponent::EquipDefaultWeapon()
             // ✅ NEW: Initialize ammo for ranged weapons
             if (URangedWeaponDataAsset* RangedData = Cast<URangedWeaponDataAsset>(DefaultWeaponData))
             {
-                DefaultWeapon->CurrentAmmo = RangedData->AmmoConfig.StartingAmmo;
+                DefaultWeapon->SetCurrentAmmo(RangedData->AmmoConfig.StartingAmmo);
                 UE_LOG(LogTemp, Log, TEXT("Initialized ranged weapon with %d ammo"), 
                     DefaultWeapon->CurrentAmmo);
             }
@@ -363,6 +412,8 @@ void UEquipmentComponent::Server_DropCurrentWeapon_Implementation()
     
     CurrentWeapon->SetActorLocation(DropLocation);
     CurrentWeapon->SetActorRotation(DropRotation);
+    ReleaseWeaponReplication(CurrentWeapon);
+    UpdateWeaponReplication();
     
     if (!GetCurrentWeapon())
     {
@@ -393,6 +444,9 @@ void UEquipmentComponent::Server_UnequipWeapon_Implementation()
     CurrentSlotData->bIsInHand = false;
     CurrentSlotData->bIsOccupied = false;
 
+    ReleaseWeaponReplication(ActiveWeapon);
+    UpdateWeaponReplication();
+
     // NEW: Switch to unarmed if no weapons remain
     if (!GetCurrentWeapon())
     {
@@ -506,6 +560,8 @@ void UEquipmentComponent::Server_SwapWeaponHandToHolster_Implementation(EWeaponS
         TargetSlot->Weapon->SetPickupEnabled(false);
     }
 
+    UpdateWeaponReplication();
+
     OnWeaponChanged.Broadcast(GetCurrentWeapon(), nullptr);
 }
 
@@ -527,6 +583,9 @@ void UEquipmentComponent::Server_EquipWeapon_Implementation(ABaseWeapon* WeaponT
     // ✅ CRITICAL FIX: SET THE WEAPON OWNER
     WeaponToEquip->SetOwner(OwnerCharacter);
     WeaponToEquip->SetInstigator(OwnerCharacter);
+
+    // Picked up from the ground: awake before the pickup multicast goes out
+    WeaponToEquip->SetWeaponDormant(false);
     
     // Stop all weapon traces before equipping new weapon
     StopAllWeaponTraces();
@@ -702,6 +761,13 @@ void UEquipmentComponent::Server_EquipWeapon_Implementation(ABaseWeapon* WeaponT
     GrantWeaponAbilities(WeaponData);
     ApplyWeaponAnimLayers(WeaponData);
 
+    // The previous weapon may have left the slots altogether (scenarios 6 and 7)
+    if (PreviousInHand && PreviousInHand != WeaponToEquip)
+    {
+        ReleaseWeaponReplication(PreviousInHand);
+    }
+    UpdateWeaponReplication();
+
     OnWeaponChanged.Broadcast(WeaponToEquip, PreviousInHand);
     
     UE_LOG(LogTemp, Warning, TEXT("[Equip Test] ✅ Equip complete!"));
@@ -818,6 +884,7 @@ void UEquipmentComponent::Server_PickupWeaponWithDrop_Implementation(ABaseWeapon
             
             WeaponToDrop->SetActorLocation(DropLocation);
             WeaponToDrop->SetActorRotation(DropRotation);
+            ReleaseWeaponReplication(WeaponToDrop);
             
             UE_LOG(LogTemp, Warning, TEXT("  ✅ Dropped at: %s"), *DropLocation.ToString());
         }
@@ -862,6 +929,7 @@ void UEquipmentComponent::Server_PickupWeaponWithDrop_Implementation(ABaseWeapon
             
             WeaponToDrop->SetActorLocation(DropLocation);
             WeaponToDrop->SetActorRotation(DropRotation);
+            ReleaseWeaponReplication(WeaponToDrop);
             
             UE_LOG(LogTemp, Warning, TEXT("  ✅ Dropped at: %s"), *DropLocation.ToString());
         }
@@ -903,6 +971,7 @@ void UEquipmentComponent::Server_PickupWeaponWithDrop_Implementation(ABaseWeapon
             
             WeaponToDrop->SetActorLocation(DropLocation);
             WeaponToDrop->SetActorRotation(DropRotation);
+            ReleaseWeaponReplication(WeaponToDrop);
             
             UE_LOG(LogTemp, Warning, TEXT("  ✅ Dropped at: %s"), *DropLocation.ToString());
         }
@@ -927,6 +996,32 @@ void UEquipmentComponent::Server_PickupWeaponWithDrop_Implementation(ABaseWeapon
 
 
 
+void UEquipmentComponent::UpdateWeaponReplication()
+{
+    MARK_PROPERTY_DIRTY_FROM_NAME(UEquipmentComponent, PrimarySlot, this);
+    MARK_PROPERTY_DIRTY_FROM_NAME(UEquipmentComponent, SecondarySlot, this);
+    MYYNetStats::RecordDirtyMark(2);
+
+    for (const FWeaponSlotData* SlotData : { &PrimarySlot, &SecondarySlot })
+    {
+        if (SlotData->bIsOccupied && SlotData->Weapon)
+        {
+            // Holstered weapons travel with their owner too, awake: a dormant dependent would never
+            // replicate. Only loose weapons sit in the grid and sleep.
+            UMYYReplicationGraph::SetWeaponCarrier(SlotData->Weapon, OwnerCharacter);
+            SlotData->Weapon->SetWeaponDormant(false);
+        }
+    }
+}
+
+void UEquipmentComponent::ReleaseWeaponReplication(ABaseWeapon* Weapon)
+{
+    if (!Weapon) return;
+
+    UMYYReplicationGraph::SetWeaponCarrier(Weapon, nullptr);
+    Weapon->SetWeaponDormant(true);
+}
+
 void UEquipmentComponent::CalculateWeaponDropTransform(ABaseWeapon* WeaponToDrop, FVector& OutLocation, FRotator& OutRotation, const TArray<AActor*>& AdditionalIgnoredActors)
 {
     if (!OwnerCharacter || !WeaponToDrop)
@@ -1001,6 +1096,9 @@ void UEquipmentComponent::ApplyDropPhysics(ABaseWeapon* WeaponToDrop, FVector Im
 {
     if (!WeaponToDrop || !WeaponToDrop->WeaponMesh) return;
 
+    // Awake while it falls so clients see it move; DisableDropPhysics puts it back to sleep
+    WeaponToDrop->SetWeaponDormant(false);
+
     WeaponToDrop->WeaponMesh->SetSimulatePhysics(true);
     WeaponToDrop->WeaponMesh->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
     WeaponToDrop->WeaponMesh->SetCollisionResponseToAllChannels(ECR_Block);
@@ -1046,6 +1144,12 @@ void UEquipmentComponent::DisableDropPhysics(ABaseWeapon* Weapon)
     {
         Weapon->SetActorLocation(HitResult.Location + FVector(0, 0, 10.0f));
     }
+
+    // Settled on the ground (not picked up while it was falling)
+    if (Weapon->IsPickupEnabled())
+    {
+        Weapon->SetWeaponDormant(true);
+    }
     
     UE_LOG(LogTemp, Warning, TEXT("[Drop Physics] Disabled physics on dropped weapon, enabled pickup collision"));
 }
@@ -1380,16 +1484,10 @@ void UEquipmentComponent::StopAllWeaponTraces()
     UE_LOG(LogTemp, Warning, TEXT("🛑 Stopping all weapon traces for: %s"),
         *CurrentWeapon->GetName());
 
-    // Server-only trace timers
+    // Server-only: unregisters the weapon from the batched trace subsystem
     if (CurrentWeapon->HasAuthority())
     {
-        CurrentWeapon->bIsTracing = false;
-
-        if (CurrentWeapon->GetWorld())
-        {
-            CurrentWeapon->GetWorld()->GetTimerManager()
-                .ClearTimer(CurrentWeapon->TraceTimerHandle);
-        }
+        CurrentWeapon->EndTrace();
     }
 
     // Clear all hit actors from previous swings
@@ -163,6 +163,9 @@ public:
 public:
 	UFUNCTION(BlueprintCallable, Category = "Equipment")
 	void DropAllWeapons();
+
+	// Pooled respawn: destroys whatever is still equipped and goes back to the loadout a freshly spawned character starts with
+	void ResetLoadout();
     
 	UFUNCTION(Server, Reliable)
 	void Server_DropAllWeapons();
@@ -170,6 +173,7 @@ public:
 	
 protected:
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+	virtual void PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker) override;
 	virtual void BeginPlay() override;
 
 	void GrantWeaponAbilities(UWeaponDataAsset* WeaponData) const;
@@ -208,6 +212,13 @@ protected:
 	void AttachWeaponToSocket(ABaseWeapon* Weapon, FName SocketName);
 	EWeaponSlot FindAvailableSlot() const;
 	EWeaponSlot GetSlotForWeapon(ABaseWeapon* Weapon) const;
+
+	// Server. Call after the slots change: marks them dirty (push model) and replicates the weapon in
+	// hand and the holstered one with OwnerCharacter (UMYYReplicationGraph), awake.
+	void UpdateWeaponReplication();
+
+	// Server. A weapon that left the slots: back in the replication graph's grid and dormant.
+	void ReleaseWeaponReplication(ABaseWeapon* Weapon);
  
 	// NEW: Track if layers are currently linked
 	UPROPERTY()
@@ -2,3 +2,216 @@
 
 
 #include "WeaponDataAsset.h"
+#include "Animation/AnimMontage.h"
+
+#if WITH_EDITOR
+#include "MYY/AbilitySystem/BaseWeapon.h"
+#include "MYY/AbilitySystem/Combat/WeaponPoseSampler.h"
+#include "MYY/AbilitySystem/Combat/DamageSpecCache.h"
+#include "Misc/DataValidation.h"
+#include "Engine/SkeletalMesh.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshSocket.h"
+#include "UObject/ObjectSaveContext.h"
+#endif
+
+// ========== FWeaponTrajectoryTrack ==========
+
+FVector FWeaponTrajectoryTrack::DecodePoint(int32 SampleIndex, int32 PointIndex) const
+{
+	const uint16* Quantized = &QuantizedSamples[SampleIndex * 6 + PointIndex * 3];
+	const FVector3f Normalized(Quantized[0], Quantized[1], Quantized[2]);
+	return FVector(BoundsMin + BoundsSize * (Normalized / 65535.f));
+}
+
+bool FWeaponTrajectoryTrack::Evaluate(float MontageTime, FVector& OutStart, FVector& OutEnd) const
+{
+	const int32 NumSamples = GetNumSamples();
+	if (NumSamples == 0)
+	{
+		return false;
+	}
+
+	const float SamplePosition = FMath::Clamp(MontageTime * SampleRate, 0.f, static_cast<float>(NumSamples - 1));
+	const int32 IndexA = FMath::FloorToInt(SamplePosition);
+	const int32 IndexB = FMath::Min(IndexA + 1, NumSamples - 1);
+	const float Alpha = SamplePosition - IndexA;
+
+	OutStart = FMath::Lerp(DecodePoint(IndexA, 0), DecodePoint(IndexB, 0), Alpha);
+	OutEnd = FMath::Lerp(DecodePoint(IndexA, 1), DecodePoint(IndexB, 1), Alpha);
+	return true;
+}
+
+void FWeaponTrajectoryTrack::Encode(const TArray<FVector>& StartPoints, const TArray<FVector>& EndPoints)
+{
+	check(StartPoints.Num() == EndPoints.Num());
+
+	FBox3f Bounds(ForceInit);
+	for (int32 Index = 0; Index < StartPoints.Num(); ++Index)
+	{
+		Bounds += FVector3f(StartPoints[Index]);
+		Bounds += FVector3f(EndPoints[Index]);
+	}
+
+	BoundsMin = Bounds.IsValid ? Bounds.Min : FVector3f::ZeroVector;
+	BoundsSize = Bounds.IsValid ? Bounds.GetSize() : FVector3f::ZeroVector;
+
+	auto Quantize = [this](const FVector& Point, uint16* Out)
+	{
+		const FVector3f Local = FVector3f(Point) - BoundsMin;
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			const float Normalized = BoundsSize[Axis] > KINDA_SMALL_NUMBER ? Local[Axis] / BoundsSize[Axis] : 0.f;
+			Out[Axis] = static_cast<uint16>(FMath::RoundToInt(FMath::Clamp(Normalized, 0.f, 1.f) * 65535.f));
+		}
+	};
+
+	QuantizedSamples.SetNumUninitialized(StartPoints.Num() * 6);
+	for (int32 Index = 0; Index < StartPoints.Num(); ++Index)
+	{
+		Quantize(StartPoints[Index], &QuantizedSamples[Index * 6]);
+		Quantize(EndPoints[Index], &QuantizedSamples[Index * 6 + 3]);
+	}
+}
+
+// ========== UWeaponDataAsset ==========
+
+const FWeaponTrajectoryTrack* UWeaponDataAsset::FindTrajectoryTrack(const UAnimMontage* Montage) const
+{
+	if (!Montage)
+	{
+		return nullptr;
+	}
+
+	return TrajectoryTracks.FindByPredicate([Montage](const FWeaponTrajectoryTrack& Track)
+	{
+		return Track.Montage == Montage && Track.GetNumSamples() > 0;
+	});
+}
+
+#if WITH_EDITOR
+
+bool UWeaponDataAsset::GetBladeInHandSocketSpace(FVector& OutStart, FVector& OutEnd) const
+{
+	const ABaseWeapon* WeaponDefaults = WeaponActorClass ? Cast<ABaseWeapon>(WeaponActorClass->GetDefaultObject()) : nullptr;
+	if (!WeaponDefaults || !WeaponDefaults->WeaponMesh)
+	{
+		return false;
+	}
+
+	const UStaticMesh* StaticMesh = WeaponDefaults->WeaponMesh->GetStaticMesh();
+
+	// Same resolution as ABaseWeapon::BeginPlay: mesh socket if present, else the placeholder component
+	auto ResolvePoint = [StaticMesh](FName SocketName, const USceneComponent* Placeholder)
+	{
+		FTransform SocketTransform = Placeholder ? Placeholder->GetRelativeTransform() : FTransform::Identity;
+		if (const UStaticMeshSocket* Socket = StaticMesh ? StaticMesh->FindSocket(SocketName) : nullptr)
+		{
+			SocketTransform = FTransform(Socket->RelativeRotation, Socket->RelativeLocation, Socket->RelativeScale);
+		}
+		return SocketTransform.GetLocation();
+	};
+
+	// Weapons snap to the hand socket without scale (EquipmentComponent attach rules)
+	const FTransform WeaponScale(FQuat::Identity, FVector::ZeroVector, WeaponDefaults->WeaponMesh->GetRelativeScale3D());
+	OutStart = WeaponScale.TransformPosition(ResolvePoint(TraceStartSocketName, WeaponDefaults->TraceStartSocket));
+	OutEnd = WeaponScale.TransformPosition(ResolvePoint(TraceEndSocketName, WeaponDefaults->TraceEndSocket));
+	return true;
+}
+
+void UWeaponDataAsset::BakeTrajectoryTracks()
+{
+	USkeletalMesh* BakeMesh = TrajectoryBakeMesh.LoadSynchronous();
+	if (!BakeMesh)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[%s] No TrajectoryBakeMesh set, skipping trajectory bake"), *GetName());
+		return;
+	}
+
+	FVector BladeStart, BladeEnd;
+	if (!GetBladeInHandSocketSpace(BladeStart, BladeEnd))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[%s] WeaponActorClass is not an ABaseWeapon, skipping trajectory bake"), *GetName());
+		return;
+	}
+
+	Modify();
+	TrajectoryTracks.Reset();
+
+	const float BakeRate = FMath::Max(TrajectoryBakeRate, 10.f);
+	TArray<FVector> StartPoints;
+	TArray<FVector> EndPoints;
+
+	for (UAnimMontage* Montage : Animations.ComboMontages)
+	{
+		if (!Montage)
+		{
+			continue;
+		}
+
+		const float PlayLength = Montage->GetPlayLength();
+		const int32 NumSamples = FMath::CeilToInt(PlayLength * BakeRate) + 1;
+
+		StartPoints.Reset(NumSamples);
+		EndPoints.Reset(NumSamples);
+
+		bool bBaked = true;
+		for (int32 SampleIndex = 0; SampleIndex < NumSamples; ++SampleIndex)
+		{
+			const float SampleTime = FMath::Min(SampleIndex / BakeRate, PlayLength);
+
+			FTransform HandSocketTransform;
+			if (!FWeaponPoseSampler::GetSocketTransformAtMontageTime(BakeMesh, Montage, SampleTime, HandSocketName, HandSocketTransform))
+			{
+				bBaked = false;
+				break;
+			}
+
+			StartPoints.Add(HandSocketTransform.TransformPosition(BladeStart));
+			EndPoints.Add(HandSocketTransform.TransformPosition(BladeEnd));
+		}
+
+		if (!bBaked)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[%s] Could not sample %s on %s, no trajectory baked for it"),
+				*GetName(), *Montage->GetName(), *BakeMesh->GetName());
+			continue;
+		}
+
+		FWeaponTrajectoryTrack& Track = TrajectoryTracks.AddDefaulted_GetRef();
+		Track.Montage = Montage;
+		Track.SampleRate = BakeRate;
+		Track.Encode(StartPoints, EndPoints);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[%s] Baked %d/%d blade trajectory tracks"),
+		*GetName(), TrajectoryTracks.Num(), Animations.ComboMontages.Num());
+}
+
+void UWeaponDataAsset::PreSave(FObjectPreSaveContext ObjectSaveContext)
+{
+	Super::PreSave(ObjectSaveContext);
+
+	// Cooking is a procedural save too: bake there as well so a cooked build never ships stale tracks
+	if (bAutoBakeTrajectoryTracks && !TrajectoryBakeMesh.IsNull()
+		&& (!ObjectSaveContext.IsProceduralSave() || ObjectSaveContext.IsCooking()))
+	{
+		BakeTrajectoryTracks();
+	}
+}
+
+EDataValidationResult UWeaponDataAsset::IsDataValid(FDataValidationContext& Context) const
+{
+	EDataValidationResult Result = Super::IsDataValid(Context);
+
+	if (!FDamageSpecCache::IsValidDamageEffect(DamageEffect))
+	{
+		Context.AddError(FText::Format(INVTEXT("DamageEffect {0} is not UGE_Damage or a child of it"),
+			FText::FromString(GetNameSafe(DamageEffect))));
+		Result = EDataValidationResult::Invalid;
+	}
+
+	return Result;
+}
+
+#endif
@@ -14,6 +14,8 @@
 class UGameplayAbility;
 class UAnimInstance;
 class ABaseWeapon;
+class USkeletalMesh;
+class FObjectPreSaveContext;
 
 USTRUCT(BlueprintType)
 struct FAbilityInputMapping
@@ -43,6 +45,15 @@ enum class EWeaponType : uint8
     Unarmed     UMETA(DisplayName = "Unarmed")
 };
 
+UENUM(BlueprintType)
+enum class EWeaponTraceMode : uint8
+{
+	// One capsule query covering the whole area the blade moved through since the last step
+	SweptBlade        UMETA(DisplayName = "Swept Blade"),
+	// Old behaviour: LastStart->Start, LastEnd->End and Start->End sweeps
+	LegacyTripleSweep UMETA(DisplayName = "Legacy Triple Sweep")
+};
+
 USTRUCT(BlueprintType)
 struct FWeaponStats
 {
@@ -74,7 +85,18 @@ struct FWeaponStats
 	float TraceHalfHeight = 50.f;  // Only used for capsule
 
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Stats|Trace")
-	bool bUseCapsuleTrace = false;  // false = sphere, true = capsule
+	bool bUseCapsuleTrace = false;  // false = sphere, true = capsule (legacy mode only)
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Stats|Trace")
+	EWeaponTraceMode TraceMode = EWeaponTraceMode::SweptBlade;
+
+	// Swept blade: extra capsule radius allowed to cover blade rotation before the step is split
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Stats|Trace", meta = (ClampMin = "1.0", EditCondition = "TraceMode == EWeaponTraceMode::SweptBlade"))
+	float MaxSweptCapsuleInflation = 15.f;
+
+	// Swept blade: upper bound of interpolated capsules for a single step (fast, wide swings)
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Stats|Trace", meta = (ClampMin = "1", ClampMax = "8", EditCondition = "TraceMode == EWeaponTraceMode::SweptBlade"))
+	int32 MaxSweptCapsules = 3;
 };
 
 USTRUCT(BlueprintType)
@@ -129,6 +151,43 @@ struct FWeaponAnimationSet
  
 };
 
+/**
+ * Blade trajectory of one attack montage, baked in the editor / on cook.
+ * TraceStart and TraceEnd in the owner mesh's component space, sampled at a fixed
+ * rate and quantized to 16 bits per axis inside the track bounds (12 bytes a sample).
+ */
+USTRUCT()
+struct MYY_API FWeaponTrajectoryTrack
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, Category = "Trajectory")
+	UAnimMontage* Montage = nullptr;
+
+	UPROPERTY(VisibleAnywhere, Category = "Trajectory")
+	float SampleRate = 60.f;
+
+	UPROPERTY(VisibleAnywhere, Category = "Trajectory")
+	FVector3f BoundsMin = FVector3f::ZeroVector;
+
+	UPROPERTY(VisibleAnywhere, Category = "Trajectory")
+	FVector3f BoundsSize = FVector3f::ZeroVector;
+
+	// 6 values per sample: TraceStart xyz, TraceEnd xyz
+	UPROPERTY()
+	TArray<uint16> QuantizedSamples;
+
+	int32 GetNumSamples() const { return QuantizedSamples.Num() / 6; }
+
+	// Blade segment (component space) at MontageTime, linearly interpolated between samples
+	bool Evaluate(float MontageTime, FVector& OutStart, FVector& OutEnd) const;
+
+	void Encode(const TArray<FVector>& StartPoints, const TArray<FVector>& EndPoints);
+
+private:
+	FVector DecodePoint(int32 SampleIndex, int32 PointIndex) const;
+};
+
 /**
  * Primary Data Asset for weapon configuration
  * Create variants: PDA_Sword, PDA_Bow, PDA_Unarmed
@@ -167,6 +226,7 @@ public:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "GamePlayEffects")
 	TSubclassOf<UGameplayEffect> BlockEffect;
 
+	// UGE_Damage or a child of it, unset means UGE_Damage (anything else fails validation). Crit/block stats are passed as SetByCaller.
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "GamePlayEffects")
 	TSubclassOf<UGameplayEffect> DamageEffect;
 	
@@ -192,6 +252,38 @@ public:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Combat")
 	FName TraceEndSocketName = "TraceEnd";
 
+	// ========== BAKED BLADE TRAJECTORIES ==========
+
+#if WITH_EDITORONLY_DATA
+	// Character mesh the ComboMontages are baked on (any mesh using the combat skeleton)
+	UPROPERTY(EditDefaultsOnly, Category = "Combat|Trajectory")
+	TSoftObjectPtr<USkeletalMesh> TrajectoryBakeMesh;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Combat|Trajectory", meta = (ClampMin = "10.0"))
+	float TrajectoryBakeRate = 60.f;
+
+	// Re-bake the tracks whenever the asset is saved or cooked
+	UPROPERTY(EditDefaultsOnly, Category = "Combat|Trajectory")
+	bool bAutoBakeTrajectoryTracks = true;
+#endif
+
+	// One track per ComboMontages entry; read by the server weapon trace instead of the live pose
+	UPROPERTY(VisibleAnywhere, Category = "Combat|Trajectory")
+	TArray<FWeaponTrajectoryTrack> TrajectoryTracks;
+
+	const FWeaponTrajectoryTrack* FindTrajectoryTrack(const UAnimMontage* Montage) const;
+
+#if WITH_EDITOR
+	UFUNCTION(CallInEditor, Category = "Combat|Trajectory")
+	void BakeTrajectoryTracks();
+
+	virtual void PreSave(FObjectPreSaveContext ObjectSaveContext) override;
+	virtual EDataValidationResult IsDataValid(FDataValidationContext& Context) const override;
+
+	// TraceStart/TraceEnd relative to HandSocketName, read from the weapon actor defaults
+	bool GetBladeInHandSocketSpace(FVector& OutStart, FVector& OutEnd) const;
+#endif
+
 	// VFX and SFX
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Effects")
 	UParticleSystem* HitVFX;
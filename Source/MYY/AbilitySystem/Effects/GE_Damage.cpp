@@ -0,0 +1,13 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "GE_Damage.h"
+#include "MYY/AbilitySystem/Effects/MYYDamageExecution.h"
+
+UGE_Damage::UGE_Damage()
+{
+	DurationPolicy = EGameplayEffectDurationType::Instant;
+
+	FGameplayEffectExecutionDefinition DamageExecution;
+	DamageExecution.CalculationClass = UMYYDamageExecution::StaticClass();
+	Executions.Add(DamageExecution);
+}
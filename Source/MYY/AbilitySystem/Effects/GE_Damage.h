@@ -0,0 +1,20 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayEffect.h"
+#include "GE_Damage.generated.h"
+
+/**
+ * Instant damage effect shared by melee, unarmed and arrow hits. All of the hit
+ * resolution happens in UMYYDamageExecution. Blueprint children may add cues.
+ */
+UCLASS()
+class MYY_API UGE_Damage : public UGameplayEffect
+{
+	GENERATED_BODY()
+
+public:
+	UGE_Damage();
+};
@@ -0,0 +1,94 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MYYDamageExecution.h"
+#include "MYY/MYY.h"
+#include "AbilitySystemComponent.h"
+#include "MYY/AbilitySystem/MYYCharacterBase.h"
+#include "MYY/AbilitySystem/AttributeSet/AttributeSetBase.h"
+#include "MYY/AbilitySystem/Effects/MYYGameplayEffectContext.h"
+#include "MYY/AbilitySystem/GameplayTags/MYYGameplayTags.h"
+
+DECLARE_CYCLE_STAT(TEXT("Damage Execution"), STAT_MYY_DamageExecution, STATGROUP_MYYCombat);
+
+struct FMYYDamageStatics
+{
+	DECLARE_ATTRIBUTE_CAPTUREDEF(Health);
+
+	FMYYDamageStatics()
+	{
+		DEFINE_ATTRIBUTE_CAPTUREDEF(UAttributeSetBase, Health, Target, false);
+	}
+};
+
+static const FMYYDamageStatics& DamageStatics()
+{
+	static FMYYDamageStatics Statics;
+	return Statics;
+}
+
+UMYYDamageExecution::UMYYDamageExecution()
+{
+	RelevantAttributesToCapture.Add(DamageStatics().HealthDef);
+}
+
+void UMYYDamageExecution::Execute_Implementation(const FGameplayEffectCustomExecutionParameters& ExecutionParams,
+	FGameplayEffectCustomExecutionOutput& OutExecutionOutput) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_MYY_DamageExecution);
+
+	const FGameplayEffectSpec& Spec = ExecutionParams.GetOwningSpec();
+	const FGameplayTagContainer* SourceTags = Spec.CapturedSourceTags.GetAggregatedTags();
+	const FGameplayTagContainer* TargetTags = Spec.CapturedTargetTags.GetAggregatedTags();
+
+	const UAbilitySystemComponent* TargetASC = ExecutionParams.GetTargetAbilitySystemComponent();
+	const AMYYCharacterBase* TargetCharacter = TargetASC ? Cast<AMYYCharacterBase>(TargetASC->GetAvatarActor()) : nullptr;
+
+	float Damage = FMath::Max(Spec.GetSetByCallerMagnitude(MYYTags::Data_Damage, false, 0.f), 0.f);
+	bool bIsCritical = false;
+	bool bIsBlocked = false;
+
+	// Arrows were never parryable, only melee and unarmed hits are
+	const bool bIsRanged = SourceTags && SourceTags->HasTagExact(MYYTags::Ability_Attack_Ranged);
+	const bool bIsParried = !bIsRanged && TargetCharacter && TargetCharacter->IsInBlockWindow();
+
+	if (bIsParried)
+	{
+		Damage = 0.f;
+	}
+	else
+	{
+		const float CritChance = Spec.GetSetByCallerMagnitude(MYYTags::Data_CritChance, false, 0.f);
+		if (CritChance > 0.f && FMath::FRand() <= CritChance)
+		{
+			bIsCritical = true;
+			Damage *= Spec.GetSetByCallerMagnitude(MYYTags::Data_CritMultiplier, false, 1.f);
+		}
+
+		if (TargetTags && TargetTags->HasTag(MYYTags::State_Combat_Blocking))
+		{
+			bIsBlocked = true;
+			Damage *= 1.f - FMath::Clamp(Spec.GetSetByCallerMagnitude(MYYTags::Data_BlockReduction, false, 0.f), 0.f, 1.f);
+		}
+	}
+
+	// No overkill: the Damage meta attribute never exceeds what the target has left
+	FAggregatorEvaluateParameters EvaluateParameters;
+	EvaluateParameters.SourceTags = SourceTags;
+	EvaluateParameters.TargetTags = TargetTags;
+
+	float TargetHealth = 0.f;
+	ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(DamageStatics().HealthDef, EvaluateParameters, TargetHealth);
+	Damage = FMath::Clamp(Damage, 0.f, FMath::Max(TargetHealth, 0.f));
+
+	if (FMYYGameplayEffectContext* Context = FMYYGameplayEffectContext::GetMutable(Spec.GetContext()))
+	{
+		Context->SetHitOutcome(bIsCritical, bIsBlocked, bIsParried);
+	}
+
+	// A parry still outputs (zero) damage so the attribute set sees the hit and fires the parry events
+	if (Damage > 0.f || bIsParried)
+	{
+		OutExecutionOutput.AddOutputModifier(
+			FGameplayModifierEvaluatedData(UAttributeSetBase::GetDamageAttribute(), EGameplayModOp::Additive, Damage));
+	}
+}
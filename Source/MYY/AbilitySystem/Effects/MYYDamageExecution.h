@@ -0,0 +1,29 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayEffectExecutionCalculation.h"
+#include "MYYDamageExecution.generated.h"
+
+/**
+ * Resolves a damage hit in one pass on the server:
+ *   parry (target in its block window, melee only) -> no damage
+ *   crit roll (Data.CritChance / Data.CritMultiplier)
+ *   block reduction (target has State.Combat.Blocking, Data.BlockReduction)
+ *   clamp to the target's current Health
+ *
+ * Base damage comes from Data.Damage. The result goes to the Damage meta attribute and
+ * the outcome into FMYYGameplayEffectContext; UAttributeSetBase fires the matching event.
+ */
+UCLASS()
+class MYY_API UMYYDamageExecution : public UGameplayEffectExecutionCalculation
+{
+	GENERATED_BODY()
+
+public:
+	UMYYDamageExecution();
+
+	virtual void Execute_Implementation(const FGameplayEffectCustomExecutionParameters& ExecutionParams,
+		FGameplayEffectCustomExecutionOutput& OutExecutionOutput) const override;
+};
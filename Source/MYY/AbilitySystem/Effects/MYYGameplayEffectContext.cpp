@@ -0,0 +1,56 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MYYGameplayEffectContext.h"
+
+const FMYYGameplayEffectContext* FMYYGameplayEffectContext::Get(const FGameplayEffectContextHandle& Handle)
+{
+	return GetMutable(Handle);
+}
+
+FMYYGameplayEffectContext* FMYYGameplayEffectContext::GetMutable(const FGameplayEffectContextHandle& Handle)
+{
+	FGameplayEffectContext* Context = Handle.Get();
+	if (Context && Context->GetScriptStruct()->IsChildOf(StaticStruct()))
+	{
+		return static_cast<FMYYGameplayEffectContext*>(Context);
+	}
+
+	return nullptr;
+}
+
+FMYYGameplayEffectContext* FMYYGameplayEffectContext::Duplicate() const
+{
+	FMYYGameplayEffectContext* NewContext = new FMYYGameplayEffectContext();
+	*NewContext = *this;
+
+	if (GetHitResult())
+	{
+		// Deep copy, the hit result is held by pointer
+		NewContext->AddHitResult(*GetHitResult(), true);
+	}
+
+	return NewContext;
+}
+
+bool FMYYGameplayEffectContext::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	const bool bBaseSuccess = Super::NetSerialize(Ar, Map, bOutSuccess);
+
+	uint8 OutcomeBits = 0;
+	if (Ar.IsSaving())
+	{
+		OutcomeBits = (bIsCriticalHit ? 1 << 0 : 0) | (bIsBlockedHit ? 1 << 1 : 0) | (bIsParried ? 1 << 2 : 0);
+	}
+
+	Ar.SerializeBits(&OutcomeBits, 3);
+
+	if (Ar.IsLoading())
+	{
+		bIsCriticalHit = (OutcomeBits & (1 << 0)) != 0;
+		bIsBlockedHit = (OutcomeBits & (1 << 1)) != 0;
+		bIsParried = (OutcomeBits & (1 << 2)) != 0;
+	}
+
+	bOutSuccess = bOutSuccess && bBaseSuccess;
+	return bOutSuccess;
+}
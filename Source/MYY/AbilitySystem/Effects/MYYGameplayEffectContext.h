@@ -0,0 +1,61 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayEffectTypes.h"
+#include "MYYGameplayEffectContext.generated.h"
+
+/**
+ * Effect context for MYY damage. UMYYDamageExecution records how the hit resolved
+ * (crit / blocked / parried) so the attribute set and the attacker can react to it
+ * without evaluating the hit a second time.
+ */
+USTRUCT()
+struct MYY_API FMYYGameplayEffectContext : public FGameplayEffectContext
+{
+	GENERATED_BODY()
+
+public:
+
+	// The MYY context behind Handle, or null if the effect was made with a plain context
+	static const FMYYGameplayEffectContext* Get(const FGameplayEffectContextHandle& Handle);
+	static FMYYGameplayEffectContext* GetMutable(const FGameplayEffectContextHandle& Handle);
+
+	bool IsCriticalHit() const { return bIsCriticalHit; }
+	bool IsBlockedHit() const { return bIsBlockedHit; }
+	bool IsParried() const { return bIsParried; }
+
+	void SetHitOutcome(bool bInCriticalHit, bool bInBlockedHit, bool bInParried)
+	{
+		bIsCriticalHit = bInCriticalHit;
+		bIsBlockedHit = bInBlockedHit;
+		bIsParried = bInParried;
+	}
+
+	// FGameplayEffectContext
+	virtual UScriptStruct* GetScriptStruct() const override { return StaticStruct(); }
+	virtual FMYYGameplayEffectContext* Duplicate() const override;
+	virtual bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess) override;
+
+protected:
+
+	UPROPERTY()
+	bool bIsCriticalHit = false;
+
+	UPROPERTY()
+	bool bIsBlockedHit = false;
+
+	UPROPERTY()
+	bool bIsParried = false;
+};
+
+template<>
+struct TStructOpsTypeTraits<FMYYGameplayEffectContext> : public TStructOpsTypeTraitsBase2<FMYYGameplayEffectContext>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithCopy = true
+	};
+};
@@ -1,4 +1,5 @@
 ﻿#include "MYY/AbilitySystem/GameplayTags/MYYGameplayTags.h"
+#include "HAL/IConsoleManager.h"
 
 namespace MYYTags
 {
@@ -10,6 +11,8 @@ namespace MYYTags
     UE_DEFINE_GAMEPLAY_TAG(GameplayAbility_Movement_Dash, "GameplayAbility.Movement.Dash");
 
     /* ------------------------------ Ability.* ------------------------------ */
+    UE_DEFINE_GAMEPLAY_TAG(Ability,                   "Ability");
+    UE_DEFINE_GAMEPLAY_TAG(Ability_Combat,            "Ability.Combat");
     UE_DEFINE_GAMEPLAY_TAG(Ability_Combat_Block,      "Ability.Combat.Block");
     UE_DEFINE_GAMEPLAY_TAG(Ability_Attack_Melee,      "Ability.Attack.Melee");
     UE_DEFINE_GAMEPLAY_TAG(Ability_Action_Dodge,      "Ability.Action.Dodge");
@@ -19,7 +22,11 @@ namespace MYYTags
     UE_DEFINE_GAMEPLAY_TAG(Ability_Weapon_Equip,      "Ability.Weapon.Equip");
     UE_DEFINE_GAMEPLAY_TAG(Ability_Attack_Stagger,    "Ability.Attack.Stagger");
     UE_DEFINE_GAMEPLAY_TAG(Ability_Attack_Ranged,     "Ability.Attack.Ranged");
+    UE_DEFINE_GAMEPLAY_TAG(Ability_Attack_Unarmed,    "Ability.Attack.Unarmed");
     UE_DEFINE_GAMEPLAY_TAG(Ability_Combat_Parry,      "Ability.Combat.Parry");
+    UE_DEFINE_GAMEPLAY_TAG(Ability_Combat_Stagger,    "Ability.Combat.Stagger");
+    UE_DEFINE_GAMEPLAY_TAG(Ability_Combat_HitReact,   "Ability.Combat.HitReact");
+    UE_DEFINE_GAMEPLAY_TAG(Ability_Combat_Death,      "Ability.Combat.Death");
     UE_DEFINE_GAMEPLAY_TAG(Ability_Interact,          "Ability.Interact");
     UE_DEFINE_GAMEPLAY_TAG(Ability_Movement_Vault,          "Ability.Movement.Vault");
     
@@ -32,10 +39,15 @@ namespace MYYTags
     UE_DEFINE_GAMEPLAY_TAG(GameplayEvent_Fire, "GameplayEvent.Fire");
     UE_DEFINE_GAMEPLAY_TAG(GameplayEvent_HitReact, "GameplayEvent.HitReact"); // ✅ ADD THIS
     UE_DEFINE_GAMEPLAY_TAG(GameplayEvent_Death, "GameplayEvent.Death");       // ✅ ADD THIS
+    UE_DEFINE_GAMEPLAY_TAG(GameplayEvent_Parry, "GameplayEvent.Parry");
+    UE_DEFINE_GAMEPLAY_TAG(GameplayEvent_Stagger, "GameplayEvent.Stagger");
 
     /* -------------------------------- Data.* ------------------------------- */
     UE_DEFINE_GAMEPLAY_TAG(Data_Damage, "Data.Damage");
     UE_DEFINE_GAMEPLAY_TAG(Data_Heal,   "Data.Heal");
+    UE_DEFINE_GAMEPLAY_TAG(Data_CritChance,     "Data.CritChance");
+    UE_DEFINE_GAMEPLAY_TAG(Data_CritMultiplier, "Data.CritMultiplier");
+    UE_DEFINE_GAMEPLAY_TAG(Data_BlockReduction, "Data.BlockReduction");
 
     /* -------------------------- GameplayCue.* ------------------------------ */
     UE_DEFINE_GAMEPLAY_TAG(GameplayCue_Dash_Activate, "GameplayCue.Dash.Activate");
@@ -43,6 +55,8 @@ namespace MYYTags
     UE_DEFINE_GAMEPLAY_TAG(GameplayCue_Heal_Burst,    "GameplayCue.Heal.Burst");
 
     /* -------------------------------- State.* ------------------------------ */
+    UE_DEFINE_GAMEPLAY_TAG(State_Combat,               "State.Combat");
+    UE_DEFINE_GAMEPLAY_TAG(State_Action,               "State.Action");
     UE_DEFINE_GAMEPLAY_TAG(State_Combat_BlockWindow,   "State.Combat.BlockWindow");
     UE_DEFINE_GAMEPLAY_TAG(State_Combat_Blocking,      "State.Combat.Blocking");
     UE_DEFINE_GAMEPLAY_TAG(State_Combat_Attacking,     "State.Combat.Attacking");
@@ -54,6 +68,9 @@ namespace MYYTags
     UE_DEFINE_GAMEPLAY_TAG(State_Combat_ParrySuccess,  "State.Combat.ParrySuccess");
     UE_DEFINE_GAMEPLAY_TAG(State_Combat_ParryWindow,  "State.Combat.ParryWindow");
     UE_DEFINE_GAMEPLAY_TAG(State_Combat_HitReact,      "State.Combat.HitReact");
+    UE_DEFINE_GAMEPLAY_TAG(State_Combat_HitStunned,    "State.Combat.HitStunned");
+    UE_DEFINE_GAMEPLAY_TAG(State_Combat_Stunned,       "State.Combat.Stunned");
+    UE_DEFINE_GAMEPLAY_TAG(State_Dead,                 "State.Dead");
     UE_DEFINE_GAMEPLAY_TAG(State_Aiming,"State.Aiming");
     UE_DEFINE_GAMEPLAY_TAG(State_Firing,"State.Firing");
 
@@ -71,6 +88,53 @@ namespace MYYTags
     /* -------------------------- Fail.* ------------------------------ */
     UE_DEFINE_GAMEPLAY_TAG(Ability_Failed_NoAmmo, "Ability.Failed.NoAmmo");
     UE_DEFINE_GAMEPLAY_TAG(Ability_Failed_NoStamina, "Ability.Failed.NoStamina");
-    
-
 }
+
+// ========== BENCHMARK ==========
+
+#if !UE_BUILD_SHIPPING
+// MYY.Tags.Bench [Iterations]
+// Tag-query throughput of the old string lookups against the native registry, on a typical owned-tag container.
+static FAutoConsoleCommandWithWorldAndArgs GBenchGameplayTagsCommand(
+    TEXT("MYY.Tags.Bench"),
+    TEXT("Compares RequestGameplayTag lookups with native MYYTags in tag queries. Usage: MYY.Tags.Bench [Iterations]"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+    {
+        const int32 Iterations = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 100000;
+
+        FGameplayTagContainer OwnedTags;
+        OwnedTags.AddTag(MYYTags::State_Combat_Attacking);
+        OwnedTags.AddTag(MYYTags::State_Aiming);
+        OwnedTags.AddTag(MYYTags::State_Combat_HitReact);
+
+        int32 Matches = 0;
+
+        // Before: the lookups PerformTrace and the BT nodes did per query
+        const double RequestStart = FPlatformTime::Seconds();
+        for (int32 Index = 0; Index < Iterations; ++Index)
+        {
+            Matches += OwnedTags.HasTag(FGameplayTag::RequestGameplayTag("State.Combat.Blocking"));
+            Matches += OwnedTags.HasTag(FGameplayTag::RequestGameplayTag("State.Combat.Attacking"));
+            Matches += OwnedTags.HasTag(FGameplayTag::RequestGameplayTag("GameplayEvent.Parry"));
+        }
+        const double RequestSeconds = FPlatformTime::Seconds() - RequestStart;
+
+        // After: native tags, resolved at startup
+        const double NativeStart = FPlatformTime::Seconds();
+        for (int32 Index = 0; Index < Iterations; ++Index)
+        {
+            Matches -= OwnedTags.HasTag(MYYTags::State_Combat_Blocking);
+            Matches -= OwnedTags.HasTag(MYYTags::State_Combat_Attacking);
+            Matches -= OwnedTags.HasTag(MYYTags::GameplayEvent_Parry);
+        }
+        const double NativeSeconds = FPlatformTime::Seconds() - NativeStart;
+
+        const double NumQueries = Iterations * 3.0;
+        UE_LOG(LogTemp, Warning, TEXT("📊 MYY.Tags.Bench x%d: RequestGameplayTag %.1f M queries/s | native %.1f M queries/s | speedup %.2fx (check %d)"),
+            Iterations,
+            RequestSeconds > 0.0 ? NumQueries / RequestSeconds * 1.0e-6 : 0.0,
+            NativeSeconds > 0.0 ? NumQueries / NativeSeconds * 1.0e-6 : 0.0,
+            NativeSeconds > 0.0 ? RequestSeconds / NativeSeconds : 0.0,
+            Matches);
+    }));
+#endif
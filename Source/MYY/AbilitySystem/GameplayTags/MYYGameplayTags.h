@@ -13,6 +13,8 @@ namespace MYYTags
     MYY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(GameplayAbility_Movement_Dash);
 
     /* ----------------------------- Ability.* ------------------------------- */
+    MYY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Ability);
+    MYY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Ability_Combat);
     MYY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Ability_Combat_Block);
     MYY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Ability_Attack_Melee);
     MYY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Ability_Action_Dodge);
@@ -22,7 +24,11 @@ namespace MYYTags
     MYY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Ability_Weapon_Equip);
     MYY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Ability_Attack_Stagger);
     MYY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Ability_Attack_Ranged);
+    MYY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Ability_Attack_Unarmed);
     MYY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Ability_Combat_Parry);
+    MYY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Ability_Combat_Stagger);
+    MYY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Ability_Combat_HitReact);
+    MYY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Ability_Combat_Death);
     MYY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Ability_Interact);
     MYY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Ability_Movement_Vault);
 
@@ -34,10 +40,15 @@ namespace MYYTags
     MYY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(GameplayEvent_Fire);
     MYY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(GameplayEvent_HitReact);
     MYY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(GameplayEvent_Death);
+    MYY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(GameplayEvent_Parry);
+    MYY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(GameplayEvent_Stagger);
 
     /* ------------------------------ Data.* -------------------------------- */
     MYY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Data_Damage);
     MYY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Data_Heal);
+    MYY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Data_CritChance);
+    MYY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Data_CritMultiplier);
+    MYY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Data_BlockReduction);
 
     /* -------------------------- GameplayCue.* ------------------------------ */
     MYY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(GameplayCue_Dash_Activate);
@@ -45,6 +56,8 @@ namespace MYYTags
     MYY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(GameplayCue_Heal_Burst);
 
     /* -------------------------------- State.* ------------------------------ */
+    MYY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(State_Combat);
+    MYY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(State_Action);
     MYY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(State_Combat_BlockWindow);
     MYY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(State_Combat_Blocking);
     MYY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(State_Combat_Attacking);
@@ -56,6 +69,9 @@ namespace MYYTags
     MYY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(State_Combat_ParrySuccess);
     MYY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(State_Combat_ParryWindow);
     MYY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(State_Combat_HitReact);
+    MYY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(State_Combat_HitStunned);
+    MYY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(State_Combat_Stunned);
+    MYY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(State_Dead);
     MYY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(State_Aiming);
     MYY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(State_Firing);
 
@@ -73,6 +89,4 @@ namespace MYYTags
     /* -------------------------- Fail.* ------------------------------ */
     MYY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Ability_Failed_NoAmmo);
     MYY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Ability_Failed_NoStamina);
-
-    
 }
@@ -0,0 +1,9 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MYYAbilitySystemGlobals.h"
+#include "MYY/AbilitySystem/Effects/MYYGameplayEffectContext.h"
+
+FGameplayEffectContext* UMYYAbilitySystemGlobals::AllocGameplayEffectContext() const
+{
+	return new FMYYGameplayEffectContext();
+}
@@ -0,0 +1,20 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AbilitySystemGlobals.h"
+#include "MYYAbilitySystemGlobals.generated.h"
+
+/**
+ * Project ability system globals (set in DefaultGame.ini), so every effect context
+ * is an FMYYGameplayEffectContext.
+ */
+UCLASS()
+class MYY_API UMYYAbilitySystemGlobals : public UAbilitySystemGlobals
+{
+	GENERATED_BODY()
+
+public:
+	virtual FGameplayEffectContext* AllocGameplayEffectContext() const override;
+};
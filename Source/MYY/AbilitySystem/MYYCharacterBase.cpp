@@ -11,15 +11,33 @@
 #include "Components/CapsuleComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
 #include "MYY/AbilitySystem/UI/HealthStaminaWidget.h"
+#include "MYY/AbilitySystem/Subsystem/LagCompensationSubsystem.h"
+#include "MYY/AbilitySystem/Subsystem/TargetGridSubsystem.h"
+#include "MYY/AbilitySystem/Subsystem/MinionPoolSubsystem.h"
+#include "MYY/AbilitySystem/GameplayTags/MYYGameplayTags.h"
+#include "MYY/AbilitySystem/Anim_Notifiers/AnimNotifyState_BlockWindow.h"
+#include "MYY/MYY.h"
+#include "MYY/Networking/MYYNetStats.h"
+#include "GameFramework/PlayerState.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<float> CVarBlockMaxRewind(
+	TEXT("MYY.Combat.BlockMaxRewind"),
+	0.3f,
+	TEXT("Furthest (seconds) a block's start is taken back for the owner's latency, from its timestamp or ping."),
+	ECVF_Default);
 
 // #include "MYY/AbilitySystem/AttributeSet/AttributeSetBase.h" 
 
 // Sets default values
 AMYYCharacterBase::AMYYCharacterBase()
 {
- 	// Set this character to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
+	// Tick only runs the unarmed trace, so it's switched on by StartUnarmedTrace and off again by EndUnarmedTrace.
+	// Subclasses that need a per-frame tick set bStartWithTickEnabled and keep it.
 	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
 
 	// Create Ability System Component
 	AbilitySystemComponent = CreateDefaultSubobject<UAbilitySystemComponent>(TEXT("AbilitySystemComponent"));
@@ -159,8 +177,56 @@ void AMYYCharacterBase::BeginPlay()
 				BindAttributeCallbacks();
 			}, 0.05f, false); // Small delay to ensure initialization
 		}
+
+		// Record hitbox history for lag-compensated hits
+		if (ULagCompensationSubsystem* LagCompensation = GetWorld()->GetSubsystem<ULagCompensationSubsystem>())
+		{
+			LagCompensation->RegisterCharacter(this);
+		}
+
+		// Shared target grid for AI acquisition
+		if (UTargetGridSubsystem* TargetGrid = GetWorld()->GetSubsystem<UTargetGridSubsystem>())
+		{
+			TargetGrid->RegisterCharacter(this);
+		}
 	}
- 
+
+	if (GetMesh())
+	{
+		ConfiguredAnimTickOption = GetMesh()->VisibilityBasedAnimTickOption;
+	}
+	SetServerPoseEvaluation(false);
+}
+
+void AMYYCharacterBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (HasAuthority())
+	{
+		if (ULagCompensationSubsystem* LagCompensation = GetWorld()->GetSubsystem<ULagCompensationSubsystem>())
+		{
+			LagCompensation->UnregisterCharacter(this);
+		}
+
+		if (UTargetGridSubsystem* TargetGrid = GetWorld()->GetSubsystem<UTargetGridSubsystem>())
+		{
+			TargetGrid->UnregisterCharacter(this);
+		}
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AMYYCharacterBase::SetServerPoseEvaluation(bool bEvaluatePose)
+{
+	if (!bOnlyTickMontagesOnDedicatedServer || GetNetMode() != NM_DedicatedServer || !GetMesh())
+	{
+		return;
+	}
+
+	// Evaluating again means back to whatever the Blueprint configured
+	GetMesh()->VisibilityBasedAnimTickOption = bEvaluatePose
+		? ConfiguredAnimTickOption
+		: EVisibilityBasedAnimTickOption::OnlyTickMontagesWhenNotRendered;
 }
 
 // Separate function to bind callbacks
@@ -371,7 +437,7 @@ void AMYYCharacterBase::PossessedBy(AController* NewController)
 		*GetName(), *GetNameSafe(NewController));
 
 	// Initialize ASC on server when possessed
-	if (HasAuthority())
+	if (HasAuthority() && !bDeferAbilitySystemInit)
 	{
 		// ✅ Small delay to ensure replication is ready
 		FTimerHandle InitTimer;
@@ -402,6 +468,13 @@ void AMYYCharacterBase::InitializeAbilitySystem()
 	if (!AbilitySystemComponent) return;
 
 	AbilitySystemComponent->InitAbilityActorInfo(this, this);
+
+	// Re-possessed after coming back from the pool: everything below is still in place
+	if (bAbilitySystemInitialized)
+	{
+		return;
+	}
+	bAbilitySystemInitialized = true;
     
 	InitializeAbilities();
 
@@ -413,28 +486,32 @@ void AMYYCharacterBase::InitializeAbilitySystem()
 		AttributeSet->GetStaminaAttribute()).AddUObject(this, &AMYYCharacterBase::OnStaminaAttributeChanged);
 
 	// Apply default effects (only on server)
-	if (HasAuthority())
+	ApplyDefaultEffects();
+}
+
+void AMYYCharacterBase::ApplyDefaultEffects()
+{
+	if (!HasAuthority() || !AbilitySystemComponent)
+	{
+		return;
+	}
+
+	for (TSubclassOf<UGameplayEffect>& EffectClass : DefaultEffects)
 	{
-		for (TSubclassOf<UGameplayEffect>& EffectClass : DefaultEffects)
+		if (EffectClass)
 		{
-			if (EffectClass)
-			{
-				FGameplayEffectContextHandle EffectContext = AbilitySystemComponent->MakeEffectContext();
-				EffectContext.AddSourceObject(this);
+			FGameplayEffectContextHandle EffectContext = AbilitySystemComponent->MakeEffectContext();
+			EffectContext.AddSourceObject(this);
 
-				FGameplayEffectSpecHandle SpecHandle = AbilitySystemComponent->MakeOutgoingSpec(
-					EffectClass, 1, EffectContext);
+			FGameplayEffectSpecHandle SpecHandle = AbilitySystemComponent->MakeOutgoingSpec(
+				EffectClass, 1, EffectContext);
 
-				if (SpecHandle.IsValid())
-				{
-					AbilitySystemComponent->ApplyGameplayEffectSpecToSelf(*SpecHandle.Data.Get());
-				}
+			if (SpecHandle.IsValid())
+			{
+				AbilitySystemComponent->ApplyGameplayEffectSpecToSelf(*SpecHandle.Data.Get());
 			}
 		}
 	}
-
-
-	
 }
 
 
@@ -466,7 +543,7 @@ void AMYYCharacterBase::Die(AActor* Killer)
 {
 	if (!IsAlive()) return;
 
-	UE_LOG(LogTemp, Warning, TEXT("💀 %s died! Killer: %s"), 
+	UE_LOG(LogMYYCombat, Log, TEXT("💀 %s died! Killer: %s"), 
 		*GetName(), *GetNameSafe(Killer));
 
 	// ========== REMOVED: Weapon dropping (now handled by GA_Death) ==========
@@ -491,8 +568,140 @@ void AMYYCharacterBase::Die(AActor* Killer)
 	// GetMesh()->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
 
 	// ========== DESTROY AFTER DELAY ==========
-	// NOTE: GA_Death also sets lifespan, this may be redundant
-	SetLifeSpan(5.0f);
+	// NOTE: GA_Death also removes the corpse, this may be redundant
+	RemoveCorpse(5.0f);
+}
+
+void AMYYCharacterBase::RemoveCorpse(float Delay)
+{
+	if (!HasAuthority())
+	{
+		return;
+	}
+
+	UMinionPoolSubsystem* MinionPool = GetWorld()->GetSubsystem<UMinionPoolSubsystem>();
+	if (MinionPool && MinionPool->IsManaged(this))
+	{
+		MinionPool->ReleaseMinion(this, Delay);
+		return;
+	}
+
+	SetLifeSpan(Delay);
+}
+
+void AMYYCharacterBase::DeactivateForPool()
+{
+	if (!HasAuthority())
+	{
+		return;
+	}
+
+	// A pending corpse lifespan would destroy the pooled actor
+	SetLifeSpan(0.f);
+
+	ForceStopAllCombatTraces();
+
+	if (AbilitySystemComponent)
+	{
+		AbilitySystemComponent->CancelAllAbilities();
+	}
+
+	if (UAnimInstance* AnimInstance = GetMesh() ? GetMesh()->GetAnimInstance() : nullptr)
+	{
+		AnimInstance->StopAllMontages(0.f);
+	}
+
+	GetCharacterMovement()->StopMovementImmediately();
+	GetCharacterMovement()->DisableMovement();
+
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+
+	// Parked characters cost nothing per frame
+	SetActorTickEnabled(false);
+	GetCharacterMovement()->SetComponentTickEnabled(false);
+	GetMesh()->SetComponentTickEnabled(false);
+
+	if (ULagCompensationSubsystem* LagCompensation = GetWorld()->GetSubsystem<ULagCompensationSubsystem>())
+	{
+		LagCompensation->UnregisterCharacter(this);
+	}
+
+	if (UTargetGridSubsystem* TargetGrid = GetWorld()->GetSubsystem<UTargetGridSubsystem>())
+	{
+		TargetGrid->UnregisterCharacter(this);
+	}
+}
+
+void AMYYCharacterBase::ReactivateFromPool(const FTransform& SpawnTransform)
+{
+	if (!HasAuthority())
+	{
+		return;
+	}
+
+	// Collision back on first: TeleportTo only looks for a free spot for a capsule that collides
+	const AMYYCharacterBase* Defaults = GetClass()->GetDefaultObject<AMYYCharacterBase>();
+	GetCapsuleComponent()->SetCollisionEnabled(Defaults->GetCapsuleComponent()->GetCollisionEnabled());
+	SetActorEnableCollision(true);
+
+	// Nudged out of anything standing on the spawn point, like AdjustIfPossibleButAlwaysSpawn
+	if (!TeleportTo(SpawnTransform.GetLocation(), SpawnTransform.Rotator()))
+	{
+		SetActorLocationAndRotation(SpawnTransform.GetLocation(), SpawnTransform.Rotator(), false, nullptr, ETeleportType::ResetPhysics);
+	}
+
+	bIsDead = false;
+	EndBlockWindow();
+	bIsAiming = false;
+	MARK_PROPERTY_DIRTY_FROM_NAME(AMYYCharacterBase, bIsAiming, this);
+	CurrentTarget = nullptr;
+	HitActorsThisSwing.Reset();
+
+	// Never possessed yet (prewarmed): InitializeAbilitySystem does the full setup on possession
+	if (bAbilitySystemInitialized && AbilitySystemComponent && AttributeSet)
+	{
+		// Effects and loose tags left over from the last life
+		for (const FActiveGameplayEffectHandle& EffectHandle : AbilitySystemComponent->GetActiveGameplayEffects().GetAllActiveEffectHandles())
+		{
+			AbilitySystemComponent->RemoveActiveGameplayEffect(EffectHandle);
+		}
+
+		FGameplayTagContainer OwnedTags;
+		AbilitySystemComponent->GetOwnedGameplayTags(OwnedTags);
+		for (const FGameplayTag& Tag : OwnedTags)
+		{
+			AbilitySystemComponent->SetLooseGameplayTagCount(Tag, 0);
+		}
+
+		AttributeSet->bIsDead = false;
+		AbilitySystemComponent->SetNumericAttributeBase(UAttributeSetBase::GetHealthAttribute(), AttributeSet->GetMaxHealth());
+		AbilitySystemComponent->SetNumericAttributeBase(UAttributeSetBase::GetStaminaAttribute(), AttributeSet->GetMaxStamina());
+
+		ApplyDefaultEffects();
+	}
+
+	if (EquipmentComponent)
+	{
+		EquipmentComponent->ResetLoadout();
+	}
+
+	SetActorHiddenInGame(false);
+
+	SetActorTickEnabled(PrimaryActorTick.bStartWithTickEnabled);
+	GetCharacterMovement()->SetComponentTickEnabled(true);
+	GetCharacterMovement()->SetDefaultMovementMode();
+	GetMesh()->SetComponentTickEnabled(true);
+
+	if (ULagCompensationSubsystem* LagCompensation = GetWorld()->GetSubsystem<ULagCompensationSubsystem>())
+	{
+		LagCompensation->RegisterCharacter(this);
+	}
+
+	if (UTargetGridSubsystem* TargetGrid = GetWorld()->GetSubsystem<UTargetGridSubsystem>())
+	{
+		TargetGrid->RegisterCharacter(this);
+	}
 }
 
 
@@ -512,9 +721,105 @@ void AMYYCharacterBase::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& Ou
     Super::GetLifetimeReplicatedProps(OutLifetimeProps);
     DOREPLIFETIME(AMYYCharacterBase, EquipmentComponent);
     DOREPLIFETIME(AMYYCharacterBase, CurrentTarget);
-	DOREPLIFETIME(AMYYCharacterBase, bIsInBlockWindow);
-	DOREPLIFETIME(AMYYCharacterBase, bIsAiming);
-	DOREPLIFETIME(AMYYCharacterBase, TeamID);          
+
+	// Rarely change: push model, only compared after a setter marked them dirty
+	FDoRepLifetimeParams PushParams;
+	PushParams.bIsPushBased = true;
+
+	DOREPLIFETIME_WITH_PARAMS_FAST(AMYYCharacterBase, bIsAiming, PushParams);
+	DOREPLIFETIME_WITH_PARAMS_FAST(AMYYCharacterBase, TeamID, PushParams);
+}
+
+void AMYYCharacterBase::PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker)
+{
+	Super::PreReplication(ChangedPropertyTracker);
+
+	// bIsAiming, TeamID
+	MYYNetStats::RecordPushModelPass(2);
+}
+
+void AMYYCharacterBase::SetTeamID(uint8 NewTeamID)
+{
+	if (TeamID == NewTeamID) return;
+
+	TeamID = NewTeamID;
+	MARK_PROPERTY_DIRTY_FROM_NAME(AMYYCharacterBase, TeamID, this);
+	MYYNetStats::RecordDirtyMark();
+}
+
+bool AMYYCharacterBase::IsInBlockWindow() const
+{
+	if (!HasAuthority())
+	{
+		return AbilitySystemComponent && AbilitySystemComponent->HasMatchingGameplayTag(MYYTags::State_Combat_BlockWindow);
+	}
+
+	if (BlockStartTime < 0.0)
+	{
+		return false;
+	}
+
+	const double MontageTime = GetWorld()->GetTimeSeconds() - BlockStartTime;
+	return MontageTime >= BlockWindowBegin && MontageTime <= BlockWindowEnd;
+}
+
+void AMYYCharacterBase::StartBlockWindow(const UAnimMontage* BlockMontage, int16 BlockKey)
+{
+	if (!HasAuthority() || !UAnimNotifyState_BlockWindow::FindWindowRange(BlockMontage, BlockWindowBegin, BlockWindowEnd))
+	{
+		EndBlockWindow();
+		return;
+	}
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	const double MaxRewind = CVarBlockMaxRewind.GetValueOnGameThread();
+
+	// The montage started on the owner about half a round trip ago
+	const APlayerState* OwnerPlayerState = IsPlayerControlled() && !IsLocallyControlled() ? GetPlayerState() : nullptr;
+	const double HalfRoundTrip = OwnerPlayerState ? OwnerPlayerState->GetPingInMilliseconds() * 0.0005 : 0.0;
+	BlockStartTime = Now - FMath::Min(HalfRoundTrip, MaxRewind);
+	CurrentBlockKey = BlockKey;
+	bBlockStartTimeConsumed = false;
+
+	// The client's timestamp is unreliable and can get here before the activation
+	if (PendingBlockStartTime >= 0.0 && PendingBlockKey == BlockKey && Now - PendingBlockStartTime <= MaxRewind)
+	{
+		BlockStartTime = FMath::Min(BlockStartTime, PendingBlockStartTime);
+		bBlockStartTimeConsumed = true;
+	}
+	PendingBlockStartTime = -1.0;
+
+	UE_LOG(LogMYYCombat, Verbose, TEXT("%s block window %.2f-%.2fs, started %.3fs ago"),
+		*GetName(), BlockWindowBegin, BlockWindowEnd, Now - BlockStartTime);
+}
+
+void AMYYCharacterBase::EndBlockWindow()
+{
+	BlockStartTime = -1.0;
+	PendingBlockStartTime = -1.0;
+}
+
+void AMYYCharacterBase::Server_SetBlockStartTime_Implementation(double ClientServerTime, int16 BlockKey)
+{
+	// Never in the future, never further back than MaxRewind
+	const double Now = GetWorld()->GetTimeSeconds();
+	const double StartTime = FMath::Clamp(ClientServerTime, Now - CVarBlockMaxRewind.GetValueOnGameThread(), Now);
+
+	if (BlockStartTime >= 0.0 && BlockKey == CurrentBlockKey)
+	{
+		// One per block, and only earlier than the ping estimate: resending can't slide the window along the hold
+		if (!bBlockStartTimeConsumed)
+		{
+			BlockStartTime = FMath::Min(BlockStartTime, StartTime);
+			bBlockStartTimeConsumed = true;
+		}
+	}
+	else
+	{
+		// Ahead of its activation; a late one from an earlier block won't match the next key
+		PendingBlockStartTime = StartTime;
+		PendingBlockKey = BlockKey;
+	}
 }
 
 void AMYYCharacterBase::DisableMovementDuringAbility(bool bDisable)
@@ -533,11 +838,6 @@ void AMYYCharacterBase::DisableMovementDuringAbility(bool bDisable)
 	}
 }
 
-void AMYYCharacterBase::OnRep_IsInBlockWindow()
-{
-	// Visual feedback for block window can go here
-}
-
 
 
 
@@ -549,18 +849,13 @@ void AMYYCharacterBase::Server_Interact_Implementation(AActor* InteractableActor
 	}
 }
 
-void AMYYCharacterBase::Server_SetBlockWindow_Implementation(bool bInWindow)
-{
-	bIsInBlockWindow = bInWindow;
-}
-
 void AMYYCharacterBase::PerformBlock()
 {
 	if (!AbilitySystemComponent) return;
 
 	// Try to activate block ability
 	FGameplayTagContainer AbilityTags;
-	AbilityTags.AddTag(FGameplayTag::RequestGameplayTag("Ability.Combat.Block"));
+	AbilityTags.AddTag(MYYTags::Ability_Combat_Block);
     
 	AbilitySystemComponent->TryActivateAbilitiesByTag(AbilityTags);
 }
@@ -571,7 +866,7 @@ void AMYYCharacterBase::StopBlocking()
 
 	// Cancel block ability
 	FGameplayTagContainer BlockTags;
-	BlockTags.AddTag(FGameplayTag::RequestGameplayTag("State.Combat.Blocking"));
+	BlockTags.AddTag(MYYTags::State_Combat_Blocking);
     
 	AbilitySystemComponent->CancelAbilities(&BlockTags);
 }
@@ -581,7 +876,12 @@ void AMYYCharacterBase::SetAiming(bool bInAiming)
 {
 	if (!HasAuthority()) return;
     
-	bIsAiming = bInAiming;
+	if (bIsAiming != bInAiming)
+	{
+		bIsAiming = bInAiming;
+		MARK_PROPERTY_DIRTY_FROM_NAME(AMYYCharacterBase, bIsAiming, this);
+		MYYNetStats::RecordDirtyMark();
+	}
     
 	UE_LOG(LogTemp, Log, TEXT("[MYYCharacterBase] %s: Aiming = %s"), 
 		*GetName(), bIsAiming ? TEXT("TRUE") : TEXT("FALSE"));
@@ -647,6 +947,25 @@ void AMYYCharacterBase::StartUnarmedTrace(
 	bIsUnarmedTracing = true;
 	ActiveUnarmedTraceSockets = TraceSockets;
 	HitActorsThisSwing.Reset();
+
+	// First step sweeps in place, later steps from each socket's previous position
+	LastUnarmedSocketLocations.Reset();
+
+	if (EquipmentComponent && EquipmentComponent->DefaultUnarmedData &&
+		UnarmedDamageSpecCache.Arm(AbilitySystemComponent, EquipmentComponent->DefaultUnarmedData->DamageEffect,
+			this, this, MYYTags::Ability_Attack_Unarmed))
+	{
+		const FWeaponStats& UnarmedStats = EquipmentComponent->DefaultUnarmedData->Stats;
+		UnarmedDamageSpecCache.SetSetByCallerMagnitude(MYYTags::Data_CritChance, UnarmedStats.CriticalHitChance);
+		UnarmedDamageSpecCache.SetSetByCallerMagnitude(MYYTags::Data_CritMultiplier, UnarmedStats.CriticalHitMultiplier);
+		UnarmedDamageSpecCache.SetSetByCallerMagnitude(MYYTags::Data_BlockReduction, UnarmedStats.BlockDamageReduction);
+	}
+
+	// Unarmed traces read live bone positions
+	SetServerPoseEvaluation(true);
+
+	// Tick drives the trace only while this window is open
+	SetActorTickEnabled(true);
 }
 
 void AMYYCharacterBase::EndUnarmedTrace()
@@ -655,7 +974,14 @@ void AMYYCharacterBase::EndUnarmedTrace()
 
 	bIsUnarmedTracing = false;
 	ActiveUnarmedTraceSockets.Reset();
+	LastUnarmedSocketLocations.Reset();
 	HitActorsThisSwing.Reset();
+	UnarmedDamageSpecCache.Reset();
+
+	SetServerPoseEvaluation(false);
+
+	// Back to the class default (off unless a subclass ticks for its own reasons)
+	SetActorTickEnabled(PrimaryActorTick.bStartWithTickEnabled);
 }
 
 
@@ -703,8 +1029,7 @@ void AMYYCharacterBase::ForceStopAllCombatTraces()
 	 * UNARMED TRACE CLEANUP
 	 * =============================== */
 
-	bIsUnarmedTracing = false;
-	ActiveUnarmedTraceSockets.Reset();
+	EndUnarmedTrace();
 
 	/* ===============================
 	 * SHARED STATE
@@ -736,7 +1061,7 @@ void AMYYCharacterBase::PerformUnarmedTrace(
 
     if (!InstigatorASC)
     {
-        UE_LOG(LogTemp, Warning,
+        UE_LOG(LogMYYCombat, Verbose,
             TEXT("⚠️ Unarmed trace: InstigatorASC missing on %s"),
             *GetName());
         return;
@@ -748,31 +1073,27 @@ void AMYYCharacterBase::PerformUnarmedTrace(
     const float BaseDamage =
         EquipmentComponent->DefaultUnarmedData->Stats.BaseDamage;
 
-    TSubclassOf<UGameplayEffect> DamageEffect =
-        EquipmentComponent->DefaultUnarmedData->DamageEffect;
+    FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(UnarmedTrace), false, this);
 
-    if (!DamageEffect)
-    {
-        UE_LOG(LogTemp, Error,
-            TEXT("❌ UnarmedDamageEffect missing on %s"),
-            *GetName());
-        return;
-    }
-
-    FCollisionQueryParams QueryParams;
-    QueryParams.AddIgnoredActor(this);
-    QueryParams.bTraceComplex = false;
+    // Sockets can change between notifies; a size mismatch restarts the sweep in place
+    const bool bHasLastLocations = LastUnarmedSocketLocations.Num() == TraceSockets.Num();
+    LastUnarmedSocketLocations.SetNum(TraceSockets.Num());
 
-    for (const FUnarmedTraceSocket& TraceData : TraceSockets)
+    for (int32 SocketIndex = 0; SocketIndex < TraceSockets.Num(); ++SocketIndex)
     {
+        const FUnarmedTraceSocket& TraceData = TraceSockets[SocketIndex];
         const FVector Center =
             MeshComp->GetSocketLocation(TraceData.SocketOrBone);
 
-        TArray<FHitResult> HitResults;
+        // Sweep the path the fist/foot took since the last step, so fast strikes can't tunnel
+        const FVector From = bHasLastLocations ? LastUnarmedSocketLocations[SocketIndex] : Center;
+        LastUnarmedSocketLocations[SocketIndex] = Center;
+
+        TArray<FHitResult>& HitResults = UnarmedHitScratch;
 
         GetWorld()->SweepMultiByChannel(
             HitResults,
-            Center,
+            From,
             Center,
             FQuat::Identity,
             ECC_Pawn,
@@ -783,6 +1104,7 @@ void AMYYCharacterBase::PerformUnarmedTrace(
 #if !UE_BUILD_SHIPPING
     	if (EquipmentComponent->DefaultUnarmedData->bDebugUnArmedTrace)
     	{
+    		DrawDebugLine(GetWorld(), From, Center, FColor::Green, false, 0.1f);
     		DrawDebugSphere(
 			GetWorld(),
 			Center,
@@ -810,74 +1132,8 @@ void AMYYCharacterBase::PerformUnarmedTrace(
 
             HitActorsThisSwing.Add(HitActor);
 
-            float Damage = BaseDamage;
-            bool bWasParried = false;
-
-            // ======================
-            // BLOCK / PARRY
-            // ======================
-            if (AMYYCharacterBase* TargetChar = Cast<AMYYCharacterBase>(HitActor))
-            {
-                if (TargetChar->bIsInBlockWindow)
-                {
-                    bWasParried = true;
-                    Damage = 0.f;
-
-                    FGameplayEventData ParryEvent;
-                    ParryEvent.Instigator = OwnerActor;
-                    ParryEvent.Target = HitActor;
-
-                    TargetASC->HandleGameplayEvent(
-                        FGameplayTag::RequestGameplayTag("GameplayEvent.Parry"),
-                        &ParryEvent);
-
-                    FGameplayEventData StaggerEvent;
-                    StaggerEvent.Instigator = HitActor;
-                    StaggerEvent.Target = OwnerActor;
-
-                    InstigatorASC->HandleGameplayEvent(
-                        FGameplayTag::RequestGameplayTag("GameplayEvent.Stagger"),
-                        &StaggerEvent);
-                }
-            }
-            else if (TargetASC->HasMatchingGameplayTag(
-                FGameplayTag::RequestGameplayTag("State.Combat.Blocking")))
-            {
-                Damage *= 0.3f;
-            }
-
-            // ======================
-            // APPLY DAMAGE (GAS)
-            // ======================
-            if (!bWasParried && Damage > 0.f)
-            {
-                FGameplayEffectContextHandle Context =
-                    InstigatorASC->MakeEffectContext();
-
-                Context.AddSourceObject(this);
-                Context.AddHitResult(Hit);
-                Context.AddInstigator(OwnerActor, GetController());
-
-                FGameplayEffectSpecHandle Spec =
-                    InstigatorASC->MakeOutgoingSpec(
-                        DamageEffect, 1.f, Context);
-
-                if (Spec.IsValid())
-                {
-                    Spec.Data->SetSetByCallerMagnitude(
-                        FGameplayTag::RequestGameplayTag("Data.Damage"),
-                        Damage);
-
-                    Spec.Data->CapturedSourceTags
-                        .GetSpecTags()
-                        .AddTag(
-                            FGameplayTag::RequestGameplayTag(
-                                "Ability.Attack.Unarmed"));
-
-                    InstigatorASC->ApplyGameplayEffectSpecToTarget(
-                        *Spec.Data.Get(), TargetASC);
-                }
-            }
+            // Crit, block, parry and the health clamp all resolve in UMYYDamageExecution
+            UnarmedDamageSpecCache.ApplyDamage(TargetASC, BaseDamage, Hit);
         }
     }
 }
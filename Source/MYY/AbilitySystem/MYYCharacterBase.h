@@ -10,6 +10,7 @@
 #include "GameplayTagContainer.h"
 #include "GenericTeamAgentInterface.h"
 #include "MYY/Enums/AbilityInputTypes.h"
+#include "MYY/AbilitySystem/Combat/DamageSpecCache.h"
 #include "MYYCharacterBase.generated.h"
 
 
@@ -43,10 +44,12 @@ public:
 	// Sets default values for this character's properties
 	AMYYCharacterBase();
 	
-	// 0=Player, 1=Enemy, 2=Neutral
+	// 0=Player, 1=Enemy, 2=Neutral. Push model: set through SetTeamID at runtime.
 	UPROPERTY(Replicated, EditAnywhere, BlueprintReadWrite, Category = "Team")
 	uint8 TeamID = 0;
 
+	void SetTeamID(uint8 NewTeamID);
+
 	// IGenericTeamAgentInterface
 	virtual FGenericTeamId GetGenericTeamId() const override;
 	virtual ETeamAttitude::Type GetTeamAttitudeTowards(const AActor& Other) const override;
@@ -166,13 +169,24 @@ public:
 	UPROPERTY()
 	TMap<TSubclassOf<UGameplayAbility>, FGameplayAbilitySpecHandle> GrantedAbilityHandles;
 
-	// CharacterBase.h - Add this property
-	UPROPERTY(ReplicatedUsing = OnRep_IsInBlockWindow, BlueprintReadWrite, Category = "Combat")
-	bool bIsInBlockWindow = false;
- 
-
-	UFUNCTION(Server, Reliable )
-	void Server_SetBlockWindow(bool bInWindow);
+	// Parry/block window of the current block (UAnimNotifyState_BlockWindow in the block montage).
+	// Server: derived from when the block montage started and the notify's range in the asset,
+	// so it doesn't depend on when the notify fires on either machine. Elsewhere: the BlockWindow
+	// tag the notify adds locally (cosmetic).
+	UFUNCTION(BlueprintPure, Category = "Combat")
+	bool IsInBlockWindow() const;
+
+	// Server. Called by GA_Block when its montage starts (StartBlockWindow) and when it ends.
+	// BlockKey: the activation's prediction key, which the owner sends back with its timestamp.
+	// The start is taken back by half the owner's ping until the client's timestamp arrives.
+	void StartBlockWindow(const UAnimMontage* BlockMontage, int16 BlockKey);
+	void EndBlockWindow();
+
+	// Owning client: when the block montage started here, in server world time (GameState).
+	// Sent by GA_Block with the activation's prediction key; the server takes one per block and only
+	// to move the start earlier than its ping estimate. A lost one leaves the estimate.
+	UFUNCTION(Server, Unreliable)
+	void Server_SetBlockStartTime(double ClientServerTime, int16 BlockKey);
  
 	UFUNCTION(Server, Reliable)
 	void Server_Interact(AActor* InteractableActor);
@@ -191,29 +205,71 @@ public:
 	UPROPERTY()
 	TArray<FUnarmedTraceSocket> ActiveUnarmedTraceSockets;
 
+	// Unarmed damage spec, armed in StartUnarmedTrace
+	FDamageSpecCache UnarmedDamageSpecCache;
+
+	// Socket positions at the previous trace step (parallel to ActiveUnarmedTraceSockets)
+	TArray<FVector> LastUnarmedSocketLocations;
+
+	TArray<FHitResult> UnarmedHitScratch;
+
+	// Opened/closed by AnimNotify_StartUnarmedTrace / AnimNotify_EndUnarmedTrace.
+	// The character only ticks while a window is open.
 	void StartUnarmedTrace(	const TArray<FUnarmedTraceSocket>& TraceSockets);
 	void EndUnarmedTrace();
  
 	void ForceStopAllCombatTraces();
 
 	//  Unarmed Trace system End  -----------------------------
+
+	// ========== POOLING ==========
+
+	// Corpse cleanup after death: back to UMinionPoolSubsystem if the pool owns this character, otherwise SetLifeSpan(Delay)
+	void RemoveCorpse(float Delay);
+
+	// Called by UMinionPoolSubsystem. Deactivate hides and parks the character; Reactivate puts it back at
+	// SpawnTransform with full attributes, no leftover effects or tags, and the default loadout.
+	void DeactivateForPool();
+	void ReactivateFromPool(const FTransform& SpawnTransform);
+
+	// Set before possession to leave InitializeAbilitySystem to the caller instead of PossessedBy's timer
+	// (UMinionSpawnDirectorSubsystem time-slices it)
+	bool bDeferAbilitySystemInit = false;
+
+	void InitializeAbilitySystem();
 	
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	void BindAttributeCallbacks();
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AbilitySystem", meta = (DisplayPriority = 100))
 	EGameplayEffectReplicationMode ASCReplicationMode = EGameplayEffectReplicationMode::Mixed;
 
+	// Dedicated server: tick montages only and skip bone evaluation for this character.
+	// Weapon traces read the baked trajectory tracks; bones are refreshed only while an unarmed trace is open.
+	UPROPERTY(EditDefaultsOnly, Category = "Performance")
+	bool bOnlyTickMontagesOnDedicatedServer = false;
+
+	// Switches between full pose ticking and montage-only ticking when bOnlyTickMontagesOnDedicatedServer is set
+	void SetServerPoseEvaluation(bool bEvaluatePose);
+
+	// The mesh's VisibilityBasedAnimTickOption as configured, restored by SetServerPoseEvaluation(true)
+	EVisibilityBasedAnimTickOption ConfiguredAnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
+
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+	virtual void PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker) override;
 	
 	// AI
 	virtual void PossessedBy(AController* NewController) override;
 	// player start or replicated
 	virtual void OnRep_PlayerState() override;
 
-	void InitializeAbilitySystem();
+	void ApplyDefaultEffects();
+
+	// Abilities granted, callbacks bound and default effects applied (once per actor, survives pooling)
+	bool bAbilitySystemInitialized = false;
 
 	// Attribute callbacks
 	virtual void OnHealthAttributeChanged(const FOnAttributeChangeData& Data);
@@ -221,8 +277,19 @@ protected:
 	UPROPERTY(Replicated)
 	AActor* CurrentTarget;
 
-	UFUNCTION()
-	void OnRep_IsInBlockWindow();
+	// Server. Block montage start (server world time, -1 while not blocking) and the window's range
+	// in that montage, from StartBlockWindow / Server_SetBlockStartTime
+	double BlockStartTime = -1.0;
+	float BlockWindowBegin = 0.f;
+	float BlockWindowEnd = 0.f;
+
+	// Server. Prediction key of the current block, and whether its client timestamp was used
+	int16 CurrentBlockKey = 0;
+	bool bBlockStartTimeConsumed = false;
+
+	// Server. Client timestamp that arrived before its block activation (-1 for none), and its key
+	double PendingBlockStartTime = -1.0;
+	int16 PendingBlockKey = 0;
 
 	virtual void OnStaminaAttributeChanged(const FOnAttributeChangeData& Data);
 	
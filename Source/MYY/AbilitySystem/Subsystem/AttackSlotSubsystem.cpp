@@ -0,0 +1,270 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AttackSlotSubsystem.h"
+#include "MYY/MYY.h"
+#include "MYY/AbilitySystem/MYYCharacterBase.h"
+#include "MYY/AbilitySystem/GameplayTags/MYYGameplayTags.h"
+#include "AbilitySystemComponent.h"
+#include "Abilities/GameplayAbility.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Attack Slots Granted"), STAT_MYY_AttackSlotsGranted, STATGROUP_MYYCombat);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Attack Slots Deferred"), STAT_MYY_AttackSlotsDeferred, STATGROUP_MYYCombat);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Attack Slots Held"), STAT_MYY_AttackSlotsHeld, STATGROUP_MYYCombat);
+
+static TAutoConsoleVariable<int32> CVarAttackSlotsPerTarget(
+	TEXT("MYY.AI.AttackSlots.PerTarget"),
+	2,
+	TEXT("Minions allowed to run a melee attack on the same target at once. 0 = unlimited."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarAttackSlotsMaxHoldTime(
+	TEXT("MYY.AI.AttackSlots.MaxHoldTime"),
+	4.f,
+	TEXT("Seconds before a slot is taken back even if the attack ability hasn't ended."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarAttackSlotsQueueTimeout(
+	TEXT("MYY.AI.AttackSlots.QueueTimeout"),
+	1.5f,
+	TEXT("Seconds a deferred minion keeps its place in the queue without asking again."),
+	ECVF_Default);
+
+bool UAttackSlotSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UAttackSlotSubsystem::Deinitialize()
+{
+	for (TPair<TWeakObjectPtr<AActor>, FTargetSlots>& Pair : Targets)
+	{
+		for (int32 SlotIndex = Pair.Value.Slots.Num() - 1; SlotIndex >= 0; --SlotIndex)
+		{
+			FreeSlot(Pair.Value, SlotIndex);
+		}
+	}
+	Targets.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UAttackSlotSubsystem::RequestSlot(AMYYCharacterBase* Attacker, AActor* Target, bool* bOutNewlyGranted)
+{
+	if (bOutNewlyGranted)
+	{
+		*bOutNewlyGranted = false;
+	}
+
+	if (!Attacker || !Target)
+	{
+		return false;
+	}
+
+	const int32 MaxSlots = CVarAttackSlotsPerTarget.GetValueOnGameThread();
+	if (MaxSlots <= 0)
+	{
+		return true;
+	}
+
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	// Targets that are gone
+	for (auto It = Targets.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().IsValid())
+		{
+			for (int32 SlotIndex = It.Value().Slots.Num() - 1; SlotIndex >= 0; --SlotIndex)
+			{
+				FreeSlot(It.Value(), SlotIndex);
+			}
+			It.RemoveCurrent();
+		}
+	}
+
+	FTargetSlots& TargetSlots = Targets.FindOrAdd(Target);
+	PruneTarget(TargetSlots, Now);
+
+	if (TargetSlots.Slots.ContainsByPredicate([Attacker](const FAttackSlot& Slot) { return Slot.Attacker.Get() == Attacker; }))
+	{
+		return true;
+	}
+
+	// One slot per attacker: switching targets gives up the old one
+	for (TPair<TWeakObjectPtr<AActor>, FTargetSlots>& Pair : Targets)
+	{
+		if (&Pair.Value == &TargetSlots)
+		{
+			continue;
+		}
+
+		const int32 OldSlotIndex = Pair.Value.Slots.IndexOfByPredicate([Attacker](const FAttackSlot& Slot)
+		{
+			return Slot.Attacker.Get() == Attacker;
+		});
+		if (OldSlotIndex != INDEX_NONE)
+		{
+			FreeSlot(Pair.Value, OldSlotIndex);
+		}
+	}
+
+	// Queued minions go first, in order
+	const int32 FreeSlots = MaxSlots - TargetSlots.Slots.Num();
+	int32 QueueIndex = TargetSlots.Queue.IndexOfByPredicate([Attacker](const FQueuedAttacker& Queued)
+	{
+		return Queued.Attacker.Get() == Attacker;
+	});
+
+	if ((QueueIndex == INDEX_NONE ? TargetSlots.Queue.Num() : QueueIndex) < FreeSlots)
+	{
+		if (QueueIndex != INDEX_NONE)
+		{
+			TargetSlots.Queue.RemoveAt(QueueIndex);
+		}
+
+		FAttackSlot& Slot = TargetSlots.Slots.AddDefaulted_GetRef();
+		Slot.Attacker = Attacker;
+		Slot.ExpireTime = Now + CVarAttackSlotsMaxHoldTime.GetValueOnGameThread();
+		if (UAbilitySystemComponent* ASC = Attacker->AbilitySystemComponent)
+		{
+			Slot.AbilitySystem = ASC;
+			Slot.AbilityEndedHandle = ASC->OnAbilityEnded.AddUObject(this, &UAttackSlotSubsystem::OnAttackerAbilityEnded,
+				TWeakObjectPtr<AActor>(Attacker));
+		}
+
+		++TotalGranted;
+		INC_DWORD_STAT(STAT_MYY_AttackSlotsGranted);
+		INC_DWORD_STAT(STAT_MYY_AttackSlotsHeld);
+		if (bOutNewlyGranted)
+		{
+			*bOutNewlyGranted = true;
+		}
+		return true;
+	}
+
+	if (QueueIndex == INDEX_NONE)
+	{
+		QueueIndex = TargetSlots.Queue.Num();
+		TargetSlots.Queue.AddDefaulted_GetRef().Attacker = Attacker;
+	}
+	TargetSlots.Queue[QueueIndex].LastRequestTime = Now;
+
+	++TotalDeferred;
+	INC_DWORD_STAT(STAT_MYY_AttackSlotsDeferred);
+	return false;
+}
+
+void UAttackSlotSubsystem::ReleaseSlot(AActor* Attacker)
+{
+	for (TPair<TWeakObjectPtr<AActor>, FTargetSlots>& Pair : Targets)
+	{
+		FTargetSlots& TargetSlots = Pair.Value;
+
+		const int32 SlotIndex = TargetSlots.Slots.IndexOfByPredicate([Attacker](const FAttackSlot& Slot)
+		{
+			return Slot.Attacker.Get() == Attacker;
+		});
+		if (SlotIndex != INDEX_NONE)
+		{
+			FreeSlot(TargetSlots, SlotIndex);
+		}
+
+		TargetSlots.Queue.RemoveAll([Attacker](const FQueuedAttacker& Queued)
+		{
+			return Queued.Attacker.Get() == Attacker;
+		});
+	}
+}
+
+bool UAttackSlotSubsystem::HasSlot(const AActor* Attacker, const AActor* Target) const
+{
+	const FTargetSlots* TargetSlots = Targets.Find(Target);
+	return TargetSlots && TargetSlots->Slots.ContainsByPredicate([Attacker](const FAttackSlot& Slot)
+	{
+		return Slot.Attacker.Get() == Attacker;
+	});
+}
+
+int32 UAttackSlotSubsystem::GetNumAttackers(const AActor* Target) const
+{
+	const FTargetSlots* TargetSlots = Targets.Find(Target);
+	return TargetSlots ? TargetSlots->Slots.Num() : 0;
+}
+
+void UAttackSlotSubsystem::PruneTarget(FTargetSlots& TargetSlots, double Now)
+{
+	for (int32 SlotIndex = TargetSlots.Slots.Num() - 1; SlotIndex >= 0; --SlotIndex)
+	{
+		const FAttackSlot& Slot = TargetSlots.Slots[SlotIndex];
+		const AMYYCharacterBase* Attacker = Slot.Attacker.Get();
+		if (!Attacker || !Attacker->IsAlive() || Now >= Slot.ExpireTime)
+		{
+			FreeSlot(TargetSlots, SlotIndex);
+		}
+	}
+
+	// Deferred minions that went off to do something else
+	const double QueueCutoff = Now - CVarAttackSlotsQueueTimeout.GetValueOnGameThread();
+	TargetSlots.Queue.RemoveAll([QueueCutoff](const FQueuedAttacker& Queued)
+	{
+		return !Queued.Attacker.IsValid() || Queued.LastRequestTime < QueueCutoff;
+	});
+}
+
+void UAttackSlotSubsystem::FreeSlot(FTargetSlots& TargetSlots, int32 SlotIndex)
+{
+	FAttackSlot& Slot = TargetSlots.Slots[SlotIndex];
+	if (UAbilitySystemComponent* ASC = Slot.AbilitySystem.Get())
+	{
+		ASC->OnAbilityEnded.Remove(Slot.AbilityEndedHandle);
+	}
+
+	TargetSlots.Slots.RemoveAtSwap(SlotIndex);
+	DEC_DWORD_STAT(STAT_MYY_AttackSlotsHeld);
+}
+
+void UAttackSlotSubsystem::OnAttackerAbilityEnded(const FAbilityEndedData& EndedData, TWeakObjectPtr<AActor> Attacker)
+{
+	const UGameplayAbility* Ability = EndedData.AbilityThatEnded;
+	if (Ability && Ability->GetAssetTags().HasTag(MYYTags::Ability_Attack_Melee))
+	{
+		ReleaseSlot(Attacker.Get());
+	}
+}
+
+void UAttackSlotSubsystem::DumpSlots() const
+{
+	UE_LOG(LogTemp, Warning, TEXT("📊 Attack slots: %d per target | granted %llu | deferred %llu"),
+		CVarAttackSlotsPerTarget.GetValueOnGameThread(), TotalGranted, TotalDeferred);
+
+	for (const TPair<TWeakObjectPtr<AActor>, FTargetSlots>& Pair : Targets)
+	{
+		const AActor* Target = Pair.Key.Get();
+		if (!Target)
+		{
+			continue;
+		}
+
+		FString Holders;
+		for (const FAttackSlot& Slot : Pair.Value.Slots)
+		{
+			Holders += FString::Printf(TEXT(" %s"), *GetNameSafe(Slot.Attacker.Get()));
+		}
+
+		UE_LOG(LogTemp, Warning, TEXT("   %s: %d attacking (%s ) | %d queued"),
+			*Target->GetName(), Pair.Value.Slots.Num(), *Holders, Pair.Value.Queue.Num());
+	}
+}
+
+// MYY.AI.AttackSlots.Dump
+static FAutoConsoleCommandWithWorld GAttackSlotsDumpCommand(
+	TEXT("MYY.AI.AttackSlots.Dump"),
+	TEXT("Logs who holds an attack slot on each target, queue lengths, and granted/deferred totals."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const UAttackSlotSubsystem* AttackSlots = World ? World->GetSubsystem<UAttackSlotSubsystem>() : nullptr)
+		{
+			AttackSlots->DumpSlots();
+		}
+	}));
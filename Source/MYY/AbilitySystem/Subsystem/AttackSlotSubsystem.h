@@ -0,0 +1,85 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AttackSlotSubsystem.generated.h"
+
+class AMYYCharacterBase;
+class UAbilitySystemComponent;
+struct FAbilityEndedData;
+
+/**
+ * Attack tokens per target, so only a few minions swing at the same character at once.
+ *
+ * A minion asks for a slot before activating its melee ability (UBTTask_MeleeAttack). Each target
+ * hands out at most MYY.AI.AttackSlots.PerTarget slots; everyone else is deferred and queued in
+ * request order, and the behavior tree sends them to a cheaper idle/strafe branch until a slot
+ * frees. A slot is held until the attacker's melee ability ends, the attacker dies, or the
+ * MYY.AI.AttackSlots.MaxHoldTime lease runs out.
+ */
+UCLASS()
+class MYY_API UAttackSlotSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	// UWorldSubsystem
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+
+	// True if Attacker holds (or was just given) a slot on Target. Otherwise queues Attacker and counts a deferral.
+	// bOutNewlyGranted is set only when this call gave the slot, i.e. when the caller owns releasing it.
+	bool RequestSlot(AMYYCharacterBase* Attacker, AActor* Target, bool* bOutNewlyGranted = nullptr);
+
+	// Frees whatever slot Attacker holds, and drops it from any queue
+	void ReleaseSlot(AActor* Attacker);
+
+	bool HasSlot(const AActor* Attacker, const AActor* Target) const;
+
+	int32 GetNumAttackers(const AActor* Target) const;
+
+	uint64 GetTotalGranted() const { return TotalGranted; }
+	uint64 GetTotalDeferred() const { return TotalDeferred; }
+
+	// Per-target slots, queues and totals to the log (MYY.AI.AttackSlots.Dump)
+	void DumpSlots() const;
+
+private:
+
+	struct FAttackSlot
+	{
+		TWeakObjectPtr<AMYYCharacterBase> Attacker;
+		TWeakObjectPtr<UAbilitySystemComponent> AbilitySystem;
+		FDelegateHandle AbilityEndedHandle;
+		double ExpireTime = 0.0;
+	};
+
+	struct FQueuedAttacker
+	{
+		TWeakObjectPtr<AActor> Attacker;
+		double LastRequestTime = 0.0;
+	};
+
+	struct FTargetSlots
+	{
+		TArray<FAttackSlot> Slots;
+
+		// Deferred attackers, oldest first
+		TArray<FQueuedAttacker> Queue;
+	};
+
+	// Drops dead, expired and stale entries
+	void PruneTarget(FTargetSlots& TargetSlots, double Now);
+
+	void FreeSlot(FTargetSlots& TargetSlots, int32 SlotIndex);
+
+	void OnAttackerAbilityEnded(const FAbilityEndedData& EndedData, TWeakObjectPtr<AActor> Attacker);
+
+	TMap<TWeakObjectPtr<AActor>, FTargetSlots> Targets;
+
+	uint64 TotalGranted = 0;
+	uint64 TotalDeferred = 0;
+};
@@ -0,0 +1,377 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "LagCompensationSubsystem.h"
+#include "MYY/MYY.h"
+#include "MYY/AbilitySystem/MYYCharacterBase.h"
+#include "Components/CapsuleComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/PlayerState.h"
+#include "HAL/IConsoleManager.h"
+#include "Algo/Sort.h"
+
+DECLARE_CYCLE_STAT(TEXT("Lag Comp Record"), STAT_MYY_LagCompRecord, STATGROUP_MYYCombat);
+DECLARE_CYCLE_STAT(TEXT("Lag Comp Rewind Query"), STAT_MYY_LagCompRewind, STATGROUP_MYYCombat);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Lag Comp Rewind Queries"), STAT_MYY_LagCompRewindQueries, STATGROUP_MYYCombat);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Lag Comp Tracked Characters"), STAT_MYY_LagCompTracked, STATGROUP_MYYCombat);
+DECLARE_MEMORY_STAT(TEXT("Lag Comp History"), STAT_MYY_LagCompMemory, STATGROUP_MYYCombat);
+
+static TAutoConsoleVariable<int32> CVarLagCompEnable(
+	TEXT("MYY.LagComp.Enable"),
+	1,
+	TEXT("1 = resolve melee and arrow hits from remote players against rewound hitboxes."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarLagCompMaxRewind(
+	TEXT("MYY.LagComp.MaxRewind"),
+	0.25f,
+	TEXT("Maximum time (seconds) hitboxes are rewound for a single attacker."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarLagCompInterpDelay(
+	TEXT("MYY.LagComp.InterpDelay"),
+	0.05f,
+	TEXT("Extra delay (seconds) of simulated proxies on clients, added to half the RTT."),
+	ECVF_Default);
+
+namespace LagCompensationPrivate
+{
+	// Squared distance between a segment and a triangle: zero when the segment passes through it,
+	// otherwise the closer of an endpoint over the face and the segment against each edge
+	float SegmentTriangleDistSq(const FVector& SegStart, const FVector& SegEnd,
+		const FVector& A, const FVector& B, const FVector& C, FVector& OutOnTriangle, FVector& OutOnSegment)
+	{
+		FVector TriangleNormal;
+		if (FMath::SegmentTriangleIntersection(SegStart, SegEnd, A, B, C, OutOnTriangle, TriangleNormal))
+		{
+			OutOnSegment = OutOnTriangle;
+			return 0.f;
+		}
+
+		float BestDistanceSq = MAX_flt;
+		const auto Consider = [&BestDistanceSq, &OutOnTriangle, &OutOnSegment](const FVector& OnTriangle, const FVector& OnSegment)
+		{
+			const float DistanceSq = FVector::DistSquared(OnTriangle, OnSegment);
+			if (DistanceSq < BestDistanceSq)
+			{
+				BestDistanceSq = DistanceSq;
+				OutOnTriangle = OnTriangle;
+				OutOnSegment = OnSegment;
+			}
+		};
+
+		Consider(FMath::ClosestPointOnTriangleToPoint(SegStart, A, B, C), SegStart);
+		Consider(FMath::ClosestPointOnTriangleToPoint(SegEnd, A, B, C), SegEnd);
+
+		const FVector Corners[3] = { A, B, C };
+		for (int32 Edge = 0; Edge < 3; ++Edge)
+		{
+			FVector EdgePoint, SegmentPoint;
+			FMath::SegmentDistToSegmentSafe(Corners[Edge], Corners[(Edge + 1) % 3], SegStart, SegEnd, EdgePoint, SegmentPoint);
+			Consider(EdgePoint, SegmentPoint);
+		}
+
+		return BestDistanceSq;
+	}
+}
+
+bool ULagCompensationSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void ULagCompensationSubsystem::Deinitialize()
+{
+	DEC_MEMORY_STAT_BY(STAT_MYY_LagCompMemory, Histories.Num() * HistoryCapacity * sizeof(FHitboxSnapshot));
+
+	Histories.Empty();
+	NumRegistered = 0;
+
+	Super::Deinitialize();
+}
+
+bool ULagCompensationSubsystem::IsTickable() const
+{
+	return NumRegistered > 0;
+}
+
+TStatId ULagCompensationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(ULagCompensationSubsystem, STATGROUP_Tickables);
+}
+
+void ULagCompensationSubsystem::RegisterCharacter(AMYYCharacterBase* Character)
+{
+	if (!Character || !Character->HasAuthority()) return;
+
+	FHitboxHistory* FreeSlot = nullptr;
+	for (FHitboxHistory& History : Histories)
+	{
+		if (History.Character.Get() == Character)
+		{
+			return;
+		}
+
+		if (!FreeSlot && !History.Character.IsValid())
+		{
+			FreeSlot = &History;
+		}
+	}
+
+	if (!FreeSlot)
+	{
+		FreeSlot = &Histories.AddDefaulted_GetRef();
+		FreeSlot->Snapshots.SetNum(HistoryCapacity);
+		INC_MEMORY_STAT_BY(STAT_MYY_LagCompMemory, HistoryCapacity * sizeof(FHitboxSnapshot));
+	}
+
+	FreeSlot->Character = Character;
+	FreeSlot->Head = 0;
+	FreeSlot->Count = 0;
+	++NumRegistered;
+
+	SET_DWORD_STAT(STAT_MYY_LagCompTracked, NumRegistered);
+}
+
+void ULagCompensationSubsystem::UnregisterCharacter(AMYYCharacterBase* Character)
+{
+	for (FHitboxHistory& History : Histories)
+	{
+		if (History.Character.Get() == Character)
+		{
+			History.Character.Reset();
+			History.Count = 0;
+			--NumRegistered;
+			break;
+		}
+	}
+
+	SET_DWORD_STAT(STAT_MYY_LagCompTracked, NumRegistered);
+}
+
+void ULagCompensationSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	SCOPE_CYCLE_COUNTER(STAT_MYY_LagCompRecord);
+
+	// Tickables run after the actor tick groups, so these are the final poses of the frame
+	const double Now = GetWorld()->GetTimeSeconds();
+	int32 NumAlive = 0;
+
+	for (FHitboxHistory& History : Histories)
+	{
+		if (History.Character.IsValid())
+		{
+			RecordSnapshot(History, Now);
+			++NumAlive;
+		}
+		else if (History.Count > 0)
+		{
+			// Destroyed without unregistering
+			History.Count = 0;
+		}
+	}
+
+	NumRegistered = NumAlive;
+}
+
+void ULagCompensationSubsystem::RecordSnapshot(FHitboxHistory& History, double Time) const
+{
+	const AMYYCharacterBase* Character = History.Character.Get();
+	const UCapsuleComponent* Capsule = Character->GetCapsuleComponent();
+
+	FHitboxSnapshot& Snapshot = History.Snapshots[History.Head];
+	Snapshot.Time = Time;
+	Snapshot.Location = Capsule->GetComponentLocation();
+	Snapshot.Rotation = Capsule->GetComponentQuat();
+	Snapshot.Radius = Capsule->GetScaledCapsuleRadius();
+	Snapshot.HalfHeight = Capsule->GetScaledCapsuleHalfHeight();
+
+	History.Head = (History.Head + 1) % HistoryCapacity;
+	History.Count = FMath::Min(History.Count + 1, HistoryCapacity);
+}
+
+bool ULagCompensationSubsystem::GetCapsuleAtTime(const FHitboxHistory& History, double Time, FHitboxSnapshot& OutCapsule) const
+{
+	if (History.Count == 0)
+	{
+		return false;
+	}
+
+	// Walk back from the newest snapshot; rewinds are short so this stays a few steps
+	int32 NewerIndex = (History.Head - 1 + HistoryCapacity) % HistoryCapacity;
+	if (Time >= History.Snapshots[NewerIndex].Time)
+	{
+		OutCapsule = History.Snapshots[NewerIndex];
+		return true;
+	}
+
+	for (int32 Step = 1; Step < History.Count; ++Step)
+	{
+		const int32 OlderIndex = (NewerIndex - 1 + HistoryCapacity) % HistoryCapacity;
+		const FHitboxSnapshot& Older = History.Snapshots[OlderIndex];
+		const FHitboxSnapshot& Newer = History.Snapshots[NewerIndex];
+
+		if (Time >= Older.Time)
+		{
+			const double Span = Newer.Time - Older.Time;
+			const float Alpha = Span > UE_SMALL_NUMBER ? static_cast<float>((Time - Older.Time) / Span) : 1.f;
+
+			OutCapsule.Time = Time;
+			OutCapsule.Location = FMath::Lerp(Older.Location, Newer.Location, Alpha);
+			OutCapsule.Rotation = FQuat::Slerp(Older.Rotation, Newer.Rotation, Alpha);
+			OutCapsule.Radius = FMath::Lerp(Older.Radius, Newer.Radius, Alpha);
+			OutCapsule.HalfHeight = FMath::Lerp(Older.HalfHeight, Newer.HalfHeight, Alpha);
+			return true;
+		}
+
+		NewerIndex = OlderIndex;
+	}
+
+	// Older than the history: use the oldest pose we have
+	OutCapsule = History.Snapshots[NewerIndex];
+	return true;
+}
+
+bool ULagCompensationSubsystem::ShouldRewindFor(const AActor* Attacker) const
+{
+	if (CVarLagCompEnable.GetValueOnGameThread() == 0 || NumRegistered == 0)
+	{
+		return false;
+	}
+
+	const APawn* AttackerPawn = Cast<APawn>(Attacker);
+	const APlayerController* PlayerController = AttackerPawn ? Cast<APlayerController>(AttackerPawn->GetController()) : nullptr;
+
+	// AI and the listen-server host already see the present
+	return PlayerController && !PlayerController->IsLocalController();
+}
+
+double ULagCompensationSubsystem::GetAttackerViewTime(const AActor* Attacker) const
+{
+	const double Now = GetWorld()->GetTimeSeconds();
+	if (!ShouldRewindFor(Attacker))
+	{
+		return Now;
+	}
+
+	const APawn* AttackerPawn = CastChecked<APawn>(Attacker);
+	const APlayerState* PlayerState = AttackerPawn->GetPlayerState();
+	const float RoundTripSeconds = PlayerState ? PlayerState->GetPingInMilliseconds() * 0.001f : 0.f;
+
+	const float Rewind = FMath::Min(RoundTripSeconds * 0.5f + CVarLagCompInterpDelay.GetValueOnGameThread(),
+		CVarLagCompMaxRewind.GetValueOnGameThread());
+
+	return Now - FMath::Max(Rewind, 0.f);
+}
+
+int32 ULagCompensationSubsystem::SweepSphereAtTime(double Time, const FVector& From, const FVector& To, float Radius,
+	const AActor* IgnoreActor, TArray<FHitResult>& OutHits) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_MYY_LagCompRewind);
+	INC_DWORD_STAT(STAT_MYY_LagCompRewindQueries);
+
+	const int32 FirstNewHit = OutHits.Num();
+	const float SweepLength = FVector::Dist(From, To);
+
+	for (const FHitboxHistory& History : Histories)
+	{
+		AMYYCharacterBase* Character = History.Character.Get();
+		FHitboxSnapshot Capsule;
+		if (!Character || Character == IgnoreActor || !GetCapsuleAtTime(History, Time, Capsule))
+		{
+			continue;
+		}
+
+		const FVector AxisOffset = Capsule.Rotation.GetUpVector() * FMath::Max(Capsule.HalfHeight - Capsule.Radius, 0.f);
+
+		FVector OnSweep, OnAxis;
+		FMath::SegmentDistToSegmentSafe(From, To, Capsule.Location - AxisOffset, Capsule.Location + AxisOffset, OnSweep, OnAxis);
+
+		if (FVector::DistSquared(OnSweep, OnAxis) > FMath::Square(Radius + Capsule.Radius))
+		{
+			continue;
+		}
+
+		const FVector Normal = (OnSweep - OnAxis).GetSafeNormal();
+		FHitResult& Hit = OutHits.Emplace_GetRef(Character, Character->GetCapsuleComponent(),
+			OnAxis + Normal * Capsule.Radius, Normal);
+		Hit.bBlockingHit = true;
+		Hit.Location = OnSweep;
+		Hit.TraceStart = From;
+		Hit.TraceEnd = To;
+		Hit.Time = SweepLength > UE_KINDA_SMALL_NUMBER ? FVector::Dist(From, OnSweep) / SweepLength : 0.f;
+		Hit.Distance = FVector::Dist(From, OnSweep);
+	}
+
+	// Earliest contact first, like a physics sweep
+	const int32 NumNewHits = OutHits.Num() - FirstNewHit;
+	if (NumNewHits > 1)
+	{
+		Algo::Sort(MakeArrayView(OutHits.GetData() + FirstNewHit, NumNewHits),
+			[](const FHitResult& A, const FHitResult& B) { return A.Time < B.Time; });
+	}
+
+	return NumNewHits;
+}
+
+int32 ULagCompensationSubsystem::SweepBladeAtTime(double Time, const FVector& FromStart, const FVector& FromEnd,
+	const FVector& ToStart, const FVector& ToEnd, float BladeRadius,
+	const AActor* IgnoreActor, TArray<FHitResult>& OutHits) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_MYY_LagCompRewind);
+	INC_DWORD_STAT(STAT_MYY_LagCompRewindQueries);
+
+	// The blade swept between the two segments, as a quad
+	const FVector Quad[4] = { FromStart, FromEnd, ToEnd, ToStart };
+	int32 NumHits = 0;
+
+	for (const FHitboxHistory& History : Histories)
+	{
+		AMYYCharacterBase* Character = History.Character.Get();
+		FHitboxSnapshot Capsule;
+		if (!Character || Character == IgnoreActor || !GetCapsuleAtTime(History, Time, Capsule))
+		{
+			continue;
+		}
+
+		const FVector AxisOffset = Capsule.Rotation.GetUpVector() * FMath::Max(Capsule.HalfHeight - Capsule.Radius, 0.f);
+		const FVector AxisBottom = Capsule.Location - AxisOffset;
+		const FVector AxisTop = Capsule.Location + AxisOffset;
+
+		// Capsule axis against both halves of the swept area, within both radii. This also catches an
+		// axis lying just off the face, which the quad's edges alone would miss
+		FVector OnBlade, OnAxis, OnBladeOther, OnAxisOther;
+		float DistanceSq = LagCompensationPrivate::SegmentTriangleDistSq(AxisBottom, AxisTop,
+			Quad[0], Quad[1], Quad[2], OnBlade, OnAxis);
+		const float OtherDistanceSq = LagCompensationPrivate::SegmentTriangleDistSq(AxisBottom, AxisTop,
+			Quad[0], Quad[2], Quad[3], OnBladeOther, OnAxisOther);
+		if (OtherDistanceSq < DistanceSq)
+		{
+			DistanceSq = OtherDistanceSq;
+			OnBlade = OnBladeOther;
+			OnAxis = OnAxisOther;
+		}
+
+		if (DistanceSq > FMath::Square(BladeRadius + Capsule.Radius))
+		{
+			continue;
+		}
+
+		FVector Normal = (OnBlade - OnAxis).GetSafeNormal();
+		if (Normal.IsNearlyZero())
+		{
+			Normal = (FromStart - Capsule.Location).GetSafeNormal2D();
+		}
+
+		FHitResult& Hit = OutHits.Emplace_GetRef(Character, Character->GetCapsuleComponent(),
+			OnAxis + Normal * Capsule.Radius, Normal);
+		Hit.bBlockingHit = true;
+		Hit.Location = OnBlade;
+		Hit.TraceStart = (FromStart + FromEnd) * 0.5f;
+		Hit.TraceEnd = (ToStart + ToEnd) * 0.5f;
+		++NumHits;
+	}
+
+	return NumHits;
+}
@@ -0,0 +1,86 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "LagCompensationSubsystem.generated.h"
+
+class AMYYCharacterBase;
+
+/**
+ * Server-side hitbox history for lag-compensated hit validation.
+ *
+ * Every registered character records its collision capsule once per server frame
+ * into a fixed-size ring buffer allocated when it registers. Melee and arrow hits
+ * from remote players are then tested against the capsules as they were at the
+ * attacker's view time (server time - half RTT - interpolation delay).
+ */
+UCLASS()
+class MYY_API ULagCompensationSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	// Snapshots kept per character (~1 s of history at 60 Hz)
+	static constexpr int32 HistoryCapacity = 64;
+
+	// UWorldSubsystem
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+
+	void RegisterCharacter(AMYYCharacterBase* Character);
+	void UnregisterCharacter(AMYYCharacterBase* Character);
+
+	// True when hits from this attacker should be resolved in the past (remote players only)
+	bool ShouldRewindFor(const AActor* Attacker) const;
+
+	// Server time the attacker was looking at when it acted
+	double GetAttackerViewTime(const AActor* Attacker) const;
+
+	// Sphere moving From -> To against the rewound character capsules. Appends hits, returns the count.
+	int32 SweepSphereAtTime(double Time, const FVector& From, const FVector& To, float Radius,
+		const AActor* IgnoreActor, TArray<FHitResult>& OutHits) const;
+
+	// Blade moving from one segment to the next (the quad between them, inflated by BladeRadius)
+	// against the rewound character capsules. Appends hits, returns the count.
+	int32 SweepBladeAtTime(double Time, const FVector& FromStart, const FVector& FromEnd,
+		const FVector& ToStart, const FVector& ToEnd, float BladeRadius,
+		const AActor* IgnoreActor, TArray<FHitResult>& OutHits) const;
+
+private:
+
+	struct FHitboxSnapshot
+	{
+		double Time = 0.0;
+		FVector Location = FVector::ZeroVector;
+		FQuat Rotation = FQuat::Identity;
+		float Radius = 0.f;
+		float HalfHeight = 0.f;
+	};
+
+	struct FHitboxHistory
+	{
+		TWeakObjectPtr<AMYYCharacterBase> Character;
+
+		// Ring buffer, sized to HistoryCapacity once and reused by later registrations
+		TArray<FHitboxSnapshot> Snapshots;
+		int32 Head = 0;
+		int32 Count = 0;
+	};
+
+	void RecordSnapshot(FHitboxHistory& History, double Time) const;
+
+	// Capsule interpolated between the two snapshots around Time (clamped to the history)
+	bool GetCapsuleAtTime(const FHitboxHistory& History, double Time, FHitboxSnapshot& OutCapsule) const;
+
+	// Slots are never removed, only cleared, so registering never reallocates snapshot storage
+	TArray<FHitboxHistory> Histories;
+	int32 NumRegistered = 0;
+};
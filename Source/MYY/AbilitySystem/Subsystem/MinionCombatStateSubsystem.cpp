@@ -0,0 +1,246 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MinionCombatStateSubsystem.h"
+#include "MYY/MYY.h"
+#include "MYY/AbilitySystem/AI/AICharacter.h"
+#include "MYY/AbilitySystem/AI/AIController/MinionAIController.h"
+#include "MYY/AbilitySystem/AttributeSet/AttributeSetBase.h"
+#include "MYY/AbilitySystem/GameplayTags/MYYGameplayTags.h"
+#include "MYY/AbilitySystem/Subsystem/MinionSignificanceSubsystem.h"
+#include "AbilitySystemComponent.h"
+#include "BehaviorTree/BlackboardComponent.h"
+#include "HAL/IConsoleManager.h"
+#include "Async/ParallelFor.h"
+
+DECLARE_CYCLE_STAT(TEXT("Combat State Gather"), STAT_MYY_CombatStateGather, STATGROUP_MYYCombat);
+DECLARE_CYCLE_STAT(TEXT("Combat State Evaluate"), STAT_MYY_CombatStateEvaluate, STATGROUP_MYYCombat);
+DECLARE_CYCLE_STAT(TEXT("Combat State Write Back"), STAT_MYY_CombatStateWrite, STATGROUP_MYYCombat);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Combat State Evaluations"), STAT_MYY_CombatStateEvaluations, STATGROUP_MYYCombat);
+
+static TAutoConsoleVariable<int32> CVarCombatStateParallelThreshold(
+	TEXT("MYY.AI.CombatState.ParallelThreshold"),
+	64,
+	TEXT("Minions due in one tick before the combat-state evaluation is spread over worker threads."),
+	ECVF_Default);
+
+bool UMinionCombatStateSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UMinionCombatStateSubsystem::Deinitialize()
+{
+	Minions.Empty();
+	Inputs.Empty();
+	Results.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UMinionCombatStateSubsystem::IsTickable() const
+{
+	return Minions.Num() > 0;
+}
+
+TStatId UMinionCombatStateSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UMinionCombatStateSubsystem, STATGROUP_Tickables);
+}
+
+UMinionCombatStateSubsystem::FMinionCombatState* UMinionCombatStateSubsystem::FindMinion(const AMinionAIController* Controller)
+{
+	return Minions.FindByPredicate([Controller](const FMinionCombatState& Minion)
+	{
+		return Minion.Controller.Get() == Controller;
+	});
+}
+
+void UMinionCombatStateSubsystem::RegisterMinion(AMinionAIController* Controller)
+{
+	if (!Controller || !Controller->HasAuthority()) return;
+
+	FMinionCombatState* State = FindMinion(Controller);
+	if (!State)
+	{
+		State = &Minions.AddDefaulted_GetRef();
+		State->Controller = Controller;
+		State->BlockRandom.Initialize(static_cast<int32>(FPlatformTime::Cycles() ^ Controller->GetUniqueID()));
+	}
+
+	// Cached here so the per-tick gather doesn't go through GetAttributeSet
+	if (const AAICharacter* Minion = Cast<AAICharacter>(Controller->GetPawn()))
+	{
+		State->AttributeSet = Minion->AttributeSet;
+		State->BlockChance = Minion->BlockChance;
+	}
+}
+
+void UMinionCombatStateSubsystem::ActivateMinion(AMinionAIController* Controller, UBlackboardComponent* Blackboard,
+	const FMinionCombatConfig& Config)
+{
+	// The tree can start before OnPossess registered the controller
+	FMinionCombatState* State = FindMinion(Controller);
+	if (!State)
+	{
+		RegisterMinion(Controller);
+		State = FindMinion(Controller);
+	}
+
+	if (!State)
+	{
+		return;
+	}
+
+	State->Blackboard = Blackboard;
+	State->Config = Config;
+	State->bActive = true;
+}
+
+void UMinionCombatStateSubsystem::PauseMinion(AMinionAIController* Controller)
+{
+	if (FMinionCombatState* State = FindMinion(Controller))
+	{
+		State->bActive = false;
+	}
+}
+
+void UMinionCombatStateSubsystem::UnregisterMinion(AMinionAIController* Controller)
+{
+	Minions.RemoveAllSwap([Controller](const FMinionCombatState& Minion)
+	{
+		return Minion.Controller.Get() == Controller;
+	});
+}
+
+void UMinionCombatStateSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	GatherInputs(Now);
+	if (Inputs.IsEmpty())
+	{
+		return;
+	}
+
+	Evaluate(Now);
+	WriteResults();
+}
+
+void UMinionCombatStateSubsystem::GatherInputs(double Now)
+{
+	SCOPE_CYCLE_COUNTER(STAT_MYY_CombatStateGather);
+
+	Inputs.Reset();
+
+	// Destroyed without unregistering
+	Minions.RemoveAllSwap([](const FMinionCombatState& Minion)
+	{
+		return !Minion.Controller.IsValid();
+	});
+
+	for (int32 Index = 0; Index < Minions.Num(); ++Index)
+	{
+		FMinionCombatState& State = Minions[Index];
+		const AMinionAIController* Controller = State.Controller.Get();
+
+		if (!State.bActive || Now < State.NextEvaluationTime)
+		{
+			continue;
+		}
+
+		const FMinionCombatConfig& Config = State.Config;
+		const float IntervalScale = UMinionSignificanceSubsystem::GetTierSettings(Controller->GetSignificanceTier()).ServiceIntervalScale;
+		State.NextEvaluationTime = Now + IntervalScale *
+			FMath::FRandRange(FMath::Max(0.f, Config.Interval - Config.RandomDeviation), Config.Interval + Config.RandomDeviation);
+
+		const APawn* Minion = Controller->GetPawn();
+		const UBlackboardComponent* Blackboard = State.Blackboard.Get();
+		if (!Minion || !Blackboard)
+		{
+			continue;
+		}
+
+		FMinionCombatInputs& Input = Inputs.AddDefaulted_GetRef();
+		Input.MinionIndex = Index;
+
+		const UAttributeSetBase* AttributeSet = State.AttributeSet.Get();
+		Input.Stamina = AttributeSet ? AttributeSet->GetStamina() : 0.f;
+
+		const AActor* Target = Cast<AActor>(Blackboard->GetValueAsObject(Config.TargetActorKey));
+		if (!Target)
+		{
+			continue;
+		}
+
+		Input.bHasTarget = true;
+		Input.TargetDistance = FVector::Dist(Minion->GetActorLocation(), Target->GetActorLocation());
+
+		const AMYYCharacterBase* TargetCharacter = Cast<AMYYCharacterBase>(Target);
+		Input.bTargetAttacking = TargetCharacter && TargetCharacter->AbilitySystemComponent &&
+			TargetCharacter->AbilitySystemComponent->HasMatchingGameplayTag(MYYTags::State_Combat_Attacking);
+	}
+}
+
+void UMinionCombatStateSubsystem::Evaluate(double Now)
+{
+	SCOPE_CYCLE_COUNTER(STAT_MYY_CombatStateEvaluate);
+	INC_DWORD_STAT_BY(STAT_MYY_CombatStateEvaluations, Inputs.Num());
+
+	Results.SetNumUninitialized(Inputs.Num());
+
+	// Each entry only touches its own minion's state
+	const bool bParallel = Inputs.Num() >= CVarCombatStateParallelThreshold.GetValueOnGameThread();
+	ParallelFor(Inputs.Num(), [this, Now](int32 InputIndex)
+	{
+		const FMinionCombatInputs& Input = Inputs[InputIndex];
+		FMinionCombatState& State = Minions[Input.MinionIndex];
+		FMinionCombatResult& Result = Results[InputIndex];
+
+		Result = FMinionCombatResult();
+		if (!Input.bHasTarget)
+		{
+			return;
+		}
+
+		const FMinionCombatConfig& Config = State.Config;
+		Result.bCanAttack = (Now - State.LastAttackTime >= Config.AttackCooldown) && (Input.Stamina >= Config.MinStaminaForAttack);
+		if (Result.bCanAttack)
+		{
+			State.LastAttackTime = Now;
+		}
+
+		// Block an attacking target, by chance, if there's stamina for it
+		if (Input.bTargetAttacking && Input.Stamina >= Config.MinStaminaForBlock)
+		{
+			Result.bShouldBlock = State.BlockRandom.FRand() <= State.BlockChance;
+		}
+	}, bParallel ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+}
+
+void UMinionCombatStateSubsystem::WriteResults()
+{
+	SCOPE_CYCLE_COUNTER(STAT_MYY_CombatStateWrite);
+
+	for (int32 InputIndex = 0; InputIndex < Inputs.Num(); ++InputIndex)
+	{
+		const FMinionCombatInputs& Input = Inputs[InputIndex];
+		const FMinionCombatState& State = Minions[Input.MinionIndex];
+		const FMinionCombatResult& Result = Results[InputIndex];
+
+		UBlackboardComponent* Blackboard = State.Blackboard.Get();
+		if (!Blackboard)
+		{
+			continue;
+		}
+
+		Blackboard->SetValueAsBool(State.Config.CanAttackKey, Result.bCanAttack);
+		Blackboard->SetValueAsBool(State.Config.ShouldBlockKey, Result.bShouldBlock);
+
+		if (Input.bHasTarget && !State.Config.TargetDistanceKey.IsNone())
+		{
+			Blackboard->SetValueAsFloat(State.Config.TargetDistanceKey, Input.TargetDistance);
+		}
+	}
+}
@@ -0,0 +1,111 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "MinionCombatStateSubsystem.generated.h"
+
+class AMinionAIController;
+class UAttributeSetBase;
+class UBlackboardComponent;
+
+// Blackboard keys and tuning for one minion, supplied by UBTService_UpdateCombatState
+struct FMinionCombatConfig
+{
+	FName TargetActorKey;
+	FName CanAttackKey;
+	FName ShouldBlockKey;
+
+	// Optional, written with the target distance when set
+	FName TargetDistanceKey;
+
+	float AttackCooldown = 2.f;
+	float MinStaminaForAttack = 15.f;
+	float MinStaminaForBlock = 10.f;
+
+	// Seconds between evaluations (scaled by the minion's significance tier)
+	float Interval = 0.5f;
+	float RandomDeviation = 0.1f;
+};
+
+/**
+ * Combat state (CanAttack / ShouldBlock) for every minion, evaluated in one batch.
+ *
+ * Each tick the minions that are due are gathered on the game thread into compact input
+ * structs (stamina, target distance, target attacking), evaluated in a ParallelFor against
+ * their own persistent state (last attack time, block roll stream), and the results are
+ * written back to their blackboards in a single pass.
+ */
+UCLASS()
+class MYY_API UMinionCombatStateSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	// UWorldSubsystem
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+
+	// For as long as the controller possesses a minion (OnPossess / OnUnPossess). Starts paused.
+	void RegisterMinion(AMinionAIController* Controller);
+	void UnregisterMinion(AMinionAIController* Controller);
+
+	// While UBTService_UpdateCombatState is relevant. Pausing keeps the minion's state (last attack time)
+	void ActivateMinion(AMinionAIController* Controller, UBlackboardComponent* Blackboard, const FMinionCombatConfig& Config);
+	void PauseMinion(AMinionAIController* Controller);
+
+private:
+
+	// Per-minion state that lives across evaluations
+	struct FMinionCombatState
+	{
+		TWeakObjectPtr<AMinionAIController> Controller;
+		TWeakObjectPtr<UBlackboardComponent> Blackboard;
+		TWeakObjectPtr<const UAttributeSetBase> AttributeSet;
+		FMinionCombatConfig Config;
+		float BlockChance = 0.f;
+
+		double LastAttackTime = 0.0;
+		double NextEvaluationTime = 0.0;
+
+		// Only evaluated while the service's branch is relevant
+		bool bActive = false;
+
+		// Own stream so the block roll is safe to take off the game thread
+		FRandomStream BlockRandom;
+	};
+
+	struct FMinionCombatInputs
+	{
+		int32 MinionIndex = INDEX_NONE;
+		float Stamina = 0.f;
+		float TargetDistance = 0.f;
+		bool bHasTarget = false;
+		bool bTargetAttacking = false;
+	};
+
+	struct FMinionCombatResult
+	{
+		bool bCanAttack = false;
+		bool bShouldBlock = false;
+	};
+
+	FMinionCombatState* FindMinion(const AMinionAIController* Controller);
+
+	void GatherInputs(double Now);
+	void Evaluate(double Now);
+	void WriteResults();
+
+	TArray<FMinionCombatState> Minions;
+
+	// Minions due this tick, parallel arrays
+	TArray<FMinionCombatInputs> Inputs;
+	TArray<FMinionCombatResult> Results;
+};
@@ -0,0 +1,408 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MinionCrowdSubsystem.h"
+#include "MYY/MYY.h"
+#include "MYY/AbilitySystem/AI/AICharacter.h"
+#include "MYY/AbilitySystem/Actor/Crowd/MinionCrowdActor.h"
+#include "MYY/AbilitySystem/AttributeSet/AttributeSetBase.h"
+#include "MYY/AbilitySystem/Subsystem/MinionPoolSubsystem.h"
+#include "MYY/AbilitySystem/Subsystem/MinionSpawnDirectorSubsystem.h"
+#include "AbilitySystemComponent.h"
+#include "Async/ParallelFor.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Crowd Simulation"), STAT_MYY_CrowdSimulation, STATGROUP_MYYCombat);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Crowd Minions"), STAT_MYY_CrowdMinions, STATGROUP_MYYCombat);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Crowd Promoted"), STAT_MYY_CrowdPromoted, STATGROUP_MYYCombat);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Crowd Promotions"), STAT_MYY_CrowdPromotions, STATGROUP_MYYCombat);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Crowd Demotions"), STAT_MYY_CrowdDemotions, STATGROUP_MYYCombat);
+
+static TAutoConsoleVariable<float> CVarCrowdPromoteRadius(
+	TEXT("MYY.AI.Crowd.PromoteRadius"),
+	4000.f,
+	TEXT("Crowd minions this close to a player become full AI characters."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarCrowdDemoteRadius(
+	TEXT("MYY.AI.Crowd.DemoteRadius"),
+	5000.f,
+	TEXT("Promoted minions without a target this far from every player go back to the crowd.\n")
+	TEXT("Keep it above PromoteRadius so minions don't bounce between the two."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarCrowdMaxPromoted(
+	TEXT("MYY.AI.Crowd.MaxPromoted"),
+	48,
+	TEXT("Most crowd minions that are full AI characters at once; the rest wait in the crowd."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarCrowdWalkSpeed(
+	TEXT("MYY.AI.Crowd.WalkSpeed"),
+	200.f,
+	TEXT("Crowd minion walking speed (cm/s)."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarCrowdWanderRadius(
+	TEXT("MYY.AI.Crowd.WanderRadius"),
+	800.f,
+	TEXT("Crowd minions wander within this distance of their home."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarCrowdParallelThreshold(
+	TEXT("MYY.AI.Crowd.ParallelThreshold"),
+	256,
+	TEXT("Crowd sizes from this many minions up are stepped across worker threads."),
+	ECVF_Default);
+
+bool UMinionCrowdSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UMinionCrowdSubsystem::Deinitialize()
+{
+	DEC_DWORD_STAT_BY(STAT_MYY_CrowdMinions, AgentIds.Num());
+	DEC_DWORD_STAT_BY(STAT_MYY_CrowdPromoted, Promoted.Num());
+
+	AgentIds.Empty();
+	Positions.Empty();
+	Velocities.Empty();
+	Homes.Empty();
+	Goals.Empty();
+	HealthFractions.Empty();
+	Teams.Empty();
+	ClassIndices.Empty();
+	Flags.Empty();
+	Promoted.Empty();
+	OnMinionPromoted.Clear();
+	CrowdActor = nullptr;
+
+	Super::Deinitialize();
+}
+
+bool UMinionCrowdSubsystem::IsTickable() const
+{
+	return AgentIds.Num() > 0 || Promoted.Num() > 0;
+}
+
+TStatId UMinionCrowdSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UMinionCrowdSubsystem, STATGROUP_Tickables);
+}
+
+uint32 UMinionCrowdSubsystem::AddAgent(TSubclassOf<AAICharacter> MinionClass, const FTransform& Transform, uint8 TeamID, float HealthFraction)
+{
+	if (!MinionClass || GetWorld()->GetNetMode() == NM_Client)
+	{
+		return 0;
+	}
+
+	const int32 Index = AddRow(FindOrAddClass(MinionClass), Transform.GetLocation(), Transform.GetLocation(), TeamID, HealthFraction);
+	return AgentIds[Index];
+}
+
+uint8 UMinionCrowdSubsystem::FindOrAddClass(TSubclassOf<AAICharacter> MinionClass)
+{
+	const int32 Existing = MinionClasses.Find(MinionClass);
+	if (Existing != INDEX_NONE)
+	{
+		return static_cast<uint8>(Existing);
+	}
+
+	// More classes than that share the last slot; a match has a handful
+	if (MinionClasses.Num() > MAX_uint8)
+	{
+		return MAX_uint8;
+	}
+
+	if (!CrowdActor)
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		CrowdActor = GetWorld()->SpawnActor<AMinionCrowdActor>(AMinionCrowdActor::StaticClass(), FTransform::Identity, SpawnParams);
+	}
+
+	const AAICharacter* MinionCDO = MinionClass->GetDefaultObject<AAICharacter>();
+	ClassMeshIndices.Add(CrowdActor ? CrowdActor->FindOrAddProxyMesh(MinionCDO->CrowdProxyMesh) : 0);
+	return static_cast<uint8>(MinionClasses.Add(MinionClass));
+}
+
+int32 UMinionCrowdSubsystem::AddRow(uint8 ClassIndex, const FVector& Location, const FVector& Home, uint8 TeamID, float HealthFraction)
+{
+	AgentIds.Add(NextAgentId++);
+	if (NextAgentId == 0)
+	{
+		NextAgentId = 1;
+	}
+
+	Positions.Add(Location);
+	Velocities.Add(FVector::ZeroVector);
+	Homes.Add(Home);
+	Goals.Add(Location);
+	HealthFractions.Add(FMath::Clamp(HealthFraction, 0.f, 1.f));
+	Teams.Add(TeamID);
+	ClassIndices.Add(ClassIndex);
+	Flags.Add(AgentFlag_None);
+
+	INC_DWORD_STAT(STAT_MYY_CrowdMinions);
+	return AgentIds.Num() - 1;
+}
+
+void UMinionCrowdSubsystem::RemoveRow(int32 Index)
+{
+	AgentIds.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Positions.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Velocities.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Homes.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Goals.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	HealthFractions.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Teams.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	ClassIndices.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Flags.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+
+	DEC_DWORD_STAT(STAT_MYY_CrowdMinions);
+}
+
+int32 UMinionCrowdSubsystem::FindRow(uint32 AgentId) const
+{
+	return AgentIds.Find(AgentId);
+}
+
+float UMinionCrowdSubsystem::GetDistanceSqToClosestPlayer(const FVector& Location) const
+{
+	float ClosestSq = UE_BIG_NUMBER;
+	for (const FVector& PlayerLocation : PlayerLocations)
+	{
+		ClosestSq = FMath::Min(ClosestSq, static_cast<float>(FVector::DistSquared(Location, PlayerLocation)));
+	}
+	return ClosestSq;
+}
+
+void UMinionCrowdSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	SCOPE_CYCLE_COUNTER(STAT_MYY_CrowdSimulation);
+
+	PlayerLocations.Reset();
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APawn* PlayerPawn = It->Get() ? It->Get()->GetPawn() : nullptr;
+		if (PlayerPawn)
+		{
+			PlayerLocations.Add(PlayerPawn->GetActorLocation());
+		}
+	}
+
+	StepAgents(DeltaTime);
+
+	// New wander goals and promotions, after the bulk step
+	const float WanderRadius = CVarCrowdWanderRadius.GetValueOnGameThread();
+	const int32 MaxPromoted = CVarCrowdMaxPromoted.GetValueOnGameThread();
+	for (int32 Index = AgentIds.Num() - 1; Index >= 0; --Index)
+	{
+		if (Flags[Index] & AgentFlag_Arrived)
+		{
+			const FVector2D Offset = FMath::RandPointInCircle(WanderRadius);
+			Goals[Index] = Homes[Index] + FVector(Offset.X, Offset.Y, 0.f);
+		}
+
+		if ((Flags[Index] & AgentFlag_InRange) && Promoted.Num() + NumPromoting < MaxPromoted)
+		{
+			Promote(Index);
+		}
+
+		Flags[Index] &= ~(AgentFlag_Arrived | AgentFlag_InRange);
+	}
+
+	DemoteOutOfRange();
+	UpdateCrowdActor();
+}
+
+void UMinionCrowdSubsystem::StepAgents(float DeltaTime)
+{
+	const float Speed = CVarCrowdWalkSpeed.GetValueOnGameThread();
+	const float ArriveDistance = FMath::Max(Speed * DeltaTime, 10.f);
+	const float PromoteRadiusSq = FMath::Square(CVarCrowdPromoteRadius.GetValueOnGameThread());
+	const bool bParallel = AgentIds.Num() >= CVarCrowdParallelThreshold.GetValueOnGameThread();
+
+	// Touches only row Index of each array, so rows can be stepped on any thread
+	ParallelFor(AgentIds.Num(), [this, DeltaTime, Speed, ArriveDistance, PromoteRadiusSq](int32 Index)
+	{
+		if (Flags[Index] & AgentFlag_Promoting)
+		{
+			Velocities[Index] = FVector::ZeroVector;
+			return;
+		}
+
+		FVector ToGoal = Goals[Index] - Positions[Index];
+		ToGoal.Z = 0.f;
+		const float Distance = ToGoal.Size();
+
+		if (Distance <= ArriveDistance)
+		{
+			Positions[Index] = FVector(Goals[Index].X, Goals[Index].Y, Positions[Index].Z);
+			Velocities[Index] = FVector::ZeroVector;
+			Flags[Index] |= AgentFlag_Arrived;
+		}
+		else
+		{
+			Velocities[Index] = ToGoal * (Speed / Distance);
+			Positions[Index] += Velocities[Index] * DeltaTime;
+		}
+
+		if (GetDistanceSqToClosestPlayer(Positions[Index]) < PromoteRadiusSq)
+		{
+			Flags[Index] |= AgentFlag_InRange;
+		}
+	}, bParallel ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+}
+
+void UMinionCrowdSubsystem::Promote(int32 Index)
+{
+	UMinionSpawnDirectorSubsystem* SpawnDirector = GetWorld()->GetSubsystem<UMinionSpawnDirectorSubsystem>();
+	const TSubclassOf<AAICharacter> MinionClass = MinionClasses[ClassIndices[Index]];
+	if (!SpawnDirector || !MinionClass)
+	{
+		return;
+	}
+
+	// Frozen in place (and still drawn) until the character is ready
+	Flags[Index] |= AgentFlag_Promoting;
+	++NumPromoting;
+
+	const FRotator Facing(0.f, Velocities[Index].IsNearlyZero() ? 0.f : Velocities[Index].Rotation().Yaw, 0.f);
+	const uint32 AgentId = AgentIds[Index];
+	const TWeakObjectPtr<UMinionCrowdSubsystem> WeakThis(this);
+
+	SpawnDirector->RequestSpawn(MinionClass, FTransform(Facing, Positions[Index]), Teams[Index], [WeakThis, AgentId](AAICharacter* Minion)
+	{
+		if (UMinionCrowdSubsystem* Crowd = WeakThis.Get())
+		{
+			Crowd->OnPromoted(AgentId, Minion);
+		}
+	});
+}
+
+void UMinionCrowdSubsystem::OnPromoted(uint32 AgentId, AAICharacter* Minion)
+{
+	--NumPromoting;
+
+	const int32 Index = FindRow(AgentId);
+	if (Index == INDEX_NONE)
+	{
+		// Row is gone (shouldn't happen); the character is extra, so park it
+		if (UMinionPoolSubsystem* Pool = GetWorld()->GetSubsystem<UMinionPoolSubsystem>())
+		{
+			Pool->ReleaseMinion(Minion);
+		}
+		return;
+	}
+
+	if (!Minion)
+	{
+		// Couldn't spawn; stays in the crowd and tries again when it's next in range
+		Flags[Index] &= ~AgentFlag_Promoting;
+		return;
+	}
+
+	if (HealthFractions[Index] < 1.f && Minion->AbilitySystemComponent && Minion->AttributeSet)
+	{
+		Minion->AbilitySystemComponent->SetNumericAttributeBase(UAttributeSetBase::GetHealthAttribute(),
+			FMath::Max(HealthFractions[Index] * Minion->AttributeSet->GetMaxHealth(), 1.f));
+	}
+
+	FPromotedMinion& Entry = Promoted.AddDefaulted_GetRef();
+	Entry.Minion = Minion;
+	Entry.ClassIndex = ClassIndices[Index];
+	Entry.Home = Homes[Index];
+
+	RemoveRow(Index);
+	INC_DWORD_STAT(STAT_MYY_CrowdPromoted);
+	INC_DWORD_STAT(STAT_MYY_CrowdPromotions);
+
+	UE_LOG(LogMYYCombat, Verbose, TEXT("Crowd: promoted %s at %s"), *Minion->GetName(), *Minion->GetActorLocation().ToCompactString());
+
+	OnMinionPromoted.Broadcast(Minion);
+}
+
+void UMinionCrowdSubsystem::DemoteOutOfRange()
+{
+	const float DemoteRadiusSq = FMath::Square(FMath::Max(CVarCrowdDemoteRadius.GetValueOnGameThread(), CVarCrowdPromoteRadius.GetValueOnGameThread()));
+	UMinionPoolSubsystem* Pool = GetWorld()->GetSubsystem<UMinionPoolSubsystem>();
+
+	for (int32 Index = Promoted.Num() - 1; Index >= 0; --Index)
+	{
+		AAICharacter* Minion = Promoted[Index].Minion.Get();
+
+		// Dead ones are the death ability's to clean up
+		const bool bGone = !Minion || !Minion->IsAlive() || !Minion->GetController();
+		if (!bGone)
+		{
+			if (!Pool || Minion->GetCurrentTarget() || GetDistanceSqToClosestPlayer(Minion->GetActorLocation()) < DemoteRadiusSq)
+			{
+				continue;
+			}
+
+			const float HealthFraction = Minion->AttributeSet && Minion->AttributeSet->GetMaxHealth() > 0.f
+				? Minion->AttributeSet->GetHealth() / Minion->AttributeSet->GetMaxHealth()
+				: 1.f;
+
+			AddRow(Promoted[Index].ClassIndex, Minion->GetActorLocation(), Promoted[Index].Home, Minion->TeamID, HealthFraction);
+			Pool->ReleaseMinion(Minion);
+			INC_DWORD_STAT(STAT_MYY_CrowdDemotions);
+		}
+
+		Promoted.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		DEC_DWORD_STAT(STAT_MYY_CrowdPromoted);
+	}
+}
+
+void UMinionCrowdSubsystem::UpdateCrowdActor()
+{
+	if (!CrowdActor)
+	{
+		return;
+	}
+
+	// Only agents that moved or turned past the thresholds are marked for replication
+	CrowdActor->BeginInstanceSync();
+	for (int32 Index = 0; Index < AgentIds.Num(); ++Index)
+	{
+		const float Yaw = Velocities[Index].IsNearlyZero() ? 0.f : Velocities[Index].Rotation().Yaw;
+		CrowdActor->SyncInstance(AgentIds[Index], Positions[Index], Yaw, ClassMeshIndices[ClassIndices[Index]]);
+	}
+	CrowdActor->EndInstanceSync();
+}
+
+void UMinionCrowdSubsystem::DumpCrowd() const
+{
+	UE_LOG(LogTemp, Warning, TEXT("📊 Crowd: %d minions, %d promoted, %d promoting (radius %.0f / %.0f, max %d)"),
+		AgentIds.Num(), Promoted.Num(), NumPromoting,
+		CVarCrowdPromoteRadius.GetValueOnGameThread(), CVarCrowdDemoteRadius.GetValueOnGameThread(),
+		CVarCrowdMaxPromoted.GetValueOnGameThread());
+
+	for (int32 ClassIndex = 0; ClassIndex < MinionClasses.Num(); ++ClassIndex)
+	{
+		int32 Count = 0;
+		for (const uint8 AgentClass : ClassIndices)
+		{
+			Count += AgentClass == ClassIndex ? 1 : 0;
+		}
+		UE_LOG(LogTemp, Warning, TEXT("   %s: %d in the crowd"), *GetNameSafe(MinionClasses[ClassIndex]), Count);
+	}
+}
+
+// MYY.AI.Crowd.Dump
+static FAutoConsoleCommandWithWorld GCrowdDumpCommand(
+	TEXT("MYY.AI.Crowd.Dump"),
+	TEXT("Logs the crowd minion counts per class and how many are promoted."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const UMinionCrowdSubsystem* Crowd = World ? World->GetSubsystem<UMinionCrowdSubsystem>() : nullptr)
+		{
+			Crowd->DumpCrowd();
+		}
+	}));
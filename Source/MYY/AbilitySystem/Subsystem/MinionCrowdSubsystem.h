@@ -0,0 +1,121 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "MinionCrowdSubsystem.generated.h"
+
+class AAICharacter;
+class AMinionCrowdActor;
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnCrowdMinionPromoted, AAICharacter*);
+
+/**
+ * Server-side crowd layer for minions far from every player.
+ *
+ * A crowd minion is a row in a set of parallel arrays (position, velocity, team, health, ...)
+ * instead of an AAICharacter: no ASC, mesh, movement component or controller. The arrays are
+ * stepped in bulk every frame (wandering around the minion's home) and drawn through
+ * AMinionCrowdActor's instanced meshes.
+ *
+ * A crowd minion that comes within MYY.AI.Crowd.PromoteRadius of a player is promoted: a full
+ * AAICharacter is brought in through UMinionSpawnDirectorSubsystem (from the minion pool) with its
+ * team and health, and the row is dropped. A promoted minion with no target that ends up past
+ * MYY.AI.Crowd.DemoteRadius is demoted back into a row and its character parked in the pool.
+ */
+UCLASS()
+class MYY_API UMinionCrowdSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	// UWorldSubsystem
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+
+	// Adds a crowd minion that becomes a MinionClass character when promoted. Returns its id.
+	uint32 AddAgent(TSubclassOf<AAICharacter> MinionClass, const FTransform& Transform, uint8 TeamID, float HealthFraction = 1.f);
+
+	// Crowd minions, not counting promoted ones
+	int32 GetNumAgents() const { return AgentIds.Num(); }
+	int32 GetNumPromoted() const { return Promoted.Num(); }
+
+	// For the game mode to hook promoted minions into the match, like any other spawn
+	FOnCrowdMinionPromoted OnMinionPromoted;
+
+	// Counts and the promotion radius to the log (MYY.AI.Crowd.Dump)
+	void DumpCrowd() const;
+
+private:
+
+	enum EAgentFlags : uint8
+	{
+		AgentFlag_None			= 0,
+		AgentFlag_Promoting		= 1 << 0,
+
+		// Set by the bulk step, consumed right after it
+		AgentFlag_Arrived		= 1 << 1,
+		AgentFlag_InRange		= 1 << 2,
+	};
+
+	struct FPromotedMinion
+	{
+		TWeakObjectPtr<AAICharacter> Minion;
+		uint8 ClassIndex = 0;
+		FVector Home = FVector::ZeroVector;
+	};
+
+	int32 AddRow(uint8 ClassIndex, const FVector& Location, const FVector& Home, uint8 TeamID, float HealthFraction);
+	void RemoveRow(int32 Index);
+	int32 FindRow(uint32 AgentId) const;
+
+	uint8 FindOrAddClass(TSubclassOf<AAICharacter> MinionClass);
+
+	// Moves every row and flags arrivals and rows in promotion range
+	void StepAgents(float DeltaTime);
+
+	void Promote(int32 Index);
+	void OnPromoted(uint32 AgentId, AAICharacter* Minion);
+
+	void DemoteOutOfRange();
+
+	void UpdateCrowdActor();
+
+	float GetDistanceSqToClosestPlayer(const FVector& Location) const;
+
+	// ========== AGENT ROWS (parallel arrays) ==========
+
+	TArray<uint32> AgentIds;
+	TArray<FVector> Positions;
+	TArray<FVector> Velocities;
+	TArray<FVector> Homes;
+	TArray<FVector> Goals;
+	TArray<float> HealthFractions;
+	TArray<uint8> Teams;
+	TArray<uint8> ClassIndices;
+	TArray<uint8> Flags;
+
+	// ClassIndices point in here
+	TArray<TSubclassOf<AAICharacter>> MinionClasses;
+
+	// Proxy mesh slot in the crowd actor, parallel to MinionClasses
+	TArray<uint8> ClassMeshIndices;
+
+	TArray<FPromotedMinion> Promoted;
+	int32 NumPromoting = 0;
+
+	// Rebuilt every frame
+	TArray<FVector> PlayerLocations;
+
+	UPROPERTY(Transient)
+	TObjectPtr<AMinionCrowdActor> CrowdActor;
+
+	uint32 NextAgentId = 1;
+};
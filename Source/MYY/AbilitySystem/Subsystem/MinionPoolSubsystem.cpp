@@ -0,0 +1,326 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MinionPoolSubsystem.h"
+#include "MYY/MYY.h"
+#include "MYY/AbilitySystem/AI/AICharacter.h"
+#include "MYY/AbilitySystem/AI/AIController/MinionAIController.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "TimerManager.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Minion Pool Hits"), STAT_MYY_MinionPoolHits, STATGROUP_MYYCombat);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Minion Pool Misses"), STAT_MYY_MinionPoolMisses, STATGROUP_MYYCombat);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Controller Pool Hits"), STAT_MYY_ControllerPoolHits, STATGROUP_MYYCombat);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Controller Pool Misses"), STAT_MYY_ControllerPoolMisses, STATGROUP_MYYCombat);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Parked Minions"), STAT_MYY_ParkedMinions, STATGROUP_MYYCombat);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Parked Controllers"), STAT_MYY_ParkedControllers, STATGROUP_MYYCombat);
+
+static TAutoConsoleVariable<int32> CVarMinionPoolEnable(
+	TEXT("MYY.AI.Pool.Enable"),
+	1,
+	TEXT("1 = park dead minions for reuse, 0 = destroy them (every respawn spawns a new character and controller)."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarMinionPoolMaxPerClass(
+	TEXT("MYY.AI.Pool.MaxPerClass"),
+	32,
+	TEXT("Parked minions kept per character class; extra corpses are destroyed."),
+	ECVF_Default);
+
+// The minion's AIControllerClass, as long as it's a minion controller
+static UClass* GetMinionControllerClass(const AAICharacter* Minion)
+{
+	return Minion->AIControllerClass && Minion->AIControllerClass->IsChildOf<AMinionAIController>()
+		? Minion->AIControllerClass.Get()
+		: AMinionAIController::StaticClass();
+}
+
+bool UMinionPoolSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UMinionPoolSubsystem::Deinitialize()
+{
+	for (const TPair<UClass*, FPooledMinionBucket>& Pair : ParkedMinions)
+	{
+		DEC_DWORD_STAT_BY(STAT_MYY_ParkedMinions, Pair.Value.Minions.Num());
+	}
+	DEC_DWORD_STAT_BY(STAT_MYY_ParkedControllers, ParkedControllers.Num());
+
+	ParkedMinions.Empty();
+	ParkedControllers.Empty();
+	ManagedMinions.Empty();
+	PendingRelease.Empty();
+
+	Super::Deinitialize();
+}
+
+AAICharacter* UMinionPoolSubsystem::AcquireMinion(TSubclassOf<AAICharacter> MinionClass, const FTransform& SpawnTransform,
+	bool bPossess)
+{
+	if (!MinionClass)
+	{
+		return nullptr;
+	}
+
+	AAICharacter* Minion = nullptr;
+	if (FPooledMinionBucket* Bucket = ParkedMinions.Find(MinionClass.Get()))
+	{
+		while (!Minion && Bucket->Minions.Num() > 0)
+		{
+			DEC_DWORD_STAT(STAT_MYY_ParkedMinions);
+
+			// Parked actors can still be destroyed from outside (level teardown, kill volumes)
+			AAICharacter* Parked = Bucket->Minions.Pop(EAllowShrinking::No);
+			Minion = IsValid(Parked) ? Parked : nullptr;
+		}
+	}
+
+	if (Minion)
+	{
+		++MinionHits;
+		INC_DWORD_STAT(STAT_MYY_MinionPoolHits);
+		Minion->ReactivateFromPool(SpawnTransform);
+	}
+	else
+	{
+		++MinionMisses;
+		INC_DWORD_STAT(STAT_MYY_MinionPoolMisses);
+		Minion = SpawnMinion(MinionClass, SpawnTransform);
+		if (!Minion)
+		{
+			return nullptr;
+		}
+	}
+
+	if (bPossess)
+	{
+		PossessMinion(Minion);
+	}
+	return Minion;
+}
+
+void UMinionPoolSubsystem::ReleaseMinion(AMYYCharacterBase* Minion, float Delay)
+{
+	AAICharacter* AIMinion = Cast<AAICharacter>(Minion);
+	if (!AIMinion || !AIMinion->HasAuthority() || PendingRelease.Contains(AIMinion))
+	{
+		return;
+	}
+
+	const FPooledMinionBucket* Bucket = ParkedMinions.Find(AIMinion->GetClass());
+	if (Bucket && Bucket->Minions.Contains(AIMinion))
+	{
+		return;
+	}
+
+	PendingRelease.Add(AIMinion);
+
+	// Always deferred, so parking never runs inside the ability callback that asked for it
+	const TWeakObjectPtr<AAICharacter> WeakMinion(AIMinion);
+	const FTimerDelegate ParkDelegate = FTimerDelegate::CreateWeakLambda(this, [this, WeakMinion]()
+	{
+		PendingRelease.Remove(WeakMinion);
+		if (AAICharacter* ReleasedMinion = WeakMinion.Get())
+		{
+			ParkMinion(ReleasedMinion);
+		}
+	});
+
+	if (Delay > 0.f)
+	{
+		FTimerHandle ParkTimer;
+		GetWorld()->GetTimerManager().SetTimer(ParkTimer, ParkDelegate, Delay, false);
+	}
+	else
+	{
+		GetWorld()->GetTimerManager().SetTimerForNextTick(ParkDelegate);
+	}
+}
+
+void UMinionPoolSubsystem::Prewarm(TSubclassOf<AAICharacter> MinionClass, int32 Count, const FTransform& ParkTransform)
+{
+	if (!MinionClass || CVarMinionPoolEnable.GetValueOnGameThread() == 0)
+	{
+		return;
+	}
+
+	const int32 Parked = ParkedMinions.FindOrAdd(MinionClass.Get()).Minions.Num();
+	for (int32 Index = Parked; Index < Count; ++Index)
+	{
+		if (!SpawnParked(MinionClass, ParkTransform))
+		{
+			break;
+		}
+	}
+}
+
+bool UMinionPoolSubsystem::SpawnParked(TSubclassOf<AAICharacter> MinionClass, const FTransform& ParkTransform)
+{
+	if (!MinionClass || CVarMinionPoolEnable.GetValueOnGameThread() == 0)
+	{
+		return false;
+	}
+
+	AAICharacter* Minion = SpawnMinion(MinionClass, ParkTransform);
+	if (!Minion)
+	{
+		return false;
+	}
+
+	// One controller each, so acquiring them later is a pure hit
+	FActorSpawnParameters ControllerParams;
+	ControllerParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	ParkController(GetWorld()->SpawnActor<AMinionAIController>(GetMinionControllerClass(Minion), ParkTransform, ControllerParams));
+
+	Minion->DeactivateForPool();
+	ParkedMinions.FindOrAdd(MinionClass.Get()).Minions.Add(Minion);
+	INC_DWORD_STAT(STAT_MYY_ParkedMinions);
+	return true;
+}
+
+bool UMinionPoolSubsystem::IsManaged(const AActor* Actor) const
+{
+	return ManagedMinions.Contains(Actor);
+}
+
+AAICharacter* UMinionPoolSubsystem::SpawnMinion(TSubclassOf<AAICharacter> MinionClass, const FTransform& SpawnTransform)
+{
+	AAICharacter* Minion = GetWorld()->SpawnActorDeferred<AAICharacter>(MinionClass, SpawnTransform, nullptr, nullptr,
+		ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn);
+	if (!Minion)
+	{
+		UE_LOG(LogTemp, Error, TEXT("❌ Minion pool: failed to spawn %s"), *GetNameSafe(MinionClass));
+		return nullptr;
+	}
+
+	// Controllers come from the pool too
+	Minion->AutoPossessAI = EAutoPossessAI::Disabled;
+	Minion->FinishSpawning(SpawnTransform);
+
+	ManagedMinions.Add(Minion);
+	return Minion;
+}
+
+void UMinionPoolSubsystem::PossessMinion(AAICharacter* Minion)
+{
+	UClass* ControllerClass = GetMinionControllerClass(Minion);
+
+	AMinionAIController* Controller = nullptr;
+	for (int32 Index = ParkedControllers.Num() - 1; Index >= 0; --Index)
+	{
+		AMinionAIController* Parked = ParkedControllers[Index];
+		if (!IsValid(Parked))
+		{
+			ParkedControllers.RemoveAtSwap(Index);
+			DEC_DWORD_STAT(STAT_MYY_ParkedControllers);
+			continue;
+		}
+
+		if (Parked->GetClass() == ControllerClass)
+		{
+			Controller = Parked;
+			ParkedControllers.RemoveAtSwap(Index);
+			DEC_DWORD_STAT(STAT_MYY_ParkedControllers);
+			break;
+		}
+	}
+
+	if (Controller)
+	{
+		++ControllerHits;
+		INC_DWORD_STAT(STAT_MYY_ControllerPoolHits);
+		Controller->SetActorLocationAndRotation(Minion->GetActorLocation(), Minion->GetActorRotation());
+	}
+	else
+	{
+		++ControllerMisses;
+		INC_DWORD_STAT(STAT_MYY_ControllerPoolMisses);
+
+		FActorSpawnParameters ControllerParams;
+		ControllerParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		Controller = GetWorld()->SpawnActor<AMinionAIController>(ControllerClass, Minion->GetActorLocation(),
+			Minion->GetActorRotation(), ControllerParams);
+	}
+
+	if (Controller)
+	{
+		Controller->Possess(Minion);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("❌ Minion pool: no controller for %s"), *Minion->GetName());
+	}
+}
+
+void UMinionPoolSubsystem::ParkMinion(AAICharacter* Minion)
+{
+	AController* Controller = Minion->GetController();
+	if (Controller)
+	{
+		// OnUnPossess stops the tree and leaves the AI subsystems
+		Controller->UnPossess();
+	}
+
+	FPooledMinionBucket& Bucket = ParkedMinions.FindOrAdd(Minion->GetClass());
+	if (CVarMinionPoolEnable.GetValueOnGameThread() == 0 || Bucket.Minions.Num() >= CVarMinionPoolMaxPerClass.GetValueOnGameThread())
+	{
+		ManagedMinions.Remove(Minion);
+		Minion->Destroy();
+		if (Controller)
+		{
+			Controller->Destroy();
+		}
+		return;
+	}
+
+	// Only minion controllers are reused; anything else that possessed the minion goes with it
+	AMinionAIController* MinionController = Cast<AMinionAIController>(Controller);
+	if (MinionController)
+	{
+		ParkController(MinionController);
+	}
+	else if (Controller)
+	{
+		Controller->Destroy();
+	}
+
+	Minion->DeactivateForPool();
+	Bucket.Minions.Add(Minion);
+	INC_DWORD_STAT(STAT_MYY_ParkedMinions);
+}
+
+void UMinionPoolSubsystem::ParkController(AMinionAIController* Controller)
+{
+	if (!Controller)
+	{
+		return;
+	}
+
+	ParkedControllers.Add(Controller);
+	INC_DWORD_STAT(STAT_MYY_ParkedControllers);
+}
+
+void UMinionPoolSubsystem::DumpPool() const
+{
+	UE_LOG(LogTemp, Warning, TEXT("📊 Minion pool: minions %u hits / %u misses | controllers %u hits / %u misses | %d parked controllers"),
+		MinionHits, MinionMisses, ControllerHits, ControllerMisses, ParkedControllers.Num());
+
+	for (const TPair<UClass*, FPooledMinionBucket>& Pair : ParkedMinions)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("   %s: %d parked"), *GetNameSafe(Pair.Key), Pair.Value.Minions.Num());
+	}
+}
+
+// MYY.AI.Pool.Dump
+static FAutoConsoleCommandWithWorld GMinionPoolDumpCommand(
+	TEXT("MYY.AI.Pool.Dump"),
+	TEXT("Logs parked minions per class and the pool hit/miss totals."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const UMinionPoolSubsystem* MinionPool = World ? World->GetSubsystem<UMinionPoolSubsystem>() : nullptr)
+		{
+			MinionPool->DumpPool();
+		}
+	}));
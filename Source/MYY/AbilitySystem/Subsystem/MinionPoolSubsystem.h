@@ -0,0 +1,85 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "MinionPoolSubsystem.generated.h"
+
+class AAICharacter;
+class AMinionAIController;
+class AMYYCharacterBase;
+
+USTRUCT()
+struct FPooledMinionBucket
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<AAICharacter*> Minions;
+};
+
+/**
+ * Server-side pool of AI characters and their controllers for respawns.
+ *
+ * Dead minions are parked instead of destroyed: unpossessed, hidden, collision and ticking off.
+ * Acquiring one resets it (attributes, effects, tags, loadout) at the spawn point and possesses it
+ * with a parked controller, which keeps its behavior tree and blackboard components. Only a miss
+ * pays for SpawnActor, ASC setup and ability granting.
+ */
+UCLASS()
+class MYY_API UMinionPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	// UWorldSubsystem
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+
+	// A minion at SpawnTransform, reused from the pool when one is parked. Without bPossess the caller
+	// possesses it later with PossessMinion (UMinionSpawnDirectorSubsystem spreads the two over frames).
+	AAICharacter* AcquireMinion(TSubclassOf<AAICharacter> MinionClass, const FTransform& SpawnTransform, bool bPossess = true);
+
+	// Possesses the minion with a parked controller of its AIControllerClass, or a new one
+	void PossessMinion(AAICharacter* Minion);
+
+	// Parks the minion and its controller after Delay seconds. No-op if it's already parked or on its way.
+	void ReleaseMinion(AMYYCharacterBase* Minion, float Delay = 0.f);
+
+	// Spawns parked minions (and controllers) until Count of MinionClass are waiting
+	void Prewarm(TSubclassOf<AAICharacter> MinionClass, int32 Count, const FTransform& ParkTransform);
+
+	// Spawns one minion and one controller straight into the pool
+	bool SpawnParked(TSubclassOf<AAICharacter> MinionClass, const FTransform& ParkTransform);
+
+	// Minions that came from this pool go back to it when their corpse is removed
+	bool IsManaged(const AActor* Actor) const;
+
+	// Parked counts and hit/miss totals to the log (MYY.AI.Pool.Dump)
+	void DumpPool() const;
+
+private:
+
+	AAICharacter* SpawnMinion(TSubclassOf<AAICharacter> MinionClass, const FTransform& SpawnTransform);
+
+	void ParkMinion(AAICharacter* Minion);
+	void ParkController(AMinionAIController* Controller);
+
+	UPROPERTY()
+	TMap<UClass*, FPooledMinionBucket> ParkedMinions;
+
+	UPROPERTY()
+	TArray<AMinionAIController*> ParkedControllers;
+
+	TSet<TWeakObjectPtr<const AActor>> ManagedMinions;
+
+	// Minions with a release timer running
+	TSet<TWeakObjectPtr<const AActor>> PendingRelease;
+
+	uint32 MinionHits = 0;
+	uint32 MinionMisses = 0;
+	uint32 ControllerHits = 0;
+	uint32 ControllerMisses = 0;
+};
@@ -0,0 +1,263 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MinionSignificanceSubsystem.h"
+#include "MYY/MYY.h"
+#include "MYY/AbilitySystem/AI/AIController/MinionAIController.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Significance Update"), STAT_MYY_SignificanceUpdate, STATGROUP_MYYCombat);
+DECLARE_CYCLE_STAT(TEXT("Minion AI (High)"), STAT_MYY_MinionAIHigh, STATGROUP_MYYCombat);
+DECLARE_CYCLE_STAT(TEXT("Minion AI (Medium)"), STAT_MYY_MinionAIMedium, STATGROUP_MYYCombat);
+DECLARE_CYCLE_STAT(TEXT("Minion AI (Low)"), STAT_MYY_MinionAILow, STATGROUP_MYYCombat);
+DECLARE_CYCLE_STAT(TEXT("Minion AI (Dormant)"), STAT_MYY_MinionAIDormant, STATGROUP_MYYCombat);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Minions High"), STAT_MYY_MinionsHigh, STATGROUP_MYYCombat);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Minions Medium"), STAT_MYY_MinionsMedium, STATGROUP_MYYCombat);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Minions Low"), STAT_MYY_MinionsLow, STATGROUP_MYYCombat);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Minions Dormant"), STAT_MYY_MinionsDormant, STATGROUP_MYYCombat);
+
+static TAutoConsoleVariable<int32> CVarSignificanceEnable(
+	TEXT("MYY.AI.Significance.Enable"),
+	1,
+	TEXT("1 = scale minion perception, BT, movement and animation rates by distance/visibility to players. 0 = every minion at full rate."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarSignificanceInterval(
+	TEXT("MYY.AI.Significance.Interval"),
+	0.25f,
+	TEXT("Seconds between minion significance passes."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarSignificanceHighDistance(
+	TEXT("MYY.AI.Significance.HighDistance"),
+	1500.f,
+	TEXT("Minions closer than this to a player run at full rate."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarSignificanceMediumDistance(
+	TEXT("MYY.AI.Significance.MediumDistance"),
+	4000.f,
+	TEXT("Upper distance of the Medium tier."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarSignificanceLowDistance(
+	TEXT("MYY.AI.Significance.LowDistance"),
+	8000.f,
+	TEXT("Upper distance of the Low tier. Minions further from every player are Dormant."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarSignificanceViewAngle(
+	TEXT("MYY.AI.Significance.ViewAngle"),
+	50.f,
+	TEXT("Half-angle (degrees) of a player's view cone. Minions inside it are bumped up one tier."),
+	ECVF_Default);
+
+namespace MinionSignificance
+{
+	// Index = EMinionSignificance
+	static const FMinionSignificanceTierSettings TierSettings[] =
+	{
+		// Acquire targets, service scale, movement tick, anim tick
+		{ true,  1.f, 0.f,         0.f },
+		{ true,  2.f, 1.f / 30.f,  1.f / 30.f },
+		{ true,  4.f, 1.f / 15.f,  1.f / 10.f },
+		{ false, 8.f, 0.25f,       0.5f },
+	};
+
+	static_assert(UE_ARRAY_COUNT(TierSettings) == static_cast<int32>(EMinionSignificance::Count), "One settings row per tier");
+
+	// A minion keeps its tier until it's this much further out than the tier's distance
+	constexpr float DemoteHysteresis = 1.15f;
+}
+
+const FMinionSignificanceTierSettings& UMinionSignificanceSubsystem::GetTierSettings(EMinionSignificance Tier)
+{
+	return MinionSignificance::TierSettings[FMath::Min(static_cast<int32>(Tier), static_cast<int32>(EMinionSignificance::Dormant))];
+}
+
+TStatId UMinionSignificanceSubsystem::GetTierStatId(EMinionSignificance Tier)
+{
+	switch (Tier)
+	{
+	case EMinionSignificance::High:		return GET_STATID(STAT_MYY_MinionAIHigh);
+	case EMinionSignificance::Medium:	return GET_STATID(STAT_MYY_MinionAIMedium);
+	case EMinionSignificance::Low:		return GET_STATID(STAT_MYY_MinionAILow);
+	default:							return GET_STATID(STAT_MYY_MinionAIDormant);
+	}
+}
+
+bool UMinionSignificanceSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UMinionSignificanceSubsystem::Deinitialize()
+{
+	Minions.Empty();
+	UpdateTierStats();
+
+	Super::Deinitialize();
+}
+
+bool UMinionSignificanceSubsystem::IsTickable() const
+{
+	return Minions.Num() > 0;
+}
+
+TStatId UMinionSignificanceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UMinionSignificanceSubsystem, STATGROUP_Tickables);
+}
+
+void UMinionSignificanceSubsystem::RegisterMinion(AMinionAIController* Controller)
+{
+	if (!Controller || !Controller->HasAuthority()) return;
+
+	Minions.AddUnique(Controller);
+	TimeUntilUpdate = 0.f;
+	UpdateTierStats();
+}
+
+void UMinionSignificanceSubsystem::UnregisterMinion(AMinionAIController* Controller)
+{
+	Minions.RemoveSwap(Controller);
+	UpdateTierStats();
+}
+
+void UMinionSignificanceSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	TimeUntilUpdate -= DeltaTime;
+	if (TimeUntilUpdate > 0.f)
+	{
+		return;
+	}
+	TimeUntilUpdate = FMath::Max(CVarSignificanceInterval.GetValueOnGameThread(), 0.f);
+
+	SCOPE_CYCLE_COUNTER(STAT_MYY_SignificanceUpdate);
+
+	const bool bEnabled = CVarSignificanceEnable.GetValueOnGameThread() != 0;
+
+	PlayerViews.Reset();
+	if (bEnabled)
+	{
+		for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+		{
+			const APlayerController* PlayerController = It->Get();
+			if (!PlayerController || !PlayerController->GetPawn())
+			{
+				continue;
+			}
+
+			FVector ViewLocation;
+			FRotator ViewRotation;
+			PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+			FPlayerView& View = PlayerViews.AddDefaulted_GetRef();
+			View.Location = ViewLocation;
+			View.Direction = ViewRotation.Vector();
+		}
+	}
+
+	for (int32 Index = Minions.Num() - 1; Index >= 0; --Index)
+	{
+		AMinionAIController* Controller = Minions[Index].Get();
+		if (!Controller)
+		{
+			// Destroyed without unregistering
+			Minions.RemoveAtSwap(Index);
+			continue;
+		}
+
+		const APawn* Minion = Controller->GetPawn();
+		if (!Minion)
+		{
+			continue;
+		}
+
+		const EMinionSignificance NewTier = bEnabled
+			? ScoreMinion(Minion->GetActorLocation(), Controller->GetSignificanceTier())
+			: EMinionSignificance::High;
+
+		Controller->SetSignificanceTier(NewTier);
+	}
+
+	UpdateTierStats();
+}
+
+EMinionSignificance UMinionSignificanceSubsystem::ScoreMinion(const FVector& MinionLocation, EMinionSignificance CurrentTier) const
+{
+	if (PlayerViews.IsEmpty())
+	{
+		return EMinionSignificance::Dormant;
+	}
+
+	const float ViewCos = FMath::Cos(FMath::DegreesToRadians(CVarSignificanceViewAngle.GetValueOnGameThread()));
+	const float LowDistance = CVarSignificanceLowDistance.GetValueOnGameThread();
+
+	float ClosestDistSq = TNumericLimits<float>::Max();
+	bool bInView = false;
+
+	for (const FPlayerView& View : PlayerViews)
+	{
+		const FVector ToMinion = MinionLocation - View.Location;
+		const float DistSq = ToMinion.SizeSquared();
+		ClosestDistSq = FMath::Min(ClosestDistSq, DistSq);
+
+		if (!bInView && DistSq < FMath::Square(LowDistance))
+		{
+			bInView = (ToMinion.GetSafeNormal() | View.Direction) >= ViewCos;
+		}
+	}
+
+	const float TierDistances[] =
+	{
+		CVarSignificanceHighDistance.GetValueOnGameThread(),
+		CVarSignificanceMediumDistance.GetValueOnGameThread(),
+		LowDistance,
+	};
+
+	int32 Tier = static_cast<int32>(EMinionSignificance::Dormant);
+	for (int32 Candidate = 0; Candidate < static_cast<int32>(UE_ARRAY_COUNT(TierDistances)); ++Candidate)
+	{
+		// Promoting uses the plain distance, staying in the current tier (or dropping less) gets the margin
+		const float Distance = Candidate >= static_cast<int32>(CurrentTier)
+			? TierDistances[Candidate] * MinionSignificance::DemoteHysteresis
+			: TierDistances[Candidate];
+
+		if (ClosestDistSq < FMath::Square(Distance))
+		{
+			Tier = Candidate;
+			break;
+		}
+	}
+
+	// Something a player is looking at can't look choppy
+	if (bInView && Tier > static_cast<int32>(EMinionSignificance::High))
+	{
+		--Tier;
+	}
+
+	return static_cast<EMinionSignificance>(Tier);
+}
+
+void UMinionSignificanceSubsystem::UpdateTierStats() const
+{
+#if STATS
+	int32 Counts[static_cast<int32>(EMinionSignificance::Count)] = {};
+	for (const TWeakObjectPtr<AMinionAIController>& Minion : Minions)
+	{
+		if (const AMinionAIController* Controller = Minion.Get())
+		{
+			++Counts[static_cast<int32>(Controller->GetSignificanceTier())];
+		}
+	}
+
+	SET_DWORD_STAT(STAT_MYY_MinionsHigh, Counts[static_cast<int32>(EMinionSignificance::High)]);
+	SET_DWORD_STAT(STAT_MYY_MinionsMedium, Counts[static_cast<int32>(EMinionSignificance::Medium)]);
+	SET_DWORD_STAT(STAT_MYY_MinionsLow, Counts[static_cast<int32>(EMinionSignificance::Low)]);
+	SET_DWORD_STAT(STAT_MYY_MinionsDormant, Counts[static_cast<int32>(EMinionSignificance::Dormant)]);
+#endif
+}
@@ -0,0 +1,86 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "MinionSignificanceSubsystem.generated.h"
+
+class AMinionAIController;
+
+// How much server time a minion gets, from full rate (High) to barely simulated (Dormant)
+enum class EMinionSignificance : uint8
+{
+	High,
+	Medium,
+	Low,
+	Dormant,
+
+	Count
+};
+
+// What each tier costs. Intervals are seconds, 0 = every frame.
+struct FMinionSignificanceTierSettings
+{
+	// Whether UTargetGridSubsystem looks for targets for this minion
+	bool bAcquireTargets = true;
+
+	// Multiplier on the BT service intervals (UBTService_UpdateCombatState)
+	float ServiceIntervalScale = 1.f;
+
+	float MovementTickInterval = 0.f;
+	float AnimTickInterval = 0.f;
+};
+
+/**
+ * Server-side significance for minions.
+ *
+ * A few times a second every registered AMinionAIController is scored by its distance to the
+ * closest player and whether it's inside any player's view cone, and put in a tier. The controller
+ * then applies the tier's target acquisition, BT service, movement and animation rates.
+ * "stat MYYCombat" shows the minions per tier and the BT time spent in each tier.
+ */
+UCLASS()
+class MYY_API UMinionSignificanceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	static const FMinionSignificanceTierSettings& GetTierSettings(EMinionSignificance Tier);
+
+	// Stat for BT work done by a minion in this tier, for FScopeCycleCounter
+	static TStatId GetTierStatId(EMinionSignificance Tier);
+
+	// UWorldSubsystem
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+
+	// New minions start at High and are rescored on the next pass
+	void RegisterMinion(AMinionAIController* Controller);
+	void UnregisterMinion(AMinionAIController* Controller);
+
+private:
+
+	struct FPlayerView
+	{
+		FVector Location = FVector::ZeroVector;
+		FVector Direction = FVector::ForwardVector;
+	};
+
+	EMinionSignificance ScoreMinion(const FVector& MinionLocation, EMinionSignificance CurrentTier) const;
+
+	void UpdateTierStats() const;
+
+	TArray<TWeakObjectPtr<AMinionAIController>> Minions;
+
+	// Rebuilt every pass
+	TArray<FPlayerView> PlayerViews;
+
+	float TimeUntilUpdate = 0.f;
+};
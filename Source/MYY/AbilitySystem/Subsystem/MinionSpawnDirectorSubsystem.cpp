@@ -0,0 +1,235 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MinionSpawnDirectorSubsystem.h"
+#include "MYY/MYY.h"
+#include "MYY/AbilitySystem/AI/AICharacter.h"
+#include "MYY/AbilitySystem/Subsystem/MinionPoolSubsystem.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "Algo/BinarySearch.h"
+
+DECLARE_CYCLE_STAT(TEXT("Spawn Director"), STAT_MYY_SpawnDirector, STATGROUP_MYYCombat);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Spawn Steps"), STAT_MYY_SpawnSteps, STATGROUP_MYYCombat);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Spawns Pending"), STAT_MYY_SpawnsPending, STATGROUP_MYYCombat);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Spawn Batch Time (ms)"), STAT_MYY_SpawnBatchTime, STATGROUP_MYYCombat);
+
+static TAutoConsoleVariable<float> CVarSpawnDirectorBudgetMs(
+	TEXT("MYY.AI.SpawnDirector.BudgetMs"),
+	2.f,
+	TEXT("Milliseconds per frame for minion spawn steps. At least one step always runs."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarSpawnDirectorAbilityInitDelay(
+	TEXT("MYY.AI.SpawnDirector.AbilityInitDelay"),
+	0.1f,
+	TEXT("Seconds between possessing a minion and initializing its ability system (same as the PossessedBy timer)."),
+	ECVF_Default);
+
+bool UMinionSpawnDirectorSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UMinionSpawnDirectorSubsystem::Deinitialize()
+{
+	DEC_DWORD_STAT_BY(STAT_MYY_SpawnsPending, Requests.Num());
+	Requests.Empty();
+	DeferredRequests.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UMinionSpawnDirectorSubsystem::IsTickable() const
+{
+	return Requests.Num() > 0;
+}
+
+TStatId UMinionSpawnDirectorSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UMinionSpawnDirectorSubsystem, STATGROUP_Tickables);
+}
+
+void UMinionSpawnDirectorSubsystem::RequestSpawn(TSubclassOf<AAICharacter> MinionClass, const FTransform& SpawnTransform,
+	uint8 TeamID, TFunction<void(AAICharacter*)> OnReady)
+{
+	FSpawnRequest Request;
+	Request.MinionClass = MinionClass;
+	Request.SpawnTransform = SpawnTransform;
+	Request.TeamID = TeamID;
+	Request.OnReady = MoveTemp(OnReady);
+
+	// Closest to any player first
+	Request.Priority = TNumericLimits<double>::Max();
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APawn* PlayerPawn = It->Get() ? It->Get()->GetPawn() : nullptr;
+		if (PlayerPawn)
+		{
+			Request.Priority = FMath::Min(Request.Priority, FVector::DistSquared(PlayerPawn->GetActorLocation(), SpawnTransform.GetLocation()));
+		}
+	}
+
+	AddRequest(MoveTemp(Request));
+}
+
+void UMinionSpawnDirectorSubsystem::RequestPrewarm(TSubclassOf<AAICharacter> MinionClass, int32 Count, const FTransform& ParkTransform)
+{
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		FSpawnRequest Request;
+		Request.MinionClass = MinionClass;
+		Request.SpawnTransform = ParkTransform;
+		Request.Step = EStep::Prewarm;
+		Request.Priority = TNumericLimits<double>::Max();
+		AddRequest(MoveTemp(Request));
+	}
+}
+
+void UMinionSpawnDirectorSubsystem::AddRequest(FSpawnRequest&& Request)
+{
+	if (bTicking)
+	{
+		DeferredRequests.Add(MoveTemp(Request));
+		return;
+	}
+
+	if (Requests.IsEmpty())
+	{
+		BatchStartSeconds = FPlatformTime::Seconds();
+		BatchStartFrame = GFrameCounter;
+		BatchSpawned = 0;
+	}
+
+	// Stable: equal priorities keep request order, and started requests stay ahead of new ones
+	const int32 InsertIndex = Algo::UpperBoundBy(Requests, Request.Priority, &FSpawnRequest::Priority);
+	Requests.Insert(MoveTemp(Request), InsertIndex);
+	INC_DWORD_STAT(STAT_MYY_SpawnsPending);
+}
+
+void UMinionSpawnDirectorSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	SCOPE_CYCLE_COUNTER(STAT_MYY_SpawnDirector);
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	const double FrameStart = FPlatformTime::Seconds();
+	const double Budget = CVarSpawnDirectorBudgetMs.GetValueOnGameThread() / 1000.0;
+
+	// Requests doesn't change shape until the loop is done, so Index stays valid across the steps
+	bTicking = true;
+
+	bool bRanStep = false;
+	for (int32 Index = 0; Index < Requests.Num();)
+	{
+		if (bRanStep && FPlatformTime::Seconds() - FrameStart >= Budget)
+		{
+			break;
+		}
+
+		if (Now < Requests[Index].NextStepTime)
+		{
+			++Index;
+			continue;
+		}
+
+		// Stepped on a copy, written back below
+		FSpawnRequest Request = MoveTemp(Requests[Index]);
+		AdvanceRequest(Request, Now);
+		bRanStep = true;
+		INC_DWORD_STAT(STAT_MYY_SpawnSteps);
+
+		if (Request.Step != EStep::Done)
+		{
+			Requests[Index] = MoveTemp(Request);
+			++Index;
+			continue;
+		}
+
+		Requests.RemoveAt(Index);
+		DEC_DWORD_STAT(STAT_MYY_SpawnsPending);
+		++BatchSpawned;
+
+		if (Request.OnReady)
+		{
+			Request.OnReady(Request.Minion.Get());
+		}
+	}
+
+	bTicking = false;
+
+	if (Requests.IsEmpty())
+	{
+		LastBatchSeconds = FPlatformTime::Seconds() - BatchStartSeconds;
+		SET_FLOAT_STAT(STAT_MYY_SpawnBatchTime, LastBatchSeconds * 1000.0);
+
+		UE_LOG(LogMYYCombat, Verbose, TEXT("Spawn director: %d minions ready in %.1f ms over %llu frames"),
+			BatchSpawned, LastBatchSeconds * 1000.0, GFrameCounter - BatchStartFrame + 1);
+	}
+
+	for (FSpawnRequest& Deferred : DeferredRequests)
+	{
+		AddRequest(MoveTemp(Deferred));
+	}
+	DeferredRequests.Reset();
+}
+
+void UMinionSpawnDirectorSubsystem::AdvanceRequest(FSpawnRequest& Request, double Now)
+{
+	UMinionPoolSubsystem* MinionPool = GetWorld()->GetSubsystem<UMinionPoolSubsystem>();
+	if (!MinionPool)
+	{
+		Request.Step = EStep::Done;
+		return;
+	}
+
+	switch (Request.Step)
+	{
+	case EStep::Acquire:
+		if (AAICharacter* Minion = MinionPool->AcquireMinion(Request.MinionClass, Request.SpawnTransform, false))
+		{
+			// Initialized by this director, not PossessedBy's timer
+			Minion->bDeferAbilitySystemInit = true;
+			Minion->SetTeamID(Request.TeamID);
+			Request.Minion = Minion;
+			Request.Step = EStep::Possess;
+		}
+		else
+		{
+			Request.Step = EStep::Done;
+		}
+		break;
+
+	case EStep::Possess:
+		if (AAICharacter* Minion = Request.Minion.Get())
+		{
+			MinionPool->PossessMinion(Minion);
+			Request.Step = EStep::InitializeAbilities;
+			Request.NextStepTime = Now + CVarSpawnDirectorAbilityInitDelay.GetValueOnGameThread();
+		}
+		else
+		{
+			Request.Step = EStep::Done;
+		}
+		break;
+
+	case EStep::InitializeAbilities:
+		if (AAICharacter* Minion = Request.Minion.Get())
+		{
+			Minion->bDeferAbilitySystemInit = false;
+			Minion->InitializeAbilitySystem();
+		}
+		Request.Step = EStep::Done;
+		break;
+
+	case EStep::Prewarm:
+		MinionPool->SpawnParked(Request.MinionClass, Request.SpawnTransform);
+		Request.Step = EStep::Done;
+		break;
+
+	default:
+		Request.Step = EStep::Done;
+		break;
+	}
+}
@@ -0,0 +1,91 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "MinionSpawnDirectorSubsystem.generated.h"
+
+class AAICharacter;
+
+/**
+ * Time-sliced minion spawning, so a wave doesn't land in one frame.
+ *
+ * Each request goes through three steps, at most one per frame: acquire the character from
+ * UMinionPoolSubsystem (construction, equipment), possess it (controller, behavior tree, default
+ * weapon) and initialize its ability system (abilities, default effects). Steps run until the
+ * MYY.AI.SpawnDirector.BudgetMs budget for the frame is used up, closest to a player first.
+ * The time from the first request of a batch to the last minion being ready is logged and kept in
+ * the "Spawn Batch Time" stat.
+ */
+UCLASS()
+class MYY_API UMinionSpawnDirectorSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	// UWorldSubsystem
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+
+	// OnReady gets the possessed, initialized minion (nullptr if it couldn't be spawned).
+	// TeamID is set before possession, so the controller and ability setup already see the right team.
+	void RequestSpawn(TSubclassOf<AAICharacter> MinionClass, const FTransform& SpawnTransform, uint8 TeamID,
+		TFunction<void(AAICharacter*)> OnReady = nullptr);
+
+	// Parks Count new minions in the pool, after every pending spawn
+	void RequestPrewarm(TSubclassOf<AAICharacter> MinionClass, int32 Count, const FTransform& ParkTransform);
+
+	int32 GetNumPending() const { return Requests.Num() + DeferredRequests.Num(); }
+
+	// Seconds from the first request of the last finished batch until everything in it was ready
+	double GetLastBatchSeconds() const { return LastBatchSeconds; }
+
+private:
+
+	enum class EStep : uint8
+	{
+		Acquire,
+		Possess,
+		InitializeAbilities,
+		Prewarm,
+		Done
+	};
+
+	struct FSpawnRequest
+	{
+		TSubclassOf<AAICharacter> MinionClass;
+		FTransform SpawnTransform;
+		TFunction<void(AAICharacter*)> OnReady;
+		TWeakObjectPtr<AAICharacter> Minion;
+		uint8 TeamID = 0;
+		EStep Step = EStep::Acquire;
+
+		// Squared distance to the closest player when requested, lower goes first
+		double Priority = 0.0;
+
+		double NextStepTime = 0.0;
+	};
+
+	void AddRequest(FSpawnRequest&& Request);
+
+	// Runs the request's next step
+	void AdvanceRequest(FSpawnRequest& Request, double Now);
+
+	TArray<FSpawnRequest> Requests;
+
+	// Queued while Tick walks Requests (steps and OnReady can spawn more); added once it's done
+	TArray<FSpawnRequest> DeferredRequests;
+	bool bTicking = false;
+
+	double BatchStartSeconds = 0.0;
+	uint64 BatchStartFrame = 0;
+	int32 BatchSpawned = 0;
+	double LastBatchSeconds = 0.0;
+};
@@ -0,0 +1,305 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "PatrolPointSubsystem.h"
+#include "MYY/MYY.h"
+#include "AIController.h"
+#include "NavigationSystem.h"
+#include "NavFilters/NavigationQueryFilter.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Patrol Point Refill"), STAT_MYY_PatrolPointRefill, STATGROUP_MYYCombat);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Patrol Points Taken"), STAT_MYY_PatrolPointsTaken, STATGROUP_MYYCombat);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Patrol Point Misses"), STAT_MYY_PatrolPointMisses, STATGROUP_MYYCombat);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Patrol Paths Dispatched"), STAT_MYY_PatrolPathsDispatched, STATGROUP_MYYCombat);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Patrol Paths Pending"), STAT_MYY_PatrolPathsPending, STATGROUP_MYYCombat);
+
+static TAutoConsoleVariable<float> CVarPatrolRegionSize(
+	TEXT("MYY.AI.Patrol.RegionSize"),
+	500.f,
+	TEXT("Minions whose homes fall in the same cell of this size share a patrol point set."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarPatrolPointsPerRegion(
+	TEXT("MYY.AI.Patrol.PointsPerRegion"),
+	16,
+	TEXT("Patrol points kept per region. Points are handed out once until half are left, then reused."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarPatrolPointQueriesPerFrame(
+	TEXT("MYY.AI.Patrol.PointQueriesPerFrame"),
+	8,
+	TEXT("Random navigable point queries per frame for refilling patrol regions."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarPatrolPathsPerFrame(
+	TEXT("MYY.AI.Patrol.PathsPerFrame"),
+	16,
+	TEXT("Queued path requests handed to the async navigation queries per frame."),
+	ECVF_Default);
+
+bool UPatrolPointSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UPatrolPointSubsystem::Deinitialize()
+{
+	if (UNavigationSystemV1* NavSys = UNavigationSystemV1::GetCurrent(GetWorld()))
+	{
+		for (const TPair<uint32, FPathRequest>& Pair : PathRequests)
+		{
+			if (Pair.Value.NavQueryId != 0)
+			{
+				NavSys->AbortAsyncFindPathRequest(Pair.Value.NavQueryId);
+			}
+		}
+	}
+
+	DEC_DWORD_STAT_BY(STAT_MYY_PatrolPathsPending, PathRequests.Num());
+	PathRequests.Empty();
+	QueuedPaths.Empty();
+	Regions.Empty();
+	RegionsToRefill.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UPatrolPointSubsystem::IsTickable() const
+{
+	return RegionsToRefill.Num() > 0 || QueuedPaths.Num() > 0;
+}
+
+TStatId UPatrolPointSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UPatrolPointSubsystem, STATGROUP_Tickables);
+}
+
+void UPatrolPointSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	DispatchPaths(FMath::Max(CVarPatrolPathsPerFrame.GetValueOnGameThread(), 1));
+	RefillRegions(FMath::Max(CVarPatrolPointQueriesPerFrame.GetValueOnGameThread(), 1));
+}
+
+UPatrolPointSubsystem::FRegionKey UPatrolPointSubsystem::GetRegionKey(const FVector& Home, float Radius) const
+{
+	const double CellSize = FMath::Max(CVarPatrolRegionSize.GetValueOnGameThread(), 1.f);
+
+	FRegionKey Key;
+	Key.Cell = FIntVector(
+		FMath::FloorToInt32(Home.X / CellSize),
+		FMath::FloorToInt32(Home.Y / CellSize),
+		FMath::FloorToInt32(Home.Z / CellSize));
+	Key.RadiusBucket = FMath::RoundToInt32(Radius / 100.f);
+	return Key;
+}
+
+bool UPatrolPointSubsystem::TakePatrolPoint(const FVector& Home, float Radius, FVector& OutPoint)
+{
+	const FRegionKey Key = GetRegionKey(Home, Radius);
+
+	FPatrolRegion* Region = Regions.Find(Key);
+	if (!Region)
+	{
+		Region = &Regions.Add(Key);
+		Region->Origin = Home;
+		Region->Radius = Radius;
+	}
+
+	const int32 PointsPerRegion = FMath::Max(CVarPatrolPointsPerRegion.GetValueOnGameThread(), 1);
+	if (Region->Points.Num() < PointsPerRegion)
+	{
+		QueueRefill(Key, *Region);
+	}
+
+	if (Region->Points.IsEmpty())
+	{
+		INC_DWORD_STAT(STAT_MYY_PatrolPointMisses);
+		return false;
+	}
+
+	const int32 Index = FMath::RandRange(0, Region->Points.Num() - 1);
+	OutPoint = Region->Points[Index];
+
+	// Fresh points while the set is full enough, reused ones once it runs low
+	if (Region->Points.Num() > PointsPerRegion / 2)
+	{
+		Region->Points.RemoveAtSwap(Index, EAllowShrinking::No);
+	}
+
+	INC_DWORD_STAT(STAT_MYY_PatrolPointsTaken);
+	return true;
+}
+
+void UPatrolPointSubsystem::QueueRefill(const FRegionKey& Key, FPatrolRegion& Region)
+{
+	if (!Region.bQueuedForRefill)
+	{
+		Region.bQueuedForRefill = true;
+		RegionsToRefill.Add(Key);
+	}
+}
+
+void UPatrolPointSubsystem::RefillRegions(int32 Budget)
+{
+	SCOPE_CYCLE_COUNTER(STAT_MYY_PatrolPointRefill);
+
+	UNavigationSystemV1* NavSys = UNavigationSystemV1::GetCurrent(GetWorld());
+	if (!NavSys)
+	{
+		return;
+	}
+
+	const int32 PointsPerRegion = FMath::Max(CVarPatrolPointsPerRegion.GetValueOnGameThread(), 1);
+
+	while (Budget > 0 && RegionsToRefill.Num() > 0)
+	{
+		FPatrolRegion* Region = Regions.Find(RegionsToRefill[0]);
+		if (!Region)
+		{
+			RegionsToRefill.RemoveAt(0, 1, EAllowShrinking::No);
+			continue;
+		}
+
+		// Every attempt costs budget, so an off-mesh region can't stall the rest
+		FNavLocation ResultLocation;
+		if (NavSys->GetRandomPointInNavigableRadius(Region->Origin, Region->Radius, ResultLocation))
+		{
+			Region->Points.Add(ResultLocation.Location);
+		}
+		--Budget;
+
+		// Full, or no navmesh around it at all
+		if (Region->Points.Num() >= PointsPerRegion || Region->Points.IsEmpty())
+		{
+			Region->bQueuedForRefill = false;
+			RegionsToRefill.RemoveAt(0, 1, EAllowShrinking::No);
+		}
+	}
+}
+
+uint32 UPatrolPointSubsystem::RequestPath(AAIController* Querier, const FVector& Goal, TFunction<void(FNavPathSharedPtr)> OnPath)
+{
+	const uint32 RequestId = NextPathRequestId++;
+	if (NextPathRequestId == 0)
+	{
+		NextPathRequestId = 1;
+	}
+
+	FPathRequest& Request = PathRequests.Add(RequestId);
+	Request.Querier = Querier;
+	Request.Goal = Goal;
+	Request.OnPath = MoveTemp(OnPath);
+
+	QueuedPaths.Add(RequestId);
+	INC_DWORD_STAT(STAT_MYY_PatrolPathsPending);
+	return RequestId;
+}
+
+void UPatrolPointSubsystem::CancelPath(uint32 RequestId)
+{
+	FPathRequest Request;
+	if (!PathRequests.RemoveAndCopyValue(RequestId, Request))
+	{
+		return;
+	}
+
+	DEC_DWORD_STAT(STAT_MYY_PatrolPathsPending);
+
+	// A still-queued id is skipped by DispatchPaths
+	if (Request.NavQueryId != 0)
+	{
+		if (UNavigationSystemV1* NavSys = UNavigationSystemV1::GetCurrent(GetWorld()))
+		{
+			NavSys->AbortAsyncFindPathRequest(Request.NavQueryId);
+		}
+	}
+}
+
+void UPatrolPointSubsystem::DispatchPaths(int32 Budget)
+{
+	UNavigationSystemV1* NavSys = UNavigationSystemV1::GetCurrent(GetWorld());
+
+	int32 Dispatched = 0;
+	for (; Dispatched < QueuedPaths.Num() && Budget > 0; ++Dispatched)
+	{
+		const uint32 RequestId = QueuedPaths[Dispatched];
+		FPathRequest* Request = PathRequests.Find(RequestId);
+		if (!Request)
+		{
+			continue;
+		}
+
+		AAIController* Querier = Request->Querier.Get();
+		const APawn* Pawn = Querier ? Querier->GetPawn() : nullptr;
+		const ANavigationData* NavData = (NavSys && Pawn) ? NavSys->GetNavDataForProps(Querier->GetNavAgentPropertiesRef(), Pawn->GetNavAgentLocation()) : nullptr;
+		if (!NavData)
+		{
+			// Nothing to path with; answer now rather than leaving the caller waiting
+			FPathRequest Failed;
+			PathRequests.RemoveAndCopyValue(RequestId, Failed);
+			DEC_DWORD_STAT(STAT_MYY_PatrolPathsPending);
+			if (Failed.OnPath)
+			{
+				Failed.OnPath(nullptr);
+			}
+			continue;
+		}
+
+		FPathFindingQuery Query(Querier, *NavData, Pawn->GetNavAgentLocation(), Request->Goal,
+			UNavigationQueryFilter::GetQueryFilter(*NavData, Querier, Querier->GetDefaultNavigationFilterClass()));
+		Query.SetAllowPartialPaths(false);
+
+		Request->NavQueryId = NavSys->FindPathAsync(Querier->GetNavAgentPropertiesRef(), Query,
+			FNavPathQueryDelegate::CreateUObject(this, &UPatrolPointSubsystem::HandlePathResult, RequestId));
+
+		INC_DWORD_STAT(STAT_MYY_PatrolPathsDispatched);
+		--Budget;
+	}
+
+	QueuedPaths.RemoveAt(0, Dispatched, EAllowShrinking::No);
+}
+
+void UPatrolPointSubsystem::HandlePathResult(uint32 NavQueryId, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path, uint32 RequestId)
+{
+	// Cancelled while in flight
+	FPathRequest Request;
+	if (!PathRequests.RemoveAndCopyValue(RequestId, Request))
+	{
+		return;
+	}
+
+	DEC_DWORD_STAT(STAT_MYY_PatrolPathsPending);
+
+	if (Request.OnPath)
+	{
+		const bool bFound = Result == ENavigationQueryResult::Success && Path.IsValid() && Path->IsValid();
+		Request.OnPath(bFound ? Path : nullptr);
+	}
+}
+
+void UPatrolPointSubsystem::DumpPatrolCache() const
+{
+	UE_LOG(LogTemp, Warning, TEXT("📊 Patrol cache: %d regions (%d refilling), %d path requests (%d queued)"),
+		Regions.Num(), RegionsToRefill.Num(), PathRequests.Num(), QueuedPaths.Num());
+
+	for (const TPair<FRegionKey, FPatrolRegion>& Pair : Regions)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("   %s r=%.0f: %d points"),
+			*Pair.Value.Origin.ToCompactString(), Pair.Value.Radius, Pair.Value.Points.Num());
+	}
+}
+
+// MYY.AI.Patrol.Dump
+static FAutoConsoleCommandWithWorld GPatrolCacheDumpCommand(
+	TEXT("MYY.AI.Patrol.Dump"),
+	TEXT("Logs the cached patrol regions and pending path requests."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const UPatrolPointSubsystem* PatrolPoints = World ? World->GetSubsystem<UPatrolPointSubsystem>() : nullptr)
+		{
+			PatrolPoints->DumpPatrolCache();
+		}
+	}));
@@ -0,0 +1,98 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "NavigationData.h"
+#include "NavigationSystemTypes.h"
+#include "PatrolPointSubsystem.generated.h"
+
+class AAIController;
+
+/**
+ * Navmesh work for idle minions, spread over frames instead of landing in the frame a wave loses its target.
+ *
+ * Patrol points: a small set of random navigable points is kept per patrol region (homes bucketed by
+ * MYY.AI.Patrol.RegionSize and patrol radius). TakePatrolPoint hands one out in O(1); regions running
+ * low are topped up a few queries per frame (MYY.AI.Patrol.PointQueriesPerFrame).
+ *
+ * Paths: RequestPath queues a pathfinding request; up to MYY.AI.Patrol.PathsPerFrame are handed to the
+ * navigation system's async query thread each frame, and the callback runs on the game thread.
+ */
+UCLASS()
+class MYY_API UPatrolPointSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	// UWorldSubsystem
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+
+	// A cached navigable point within about Radius of Home. False on a cache miss (the region is queued for
+	// a refill), in which case the caller does its own query.
+	bool TakePatrolPoint(const FVector& Home, float Radius, FVector& OutPoint);
+
+	// OnPath gets the path, or nullptr when there is none. Returns an id for CancelPath (never 0).
+	uint32 RequestPath(AAIController* Querier, const FVector& Goal, TFunction<void(FNavPathSharedPtr)> OnPath);
+
+	// Drops a queued or in-flight request without calling it back
+	void CancelPath(uint32 RequestId);
+
+	// Regions and queues to the log (MYY.AI.Patrol.Dump)
+	void DumpPatrolCache() const;
+
+private:
+
+	struct FRegionKey
+	{
+		FIntVector Cell = FIntVector::ZeroValue;
+		int32 RadiusBucket = 0;
+
+		bool operator==(const FRegionKey& Other) const { return Cell == Other.Cell && RadiusBucket == Other.RadiusBucket; }
+		friend uint32 GetTypeHash(const FRegionKey& Key) { return HashCombine(GetTypeHash(Key.Cell), GetTypeHash(Key.RadiusBucket)); }
+	};
+
+	struct FPatrolRegion
+	{
+		// Home of the first minion that asked; points are scattered around it
+		FVector Origin = FVector::ZeroVector;
+		float Radius = 0.f;
+		TArray<FVector> Points;
+		bool bQueuedForRefill = false;
+	};
+
+	struct FPathRequest
+	{
+		TWeakObjectPtr<AAIController> Querier;
+		FVector Goal = FVector::ZeroVector;
+		TFunction<void(FNavPathSharedPtr)> OnPath;
+
+		// Navigation system query id once dispatched
+		uint32 NavQueryId = 0;
+	};
+
+	FRegionKey GetRegionKey(const FVector& Home, float Radius) const;
+
+	void QueueRefill(const FRegionKey& Key, FPatrolRegion& Region);
+
+	void RefillRegions(int32 Budget);
+	void DispatchPaths(int32 Budget);
+
+	void HandlePathResult(uint32 NavQueryId, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path, uint32 RequestId);
+
+	TMap<FRegionKey, FPatrolRegion> Regions;
+	TArray<FRegionKey> RegionsToRefill;
+
+	// FIFO of request ids not yet handed to the navigation system
+	TArray<uint32> QueuedPaths;
+	TMap<uint32, FPathRequest> PathRequests;
+	uint32 NextPathRequestId = 1;
+};
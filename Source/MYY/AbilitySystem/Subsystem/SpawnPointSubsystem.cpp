@@ -0,0 +1,273 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SpawnPointSubsystem.h"
+#include "MYY/MYY.h"
+#include "MYY/AbilitySystem/Subsystem/TargetGridSubsystem.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Spawn Point Scoring"), STAT_MYY_SpawnPointScoring, STATGROUP_MYYCombat);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Spawn Points"), STAT_MYY_SpawnPoints, STATGROUP_MYYCombat);
+
+static TAutoConsoleVariable<float> CVarSpawnThreatRadius(
+	TEXT("MYY.Spawn.ThreatRadius"),
+	3000.f,
+	TEXT("Hostiles within this distance of a spawn point make it less safe (closer counts more)."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarSpawnPointsPerFrame(
+	TEXT("MYY.Spawn.PointsPerFrame"),
+	8,
+	TEXT("Spawn points re-scored per frame."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarSpawnCandidates(
+	TEXT("MYY.Spawn.Candidates"),
+	3,
+	TEXT("How many of the safest points a spawn picks from at random."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarSpawnRecentUsePenalty(
+	TEXT("MYY.Spawn.RecentUsePenalty"),
+	2.f,
+	TEXT("Score penalty for a point that was just used, fading out over MYY.Spawn.RecentUseWindow."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarSpawnRecentUseWindow(
+	TEXT("MYY.Spawn.RecentUseWindow"),
+	5.f,
+	TEXT("Seconds until a used spawn point is back to its plain safety score."),
+	ECVF_Default);
+
+bool USpawnPointSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void USpawnPointSubsystem::Deinitialize()
+{
+	DEC_DWORD_STAT_BY(STAT_MYY_SpawnPoints, SpawnPoints.Num());
+	SpawnPoints.Empty();
+
+	for (int32 SpawnList = 0; SpawnList < NumSpawnLists; ++SpawnList)
+	{
+		for (int32 TeamID = 0; TeamID < NumTeams; ++TeamID)
+		{
+			BestPoints[SpawnList][TeamID].Empty();
+		}
+	}
+
+	Super::Deinitialize();
+}
+
+bool USpawnPointSubsystem::IsTickable() const
+{
+	return SpawnPoints.Num() > 0;
+}
+
+TStatId USpawnPointSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USpawnPointSubsystem, STATGROUP_Tickables);
+}
+
+void USpawnPointSubsystem::RegisterSpawnPoint(ACustomPlayerStart* SpawnPoint)
+{
+	if (!SpawnPoint || !SpawnPoint->HasAuthority())
+	{
+		return;
+	}
+
+	if (SpawnPoints.ContainsByPredicate([SpawnPoint](const FSpawnPointEntry& Entry) { return Entry.SpawnPoint.Get() == SpawnPoint; }))
+	{
+		return;
+	}
+
+	FSpawnPointEntry& Entry = SpawnPoints.AddDefaulted_GetRef();
+	Entry.SpawnPoint = SpawnPoint;
+	Entry.Location = SpawnPoint->GetActorLocation();
+	Entry.SpawnType = SpawnPoint->SpawnType;
+	INC_DWORD_STAT(STAT_MYY_SpawnPoints);
+
+	// Usable straight away (zero threat until its first re-score)
+	RankPoints(GetWorld()->GetTimeSeconds());
+}
+
+void USpawnPointSubsystem::UnregisterSpawnPoint(ACustomPlayerStart* SpawnPoint)
+{
+	const int32 Removed = SpawnPoints.RemoveAll([SpawnPoint](const FSpawnPointEntry& Entry)
+	{
+		return Entry.SpawnPoint.Get() == SpawnPoint;
+	});
+
+	if (Removed > 0)
+	{
+		DEC_DWORD_STAT_BY(STAT_MYY_SpawnPoints, Removed);
+		RankPoints(GetWorld()->GetTimeSeconds());
+	}
+}
+
+void USpawnPointSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	SCOPE_CYCLE_COUNTER(STAT_MYY_SpawnPointScoring);
+
+	const int32 Budget = FMath::Min(FMath::Max(CVarSpawnPointsPerFrame.GetValueOnGameThread(), 1), SpawnPoints.Num());
+	for (int32 Step = 0; Step < Budget; ++Step)
+	{
+		NextRescoreIndex = NextRescoreIndex % SpawnPoints.Num();
+		RescorePoint(SpawnPoints[NextRescoreIndex]);
+		++NextRescoreIndex;
+	}
+
+	RankPoints(GetWorld()->GetTimeSeconds());
+}
+
+ACustomPlayerStart* USpawnPointSubsystem::PickSpawnPoint(ESpawnPointType SpawnFor, uint8 TeamID)
+{
+	if (TeamID >= NumTeams)
+	{
+		return nullptr;
+	}
+
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	const TArray<int32>& Candidates = BestPoints[GetSpawnList(SpawnFor)][TeamID];
+	if (Candidates.IsEmpty())
+	{
+		// Used up by earlier picks this frame: rank again, with their recent-use penalty
+		RankPoints(Now);
+		if (Candidates.IsEmpty())
+		{
+			return nullptr;
+		}
+	}
+
+	const int32 PointIndex = Candidates[FMath::RandRange(0, Candidates.Num() - 1)];
+	FSpawnPointEntry& Entry = SpawnPoints[PointIndex];
+	Entry.LastUsedTime = Now;
+
+	// Out of every list until the next ranking, so another spawn this frame lands somewhere else
+	for (int32 SpawnList = 0; SpawnList < NumSpawnLists; ++SpawnList)
+	{
+		for (int32 OtherTeam = 0; OtherTeam < NumTeams; ++OtherTeam)
+		{
+			BestPoints[SpawnList][OtherTeam].RemoveSingle(PointIndex);
+		}
+	}
+
+	return Entry.SpawnPoint.Get();
+}
+
+int32 USpawnPointSubsystem::GetNumSpawnPoints(ESpawnPointType SpawnFor) const
+{
+	const int32 SpawnList = GetSpawnList(SpawnFor);
+	int32 Count = 0;
+	for (const FSpawnPointEntry& Entry : SpawnPoints)
+	{
+		Count += ServesList(Entry, SpawnList) ? 1 : 0;
+	}
+	return Count;
+}
+
+bool USpawnPointSubsystem::ServesList(const FSpawnPointEntry& Entry, int32 SpawnList) const
+{
+	return Entry.SpawnType == ESpawnPointType::Both || GetSpawnList(Entry.SpawnType) == SpawnList;
+}
+
+float USpawnPointSubsystem::GetScore(const FSpawnPointEntry& Entry, int32 TeamID, double Now) const
+{
+	float HostileThreat = 0.f;
+	for (int32 OtherTeam = 0; OtherTeam < NumTeams; ++OtherTeam)
+	{
+		if (OtherTeam != TeamID)
+		{
+			HostileThreat += Entry.ThreatByTeam[OtherTeam];
+		}
+	}
+
+	const float UseWindow = FMath::Max(CVarSpawnRecentUseWindow.GetValueOnGameThread(), KINDA_SMALL_NUMBER);
+	const float RecentUse = FMath::Max(0.f, 1.f - static_cast<float>(Now - Entry.LastUsedTime) / UseWindow);
+
+	return -HostileThreat - RecentUse * CVarSpawnRecentUsePenalty.GetValueOnGameThread();
+}
+
+void USpawnPointSubsystem::RescorePoint(FSpawnPointEntry& Entry)
+{
+	FMemory::Memzero(Entry.ThreatByTeam);
+
+	const UTargetGridSubsystem* TargetGrid = GetWorld()->GetSubsystem<UTargetGridSubsystem>();
+	if (TargetGrid && Entry.SpawnPoint.IsValid())
+	{
+		TargetGrid->AccumulateTeamThreat(Entry.Location, CVarSpawnThreatRadius.GetValueOnGameThread(), Entry.ThreatByTeam);
+	}
+}
+
+void USpawnPointSubsystem::RankPoints(double Now)
+{
+	const int32 NumCandidates = FMath::Max(CVarSpawnCandidates.GetValueOnGameThread(), 1);
+
+	for (int32 SpawnList = 0; SpawnList < NumSpawnLists; ++SpawnList)
+	{
+		for (int32 TeamID = 0; TeamID < NumTeams; ++TeamID)
+		{
+			TArray<int32>& Best = BestPoints[SpawnList][TeamID];
+			Best.Reset();
+
+			// Insertion into a list of at most NumCandidates, best first
+			TArray<float, TInlineAllocator<8>> BestScores;
+			for (int32 Index = 0; Index < SpawnPoints.Num(); ++Index)
+			{
+				const FSpawnPointEntry& Entry = SpawnPoints[Index];
+				if (!ServesList(Entry, SpawnList) || !Entry.SpawnPoint.IsValid())
+				{
+					continue;
+				}
+
+				const float Score = GetScore(Entry, TeamID, Now);
+				int32 Slot = BestScores.Num();
+				while (Slot > 0 && BestScores[Slot - 1] < Score)
+				{
+					--Slot;
+				}
+
+				if (Slot < NumCandidates)
+				{
+					BestScores.Insert(Score, Slot);
+					Best.Insert(Index, Slot);
+					if (Best.Num() > NumCandidates)
+					{
+						BestScores.Pop(EAllowShrinking::No);
+						Best.Pop(EAllowShrinking::No);
+					}
+				}
+			}
+		}
+	}
+}
+
+void USpawnPointSubsystem::DumpSpawnPoints() const
+{
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	UE_LOG(LogTemp, Warning, TEXT("📊 Spawn points: %d registered"), SpawnPoints.Num());
+	for (const FSpawnPointEntry& Entry : SpawnPoints)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("   %s (%s): threat P %.2f / E %.2f / N %.2f | score as player %.2f, as enemy %.2f"),
+			*GetNameSafe(Entry.SpawnPoint.Get()), *UEnum::GetDisplayValueAsText(Entry.SpawnType).ToString(),
+			Entry.ThreatByTeam[0], Entry.ThreatByTeam[1], Entry.ThreatByTeam[2],
+			GetScore(Entry, 0, Now), GetScore(Entry, 1, Now));
+	}
+}
+
+// MYY.Spawn.DumpPoints
+static FAutoConsoleCommandWithWorld GSpawnPointsDumpCommand(
+	TEXT("MYY.Spawn.DumpPoints"),
+	TEXT("Logs every registered spawn point with its per-team threat and safety scores."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const USpawnPointSubsystem* SpawnPointRegistry = World ? World->GetSubsystem<USpawnPointSubsystem>() : nullptr)
+		{
+			SpawnPointRegistry->DumpSpawnPoints();
+		}
+	}));
@@ -0,0 +1,84 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "MYY/PlayerStart/CustomPlayerStart.h"
+#include "SpawnPointSubsystem.generated.h"
+
+/**
+ * Registry of ACustomPlayerStart spawn points with a running safety score, replacing
+ * GetAllActorsOfClassWithTag sweeps on every spawn.
+ *
+ * Points register themselves at BeginPlay. A few are re-scored each frame (round-robin) from the
+ * hostile threat around them in UTargetGridSubsystem, per team, and the best few for each
+ * (spawn type, team) pair are kept ready. PickSpawnPoint takes a random one of those, so
+ * picking is O(1) and back-to-back spawns don't stack on one point.
+ */
+UCLASS()
+class MYY_API USpawnPointSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	// Matches AMYYCharacterBase::TeamID: 0=Player, 1=Enemy, 2=Neutral
+	static constexpr int32 NumTeams = 3;
+
+	// UWorldSubsystem
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+
+	void RegisterSpawnPoint(ACustomPlayerStart* SpawnPoint);
+	void UnregisterSpawnPoint(ACustomPlayerStart* SpawnPoint);
+
+	// A safe point usable for SpawnFor (Player or AI; Both points serve either) for a character of TeamID.
+	// nullptr when no point of that kind is registered.
+	ACustomPlayerStart* PickSpawnPoint(ESpawnPointType SpawnFor, uint8 TeamID);
+
+	int32 GetNumSpawnPoints(ESpawnPointType SpawnFor) const;
+
+	// Scores and rankings to the log (MYY.Spawn.DumpPoints)
+	void DumpSpawnPoints() const;
+
+private:
+
+	struct FSpawnPointEntry
+	{
+		TWeakObjectPtr<ACustomPlayerStart> SpawnPoint;
+		FVector Location = FVector::ZeroVector;
+		ESpawnPointType SpawnType = ESpawnPointType::Player;
+
+		// Threat from each team's characters around the point, as of the last re-score
+		float ThreatByTeam[NumTeams] = {};
+
+		double LastUsedTime = -UE_BIG_NUMBER;
+	};
+
+	// Player and AI lists (Both points are in each)
+	static constexpr int32 NumSpawnLists = 2;
+
+	static int32 GetSpawnList(ESpawnPointType SpawnFor) { return SpawnFor == ESpawnPointType::AI ? 1 : 0; }
+
+	bool ServesList(const FSpawnPointEntry& Entry, int32 SpawnList) const;
+
+	// Higher is safer for a character of TeamID
+	float GetScore(const FSpawnPointEntry& Entry, int32 TeamID, double Now) const;
+
+	void RescorePoint(FSpawnPointEntry& Entry);
+
+	// Rebuilds the best-points lists from the current scores
+	void RankPoints(double Now);
+
+	TArray<FSpawnPointEntry> SpawnPoints;
+	int32 NextRescoreIndex = 0;
+
+	// Best indices into SpawnPoints, best first, per [spawn list][team]
+	TArray<int32> BestPoints[NumSpawnLists][NumTeams];
+};
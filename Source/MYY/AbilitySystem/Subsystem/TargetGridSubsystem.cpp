@@ -0,0 +1,411 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "TargetGridSubsystem.h"
+#include "MYY/MYY.h"
+#include "MYY/AbilitySystem/MYYCharacterBase.h"
+#include "MYY/AbilitySystem/AI/AIController/MinionAIController.h"
+#include "MYY/AbilitySystem/Subsystem/MinionSignificanceSubsystem.h"
+#include "MYY/AbilitySystem/Subsystem/TargetSelectionSubsystem.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Algo/Sort.h"
+
+DECLARE_CYCLE_STAT(TEXT("Target Grid Rebuild"), STAT_MYY_TargetGridRebuild, STATGROUP_MYYCombat);
+DECLARE_CYCLE_STAT(TEXT("Target Grid Query"), STAT_MYY_TargetGridQuery, STATGROUP_MYYCombat);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Target Grid Sight Traces"), STAT_MYY_TargetGridSightTraces, STATGROUP_MYYCombat);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Target Grid Characters"), STAT_MYY_TargetGridCharacters, STATGROUP_MYYCombat);
+
+static TAutoConsoleVariable<float> CVarTargetGridCellSize(
+	TEXT("MYY.AI.TargetGrid.CellSize"),
+	2000.f,
+	TEXT("Cell size (uu) of the team target grid. Roughly the usual query radius."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarTargetGridRefreshInterval(
+	TEXT("MYY.AI.TargetGrid.RefreshInterval"),
+	0.2f,
+	TEXT("Seconds between target refreshes of one minion."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarTargetGridMaxRefreshesPerFrame(
+	TEXT("MYY.AI.TargetGrid.MaxRefreshesPerFrame"),
+	64,
+	TEXT("Minion target refreshes (and line-of-sight traces) started per frame at most."),
+	ECVF_Default);
+
+bool UTargetGridSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UTargetGridSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	SightTraceDelegate.BindUObject(this, &UTargetGridSubsystem::OnSightTraceDone);
+}
+
+void UTargetGridSubsystem::Deinitialize()
+{
+	Characters.Empty();
+	Entries.Empty();
+	Cells.Empty();
+	Seekers.Empty();
+	PendingSightChecks.Empty();
+	SightTraceDelegate.Unbind();
+
+	SET_DWORD_STAT(STAT_MYY_TargetGridCharacters, 0);
+
+	Super::Deinitialize();
+}
+
+bool UTargetGridSubsystem::IsTickable() const
+{
+	return Characters.Num() > 0;
+}
+
+TStatId UTargetGridSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UTargetGridSubsystem, STATGROUP_Tickables);
+}
+
+void UTargetGridSubsystem::RegisterCharacter(AMYYCharacterBase* Character)
+{
+	if (!Character || !Character->HasAuthority()) return;
+
+	Characters.AddUnique(Character);
+}
+
+void UTargetGridSubsystem::UnregisterCharacter(AMYYCharacterBase* Character)
+{
+	Characters.RemoveSwap(Character);
+}
+
+void UTargetGridSubsystem::RegisterSeeker(AMinionAIController* Controller)
+{
+	if (!Controller || !Controller->HasAuthority()) return;
+
+	for (const FSeeker& Seeker : Seekers)
+	{
+		if (Seeker.Controller.Get() == Controller)
+		{
+			return;
+		}
+	}
+
+	FSeeker& Seeker = Seekers.AddDefaulted_GetRef();
+	Seeker.Controller = Controller;
+}
+
+void UTargetGridSubsystem::UnregisterSeeker(AMinionAIController* Controller)
+{
+	Seekers.RemoveAllSwap([Controller](const FSeeker& Seeker)
+	{
+		return Seeker.Controller.Get() == Controller;
+	});
+}
+
+FIntPoint UTargetGridSubsystem::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize));
+}
+
+void UTargetGridSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	RebuildGrid();
+
+	// Dead controllers, then a budgeted round-robin over the rest
+	Seekers.RemoveAllSwap([](const FSeeker& Seeker)
+	{
+		return !Seeker.Controller.IsValid();
+	});
+
+	if (Seekers.IsEmpty())
+	{
+		return;
+	}
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	const float RefreshInterval = FMath::Max(CVarTargetGridRefreshInterval.GetValueOnGameThread(), 0.f);
+	int32 Budget = FMath::Max(CVarTargetGridMaxRefreshesPerFrame.GetValueOnGameThread(), 1);
+
+	NextSeekerIndex = NextSeekerIndex % Seekers.Num();
+	for (int32 Step = 0; Step < Seekers.Num() && Budget > 0; ++Step)
+	{
+		FSeeker& Seeker = Seekers[NextSeekerIndex];
+		NextSeekerIndex = (NextSeekerIndex + 1) % Seekers.Num();
+
+		if (Now < Seeker.NextRefreshTime)
+		{
+			continue;
+		}
+
+		// Jittered so minions spawned together don't refresh on the same frame forever
+		Seeker.NextRefreshTime = Now + RefreshInterval * FMath::FRandRange(0.9f, 1.1f);
+		RefreshSeeker(Seeker.Controller.Get());
+		--Budget;
+	}
+}
+
+void UTargetGridSubsystem::RebuildGrid()
+{
+	SCOPE_CYCLE_COUNTER(STAT_MYY_TargetGridRebuild);
+
+	CellSize = FMath::Max(CVarTargetGridCellSize.GetValueOnGameThread(), 100.f);
+
+	Entries.Reset();
+	for (int32 Index = Characters.Num() - 1; Index >= 0; --Index)
+	{
+		AMYYCharacterBase* Character = Characters[Index].Get();
+		if (!Character)
+		{
+			// Destroyed without unregistering
+			Characters.RemoveAtSwap(Index);
+			continue;
+		}
+
+		if (!Character->IsAlive())
+		{
+			continue;
+		}
+
+		FGridEntry& Entry = Entries.AddDefaulted_GetRef();
+		Entry.Character = Character;
+		Entry.Location = Character->GetActorLocation();
+		Entry.Cell = GetCell(Entry.Location);
+		Entry.TeamID = Character->TeamID;
+	}
+
+	Algo::Sort(Entries, [](const FGridEntry& A, const FGridEntry& B)
+	{
+		return A.Cell.X != B.Cell.X ? A.Cell.X < B.Cell.X : A.Cell.Y < B.Cell.Y;
+	});
+
+	Cells.Reset();
+	for (int32 Start = 0; Start < Entries.Num();)
+	{
+		int32 End = Start + 1;
+		while (End < Entries.Num() && Entries[End].Cell == Entries[Start].Cell)
+		{
+			++End;
+		}
+
+		Cells.Add(Entries[Start].Cell, TPair<int32, int32>(Start, End - Start));
+		Start = End;
+	}
+
+	SET_DWORD_STAT(STAT_MYY_TargetGridCharacters, Entries.Num());
+}
+
+AMYYCharacterBase* UTargetGridSubsystem::FindNearestHostile(const AMYYCharacterBase* Seeker, float Radius,
+	const FVector& ViewDirection, float MinViewDot) const
+{
+	if (!Seeker || Radius <= 0.f)
+	{
+		return nullptr;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_MYY_TargetGridQuery);
+
+	const FVector Origin = Seeker->GetActorLocation();
+	const FIntPoint MinCell = GetCell(Origin - FVector(Radius));
+	const FIntPoint MaxCell = GetCell(Origin + FVector(Radius));
+	const bool bUseViewCone = !ViewDirection.IsNearlyZero() && MinViewDot > -1.f;
+
+	AMYYCharacterBase* Nearest = nullptr;
+	float NearestDistSq = FMath::Square(Radius);
+
+	for (int32 CellX = MinCell.X; CellX <= MaxCell.X; ++CellX)
+	{
+		for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; ++CellY)
+		{
+			const TPair<int32, int32>* Range = Cells.Find(FIntPoint(CellX, CellY));
+			if (!Range)
+			{
+				continue;
+			}
+
+			for (int32 Index = Range->Key; Index < Range->Key + Range->Value; ++Index)
+			{
+				const FGridEntry& Entry = Entries[Index];
+				if (Entry.TeamID == Seeker->TeamID || Entry.Character == Seeker)
+				{
+					continue;
+				}
+
+				const FVector ToEntry = Entry.Location - Origin;
+				const float DistSq = ToEntry.SizeSquared();
+				if (DistSq >= NearestDistSq)
+				{
+					continue;
+				}
+
+				if (bUseViewCone && (ToEntry.GetSafeNormal() | ViewDirection) < MinViewDot)
+				{
+					continue;
+				}
+
+				if (!IsValid(Entry.Character))
+				{
+					continue;
+				}
+
+				Nearest = Entry.Character;
+				NearestDistSq = DistSq;
+			}
+		}
+	}
+
+	return Nearest;
+}
+
+void UTargetGridSubsystem::AccumulateTeamThreat(const FVector& Origin, float Radius, TArrayView<float> OutThreatByTeam) const
+{
+	if (Radius <= 0.f)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_MYY_TargetGridQuery);
+
+	const FIntPoint MinCell = GetCell(Origin - FVector(Radius));
+	const FIntPoint MaxCell = GetCell(Origin + FVector(Radius));
+	const float RadiusSq = FMath::Square(Radius);
+
+	for (int32 CellX = MinCell.X; CellX <= MaxCell.X; ++CellX)
+	{
+		for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; ++CellY)
+		{
+			const TPair<int32, int32>* Range = Cells.Find(FIntPoint(CellX, CellY));
+			if (!Range)
+			{
+				continue;
+			}
+
+			for (int32 Index = Range->Key; Index < Range->Key + Range->Value; ++Index)
+			{
+				const FGridEntry& Entry = Entries[Index];
+				if (!OutThreatByTeam.IsValidIndex(Entry.TeamID))
+				{
+					continue;
+				}
+
+				const float DistSq = FVector::DistSquared(Entry.Location, Origin);
+				if (DistSq < RadiusSq)
+				{
+					OutThreatByTeam[Entry.TeamID] += 1.f - FMath::Sqrt(DistSq) / Radius;
+				}
+			}
+		}
+	}
+}
+
+void UTargetGridSubsystem::GetLivingCharacters(TArray<AMYYCharacterBase*>& OutCharacters) const
+{
+	OutCharacters.Reset(Entries.Num());
+	for (const FGridEntry& Entry : Entries)
+	{
+		if (IsValid(Entry.Character))
+		{
+			OutCharacters.Add(Entry.Character);
+		}
+	}
+}
+
+void UTargetGridSubsystem::RefreshSeeker(AMinionAIController* Controller)
+{
+	APawn* Pawn = Controller ? Controller->GetPawn() : nullptr;
+	const AMYYCharacterBase* Self = Cast<AMYYCharacterBase>(Pawn);
+	if (!Self || !Self->IsAlive())
+	{
+		return;
+	}
+
+	const EMinionSignificance Tier = Controller->GetSignificanceTier();
+	if (!UMinionSignificanceSubsystem::GetTierSettings(Tier).bAcquireTargets)
+	{
+		return;
+	}
+
+	FScopeCycleCounter TierCounter(UMinionSignificanceSubsystem::GetTierStatId(Tier));
+
+	FVector EyeLocation;
+	FRotator EyeRotation;
+	Pawn->GetActorEyesViewPoint(EyeLocation, EyeRotation);
+
+	AActor* CurrentTarget = Controller->GetTargetActor();
+	const AMYYCharacterBase* CurrentCharacter = Cast<AMYYCharacterBase>(CurrentTarget);
+	if (CurrentCharacter && !CurrentCharacter->IsAlive())
+	{
+		Controller->ClearTarget();
+		CurrentTarget = nullptr;
+		CurrentCharacter = nullptr;
+	}
+
+	// The scored choice when there is one; otherwise keep watching the current target out to the
+	// lose-sight radius, or look for the nearest hostile in view
+	AActor* Candidate = nullptr;
+	const UTargetSelectionSubsystem* TargetSelection = GetWorld()->GetSubsystem<UTargetSelectionSubsystem>();
+	const bool bScored = TargetSelection && TargetSelection->GetSelectedTarget(Controller, Candidate);
+	if (!bScored)
+	{
+		if (CurrentTarget && FVector::DistSquared(CurrentTarget->GetActorLocation(), Self->GetActorLocation())
+			< FMath::Square(Controller->LoseSightRadius))
+		{
+			Candidate = CurrentTarget;
+		}
+		else
+		{
+			Candidate = FindNearestHostile(Self, Controller->SightRadius, EyeRotation.Vector(),
+				FMath::Cos(FMath::DegreesToRadians(Controller->PeripheralVisionAngleDegrees)));
+		}
+	}
+
+	if (CurrentTarget && Candidate != CurrentTarget)
+	{
+		Controller->HandleSightResult(CurrentTarget, false);
+	}
+
+	if (!Candidate)
+	{
+		return;
+	}
+
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(MinionSight), false, Pawn);
+
+	const APawn* CandidatePawn = Cast<APawn>(Candidate);
+	const FVector TargetLocation = CandidatePawn ? CandidatePawn->GetPawnViewLocation() : Candidate->GetActorLocation();
+
+	const uint32 SightCheckId = NextSightCheckId++;
+	FSightCheck& SightCheck = PendingSightChecks.Add(SightCheckId);
+	SightCheck.Controller = Controller;
+	SightCheck.Target = Candidate;
+
+	GetWorld()->AsyncLineTraceByChannel(EAsyncTraceType::Single, EyeLocation, TargetLocation, ECC_Visibility,
+		QueryParams, FCollisionResponseParams::DefaultResponseParam, &SightTraceDelegate, SightCheckId);
+
+	INC_DWORD_STAT(STAT_MYY_TargetGridSightTraces);
+}
+
+void UTargetGridSubsystem::OnSightTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceData)
+{
+	FSightCheck SightCheck;
+	if (!PendingSightChecks.RemoveAndCopyValue(TraceData.UserData, SightCheck))
+	{
+		return;
+	}
+
+	AMinionAIController* Controller = SightCheck.Controller.Get();
+	AActor* Target = SightCheck.Target.Get();
+	if (!Controller || !Target)
+	{
+		return;
+	}
+
+	const FHitResult* BlockingHit = FHitResult::GetFirstBlockingHit(TraceData.OutHits);
+	const bool bVisible = !BlockingHit || BlockingHit->GetActor() == Target;
+
+	Controller->HandleSightResult(Target, bVisible);
+}
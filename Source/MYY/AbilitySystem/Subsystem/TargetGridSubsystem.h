@@ -0,0 +1,104 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldCollision.h"
+#include "TargetGridSubsystem.generated.h"
+
+class AMYYCharacterBase;
+class AMinionAIController;
+
+/**
+ * Server-side target acquisition shared by every minion, replacing per-controller sight perception.
+ *
+ * Living characters are bucketed into a uniform XY grid once per frame, keeping their team, so
+ * "nearest hostile within R" only visits the cells the radius touches. Registered seekers (minion
+ * controllers) are refreshed round-robin under a per-frame budget: each refresh picks a candidate
+ * from the grid and confirms it with an async line-of-sight trace. All traces of a frame run in
+ * the async trace batch and come back next frame through AMinionAIController::HandleSightResult.
+ * The candidate is UTargetSelectionSubsystem's scored choice once it has one for the minion.
+ */
+UCLASS()
+class MYY_API UTargetGridSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	// UWorldSubsystem
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+
+	void RegisterCharacter(AMYYCharacterBase* Character);
+	void UnregisterCharacter(AMYYCharacterBase* Character);
+
+	void RegisterSeeker(AMinionAIController* Controller);
+	void UnregisterSeeker(AMinionAIController* Controller);
+
+	// Closest living character on another team within Radius, as of this frame's grid.
+	// With a ViewDirection, only characters where dot(direction to them, ViewDirection) >= MinViewDot count.
+	AMYYCharacterBase* FindNearestHostile(const AMYYCharacterBase* Seeker, float Radius,
+		const FVector& ViewDirection = FVector::ZeroVector, float MinViewDot = -1.f) const;
+
+	// Adds every living character within Radius of Origin to OutThreatByTeam[its TeamID], weighted from 1 at
+	// Origin down to 0 at Radius. Teams past the end of the array are skipped.
+	void AccumulateTeamThreat(const FVector& Origin, float Radius, TArrayView<float> OutThreatByTeam) const;
+
+	// Every living character in this frame's grid
+	void GetLivingCharacters(TArray<AMYYCharacterBase*>& OutCharacters) const;
+
+private:
+
+	struct FGridEntry
+	{
+		AMYYCharacterBase* Character = nullptr;
+		FVector Location = FVector::ZeroVector;
+		FIntPoint Cell = FIntPoint::ZeroValue;
+		uint8 TeamID = 0;
+	};
+
+	struct FSeeker
+	{
+		TWeakObjectPtr<AMinionAIController> Controller;
+		double NextRefreshTime = 0.0;
+	};
+
+	struct FSightCheck
+	{
+		TWeakObjectPtr<AMinionAIController> Controller;
+		TWeakObjectPtr<AActor> Target;
+	};
+
+	FIntPoint GetCell(const FVector& Location) const;
+
+	void RebuildGrid();
+
+	// Picks a candidate for the seeker and queues its line-of-sight trace
+	void RefreshSeeker(AMinionAIController* Controller);
+
+	void OnSightTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceData);
+
+	TArray<TWeakObjectPtr<AMYYCharacterBase>> Characters;
+
+	// Rebuilt every frame, sorted by cell. Cells maps a cell to its [start, start + count) range in Entries.
+	TArray<FGridEntry> Entries;
+	TMap<FIntPoint, TPair<int32, int32>> Cells;
+	float CellSize = 2000.f;
+
+	TArray<FSeeker> Seekers;
+	int32 NextSeekerIndex = 0;
+
+	// In-flight line-of-sight traces by their UserData id
+	TMap<uint32, FSightCheck> PendingSightChecks;
+	uint32 NextSightCheckId = 0;
+
+	FTraceDelegate SightTraceDelegate;
+};
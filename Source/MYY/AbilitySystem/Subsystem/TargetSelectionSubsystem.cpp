@@ -0,0 +1,447 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "TargetSelectionSubsystem.h"
+#include "MYY/MYY.h"
+#include "MYY/AbilitySystem/MYYCharacterBase.h"
+#include "MYY/AbilitySystem/AI/AIController/MinionAIController.h"
+#include "MYY/AbilitySystem/Subsystem/AttackSlotSubsystem.h"
+#include "MYY/AbilitySystem/Subsystem/TargetGridSubsystem.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Target Selection Snapshot"), STAT_MYY_TargetSelectionSnapshot, STATGROUP_MYYCombat);
+DECLARE_CYCLE_STAT(TEXT("Target Selection Scoring"), STAT_MYY_TargetSelectionScoring, STATGROUP_MYYCombat);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Target Selection Switches"), STAT_MYY_TargetSelectionSwitches, STATGROUP_MYYCombat);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Target Selection Task (ms)"), STAT_MYY_TargetSelectionTaskMs, STATGROUP_MYYCombat);
+
+static TAutoConsoleVariable<float> CVarTargetSelectionInterval(
+	TEXT("MYY.AI.TargetSelection.Interval"),
+	0.1f,
+	TEXT("Seconds between minion target scoring passes."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarTargetSelectionWeightDistance(
+	TEXT("MYY.AI.TargetSelection.WeightDistance"),
+	1.f,
+	TEXT("Score weight for closeness (1 at the minion, 0 at its sight radius)."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarTargetSelectionWeightThreat(
+	TEXT("MYY.AI.TargetSelection.WeightThreat"),
+	0.75f,
+	TEXT("Score weight for a candidate that is targeting this minion."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarTargetSelectionWeightDamage(
+	TEXT("MYY.AI.TargetSelection.WeightDamage"),
+	1.f,
+	TEXT("Score weight for recent damage taken from the candidate (relative to the minion's max health)."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarTargetSelectionWeightHealth(
+	TEXT("MYY.AI.TargetSelection.WeightHealth"),
+	0.5f,
+	TEXT("Score weight for the candidate's missing health."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarTargetSelectionWeightCrowding(
+	TEXT("MYY.AI.TargetSelection.WeightCrowding"),
+	0.5f,
+	TEXT("Score penalty for attackers already on the candidate."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarTargetSelectionCrowdedAttackers(
+	TEXT("MYY.AI.TargetSelection.CrowdedAttackers"),
+	3.f,
+	TEXT("Attackers at which the crowding penalty is at its full weight."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarTargetSelectionStickyBonus(
+	TEXT("MYY.AI.TargetSelection.StickyBonus"),
+	0.4f,
+	TEXT("Score bonus for the current target; another candidate has to beat it by this much."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarTargetSelectionDamageHalfLife(
+	TEXT("MYY.AI.TargetSelection.DamageHalfLife"),
+	4.f,
+	TEXT("Seconds for remembered damage to halve."),
+	ECVF_Default);
+
+void UTargetSelectionSubsystem::FSelectionBuffer::Reset()
+{
+	Seekers.Reset();
+	Candidates.Reset();
+	Damage.Reset();
+	Choices.Reset();
+	CandidateActors.Reset();
+	SeekerLookup.Reset();
+}
+
+bool UTargetSelectionSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UTargetSelectionSubsystem::Deinitialize()
+{
+	// The task owns the back buffer until it's done
+	SelectionTask.Wait();
+	bSelectionInFlight = false;
+
+	SeekerStates.Empty();
+	Buffers[0].Reset();
+	Buffers[1].Reset();
+	bHasFrontResults = false;
+
+	Super::Deinitialize();
+}
+
+bool UTargetSelectionSubsystem::IsTickable() const
+{
+	return SeekerStates.Num() > 0 || bSelectionInFlight;
+}
+
+TStatId UTargetSelectionSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UTargetSelectionSubsystem, STATGROUP_Tickables);
+}
+
+void UTargetSelectionSubsystem::RegisterSeeker(AMinionAIController* Controller)
+{
+	if (!Controller || !Controller->HasAuthority())
+	{
+		return;
+	}
+
+	if (SeekerStates.ContainsByPredicate([Controller](const FSeekerState& State) { return State.Controller.Get() == Controller; }))
+	{
+		return;
+	}
+
+	FSeekerState& State = SeekerStates.AddDefaulted_GetRef();
+	State.Controller = Controller;
+}
+
+void UTargetSelectionSubsystem::UnregisterSeeker(AMinionAIController* Controller)
+{
+	SeekerStates.RemoveAllSwap([Controller](const FSeekerState& State)
+	{
+		return State.Controller.Get() == Controller;
+	});
+}
+
+void UTargetSelectionSubsystem::RecordDamage(const AActor* Victim, AActor* Source, float Damage)
+{
+	const APawn* VictimPawn = Cast<APawn>(Victim);
+	const AMinionAIController* Controller = VictimPawn ? Cast<AMinionAIController>(VictimPawn->GetController()) : nullptr;
+	if (!Controller || !Source || Damage <= 0.f)
+	{
+		return;
+	}
+
+	FSeekerState* State = SeekerStates.FindByPredicate([Controller](const FSeekerState& Entry) { return Entry.Controller.Get() == Controller; });
+	if (!State)
+	{
+		return;
+	}
+
+	for (TPair<TWeakObjectPtr<AActor>, float>& Entry : State->DamageTaken)
+	{
+		if (Entry.Key.Get() == Source)
+		{
+			Entry.Value += Damage;
+			return;
+		}
+	}
+
+	State->DamageTaken.Emplace(Source, Damage);
+}
+
+bool UTargetSelectionSubsystem::GetSelectedTarget(const AMinionAIController* Controller, AActor*& OutTarget) const
+{
+	OutTarget = nullptr;
+	if (!bHasFrontResults)
+	{
+		return false;
+	}
+
+	const FSelectionBuffer& Front = Buffers[FrontBuffer];
+	const int32* SeekerIndex = Front.SeekerLookup.Find(TObjectKey<AMinionAIController>(Controller));
+	if (!SeekerIndex)
+	{
+		return false;
+	}
+
+	const FChoice& Choice = Front.Choices[*SeekerIndex];
+	if (Front.CandidateActors.IsValidIndex(Choice.Candidate))
+	{
+		// May have died since the snapshot
+		const AMYYCharacterBase* Character = Cast<AMYYCharacterBase>(Front.CandidateActors[Choice.Candidate].Get());
+		if (Character && Character->IsAlive())
+		{
+			OutTarget = Front.CandidateActors[Choice.Candidate].Get();
+		}
+	}
+	return true;
+}
+
+void UTargetSelectionSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// Never waits: a pass that isn't done yet just keeps the current results another frame
+	if (bSelectionInFlight)
+	{
+		if (!SelectionTask.IsCompleted())
+		{
+			return;
+		}
+
+		bSelectionInFlight = false;
+		FrontBuffer ^= 1;
+		bHasFrontResults = true;
+
+		LastTaskMs = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - LaunchCycles);
+		SET_FLOAT_STAT(STAT_MYY_TargetSelectionTaskMs, LastTaskMs);
+	}
+
+	SeekerStates.RemoveAllSwap([](const FSeekerState& State)
+	{
+		return !State.Controller.IsValid();
+	});
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	if (SeekerStates.IsEmpty() || Now - LastSnapshotTime < CVarTargetSelectionInterval.GetValueOnGameThread())
+	{
+		return;
+	}
+
+	FSelectionBuffer& Back = Buffers[FrontBuffer ^ 1];
+	BuildSnapshot(Back);
+	LastSnapshotTime = Now;
+
+	LaunchCycles = FPlatformTime::Cycles64();
+	bSelectionInFlight = true;
+	SelectionTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [&Back]()
+	{
+		ScoreSeekers(Back);
+	});
+}
+
+void UTargetSelectionSubsystem::BuildSnapshot(FSelectionBuffer& Buffer)
+{
+	SCOPE_CYCLE_COUNTER(STAT_MYY_TargetSelectionSnapshot);
+
+	Buffer.Reset();
+	Buffer.SnapshotTime = GetWorld()->GetTimeSeconds();
+
+	FWeights& Weights = Buffer.Weights;
+	Weights.Distance = CVarTargetSelectionWeightDistance.GetValueOnGameThread();
+	Weights.Threat = CVarTargetSelectionWeightThreat.GetValueOnGameThread();
+	Weights.Damage = CVarTargetSelectionWeightDamage.GetValueOnGameThread();
+	Weights.Health = CVarTargetSelectionWeightHealth.GetValueOnGameThread();
+	Weights.Crowding = CVarTargetSelectionWeightCrowding.GetValueOnGameThread();
+	Weights.Sticky = CVarTargetSelectionStickyBonus.GetValueOnGameThread();
+	Weights.CrowdedAttackers = FMath::Max(CVarTargetSelectionCrowdedAttackers.GetValueOnGameThread(), 1.f);
+
+	// Candidates: everyone alive on the target grid this frame
+	const UTargetGridSubsystem* TargetGrid = GetWorld()->GetSubsystem<UTargetGridSubsystem>();
+	const UAttackSlotSubsystem* AttackSlots = GetWorld()->GetSubsystem<UAttackSlotSubsystem>();
+
+	TArray<AMYYCharacterBase*> Characters;
+	if (TargetGrid)
+	{
+		TargetGrid->GetLivingCharacters(Characters);
+	}
+
+	CandidateIndexScratch.Reset();
+	for (AMYYCharacterBase* Character : Characters)
+	{
+		CandidateIndexScratch.Add(Character, Buffer.Candidates.Num());
+		Buffer.CandidateActors.Add(Character);
+
+		FCandidateInput& Candidate = Buffer.Candidates.AddDefaulted_GetRef();
+		Candidate.Location = Character->GetActorLocation();
+		Candidate.TeamID = Character->TeamID;
+		Candidate.Attackers = AttackSlots ? AttackSlots->GetNumAttackers(Character) : 0;
+		if (Character->AttributeSet && Character->AttributeSet->GetMaxHealth() > 0.f)
+		{
+			Candidate.HealthFraction = Character->AttributeSet->GetHealth() / Character->AttributeSet->GetMaxHealth();
+		}
+	}
+
+	// Who each candidate is after, once every index is known
+	for (int32 Index = 0; Index < Characters.Num(); ++Index)
+	{
+		if (const int32* TargetIndex = CandidateIndexScratch.Find(Characters[Index]->GetCurrentTarget()))
+		{
+			Buffer.Candidates[Index].Target = *TargetIndex;
+		}
+	}
+
+	const float DamageDecay = FMath::Pow(0.5f, static_cast<float>(Buffer.SnapshotTime - LastSnapshotTime)
+		/ FMath::Max(CVarTargetSelectionDamageHalfLife.GetValueOnGameThread(), 0.01f));
+
+	for (FSeekerState& State : SeekerStates)
+	{
+		AMinionAIController* Controller = State.Controller.Get();
+		const AMYYCharacterBase* Self = Controller ? Cast<AMYYCharacterBase>(Controller->GetPawn()) : nullptr;
+		if (!Self || !Self->IsAlive())
+		{
+			State.DamageTaken.Reset();
+			continue;
+		}
+
+		FVector EyeLocation;
+		FRotator EyeRotation;
+		Self->GetActorEyesViewPoint(EyeLocation, EyeRotation);
+
+		Buffer.SeekerLookup.Add(TObjectKey<AMinionAIController>(Controller), Buffer.Seekers.Num());
+
+		FSeekerInput& Seeker = Buffer.Seekers.AddDefaulted_GetRef();
+		Seeker.Location = Self->GetActorLocation();
+		Seeker.Forward = EyeRotation.Vector();
+		Seeker.SightRadius = FMath::Max(Controller->SightRadius, 1.f);
+		Seeker.SightRadiusSq = FMath::Square(Controller->SightRadius);
+		Seeker.LoseSightRadiusSq = FMath::Square(FMath::Max(Controller->LoseSightRadius, Controller->SightRadius));
+		Seeker.MinViewDot = FMath::Cos(FMath::DegreesToRadians(Controller->PeripheralVisionAngleDegrees));
+		Seeker.MaxHealth = Self->AttributeSet ? FMath::Max(Self->AttributeSet->GetMaxHealth(), 1.f) : 100.f;
+		Seeker.TeamID = Self->TeamID;
+
+		if (const int32* SelfIndex = CandidateIndexScratch.Find(Self))
+		{
+			Seeker.Self = *SelfIndex;
+		}
+		if (const int32* TargetIndex = CandidateIndexScratch.Find(Controller->GetTargetActor()))
+		{
+			Seeker.CurrentTarget = *TargetIndex;
+		}
+
+		// Decay remembered damage and pass on what's left
+		Seeker.DamageStart = Buffer.Damage.Num();
+		for (int32 Index = State.DamageTaken.Num() - 1; Index >= 0; --Index)
+		{
+			TPair<TWeakObjectPtr<AActor>, float>& Entry = State.DamageTaken[Index];
+			Entry.Value *= DamageDecay;
+
+			const int32* SourceIndex = CandidateIndexScratch.Find(Entry.Key.Get());
+			if (Entry.Value < 1.f || !Entry.Key.IsValid())
+			{
+				State.DamageTaken.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+			}
+			else if (SourceIndex)
+			{
+				Buffer.Damage.Add({ *SourceIndex, Entry.Value });
+			}
+		}
+		Seeker.DamageCount = Buffer.Damage.Num() - Seeker.DamageStart;
+	}
+
+	Buffer.Choices.SetNum(Buffer.Seekers.Num());
+}
+
+void UTargetSelectionSubsystem::ScoreSeekers(FSelectionBuffer& Buffer)
+{
+	SCOPE_CYCLE_COUNTER(STAT_MYY_TargetSelectionScoring);
+
+	const FWeights& Weights = Buffer.Weights;
+
+	for (int32 SeekerIndex = 0; SeekerIndex < Buffer.Seekers.Num(); ++SeekerIndex)
+	{
+		const FSeekerInput& Seeker = Buffer.Seekers[SeekerIndex];
+		FChoice Best;
+		float BestScore = -UE_BIG_NUMBER;
+
+		for (int32 CandidateIndex = 0; CandidateIndex < Buffer.Candidates.Num(); ++CandidateIndex)
+		{
+			const FCandidateInput& Candidate = Buffer.Candidates[CandidateIndex];
+			if (Candidate.TeamID == Seeker.TeamID || CandidateIndex == Seeker.Self)
+			{
+				continue;
+			}
+
+			const bool bIsCurrent = CandidateIndex == Seeker.CurrentTarget;
+
+			float DamageFromCandidate = 0.f;
+			for (int32 DamageIndex = Seeker.DamageStart; DamageIndex < Seeker.DamageStart + Seeker.DamageCount; ++DamageIndex)
+			{
+				if (Buffer.Damage[DamageIndex].Candidate == CandidateIndex)
+				{
+					DamageFromCandidate += Buffer.Damage[DamageIndex].Damage;
+				}
+			}
+
+			// Same reach as the sight checks: in view within sight radius, the current target out to the lose-sight
+			// radius, and whoever hurt us from anywhere in sight radius
+			const FVector ToCandidate = Candidate.Location - Seeker.Location;
+			const float DistSq = ToCandidate.SizeSquared();
+			if (DistSq > (bIsCurrent ? Seeker.LoseSightRadiusSq : Seeker.SightRadiusSq))
+			{
+				continue;
+			}
+			if (!bIsCurrent && DamageFromCandidate <= 0.f && (ToCandidate.GetSafeNormal() | Seeker.Forward) < Seeker.MinViewDot)
+			{
+				continue;
+			}
+
+			// Our own slot doesn't count against the target we're already on
+			const int32 OtherAttackers = FMath::Max(Candidate.Attackers - (bIsCurrent ? 1 : 0), 0);
+
+			const float Score =
+				Weights.Distance * FMath::Max(1.f - FMath::Sqrt(DistSq) / Seeker.SightRadius, 0.f)
+				+ Weights.Threat * (Candidate.Target != INDEX_NONE && Candidate.Target == Seeker.Self ? 1.f : 0.f)
+				+ Weights.Damage * FMath::Min(DamageFromCandidate / Seeker.MaxHealth, 1.f)
+				+ Weights.Health * (1.f - FMath::Clamp(Candidate.HealthFraction, 0.f, 1.f))
+				- Weights.Crowding * FMath::Min(OtherAttackers / Weights.CrowdedAttackers, 1.f)
+				+ (bIsCurrent ? Weights.Sticky : 0.f);
+
+			if (Score > BestScore)
+			{
+				BestScore = Score;
+				Best.Candidate = CandidateIndex;
+				Best.Score = Score;
+			}
+		}
+
+		if (Best.Candidate != Seeker.CurrentTarget)
+		{
+			INC_DWORD_STAT(STAT_MYY_TargetSelectionSwitches);
+		}
+
+		Buffer.Choices[SeekerIndex] = Best;
+	}
+}
+
+void UTargetSelectionSubsystem::DumpSelection() const
+{
+	UE_LOG(LogTemp, Warning, TEXT("📊 Target selection: %d minions, last pass %.3f ms%s"),
+		SeekerStates.Num(), LastTaskMs, bSelectionInFlight ? TEXT(" (pass running)") : TEXT(""));
+
+	if (!bHasFrontResults)
+	{
+		return;
+	}
+
+	const FSelectionBuffer& Front = Buffers[FrontBuffer];
+	for (const TPair<TObjectKey<AMinionAIController>, int32>& Pair : Front.SeekerLookup)
+	{
+		const FChoice& Choice = Front.Choices[Pair.Value];
+		const AActor* Target = Front.CandidateActors.IsValidIndex(Choice.Candidate) ? Front.CandidateActors[Choice.Candidate].Get() : nullptr;
+		const AMinionAIController* Controller = Pair.Key.ResolveObjectPtr();
+		UE_LOG(LogTemp, Warning, TEXT("   %s -> %s (%.2f)"),
+			*GetNameSafe(Controller ? Controller->GetPawn() : nullptr), *GetNameSafe(Target), Choice.Score);
+	}
+}
+
+// MYY.AI.TargetSelection.Dump
+static FAutoConsoleCommandWithWorld GTargetSelectionDumpCommand(
+	TEXT("MYY.AI.TargetSelection.Dump"),
+	TEXT("Logs each minion's selected target and score from the last finished pass."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const UTargetSelectionSubsystem* Selection = World ? World->GetSubsystem<UTargetSelectionSubsystem>() : nullptr)
+		{
+			Selection->DumpSelection();
+		}
+	}));
@@ -0,0 +1,155 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tasks/Task.h"
+#include "UObject/ObjectKey.h"
+#include "TargetSelectionSubsystem.generated.h"
+
+class AMinionAIController;
+
+/**
+ * Utility-scored target choice for minions, computed off the game thread.
+ *
+ * Every MYY.AI.TargetSelection.Interval the game thread snapshots the registered minions and every
+ * living character (position, team, health, current target, attackers on it, damage each minion
+ * took from it) and hands the snapshot to a task. The task scores each minion's candidates on
+ * distance, threat (the candidate is after this minion), damage received from it, its missing
+ * health and how many attackers it already has, with a bonus for the current target so choices
+ * don't flip-flop. Results are double-buffered: UTargetGridSubsystem reads the last finished
+ * set through GetSelectedTarget while the next one is computed, with no locking.
+ */
+UCLASS()
+class MYY_API UTargetSelectionSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	// UWorldSubsystem
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+
+	void RegisterSeeker(AMinionAIController* Controller);
+	void UnregisterSeeker(AMinionAIController* Controller);
+
+	// Called on the server for every damaging hit; remembered (decaying) by the victim's minion controller
+	void RecordDamage(const AActor* Victim, AActor* Source, float Damage);
+
+	// False until a finished result includes Controller. OutTarget is nullptr when nothing is worth targeting.
+	bool GetSelectedTarget(const AMinionAIController* Controller, AActor*& OutTarget) const;
+
+	// Selections and timings to the log (MYY.AI.TargetSelection.Dump)
+	void DumpSelection() const;
+
+private:
+
+	struct FSeekerState
+	{
+		TWeakObjectPtr<AMinionAIController> Controller;
+		TArray<TPair<TWeakObjectPtr<AActor>, float>> DamageTaken;
+	};
+
+	// Plain data only: read by the selection task
+	struct FSeekerInput
+	{
+		FVector Location = FVector::ZeroVector;
+		FVector Forward = FVector::ForwardVector;
+		float SightRadiusSq = 0.f;
+		float LoseSightRadiusSq = 0.f;
+		float MinViewDot = -1.f;
+		float SightRadius = 1.f;
+		float MaxHealth = 1.f;
+
+		// Candidate indices, INDEX_NONE when not a candidate
+		int32 Self = INDEX_NONE;
+		int32 CurrentTarget = INDEX_NONE;
+
+		// [DamageStart, DamageStart + DamageCount) in FSelectionBuffer::Damage
+		int32 DamageStart = 0;
+		int32 DamageCount = 0;
+
+		uint8 TeamID = 0;
+	};
+
+	struct FCandidateInput
+	{
+		FVector Location = FVector::ZeroVector;
+		float HealthFraction = 1.f;
+		int32 Attackers = 0;
+
+		// Candidate index of whoever this candidate is after
+		int32 Target = INDEX_NONE;
+
+		uint8 TeamID = 0;
+	};
+
+	struct FDamageInput
+	{
+		int32 Candidate = INDEX_NONE;
+		float Damage = 0.f;
+	};
+
+	struct FWeights
+	{
+		float Distance = 1.f;
+		float Threat = 1.f;
+		float Damage = 1.f;
+		float Health = 1.f;
+		float Crowding = 1.f;
+		float Sticky = 0.f;
+		float CrowdedAttackers = 1.f;
+	};
+
+	struct FChoice
+	{
+		int32 Candidate = INDEX_NONE;
+		float Score = 0.f;
+	};
+
+	// One snapshot and its results. The game thread only touches the front buffer while the task runs on the back one.
+	struct FSelectionBuffer
+	{
+		TArray<FSeekerInput> Seekers;
+		TArray<FCandidateInput> Candidates;
+		TArray<FDamageInput> Damage;
+		FWeights Weights;
+
+		TArray<FChoice> Choices;
+
+		// Game thread side, to resolve Choices
+		TArray<TWeakObjectPtr<AActor>> CandidateActors;
+		TMap<TObjectKey<AMinionAIController>, int32> SeekerLookup;
+
+		double SnapshotTime = 0.0;
+
+		void Reset();
+	};
+
+	void BuildSnapshot(FSelectionBuffer& Buffer);
+
+	static void ScoreSeekers(FSelectionBuffer& Buffer);
+
+	TArray<FSeekerState> SeekerStates;
+
+	FSelectionBuffer Buffers[2];
+	int32 FrontBuffer = 0;
+	bool bHasFrontResults = false;
+
+	UE::Tasks::FTask SelectionTask;
+	bool bSelectionInFlight = false;
+	uint64 LaunchCycles = 0;
+	double LastTaskMs = 0.0;
+
+	double LastSnapshotTime = 0.0;
+
+	// Snapshot scratch
+	TMap<const AActor*, int32> CandidateIndexScratch;
+};
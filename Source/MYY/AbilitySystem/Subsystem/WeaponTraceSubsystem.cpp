@@ -0,0 +1,155 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "WeaponTraceSubsystem.h"
+#include "MYY/MYY.h"
+#include "MYY/AbilitySystem/BaseWeapon.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Weapon Trace Batch"), STAT_MYY_WeaponTraceBatch, STATGROUP_MYYCombat);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Weapon Sweeps / Frame"), STAT_MYY_WeaponSweeps, STATGROUP_MYYCombat);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Active Weapon Traces"), STAT_MYY_ActiveWeaponTraces, STATGROUP_MYYCombat);
+
+static TAutoConsoleVariable<float> CVarWeaponTraceRate(
+	TEXT("MYY.WeaponTrace.Rate"),
+	0.f,
+	TEXT("Fixed rate (Hz) for the batched melee weapon traces. 0 = once per world tick."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarWeaponTraceMaxSubsteps(
+	TEXT("MYY.WeaponTrace.MaxSubsteps"),
+	4,
+	TEXT("Most fixed-rate steps traced in one frame after a hitch. Time beyond that is covered by wider steps."),
+	ECVF_Default);
+
+bool UWeaponTraceSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UWeaponTraceSubsystem::Deinitialize()
+{
+	ActiveWeapons.Empty();
+	HitScratch.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UWeaponTraceSubsystem::IsTickable() const
+{
+	return ActiveWeapons.Num() > 0;
+}
+
+TStatId UWeaponTraceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UWeaponTraceSubsystem, STATGROUP_Tickables);
+}
+
+void UWeaponTraceSubsystem::RegisterWeapon(ABaseWeapon* Weapon)
+{
+	if (!Weapon || IsWeaponRegistered(Weapon)) return;
+
+	// First weapon of a new batch: trace on the very next tick
+	if (ActiveWeapons.Num() == 0)
+	{
+		const float Rate = CVarWeaponTraceRate.GetValueOnGameThread();
+		StepAccumulator = Rate > 0.f ? 1.f / Rate : 0.f;
+	}
+
+	ActiveWeapons.Add(Weapon);
+	SET_DWORD_STAT(STAT_MYY_ActiveWeaponTraces, ActiveWeapons.Num());
+}
+
+void UWeaponTraceSubsystem::UnregisterWeapon(ABaseWeapon* Weapon)
+{
+	const int32 Index = ActiveWeapons.IndexOfByPredicate([Weapon](const TWeakObjectPtr<ABaseWeapon>& Entry)
+	{
+		return Entry.Get() == Weapon;
+	});
+
+	if (Index == INDEX_NONE) return;
+
+	if (bIsTracingBatch)
+	{
+		// A hit inside the batch can end another trace (death, parry stagger...)
+		ActiveWeapons[Index].Reset();
+		return;
+	}
+
+	ActiveWeapons.RemoveAtSwap(Index);
+	SET_DWORD_STAT(STAT_MYY_ActiveWeaponTraces, ActiveWeapons.Num());
+}
+
+bool UWeaponTraceSubsystem::IsWeaponRegistered(const ABaseWeapon* Weapon) const
+{
+	return ActiveWeapons.ContainsByPredicate([Weapon](const TWeakObjectPtr<ABaseWeapon>& Entry)
+	{
+		return Entry.Get() == Weapon;
+	});
+}
+
+int32 UWeaponTraceSubsystem::ConsumeFixedSteps(float DeltaTime)
+{
+	const float Rate = CVarWeaponTraceRate.GetValueOnGameThread();
+	if (Rate <= 0.f)
+	{
+		return 1;
+	}
+
+	const float StepTime = 1.f / Rate;
+	StepAccumulator += DeltaTime;
+
+	const int32 NumSteps = FMath::FloorToInt(StepAccumulator / StepTime);
+	StepAccumulator -= NumSteps * StepTime;
+
+	// Past the cap the remaining steps are merged into wider ones, the blade still covers the whole span
+	return FMath::Min(NumSteps, FMath::Max(CVarWeaponTraceMaxSubsteps.GetValueOnGameThread(), 1));
+}
+
+void UWeaponTraceSubsystem::CompactActiveWeapons()
+{
+	ActiveWeapons.RemoveAllSwap([](const TWeakObjectPtr<ABaseWeapon>& Entry)
+	{
+		return !Entry.IsValid();
+	});
+
+	SET_DWORD_STAT(STAT_MYY_ActiveWeaponTraces, ActiveWeapons.Num());
+}
+
+void UWeaponTraceSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	SCOPE_CYCLE_COUNTER(STAT_MYY_WeaponTraceBatch);
+
+	const int32 NumSteps = ConsumeFixedSteps(DeltaTime);
+	if (NumSteps == 0)
+	{
+		return;
+	}
+
+	int32 SweepCount = 0;
+
+	bIsTracingBatch = true;
+	for (int32 Step = 0; Step < NumSteps; ++Step)
+	{
+		// Each substep sweeps an equal share of what's left of this frame's motion
+		const float StepAlpha = 1.f / (NumSteps - Step);
+
+		for (int32 Index = 0; Index < ActiveWeapons.Num(); ++Index)
+		{
+			if (ABaseWeapon* Weapon = ActiveWeapons[Index].Get())
+			{
+				SweepCount += Weapon->PerformTrace(HitScratch, StepAlpha);
+			}
+		}
+	}
+	bIsTracingBatch = false;
+
+	CompactActiveWeapons();
+
+	LastFrameSweepCount = SweepCount;
+	INC_DWORD_STAT_BY(STAT_MYY_WeaponSweeps, SweepCount);
+
+	UE_LOG(LogMYYCombat, Verbose, TEXT("[WeaponTraceSubsystem] %d weapons, %d sweeps this batch"),
+		ActiveWeapons.Num(), SweepCount);
+}
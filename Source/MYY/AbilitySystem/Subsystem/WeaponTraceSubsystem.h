@@ -0,0 +1,64 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WeaponTraceSubsystem.generated.h"
+
+class ABaseWeapon;
+
+/**
+ * Drives every active melee weapon trace from one place on the server.
+ * Weapons register when a trace window opens (StartTrace / EnableWeaponCollision)
+ * and unregister when it closes, instead of each owning a 10 ms looping timer.
+ *
+ * By default every registered weapon is traced once per world tick. Setting
+ * MYY.WeaponTrace.Rate to a value > 0 runs the batch at that fixed rate instead.
+ */
+UCLASS()
+class MYY_API UWeaponTraceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	// UWorldSubsystem
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+
+	void RegisterWeapon(ABaseWeapon* Weapon);
+	void UnregisterWeapon(ABaseWeapon* Weapon);
+	bool IsWeaponRegistered(const ABaseWeapon* Weapon) const;
+
+	UFUNCTION(BlueprintPure, Category = "Combat|Debug")
+	int32 GetActiveWeaponCount() const { return ActiveWeapons.Num(); }
+
+	// Sweeps issued by the last batch that actually ran
+	UFUNCTION(BlueprintPure, Category = "Combat|Debug")
+	int32 GetLastFrameSweepCount() const { return LastFrameSweepCount; }
+
+private:
+
+	// Whole fixed-rate steps due this frame (0: skip the frame), at most MYY.WeaponTrace.MaxSubsteps.
+	// Always 1 without a fixed rate.
+	int32 ConsumeFixedSteps(float DeltaTime);
+
+	void CompactActiveWeapons();
+
+	TArray<TWeakObjectPtr<ABaseWeapon>> ActiveWeapons;
+
+	// Reused by every PerformTrace so the batch does not allocate per weapon
+	TArray<FHitResult> HitScratch;
+
+	float StepAccumulator = 0.f;
+	int32 LastFrameSweepCount = 0;
+
+	// Unregister during the batch only nulls the slot; compaction happens after
+	bool bIsTracingBatch = false;
+};
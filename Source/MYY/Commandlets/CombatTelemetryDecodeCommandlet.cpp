@@ -0,0 +1,100 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CombatTelemetryDecodeCommandlet.h"
+#include "MYY/AbilitySystem/Combat/CombatTelemetry.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+UCombatTelemetryDecodeCommandlet::UCombatTelemetryDecodeCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UCombatTelemetryDecodeCommandlet::Main(const FString& Params)
+{
+	FString InPath;
+	if (!FParse::Value(*Params, TEXT("In="), InPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("❌ Usage: -run=CombatTelemetryDecode -In=<file.mct> [-Out=<file.csv>]"));
+		return 1;
+	}
+
+	FString OutPath;
+	if (!FParse::Value(*Params, TEXT("Out="), OutPath))
+	{
+		OutPath = FPaths::ChangeExtension(InPath, TEXT("csv"));
+	}
+
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *InPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("❌ Can't read %s"), *InPath);
+		return 1;
+	}
+
+	CombatTelemetry::FFileHeader Header;
+	if (Bytes.Num() < static_cast<int32>(sizeof(Header)))
+	{
+		UE_LOG(LogTemp, Error, TEXT("❌ %s is too small for a telemetry header"), *InPath);
+		return 1;
+	}
+
+	FMemory::Memcpy(&Header, Bytes.GetData(), sizeof(Header));
+	if (Header.Magic != CombatTelemetry::FileMagic || Header.Version != CombatTelemetry::FileVersion
+		|| Header.RecordSize != sizeof(FCombatTelemetryRecord))
+	{
+		UE_LOG(LogTemp, Error, TEXT("❌ %s: unsupported telemetry file (magic %08x, version %d, record size %d)"),
+			*InPath, Header.Magic, Header.Version, Header.RecordSize);
+		return 1;
+	}
+
+	// A writer killed mid-flush can leave a partial record at the end; it's ignored
+	const int32 RecordCount = static_cast<int32>((Bytes.Num() - sizeof(Header)) / sizeof(FCombatTelemetryRecord));
+	const FCombatTelemetryRecord* Records =
+		reinterpret_cast<const FCombatTelemetryRecord*>(Bytes.GetData() + sizeof(Header));
+
+	TArray<FString> Lines;
+	Lines.Reserve(RecordCount + 1);
+	Lines.Add(TEXT("Time,Frame,Thread,Event,Source,Target,Value,Aux,Critical,Blocked,Parried"));
+
+	int32 EventCounts[static_cast<int32>(ECombatTelemetryEvent::Count) + 1] = {};
+
+	for (int32 Index = 0; Index < RecordCount; ++Index)
+	{
+		FCombatTelemetryRecord Record;
+		FMemory::Memcpy(&Record, Records + Index, sizeof(Record));
+
+		const int32 EventIndex = FMath::Min(static_cast<int32>(Record.Event), static_cast<int32>(ECombatTelemetryEvent::Count));
+		++EventCounts[EventIndex];
+
+		Lines.Add(FString::Printf(TEXT("%.4f,%u,%u,%s,%u,%u,%.2f,%.2f,%d,%d,%d"),
+			Record.Time, Record.Frame, Record.ThreadSlot, CombatTelemetry::LexToString(Record.Event),
+			Record.SourceId, Record.TargetId, Record.Value, Record.Aux,
+			(Record.Flags & ECombatTelemetryFlags::Critical) ? 1 : 0,
+			(Record.Flags & ECombatTelemetryFlags::Blocked) ? 1 : 0,
+			(Record.Flags & ECombatTelemetryFlags::Parried) ? 1 : 0));
+	}
+
+	if (!FFileHelper::SaveStringArrayToFile(Lines, *OutPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("❌ Can't write %s"), *OutPath);
+		return 1;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("📊 %s: %d records (started %s UTC) -> %s"),
+		*InPath, RecordCount, *FDateTime(Header.StartTicks).ToString(), *OutPath);
+
+	for (int32 EventIndex = 0; EventIndex <= static_cast<int32>(ECombatTelemetryEvent::Count); ++EventIndex)
+	{
+		if (EventCounts[EventIndex] > 0)
+		{
+			UE_LOG(LogTemp, Display, TEXT("   %-8s %d"),
+				CombatTelemetry::LexToString(static_cast<ECombatTelemetryEvent>(EventIndex)), EventCounts[EventIndex]);
+		}
+	}
+
+	return 0;
+}
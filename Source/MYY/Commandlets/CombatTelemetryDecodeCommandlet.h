@@ -0,0 +1,24 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "CombatTelemetryDecodeCommandlet.generated.h"
+
+/**
+ * Offline decoder for combat telemetry files (Saved/Telemetry/*.mct).
+ * Writes one CSV row per record and logs a per-event summary.
+ *
+ * UnrealEditor-Cmd MYY.uproject -run=CombatTelemetryDecode -In=<file.mct> [-Out=<file.csv>]
+ */
+UCLASS()
+class UCombatTelemetryDecodeCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UCombatTelemetryDecodeCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -8,6 +8,9 @@
 #include "Kismet/GameplayStatics.h"
 #include "EngineUtils.h"
 #include "MYY/PlayerController/MYYPlayerController.h"
+#include "MYY/AbilitySystem/Subsystem/MinionSpawnDirectorSubsystem.h"
+#include "MYY/AbilitySystem/Subsystem/SpawnPointSubsystem.h"
+#include "MYY/AbilitySystem/Subsystem/MinionCrowdSubsystem.h"
 
 APlayerVsAIGameMode::APlayerVsAIGameMode()
 {
@@ -22,6 +25,12 @@ void APlayerVsAIGameMode::BeginPlay()
     FTimerHandle StartTimer;
     GetWorld()->GetTimerManager().SetTimer(StartTimer, this, &APlayerVsAIGameMode::StartMatch, 3.0f, false);
 
+    // Crowd minions that come close to a player join the match like any other spawn
+    if (UMinionCrowdSubsystem* Crowd = GetWorld()->GetSubsystem<UMinionCrowdSubsystem>())
+    {
+        Crowd->OnMinionPromoted.AddUObject(this, &APlayerVsAIGameMode::OnAISpawned);
+    }
+
     UE_LOG(LogTemp, Warning, TEXT("🔥 GameMode BeginPlay - Default Pawn: %s"), *GetNameSafe(DefaultPawnClass));
     UE_LOG(LogTemp, Warning, TEXT("🔥 AI Class: %s"), *GetNameSafe(AICharacterClass));
 }
@@ -50,19 +59,12 @@ void APlayerVsAIGameMode::SpawnPlayer()
         return; // Already has pawn
     }
 
-    // Find spawn point with "PlayerSpawn" tag
-    TArray<AActor*> PlayerSpawns;
-    UGameplayStatics::GetAllActorsOfClassWithTag(
-        GetWorld(), 
-        APlayerStart::StaticClass(), 
-        FName("PlayerSpawn"), 
-        PlayerSpawns
-    );
-
-    if (PlayerSpawns.Num() == 0) return;
+    // Safest player spawn point
+    AActor* SpawnPoint = FindSpawnPoint(ESpawnPointType::Player, 0);
+    if (!SpawnPoint) return;
 
     // Get transform from spawn point (like BP's GetActorTransform)
-    FTransform SpawnTransform = PlayerSpawns[0]->GetActorTransform();
+    FTransform SpawnTransform = SpawnPoint->GetActorTransform();
 
     // Spawn parameters
     FActorSpawnParameters SpawnParams;
@@ -175,105 +177,44 @@ void APlayerVsAIGameMode::SpawnAIEnemies()
         return;
     }
 
-    // ✅ Get AI spawn points only
-    TArray<AActor*> AISpawns;
-    UGameplayStatics::GetAllActorsOfClassWithTag(GetWorld(), APlayerStart::StaticClass(), FName("AISpawn"), AISpawns);
-
-    if (AISpawns.Num() == 0)
+    // ✅ AI spawn points only
+    const AActor* FirstSpawnPoint = FindSpawnPoint(ESpawnPointType::AI, 1);
+    if (!FirstSpawnPoint)
     {
         UE_LOG(LogTemp, Error, TEXT("❌ No PlayerStart actors with 'AISpawn' tag!"));
         return;
     }
 
+    // Spread over the next frames by the spawn director, closest to the player first
+    int32 Queued = 0;
     for (int32 i = 0; i < NumberOfAIEnemies; i++)
     {
-        // ✅ Select random spawn point (but spawn exactly at its location)
-        AActor* SpawnPoint = AISpawns[FMath::RandRange(0, AISpawns.Num() - 1)];
+        // ✅ One of the safest spawn points (but spawn exactly at its location)
+        const AActor* SpawnPoint = i == 0 ? FirstSpawnPoint : FindSpawnPoint(ESpawnPointType::AI, 1);
 
-        // ✅ FIXED: Spawn at EXACT PlayerStart location (no random offset)
-        FVector SpawnLocation = SpawnPoint->GetActorLocation();
-        FRotator SpawnRotation = SpawnPoint->GetActorRotation();
-
-        UE_LOG(LogTemp, Log, TEXT("🎯 Spawning AI %d at exact location: %s"), i + 1, *SpawnLocation.ToString());
-
-        // ✅ CRITICAL: Proper spawn parameters
-        FActorSpawnParameters SpawnParams;
-        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
-        SpawnParams.bDeferConstruction = false;
-
-        AAICharacter* AIChar = GetWorld()->SpawnActor<AAICharacter>(
-            AICharacterClass, 
-            SpawnLocation, 
-            SpawnRotation, 
-            SpawnParams
-        );
-
-        if (AIChar)
+        if (QueueAISpawn(SpawnPoint))
         {
-            // 🔍 DEBUG: Log component status
-            UE_LOG(LogTemp, Warning, TEXT("🔍 AI %d Component Check:"), i + 1);
-            UE_LOG(LogTemp, Warning, TEXT("   - AbilitySystemComponent: %s"), 
-                AIChar->AbilitySystemComponent ? TEXT("✅ EXISTS") : TEXT("❌ NULL"));
-            UE_LOG(LogTemp, Warning, TEXT("   - AttributeSet: %s"), 
-                AIChar->AttributeSet ? TEXT("✅ EXISTS") : TEXT("❌ NULL"));
-
-            // 🛡️ MODIFIED: Only check ASC (AttributeSet might initialize later)
-            if (!AIChar->AbilitySystemComponent)
-            {
-                UE_LOG(LogTemp, Error, TEXT("❌ AI %d has no AbilitySystemComponent!"), i + 1);
-                AIChar->Destroy();
-                continue;
-            }
-
-            AIChar->TeamID = 1; // Enemy team
-            
-            // 🛡️ CRASH FIX: Delay controller spawn to ensure AI initialization completes
-            FTimerHandle ControllerSpawnTimer;
-            GetWorld()->GetTimerManager().SetTimer(ControllerSpawnTimer, [this, AIChar, SpawnLocation, SpawnRotation, i]()
-            {
-                if (!IsValid(AIChar))
-                {
-                    UE_LOG(LogTemp, Warning, TEXT("⚠️ AI %d was destroyed before controller could possess"), i + 1);
-                    return;
-                }
-
-                // ✅ CRITICAL: Spawn AI Controller AFTER character spawns
-                FActorSpawnParameters ControllerParams;
-                ControllerParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-                
-                AMinionAIController* AIController = GetWorld()->SpawnActor<AMinionAIController>(
-                    AMinionAIController::StaticClass(),
-                    SpawnLocation,
-                    SpawnRotation,
-                    ControllerParams
-                );
-
-                if (AIController)
-                {
-                    AIController->Possess(AIChar);
-                    UE_LOG(LogTemp, Log, TEXT("✅ AI Controller possessed AI character %d"), i + 1);
-                }
-                else
-                {
-                    UE_LOG(LogTemp, Error, TEXT("❌ Failed to spawn controller for AI %d"), i + 1);
-                }
-                
-            }, 0.2f, false);
-
-            SpawnedAI.Add(AIChar);
-
-            // Bind death event
-            AIChar->OnCharacterDied.AddDynamic(this, &APlayerVsAIGameMode::OnCharacterKilled);
-
-            UE_LOG(LogTemp, Log, TEXT("✅ Spawned AI %d at %s"), i + 1, *SpawnLocation.ToString());
+            ++Queued;
         }
-        else
+    }
+
+    // Park a few more for respawns, once the wave is in
+    if (UMinionSpawnDirectorSubsystem* SpawnDirector = GetWorld()->GetSubsystem<UMinionSpawnDirectorSubsystem>())
+    {
+        SpawnDirector->RequestPrewarm(AICharacterClass, PooledAIReserve, FirstSpawnPoint->GetActorTransform());
+    }
+
+    // The rest of the horde stays in the crowd layer until a player gets close
+    UMinionCrowdSubsystem* Crowd = GetWorld()->GetSubsystem<UMinionCrowdSubsystem>();
+    for (int32 i = 0; Crowd && i < CrowdAIEnemies; i++)
+    {
+        if (const AActor* SpawnPoint = FindSpawnPoint(ESpawnPointType::AI, 1))
         {
-            UE_LOG(LogTemp, Error, TEXT("❌ Failed to spawn AI %d"), i + 1);
+            Crowd->AddAgent(AICharacterClass, SpawnPoint->GetActorTransform(), 1);
         }
     }
 
-    UE_LOG(LogTemp, Warning, TEXT("🤖 Spawned %d AI enemies"), SpawnedAI.Num());
+    UE_LOG(LogTemp, Warning, TEXT("🤖 Queued %d AI enemies (+%d in the crowd)"), Queued, Crowd ? CrowdAIEnemies : 0);
 }
 
 
@@ -328,18 +269,11 @@ void APlayerVsAIGameMode::OnCharacterKilled(AMYYCharacterBase* Victim, AActor* K
         }
     }
 
-    // Respawn AI after delay
+    // Respawn AI after delay (the corpse goes back to the minion pool on its own)
     if (AIVictim)
     {
-        AController* AIController = AIVictim->GetController();
-        if (AIController)
-        {
-            FTimerHandle RespawnTimer;
-            GetWorld()->GetTimerManager().SetTimer(RespawnTimer, [this, AIController]()
-            {
-                RespawnCharacter(AIController);
-            }, RespawnDelay, false);
-        }
+        FTimerHandle RespawnTimer;
+        GetWorld()->GetTimerManager().SetTimer(RespawnTimer, this, &APlayerVsAIGameMode::RespawnAI, RespawnDelay, false);
     }
 
     CheckWinCondition();
@@ -349,33 +283,19 @@ void APlayerVsAIGameMode::RespawnCharacter(AController* Controller)
 {
     if (!Controller) return;
 
-    AActor* SpawnPoint = nullptr;
-    
-    if (Controller->IsPlayerController())
+    // AI controllers are pooled with their pawns
+    if (!Controller->IsPlayerController())
     {
-        TArray<AActor*> PlayerSpawns;
-        UGameplayStatics::GetAllActorsOfClassWithTag(GetWorld(), APlayerStart::StaticClass(), FName("PlayerSpawn"), PlayerSpawns);
-        
-        if (PlayerSpawns.Num() == 0)
-        {
-            UE_LOG(LogTemp, Error, TEXT("❌ No PlayerStart with 'PlayerSpawn' tag!"));
-            return;
-        }
-        
-        SpawnPoint = PlayerSpawns[FMath::RandRange(0, PlayerSpawns.Num() - 1)];
+        RespawnAI();
+        return;
     }
-    else
+
+    // Away from the AI that just killed them
+    AActor* SpawnPoint = FindSpawnPoint(ESpawnPointType::Player, 0);
+    if (!SpawnPoint)
     {
-        TArray<AActor*> AISpawns;
-        UGameplayStatics::GetAllActorsOfClassWithTag(GetWorld(), APlayerStart::StaticClass(), FName("AISpawn"), AISpawns);
-        
-        if (AISpawns.Num() == 0)
-        {
-            UE_LOG(LogTemp, Error, TEXT("❌ No PlayerStart with 'AISpawn' tag!"));
-            return;
-        }
-        
-        SpawnPoint = AISpawns[FMath::RandRange(0, AISpawns.Num() - 1)];
+        UE_LOG(LogTemp, Error, TEXT("❌ No PlayerStart with 'PlayerSpawn' tag!"));
+        return;
     }
 
     // ✅ CRITICAL: Proper spawn with initialization delay
@@ -383,60 +303,107 @@ void APlayerVsAIGameMode::RespawnCharacter(AController* Controller)
     SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
     SpawnParams.bDeferConstruction = false;
 
-    APawn* NewPawn = nullptr;
-    
-    if (Controller->IsPlayerController())
+    APawn* NewPawn = GetWorld()->SpawnActor<APlayerCharacter>(
+        DefaultPawnClass, 
+        SpawnPoint->GetActorLocation(), 
+        SpawnPoint->GetActorRotation(),
+        SpawnParams
+    );
+
+    if (NewPawn)
     {
-        NewPawn = GetWorld()->SpawnActor<APlayerCharacter>(
-            DefaultPawnClass, 
-            SpawnPoint->GetActorLocation(), 
-            SpawnPoint->GetActorRotation(),
-            SpawnParams
-        );
-
-        if (NewPawn)
+        // ✅ Delay possession to ensure replication
+        FTimerHandle PossessTimer;
+        GetWorld()->GetTimerManager().SetTimer(PossessTimer, [this, Controller, NewPawn]()
         {
-            // ✅ Delay possession to ensure replication
-            FTimerHandle PossessTimer;
-            GetWorld()->GetTimerManager().SetTimer(PossessTimer, [this, Controller, NewPawn]()
-            {
-                Controller->Possess(NewPawn);
-                UE_LOG(LogTemp, Log, TEXT("✅ Player possessed after delay"));
-            }, 0.1f, false);
-        }
+            Controller->Possess(NewPawn);
+            UE_LOG(LogTemp, Log, TEXT("✅ Player possessed after delay"));
+        }, 0.1f, false);
+
+        UE_LOG(LogTemp, Log, TEXT("✅ Spawned %s"), *GetNameSafe(NewPawn));
     }
     else
     {
-        NewPawn = GetWorld()->SpawnActor<AAICharacter>(
-            AICharacterClass, 
-            SpawnPoint->GetActorLocation(), 
-            SpawnPoint->GetActorRotation(),
-            SpawnParams
-        );
-
-        if (AAICharacter* AIChar = Cast<AAICharacter>(NewPawn))
-        {
-            AIChar->TeamID = 1;
-            AIChar->OnCharacterDied.AddDynamic(this, &APlayerVsAIGameMode::OnCharacterKilled);
+        UE_LOG(LogTemp, Error, TEXT("❌ Failed to spawn pawn for respawn"));
+    }
+}
 
-            // ✅ Delay possession for AI to ensure BT initialization
-            FTimerHandle PossessTimer;
-            GetWorld()->GetTimerManager().SetTimer(PossessTimer, [this, Controller, NewPawn]()
-            {
-                Controller->Possess(NewPawn);
-                UE_LOG(LogTemp, Log, TEXT("✅ AI possessed after delay"));
-            }, 0.1f, false);
+void APlayerVsAIGameMode::RespawnAI()
+{
+    if (CurrentMatchState != EMatchState::InProgress) return;
+
+    const AActor* SpawnPoint = FindSpawnPoint(ESpawnPointType::AI, 1);
+    if (!SpawnPoint)
+    {
+        UE_LOG(LogTemp, Error, TEXT("❌ No PlayerStart with 'AISpawn' tag!"));
+        return;
+    }
+
+    if (!QueueAISpawn(SpawnPoint))
+    {
+        UE_LOG(LogTemp, Error, TEXT("❌ Failed to respawn AI"));
+    }
+}
+
+AActor* APlayerVsAIGameMode::FindSpawnPoint(ESpawnPointType SpawnType, uint8 TeamID) const
+{
+    if (USpawnPointSubsystem* SpawnPointRegistry = GetWorld()->GetSubsystem<USpawnPointSubsystem>())
+    {
+        if (ACustomPlayerStart* SpawnPoint = SpawnPointRegistry->PickSpawnPoint(SpawnType, TeamID))
+        {
+            return SpawnPoint;
         }
     }
 
-    if (NewPawn)
+    // Plain APlayerStarts placed with the tag by hand
+    TArray<AActor*> TaggedSpawns;
+    UGameplayStatics::GetAllActorsOfClassWithTag(GetWorld(), APlayerStart::StaticClass(),
+        SpawnType == ESpawnPointType::AI ? FName("AISpawn") : FName("PlayerSpawn"), TaggedSpawns);
+
+    return TaggedSpawns.Num() > 0 ? TaggedSpawns[FMath::RandRange(0, TaggedSpawns.Num() - 1)] : nullptr;
+}
+
+bool APlayerVsAIGameMode::QueueAISpawn(const AActor* SpawnPoint)
+{
+    UMinionSpawnDirectorSubsystem* SpawnDirector = GetWorld()->GetSubsystem<UMinionSpawnDirectorSubsystem>();
+    if (!SpawnDirector || !SpawnPoint || !AICharacterClass)
     {
-        UE_LOG(LogTemp, Log, TEXT("✅ Spawned %s"), *GetNameSafe(NewPawn));
+        return false;
     }
-    else
+
+    // ✅ Spawn at EXACT PlayerStart location; the pool possesses it with a (pooled) controller
+    TWeakObjectPtr<APlayerVsAIGameMode> WeakThis(this);
+    SpawnDirector->RequestSpawn(AICharacterClass, SpawnPoint->GetActorTransform(), 1 /* Enemy team */, [WeakThis](AAICharacter* AIChar)
     {
-        UE_LOG(LogTemp, Error, TEXT("❌ Failed to spawn pawn for respawn"));
+        if (APlayerVsAIGameMode* GameMode = WeakThis.Get())
+        {
+            GameMode->OnAISpawned(AIChar);
+        }
+    });
+
+    return true;
+}
+
+void APlayerVsAIGameMode::OnAISpawned(AAICharacter* AIChar)
+{
+    if (!AIChar)
+    {
+        UE_LOG(LogTemp, Error, TEXT("❌ Failed to spawn AI"));
+        return;
     }
+
+    if (!AIChar->AbilitySystemComponent)
+    {
+        UE_LOG(LogTemp, Error, TEXT("❌ %s has no AbilitySystemComponent!"), *AIChar->GetName());
+        AIChar->Destroy();
+        return;
+    }
+
+    // Reused characters are already bound and listed
+    AIChar->OnCharacterDied.AddUniqueDynamic(this, &APlayerVsAIGameMode::OnCharacterKilled);
+    SpawnedAI.AddUnique(AIChar);
+
+    UE_LOG(LogTemp, Log, TEXT("✅ Spawned %s at %s"), *AIChar->GetName(), *AIChar->GetActorLocation().ToString());
 }
 
 void APlayerVsAIGameMode::CheckWinCondition()
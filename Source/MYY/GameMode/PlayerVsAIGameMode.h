@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/GameMode.h"
+#include "MYY/PlayerStart/CustomPlayerStart.h"
 #include "PlayerVsAIGameMode.generated.h"
 
 UENUM(BlueprintType)
@@ -38,6 +39,15 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Match Settings")
 	TSubclassOf<AAICharacter> AICharacterClass;
 
+	// Extra AI characters parked in UMinionPoolSubsystem at match start, so respawns never spawn
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Match Settings")
+	int32 PooledAIReserve = 2;
+
+	// Extra AI enemies that start in the crowd layer (UMinionCrowdSubsystem) and only become full
+	// characters near a player
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Match Settings")
+	int32 CrowdAIEnemies = 0;
+
 	// ========== MATCH STATE ==========
     
 	UPROPERTY(BlueprintReadOnly, Category = "Match")
@@ -70,6 +80,10 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Match")
 	void RespawnCharacter(AController* Controller);
 
+	// Brings one AI back at a random AI spawn point (from the minion pool)
+	UFUNCTION(BlueprintCallable, Category = "Match")
+	void RespawnAI();
+
 
 protected:
 	virtual void BeginPlay() override;
@@ -78,6 +92,16 @@ protected:
 	UFUNCTION()
 	void CheckWinCondition();
 
+	// Safest spawn point of SpawnType for TeamID from USpawnPointSubsystem; falls back to a random
+	// tagged APlayerStart when no ACustomPlayerStart is registered
+	AActor* FindSpawnPoint(ESpawnPointType SpawnType, uint8 TeamID) const;
+
+	// Queues an AI at SpawnPoint with the spawn director (time-sliced, from the minion pool)
+	bool QueueAISpawn(const AActor* SpawnPoint);
+
+	// Hooks a spawned AI into the match
+	void OnAISpawned(AAICharacter* AIChar);
+
 	UPROPERTY()
 	TArray<AAICharacter*> SpawnedAI;
 };
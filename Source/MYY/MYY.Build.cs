@@ -10,7 +10,10 @@ public class MYY : ModuleRules
 	
 		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore","AIModule","NavigationSystem","UMG" });
 
-		PrivateDependencyModuleNames.AddRange(new string[] { "GameplayAbilities","GameplayTasks","GameplayTags", "EnhancedInput", "EnhancedInput", "Niagara", "Niagara", "MotionWarping" });
+		PrivateDependencyModuleNames.AddRange(new string[] { "GameplayAbilities","GameplayTasks","GameplayTags", "EnhancedInput", "EnhancedInput", "Niagara", "Niagara", "MotionWarping", "ReplicationGraph", "NetCore" });
+
+		// 1 = compile in the Log/Verbose combat logs (LogMYYCombat), see MYY.h
+		PublicDefinitions.Add("MYY_VERBOSE_COMBAT_LOGS=0");
 
 		// Uncomment if you are using Slate UI
 		// PrivateDependencyModuleNames.AddRange(new string[] { "Slate", "SlateCore" });
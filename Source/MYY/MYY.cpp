@@ -2,5 +2,22 @@
 
 #include "MYY.h"
 #include "Modules/ModuleManager.h"
+#include "MYY/AbilitySystem/Combat/CombatTelemetry.h"
 
-IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, MYY, "MYY" );
+DEFINE_LOG_CATEGORY(LogMYYCombat);
+
+class FMYYModule : public FDefaultGameModuleImpl
+{
+public:
+	virtual void StartupModule() override
+	{
+		CombatTelemetry::Startup();
+	}
+
+	virtual void ShutdownModule() override
+	{
+		CombatTelemetry::Shutdown();
+	}
+};
+
+IMPLEMENT_PRIMARY_GAME_MODULE( FMYYModule, MYY, "MYY" );
@@ -3,4 +3,19 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Stats/Stats.h"
 
+// Runtime counters for the combat systems. Use "stat MYYCombat" in the console.
+DECLARE_STATS_GROUP(TEXT("MYY Combat"), STATGROUP_MYYCombat, STATCAT_Advanced);
+
+// Hot-path combat logs (hits, traces, firing). Anything below Warning is compiled out unless the
+// target sets MYY_VERBOSE_COMBAT_LOGS=1; use the combat telemetry stream (MYY.Telemetry.*) for per-hit data.
+#ifndef MYY_VERBOSE_COMBAT_LOGS
+#define MYY_VERBOSE_COMBAT_LOGS 0
+#endif
+
+#if MYY_VERBOSE_COMBAT_LOGS
+MYY_API DECLARE_LOG_CATEGORY_EXTERN(LogMYYCombat, Log, All);
+#else
+MYY_API DECLARE_LOG_CATEGORY_EXTERN(LogMYYCombat, Warning, Warning);
+#endif
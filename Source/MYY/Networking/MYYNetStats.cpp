@@ -0,0 +1,162 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MYYNetStats.h"
+#include "MYY/MYY.h"
+#include "MYY/AbilitySystem/MYYCharacterBase.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/App.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Push Model Comparisons Skipped/s (Estimate)"), STAT_MYY_PushComparisonsSkipped, STATGROUP_MYYCombat);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Push Model Dirty Marks/s"), STAT_MYY_PushDirtyMarks, STATGROUP_MYYCombat);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Dormant Weapons"), STAT_MYY_DormantWeapons, STATGROUP_MYYCombat);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Attribute Bits/s Per Connection (Modelled)"), STAT_MYY_AttributeBits, STATGROUP_MYYCombat);
+
+namespace MYYNetStatsPrivate
+{
+	// Game thread only, like replication itself
+	double WindowStart = 0.0;
+	int64 WindowComparisons = 0;
+	int64 WindowDirtyMarks = 0;
+	int64 WindowAttributeUpdates = 0;
+	int64 WindowLegacyBits = 0;
+	int64 WindowCompactBits = 0;
+	int64 WindowOwnerOnlyBits = 0;
+
+	int64 LastComparisons = 0;
+	int64 LastDirtyMarks = 0;
+	int64 LastAttributeUpdates = 0;
+	int64 LastLegacyBits = 0;
+	int64 LastCompactBits = 0;
+	int64 LastOwnerOnlyBits = 0;
+	int32 NumDormantWeapons = 0;
+
+	void RollWindow()
+	{
+		const double Now = FApp::GetCurrentTime();
+		if (Now - WindowStart < 1.0)
+		{
+			return;
+		}
+
+		// Scale a long gap (hitch, idle server) back to a per-second figure
+		const double Elapsed = WindowStart > 0.0 ? Now - WindowStart : 1.0;
+		LastComparisons = static_cast<int64>(WindowComparisons / Elapsed);
+		LastDirtyMarks = static_cast<int64>(WindowDirtyMarks / Elapsed);
+		LastAttributeUpdates = static_cast<int64>(WindowAttributeUpdates / Elapsed);
+		LastLegacyBits = static_cast<int64>(WindowLegacyBits / Elapsed);
+		LastCompactBits = static_cast<int64>(WindowCompactBits / Elapsed);
+		LastOwnerOnlyBits = static_cast<int64>(WindowOwnerOnlyBits / Elapsed);
+
+		SET_DWORD_STAT(STAT_MYY_PushComparisonsSkipped, static_cast<uint32>(FMath::Max<int64>(LastComparisons - LastDirtyMarks, 0)));
+		SET_DWORD_STAT(STAT_MYY_PushDirtyMarks, static_cast<uint32>(LastDirtyMarks));
+		SET_DWORD_STAT(STAT_MYY_AttributeBits, static_cast<uint32>(LastCompactBits));
+
+		WindowStart = Now;
+		WindowComparisons = 0;
+		WindowDirtyMarks = 0;
+		WindowAttributeUpdates = 0;
+		WindowLegacyBits = 0;
+		WindowCompactBits = 0;
+		WindowOwnerOnlyBits = 0;
+	}
+}
+
+void MYYNetStats::RecordPushModelPass(int32 NumPushProperties)
+{
+	MYYNetStatsPrivate::RollWindow();
+	MYYNetStatsPrivate::WindowComparisons += NumPushProperties;
+}
+
+void MYYNetStats::RecordDirtyMark(int32 NumProperties)
+{
+	MYYNetStatsPrivate::RollWindow();
+	MYYNetStatsPrivate::WindowDirtyMarks += NumProperties;
+}
+
+void MYYNetStats::RecordWeaponDormancy(bool bDormant)
+{
+	if (bDormant)
+	{
+		++MYYNetStatsPrivate::NumDormantWeapons;
+		INC_DWORD_STAT(STAT_MYY_DormantWeapons);
+	}
+	else
+	{
+		--MYYNetStatsPrivate::NumDormantWeapons;
+		DEC_DWORD_STAT(STAT_MYY_DormantWeapons);
+	}
+}
+
+void MYYNetStats::RecordAttributeUpdate(int32 LegacyBits, int32 CompactBits, int32 OwnerOnlyBits)
+{
+	MYYNetStatsPrivate::RollWindow();
+	++MYYNetStatsPrivate::WindowAttributeUpdates;
+	MYYNetStatsPrivate::WindowLegacyBits += LegacyBits;
+	MYYNetStatsPrivate::WindowCompactBits += CompactBits;
+	MYYNetStatsPrivate::WindowOwnerOnlyBits += OwnerOnlyBits;
+}
+
+void MYYNetStats::Dump()
+{
+	using namespace MYYNetStatsPrivate;
+
+	UE_LOG(LogTemp, Warning, TEXT("📊 Push model (last second, estimate): %lld property checks polled replication would do, %lld dirty marks, ~%lld comparisons skipped"),
+		LastComparisons, LastDirtyMarks, FMath::Max<int64>(LastComparisons - LastDirtyMarks, 0));
+	UE_LOG(LogTemp, Warning, TEXT("   %d dormant weapons"), NumDormantWeapons);
+}
+
+void MYYNetStats::DumpAttributes(int32 NumConnections, int32 NumCharacters)
+{
+	using namespace MYYNetStatsPrivate;
+
+	// Every connection is assumed to see every character, as on a small combat map. Changes that
+	// land between two net updates are sent once, so both figures are upper bounds.
+	const double LegacyBytes = LastLegacyBits * NumConnections / 8.0;
+	const double CompactBytes = (LastCompactBits * NumConnections + LastOwnerOnlyBits) / 8.0;
+	const double PerCharacter = NumCharacters > 0 ? 1.0 / NumCharacters : 0.0;
+
+	UE_LOG(LogTemp, Warning, TEXT("📊 Attribute replication (last second, modelled estimate): %lld changes, %d characters, %d connections"),
+		LastAttributeUpdates, NumCharacters, NumConnections);
+	UE_LOG(LogTemp, Warning, TEXT("   full floats: %.0f B/s (%.1f B/s per character)"), LegacyBytes, LegacyBytes * PerCharacter);
+	UE_LOG(LogTemp, Warning, TEXT("   compact:     %.0f B/s (%.1f B/s per character), %lld bits/s owner-only"),
+		CompactBytes, CompactBytes * PerCharacter, LastOwnerOnlyBits);
+	if (LegacyBytes > 0.0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("   saved:       %.0f%%"), 100.0 * (1.0 - CompactBytes / LegacyBytes));
+	}
+}
+
+// MYY.Net.PushModel.Dump
+static FAutoConsoleCommand GPushModelDumpCommand(
+	TEXT("MYY.Net.PushModel.Dump"),
+	TEXT("Logs an estimate of the replicated property comparisons push model saved in the last second, and the dormant weapon count."),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		MYYNetStats::Dump();
+	}));
+
+// MYY.Net.Attributes.Dump
+static FAutoConsoleCommandWithWorld GAttributesDumpCommand(
+	TEXT("MYY.Net.Attributes.Dump"),
+	TEXT("Logs a modelled estimate of last second's Health/Stamina replication bandwidth, compact against full floats, for the current connections and characters."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (!World)
+		{
+			return;
+		}
+
+		const UNetDriver* NetDriver = World->GetNetDriver();
+		const int32 NumConnections = NetDriver ? NetDriver->ClientConnections.Num() : 0;
+
+		int32 NumCharacters = 0;
+		for (TActorIterator<AMYYCharacterBase> It(World); It; ++It)
+		{
+			++NumCharacters;
+		}
+
+		MYYNetStats::DumpAttributes(NumConnections, NumCharacters);
+	}));
@@ -0,0 +1,40 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Push-model and dormancy counters (stat MYYCombat, MYY.Net.PushModel.Dump).
+ *
+ * A polled replicated property is compared against its shadow state every time its actor goes
+ * through replication; a push-model property only when it was marked dirty. Converted classes
+ * report each replication pass (PreReplication) with their push-model property count, and each
+ * dirty mark. The difference is an estimate of the comparisons skipped, not a measurement: it
+ * assumes one comparison per property per pass and one per dirty mark, and ignores what the engine
+ * shares between connections. Dormant actors skip the pass altogether and aren't counted. Rates
+ * cover the last full second.
+ */
+namespace MYYNetStats
+{
+	// An actor or component with NumPushProperties push-model properties is being replicated
+	MYY_API void RecordPushModelPass(int32 NumPushProperties);
+
+	// Push-model properties were marked dirty
+	MYY_API void RecordDirtyMark(int32 NumProperties = 1);
+
+	// A weapon went dormant (true) or woke up (false)
+	MYY_API void RecordWeaponDormancy(bool bDormant);
+
+	// An attribute change on the server (UAttributeSetBase), in modelled payload bits per receiving
+	// connection: what the full-float path would send everyone, what the compact path sends everyone,
+	// and what it sends the owner only. Property payloads only, not what the net driver writes.
+	MYY_API void RecordAttributeUpdate(int32 LegacyBits, int32 CompactBits, int32 OwnerOnlyBits);
+
+	// Last second's counters to the log
+	MYY_API void Dump();
+
+	// Last second's modelled attribute bandwidth, full-float against compact, for NumConnections
+	// clients (MYY.Net.Attributes.Dump). An estimate from the recorded payload sizes, not a capture.
+	MYY_API void DumpAttributes(int32 NumConnections, int32 NumCharacters);
+}
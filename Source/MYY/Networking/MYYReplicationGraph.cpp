@@ -0,0 +1,507 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MYYReplicationGraph.h"
+#include "MYY/MYY.h"
+#include "MYY/AbilitySystem/MYYCharacterBase.h"
+#include "MYY/AbilitySystem/BaseWeapon.h"
+#include "MYY/AbilitySystem/Components/EquipmentComponent.h"
+#include "MYY/AbilitySystem/Actor/Collectable/ArrowPickup.h"
+#include "MYY/AbilitySystem/Actor/Crowd/MinionCrowdActor.h"
+#include "MYY/AbilitySystem/Actor/Havankund/Ghost.h"
+#include "MYY/AbilitySystem/Actor/Projectile/ArrowProjectile.h"
+#include "Engine/LevelScriptActor.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/PlayerState.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/UObjectIterator.h"
+
+DECLARE_CYCLE_STAT(TEXT("RepGraph Team Buckets"), STAT_MYY_RepGraphTeams, STATGROUP_MYYCombat);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("RepGraph Weapons Carried"), STAT_MYY_RepGraphWeaponsCarried, STATGROUP_MYYCombat);
+
+static TAutoConsoleVariable<float> CVarRepGraphCellSize(
+	TEXT("MYY.Net.RepGraph.CellSize"),
+	10000.f,
+	TEXT("Spatial grid cell size (cm). Read when the server starts."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarRepGraphSpatialBias(
+	TEXT("MYY.Net.RepGraph.SpatialBias"),
+	-200000.f,
+	TEXT("World X/Y where the spatial grid starts; keep it below the smallest coordinate of the map.\n")
+	TEXT("Read when the server starts."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarRepGraphPlayerStateFrequency(
+	TEXT("MYY.Net.RepGraph.PlayerStateFrequency"),
+	2.f,
+	TEXT("Times per second each player state is considered for every connection. Read when the server starts."),
+	ECVF_Default);
+
+namespace MYYReplicationGraphPrivate
+{
+	const TCHAR* LexToString(EMYYClassRepNodeMapping Mapping)
+	{
+		switch (Mapping)
+		{
+		case EMYYClassRepNodeMapping::NotRouted:				return TEXT("NotRouted");
+		case EMYYClassRepNodeMapping::RelevantAllConnections:	return TEXT("RelevantAllConnections");
+		case EMYYClassRepNodeMapping::Spatialize_Static:		return TEXT("Spatialize_Static");
+		case EMYYClassRepNodeMapping::Spatialize_Dynamic:		return TEXT("Spatialize_Dynamic");
+		case EMYYClassRepNodeMapping::Spatialize_Dormancy:		return TEXT("Spatialize_Dormancy");
+		default:												return TEXT("Unknown");
+		}
+	}
+
+	bool IsSpatialized(EMYYClassRepNodeMapping Mapping)
+	{
+		return Mapping >= EMYYClassRepNodeMapping::Spatialize_Static;
+	}
+}
+
+void UMYYReplicationGraph::ResetGameWorldState()
+{
+	Super::ResetGameWorldState();
+
+	for (const TPair<AActor*, AActor*>& Pair : WeaponParents)
+	{
+		if (Pair.Value)
+		{
+			DEC_DWORD_STAT(STAT_MYY_RepGraphWeaponsCarried);
+		}
+	}
+
+	WeaponParents.Reset();
+	FMemory::Memzero(NumRouted);
+}
+
+void UMYYReplicationGraph::InitGlobalActorClassSettings()
+{
+	Super::InitGlobalActorClassSettings();
+
+	// Explicit routes. Anything else is worked out from its CDO the first time it's seen.
+	ClassRepNodePolicies.Set(APlayerController::StaticClass(), EMYYClassRepNodeMapping::NotRouted);
+	ClassRepNodePolicies.Set(ALevelScriptActor::StaticClass(), EMYYClassRepNodeMapping::NotRouted);
+	ClassRepNodePolicies.Set(APlayerState::StaticClass(), EMYYClassRepNodeMapping::RelevantAllConnections);
+	ClassRepNodePolicies.Set(AMinionCrowdActor::StaticClass(), EMYYClassRepNodeMapping::RelevantAllConnections);
+	ClassRepNodePolicies.Set(AMYYCharacterBase::StaticClass(), EMYYClassRepNodeMapping::Spatialize_Dynamic);
+	ClassRepNodePolicies.Set(AArrowProjectile::StaticClass(), EMYYClassRepNodeMapping::Spatialize_Dynamic);
+	ClassRepNodePolicies.Set(AGhost::StaticClass(), EMYYClassRepNodeMapping::Spatialize_Dynamic);
+	ClassRepNodePolicies.Set(AArrowPickup::StaticClass(), EMYYClassRepNodeMapping::Spatialize_Dormancy);
+
+	// In the grid while lying loose, a dependent of its owner while in hand or holstered (see RouteWeapon)
+	ClassRepNodePolicies.Set(ABaseWeapon::StaticClass(), EMYYClassRepNodeMapping::Spatialize_Dormancy);
+
+	// Cull distance and update period for every replicated class loaded now; classes loaded later
+	// use their closest parent's settings
+	for (TObjectIterator<UClass> It; It; ++It)
+	{
+		UClass* Class = *It;
+		const AActor* CDO = Cast<AActor>(Class->GetDefaultObject(false));
+		if (!CDO || !CDO->GetIsReplicated() || Class->HasAnyClassFlags(CLASS_Abstract | CLASS_Deprecated | CLASS_NewerVersionExists))
+		{
+			continue;
+		}
+
+		// Blueprint skeleton and reinstanced classes
+		if (Class->GetName().StartsWith(TEXT("SKEL_")) || Class->GetName().StartsWith(TEXT("REINST_")))
+		{
+			continue;
+		}
+
+		FClassReplicationInfo ClassInfo;
+		InitClassReplicationInfo(ClassInfo, Class, MYYReplicationGraphPrivate::IsSpatialized(GetMappingPolicy(Class)));
+		GlobalActorReplicationInfoMap.SetClassInfo(Class, ClassInfo);
+	}
+
+	// Player states go to everyone, so spread them out
+	FClassReplicationInfo PlayerStateInfo;
+	InitClassReplicationInfo(PlayerStateInfo, APlayerState::StaticClass(), false);
+	PlayerStateInfo.ReplicationPeriodFrame = static_cast<uint16>(FMath::Clamp(FMath::RoundToInt(
+		(NetDriver ? NetDriver->GetNetServerMaxTickRate() : 30) / FMath::Max(CVarRepGraphPlayerStateFrequency.GetValueOnGameThread(), 0.1f)),
+		1, MAX_uint16));
+	GlobalActorReplicationInfoMap.SetClassInfo(APlayerState::StaticClass(), PlayerStateInfo);
+}
+
+void UMYYReplicationGraph::InitClassReplicationInfo(FClassReplicationInfo& Info, UClass* Class, bool bSpatialize) const
+{
+	const AActor* CDO = Class->GetDefaultObject<AActor>();
+	if (bSpatialize)
+	{
+		Info.SetCullDistanceSquared(CDO->GetNetCullDistanceSquared());
+	}
+
+	const float ServerMaxTickRate = NetDriver ? NetDriver->GetNetServerMaxTickRate() : 30.f;
+	Info.ReplicationPeriodFrame = static_cast<uint16>(FMath::Clamp(
+		FMath::RoundToInt(ServerMaxTickRate / FMath::Max(CDO->GetNetUpdateFrequency(), 1.f)), 1, MAX_uint16));
+}
+
+EMYYClassRepNodeMapping UMYYReplicationGraph::GetMappingPolicy(UClass* Class)
+{
+	if (const EMYYClassRepNodeMapping* Policy = ClassRepNodePolicies.Get(Class))
+	{
+		return *Policy;
+	}
+
+	const AActor* CDO = Class->GetDefaultObject<AActor>();
+
+	EMYYClassRepNodeMapping Policy;
+	if (CDO->bOnlyRelevantToOwner || CDO->bNetUseOwnerRelevancy)
+	{
+		Policy = EMYYClassRepNodeMapping::NotRouted;
+	}
+	else if (CDO->bAlwaysRelevant)
+	{
+		Policy = EMYYClassRepNodeMapping::RelevantAllConnections;
+	}
+	else
+	{
+		Policy = CDO->IsReplicatingMovement() ? EMYYClassRepNodeMapping::Spatialize_Dynamic : EMYYClassRepNodeMapping::Spatialize_Static;
+	}
+
+	ClassRepNodePolicies.Set(Class, Policy);
+	return Policy;
+}
+
+void UMYYReplicationGraph::InitGlobalGraphNodes()
+{
+	GridNode = CreateNewNode<UReplicationGraphNode_GridSpatialization2D>();
+	GridNode->CellSize = CVarRepGraphCellSize.GetValueOnGameThread();
+	GridNode->SpatialBias = FVector2D(CVarRepGraphSpatialBias.GetValueOnGameThread(), CVarRepGraphSpatialBias.GetValueOnGameThread());
+	AddGlobalGraphNode(GridNode);
+
+	AlwaysRelevantNode = CreateNewNode<UReplicationGraphNode_ActorList>();
+	AddGlobalGraphNode(AlwaysRelevantNode);
+
+	TeamNode = CreateNewNode<UMYYReplicationGraphNode_Teams>();
+	AddGlobalGraphNode(TeamNode);
+}
+
+void UMYYReplicationGraph::InitConnectionGraphNodes(UNetReplicationGraphConnection* RepGraphConnection)
+{
+	Super::InitConnectionGraphNodes(RepGraphConnection);
+
+	AddConnectionGraphNode(CreateNewNode<UMYYReplicationGraphNode_AlwaysRelevant_ForConnection>(), RepGraphConnection);
+}
+
+void UMYYReplicationGraph::RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo)
+{
+	const EMYYClassRepNodeMapping Policy = GetMappingPolicy(ActorInfo.Class);
+	++NumRouted[static_cast<int32>(Policy)];
+
+	switch (Policy)
+	{
+	case EMYYClassRepNodeMapping::NotRouted:
+		break;
+
+	case EMYYClassRepNodeMapping::RelevantAllConnections:
+		AlwaysRelevantNode->NotifyAddNetworkActor(ActorInfo);
+		break;
+
+	case EMYYClassRepNodeMapping::Spatialize_Static:
+		GridNode->AddActor_Static(ActorInfo, GlobalInfo);
+		break;
+
+	case EMYYClassRepNodeMapping::Spatialize_Dynamic:
+		GridNode->AddActor_Dynamic(ActorInfo, GlobalInfo);
+		break;
+
+	case EMYYClassRepNodeMapping::Spatialize_Dormancy:
+		if (ABaseWeapon* Weapon = Cast<ABaseWeapon>(ActorInfo.Actor))
+		{
+			// Normally spawned ownerless and moved into a slot right after by UEquipmentComponent
+			const AMYYCharacterBase* OwnerCharacter = Cast<AMYYCharacterBase>(Weapon->GetOwner());
+			const UEquipmentComponent* Equipment = OwnerCharacter ? OwnerCharacter->EquipmentComponent : nullptr;
+			const bool bCarried = Equipment && (Equipment->GetWeaponInSlot(EWeaponSlot::Primary) == Weapon ||
+				Equipment->GetWeaponInSlot(EWeaponSlot::Secondary) == Weapon);
+			RouteWeapon(Weapon, bCarried ? Weapon->GetOwner() : nullptr);
+		}
+		else
+		{
+			GridNode->AddActor_Dormancy(ActorInfo, GlobalInfo);
+		}
+		break;
+
+	default:
+		break;
+	}
+
+	if (ActorInfo.Class->IsChildOf(AMYYCharacterBase::StaticClass()))
+	{
+		TeamNode->NotifyAddNetworkActor(ActorInfo);
+	}
+}
+
+void UMYYReplicationGraph::RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo)
+{
+	const EMYYClassRepNodeMapping Policy = GetMappingPolicy(ActorInfo.Class);
+	--NumRouted[static_cast<int32>(Policy)];
+
+	switch (Policy)
+	{
+	case EMYYClassRepNodeMapping::NotRouted:
+		break;
+
+	case EMYYClassRepNodeMapping::RelevantAllConnections:
+		AlwaysRelevantNode->NotifyRemoveNetworkActor(ActorInfo);
+		break;
+
+	case EMYYClassRepNodeMapping::Spatialize_Static:
+		GridNode->RemoveActor_Static(ActorInfo);
+		break;
+
+	case EMYYClassRepNodeMapping::Spatialize_Dynamic:
+		GridNode->RemoveActor_Dynamic(ActorInfo);
+		break;
+
+	case EMYYClassRepNodeMapping::Spatialize_Dormancy:
+		if (AActor** Parent = WeaponParents.Find(ActorInfo.Actor))
+		{
+			if (*Parent)
+			{
+				GlobalActorReplicationInfoMap.RemoveDependentActor(*Parent, ActorInfo.Actor);
+				DEC_DWORD_STAT(STAT_MYY_RepGraphWeaponsCarried);
+			}
+			else
+			{
+				GridNode->RemoveActor_Dormancy(ActorInfo);
+			}
+			WeaponParents.Remove(ActorInfo.Actor);
+		}
+		else
+		{
+			GridNode->RemoveActor_Dormancy(ActorInfo);
+		}
+		break;
+
+	default:
+		break;
+	}
+
+	if (ActorInfo.Class->IsChildOf(AMYYCharacterBase::StaticClass()))
+	{
+		TeamNode->NotifyRemoveNetworkActor(ActorInfo);
+
+		// Weapons this character still carried (destroyed without dropping) go back to the grid
+		for (TPair<AActor*, AActor*>& Pair : WeaponParents)
+		{
+			if (Pair.Value == ActorInfo.Actor)
+			{
+				GlobalActorReplicationInfoMap.RemoveDependentActor(ActorInfo.Actor, Pair.Key);
+				GridNode->AddActor_Dormancy(FNewReplicatedActorInfo(Pair.Key), GlobalActorReplicationInfoMap.Get(Pair.Key));
+				Pair.Value = nullptr;
+				DEC_DWORD_STAT(STAT_MYY_RepGraphWeaponsCarried);
+			}
+		}
+	}
+}
+
+void UMYYReplicationGraph::RouteWeapon(ABaseWeapon* Weapon, AActor* Carrier)
+{
+	// A dependent only replicates through a parent the graph knows about
+	if (Carrier && !GlobalActorReplicationInfoMap.Find(Carrier))
+	{
+		Carrier = nullptr;
+	}
+
+	const FNewReplicatedActorInfo ActorInfo(Weapon);
+
+	if (AActor** Parent = WeaponParents.Find(Weapon))
+	{
+		if (*Parent == Carrier)
+		{
+			return;
+		}
+
+		if (*Parent)
+		{
+			GlobalActorReplicationInfoMap.RemoveDependentActor(*Parent, Weapon);
+			DEC_DWORD_STAT(STAT_MYY_RepGraphWeaponsCarried);
+		}
+		else
+		{
+			GridNode->RemoveActor_Dormancy(ActorInfo);
+		}
+	}
+
+	if (Carrier)
+	{
+		GlobalActorReplicationInfoMap.AddDependentActor(Carrier, Weapon);
+		INC_DWORD_STAT(STAT_MYY_RepGraphWeaponsCarried);
+	}
+	else
+	{
+		GridNode->AddActor_Dormancy(ActorInfo, GlobalActorReplicationInfoMap.Get(Weapon));
+	}
+
+	WeaponParents.Add(Weapon, Carrier);
+
+	UE_LOG(LogMYYCombat, Verbose, TEXT("RepGraph: %s %s"), *GetNameSafe(Weapon),
+		Carrier ? *FString::Printf(TEXT("replicates with %s"), *Carrier->GetName()) : TEXT("is in the grid"));
+}
+
+void UMYYReplicationGraph::SetWeaponCarrier(ABaseWeapon* Weapon, AActor* Carrier)
+{
+	UNetDriver* WeaponNetDriver = Weapon ? Weapon->GetNetDriver() : nullptr;
+	UMYYReplicationGraph* Graph = WeaponNetDriver ? Cast<UMYYReplicationGraph>(WeaponNetDriver->GetReplicationDriver()) : nullptr;
+
+	// Only weapons the graph routed (server, replicated)
+	if (Graph && Graph->WeaponParents.Contains(Weapon))
+	{
+		Graph->RouteWeapon(Weapon, Carrier);
+	}
+}
+
+void UMYYReplicationGraph::DumpGraph() const
+{
+	int32 NumCarried = 0;
+	for (const TPair<AActor*, AActor*>& Pair : WeaponParents)
+	{
+		NumCarried += Pair.Value ? 1 : 0;
+	}
+
+	UE_LOG(LogTemp, Warning, TEXT("📊 RepGraph: %d connections, grid cell %.0f, %d weapons (%d carried, %d in the grid)"),
+		Connections.Num(), GridNode ? GridNode->CellSize : 0.f, WeaponParents.Num(), NumCarried, WeaponParents.Num() - NumCarried);
+
+	for (int32 Index = 0; Index < static_cast<int32>(EMYYClassRepNodeMapping::Count); ++Index)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("   %s: %d actors"),
+			MYYReplicationGraphPrivate::LexToString(static_cast<EMYYClassRepNodeMapping>(Index)), NumRouted[Index]);
+	}
+
+	if (TeamNode)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("   Team node: %d characters"), TeamNode->GetNumCharacters());
+		for (int32 TeamID = 0; TeamID < TeamNode->GetNumTeams(); ++TeamID)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("      Team %d: %d player-controlled"), TeamID, TeamNode->GetNumInTeam(static_cast<uint8>(TeamID)));
+		}
+	}
+}
+
+// ========== TEAM NODE ==========
+
+UMYYReplicationGraphNode_Teams::UMYYReplicationGraphNode_Teams()
+{
+	bRequiresPrepareForReplicationCall = true;
+}
+
+void UMYYReplicationGraphNode_Teams::NotifyAddNetworkActor(const FNewReplicatedActorInfo& ActorInfo)
+{
+	if (AMYYCharacterBase* Character = Cast<AMYYCharacterBase>(ActorInfo.Actor))
+	{
+		Characters.AddUnique(Character);
+	}
+}
+
+bool UMYYReplicationGraphNode_Teams::NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound)
+{
+	const bool bRemoved = Characters.RemoveSwap(Cast<AMYYCharacterBase>(ActorInfo.Actor)) > 0;
+	if (!bRemoved && bWarnIfNotFound)
+	{
+		UE_LOG(LogMYYCombat, Warning, TEXT("RepGraph team node: %s wasn't tracked"), *GetNameSafe(ActorInfo.Actor));
+	}
+
+	// The team lists may still hold it until the next PrepareForReplication
+	for (FActorRepListRefView& TeamList : TeamLists)
+	{
+		TeamList.RemoveFast(ActorInfo.Actor);
+	}
+	return bRemoved;
+}
+
+void UMYYReplicationGraphNode_Teams::NotifyResetAllNetworkActors()
+{
+	Characters.Reset();
+	TeamLists.Reset();
+}
+
+void UMYYReplicationGraphNode_Teams::PrepareForReplication()
+{
+	SCOPE_CYCLE_COUNTER(STAT_MYY_RepGraphTeams);
+
+	for (FActorRepListRefView& TeamList : TeamLists)
+	{
+		TeamList.Reset();
+	}
+
+	// TeamID is set after spawn (and minions are pooled), so bucket every frame instead of on add
+	for (AMYYCharacterBase* Character : Characters)
+	{
+		if (!Character->IsPlayerControlled())
+		{
+			continue;
+		}
+
+		if (!TeamLists.IsValidIndex(Character->TeamID))
+		{
+			TeamLists.SetNum(Character->TeamID + 1);
+		}
+		TeamLists[Character->TeamID].Add(Character);
+	}
+}
+
+void UMYYReplicationGraphNode_Teams::GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params)
+{
+	// Split screen viewers on the same team share one list
+	TArray<uint8, TInlineAllocator<2>> GatheredTeams;
+
+	for (const FNetViewer& Viewer : Params.Viewers)
+	{
+		const AMYYCharacterBase* ViewCharacter = Cast<AMYYCharacterBase>(Viewer.ViewTarget);
+		if (!ViewCharacter)
+		{
+			const APlayerController* PC = Cast<APlayerController>(Viewer.InViewer);
+			ViewCharacter = PC ? Cast<AMYYCharacterBase>(PC->GetPawn()) : nullptr;
+		}
+
+		if (!ViewCharacter || !TeamLists.IsValidIndex(ViewCharacter->TeamID) || GatheredTeams.Contains(ViewCharacter->TeamID))
+		{
+			continue;
+		}
+
+		GatheredTeams.Add(ViewCharacter->TeamID);
+		if (TeamLists[ViewCharacter->TeamID].Num() > 0)
+		{
+			Params.OutGatheredReplicationLists.AddReplicationActorList(TeamLists[ViewCharacter->TeamID]);
+		}
+	}
+}
+
+// ========== PER-CONNECTION NODE ==========
+
+void UMYYReplicationGraphNode_AlwaysRelevant_ForConnection::GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params)
+{
+	ReplicationActorList.Reset();
+
+	for (const FNetViewer& Viewer : Params.Viewers)
+	{
+		ReplicationActorList.ConditionalAdd(Viewer.InViewer);
+		ReplicationActorList.ConditionalAdd(Viewer.ViewTarget);
+
+		if (const APlayerController* PC = Cast<APlayerController>(Viewer.InViewer))
+		{
+			ReplicationActorList.ConditionalAdd(PC->GetPawn());
+		}
+	}
+
+	Params.OutGatheredReplicationLists.AddReplicationActorList(ReplicationActorList);
+}
+
+// MYY.Net.RepGraph.Dump
+static FAutoConsoleCommandWithWorld GRepGraphDumpCommand(
+	TEXT("MYY.Net.RepGraph.Dump"),
+	TEXT("Logs how many actors each replication graph route holds, weapon routes and team sizes."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		UNetDriver* WorldNetDriver = World ? World->GetNetDriver() : nullptr;
+		if (const UMYYReplicationGraph* Graph = WorldNetDriver ? Cast<UMYYReplicationGraph>(WorldNetDriver->GetReplicationDriver()) : nullptr)
+		{
+			Graph->DumpGraph();
+		}
+		else
+		{
+			UE_LOG(LogTemp, Warning, TEXT("📊 RepGraph: not running (no server net driver or another replication driver)"));
+		}
+	}));
@@ -0,0 +1,147 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ReplicationGraph.h"
+#include "MYYReplicationGraph.generated.h"
+
+class AMYYCharacterBase;
+class ABaseWeapon;
+class UMYYReplicationGraphNode_Teams;
+
+// How actors of a class are routed into the graph
+enum class EMYYClassRepNodeMapping : uint8
+{
+	// Not routed: added per connection (player controller, pawn) or replicated with a parent actor
+	NotRouted,
+
+	// Sent to every connection
+	RelevantAllConnections,
+
+	// Grid cells, never move
+	Spatialize_Static,
+
+	// Grid cells, rebuilt every frame
+	Spatialize_Dynamic,
+
+	// Grid cells, static while dormant and dynamic while awake
+	Spatialize_Dormancy,
+
+	Count
+};
+
+/**
+ * Replication graph for combat matches.
+ *
+ * Instead of checking every replicated actor against every connection each net tick, actors are
+ * routed once into shared nodes and each connection only gathers the lists it can see:
+ * - characters, projectiles and ghosts go into a 2D spatial grid (MYY.Net.RepGraph.CellSize), so a
+ *   connection only walks the cells around its view target
+ * - weapons lying loose and arrow pickups go into the same grid through its dormancy path:
+ *   while dormant they are static cell entries that cost nothing per frame
+ * - a weapon someone carries (in hand or holstered) is not routed at all: it is a dependent actor of
+ *   its owner and replicates whenever the owner does (UEquipmentComponent keeps this up to date)
+ * - teammates (player-controlled characters) are always relevant to each other through one team
+ *   node, bucketed once per frame and shared by every connection of that team
+ * - always relevant actors (game state, crowd actor, player states) are one shared list
+ *
+ * The per-connection work is a grid lookup plus a few list references, so the server's net update
+ * cost grows with what each connection sees, not with connections x actors.
+ *
+ * Enabled through ReplicationDriverClassName in DefaultEngine.ini.
+ */
+UCLASS(Transient, Config = Engine)
+class MYY_API UMYYReplicationGraph : public UReplicationGraph
+{
+	GENERATED_BODY()
+
+public:
+	// UReplicationGraph
+	virtual void ResetGameWorldState() override;
+	virtual void InitGlobalActorClassSettings() override;
+	virtual void InitGlobalGraphNodes() override;
+	virtual void InitConnectionGraphNodes(UNetReplicationGraphConnection* RepGraphConnection) override;
+	virtual void RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo) override;
+	virtual void RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo) override;
+
+	// Server. Replicates Weapon with Carrier while it is in their hand or holstered on them, through
+	// the grid's dormancy path otherwise (nullptr: lying loose). No-op without this graph.
+	static void SetWeaponCarrier(ABaseWeapon* Weapon, AActor* Carrier);
+
+	// Node sizes and weapon routes to the log (MYY.Net.RepGraph.Dump)
+	void DumpGraph() const;
+
+private:
+	EMYYClassRepNodeMapping GetMappingPolicy(UClass* Class);
+	void InitClassReplicationInfo(FClassReplicationInfo& Info, UClass* Class, bool bSpatialize) const;
+
+	void RouteWeapon(ABaseWeapon* Weapon, AActor* Carrier);
+
+	UPROPERTY()
+	TObjectPtr<UReplicationGraphNode_GridSpatialization2D> GridNode;
+
+	UPROPERTY()
+	TObjectPtr<UReplicationGraphNode_ActorList> AlwaysRelevantNode;
+
+	UPROPERTY()
+	TObjectPtr<UMYYReplicationGraphNode_Teams> TeamNode;
+
+	TClassMap<EMYYClassRepNodeMapping> ClassRepNodePolicies;
+
+	// Routed actors per policy, for the dump
+	int32 NumRouted[static_cast<int32>(EMYYClassRepNodeMapping::Count)] = {};
+
+	// Every routed weapon -> the actor it replicates with, nullptr while it sits in the grid
+	TMap<AActor*, AActor*> WeaponParents;
+};
+
+/**
+ * Player-controlled characters bucketed by TeamID once per frame. Each connection gathers the
+ * bucket of its own view target's team, so teammates are always relevant to each other.
+ */
+UCLASS()
+class MYY_API UMYYReplicationGraphNode_Teams : public UReplicationGraphNode
+{
+	GENERATED_BODY()
+
+public:
+	UMYYReplicationGraphNode_Teams();
+
+	// UReplicationGraphNode
+	virtual void NotifyAddNetworkActor(const FNewReplicatedActorInfo& ActorInfo) override;
+	virtual bool NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound = true) override;
+	virtual void NotifyResetAllNetworkActors() override;
+	virtual void PrepareForReplication() override;
+	virtual void GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params) override;
+
+	int32 GetNumCharacters() const { return Characters.Num(); }
+	int32 GetNumInTeam(uint8 TeamID) const { return TeamLists.IsValidIndex(TeamID) ? TeamLists[TeamID].Num() : 0; }
+	int32 GetNumTeams() const { return TeamLists.Num(); }
+
+private:
+	TArray<AMYYCharacterBase*> Characters;
+
+	// Indexed by TeamID, rebuilt in PrepareForReplication
+	TArray<FActorRepListRefView> TeamLists;
+};
+
+/**
+ * The connection's own player controller, view target and pawn, which aren't routed anywhere else
+ * (player controllers are owner-only; the pawn is in the grid too, duplicates are skipped).
+ */
+UCLASS()
+class MYY_API UMYYReplicationGraphNode_AlwaysRelevant_ForConnection : public UReplicationGraphNode
+{
+	GENERATED_BODY()
+
+public:
+	// UReplicationGraphNode
+	virtual void NotifyAddNetworkActor(const FNewReplicatedActorInfo& ActorInfo) override {}
+	virtual bool NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound = true) override { return false; }
+	virtual void NotifyResetAllNetworkActors() override {}
+	virtual void GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params) override;
+
+private:
+	FActorRepListRefView ReplicationActorList;
+};
@@ -2,6 +2,7 @@
 #include "Components/SphereComponent.h"
 #include "Components/ArrowComponent.h"
 #include "Components/BillboardComponent.h"
+#include "MYY/AbilitySystem/Subsystem/SpawnPointSubsystem.h"
 
 ACustomPlayerStart::ACustomPlayerStart(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -28,6 +29,22 @@ void ACustomPlayerStart::BeginPlay()
 	{
 		Tags.AddUnique(FName("AISpawn"));
 	}
+
+	// Scored and picked by the game mode through the registry
+	if (USpawnPointSubsystem* SpawnPointRegistry = GetWorld()->GetSubsystem<USpawnPointSubsystem>())
+	{
+		SpawnPointRegistry->RegisterSpawnPoint(this);
+	}
+}
+
+void ACustomPlayerStart::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (USpawnPointSubsystem* SpawnPointRegistry = GetWorld()->GetSubsystem<USpawnPointSubsystem>())
+	{
+		SpawnPointRegistry->UnregisterSpawnPoint(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 #if WITH_EDITOR
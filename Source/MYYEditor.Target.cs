@@ -10,6 +10,9 @@ public class MYYEditorTarget : TargetRules
 		Type = TargetType.Editor;
 		DefaultBuildSettings = BuildSettingsVersion.V5;
 
+		// Push-model replication (net.IsPushModelEnabled)
+		bWithPushModel = true;
+
 		ExtraModuleNames.AddRange( new string[] { "MYY" } );
 	}
 }